@@ -0,0 +1,163 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_AABC_HPP
+#define UFO_GEOMETRY_AABC_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
+
+namespace ufo
+{
+/*!
+ * @brief Axis-aligned bounding cube, a center and a scalar half length.
+ *
+ * Octree nodes are always cubes, storing them as an AABB costs twice the memory and
+ * extra per-axis work in the queries.
+ */
+template <std::size_t Dim = 3, class T = float>
+struct AABC {
+	static_assert(std::is_floating_point_v<T>, "T is required to be floating point.");
+
+	using value_type = T;
+
+	Vec<Dim, T> center;
+	T           half_length;
+
+	constexpr AABC() noexcept = default;
+
+	constexpr AABC(Vec<Dim, T> const& center, T half_length) noexcept
+	    : center(center), half_length(half_length)
+	{
+	}
+
+	constexpr AABC(AABC const&) noexcept = default;
+
+	template <class U>
+	constexpr explicit AABC(AABC<Dim, U> const& other) noexcept
+	    : center(other.center), half_length(other.half_length)
+	{
+	}
+
+	constexpr explicit operator AABB<Dim, T>() const noexcept
+	{
+		return AABB<Dim, T>(min(), max());
+	}
+
+	[[nodiscard]] static constexpr std::size_t size() noexcept { return Dim; }
+
+	[[nodiscard]] constexpr Vec<Dim, T> min() const noexcept
+	{
+		return center - half_length;
+	}
+
+	[[nodiscard]] constexpr Vec<Dim, T> max() const noexcept
+	{
+		return center + half_length;
+	}
+
+	[[nodiscard]] constexpr T length() const noexcept { return T(2) * half_length; }
+};
+
+//
+// Deduction guide
+//
+
+template <std::size_t Dim, class T>
+AABC(Vec<Dim, T>, T) -> AABC<Dim, T>;
+
+/*!
+ * @brief Compare two AABCs.
+ *
+ * @param lhs,rhs The AABCs to compare
+ * @return `true` if they compare equal, `false` otherwise.
+ */
+template <std::size_t Dim, class T>
+bool operator==(AABC<Dim, T> const& lhs, AABC<Dim, T> const& rhs)
+{
+	return lhs.center == rhs.center && lhs.half_length == rhs.half_length;
+}
+
+/*!
+ * @brief Compare two AABCs.
+ *
+ * @param lhs,rhs The AABCs to compare
+ * @return `true` if they do not compare equal, `false` otherwise.
+ */
+template <std::size_t Dim, class T>
+bool operator!=(AABC<Dim, T> const& lhs, AABC<Dim, T> const& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <std::size_t Dim, class T>
+std::ostream& operator<<(std::ostream& out, AABC<Dim, T> const& aabc)
+{
+	return out << "Center: " << aabc.center << ", Half length: " << aabc.half_length;
+}
+
+template <class T>
+using AABC1 = AABC<1, T>;
+template <class T>
+using AABC2 = AABC<2, T>;
+template <class T>
+using AABC3 = AABC<3, T>;
+template <class T>
+using AABC4 = AABC<4, T>;
+
+using AABC1f = AABC<1, float>;
+using AABC2f = AABC<2, float>;
+using AABC3f = AABC<3, float>;
+using AABC4f = AABC<4, float>;
+
+using AABC1d = AABC<1, double>;
+using AABC2d = AABC<2, double>;
+using AABC3d = AABC<3, double>;
+using AABC4d = AABC<4, double>;
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_AABC_HPP
@@ -0,0 +1,502 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_BOUNDING_VOLUME_HPP
+#define UFO_GEOMETRY_BOUNDING_VOLUME_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/detail/symmetric_eigen.hpp>
+#include <ufo/geometry/fun.hpp>
+#include <ufo/geometry/obb.hpp>
+#include <ufo/geometry/sphere.hpp>
+#include <ufo/math/mat.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <execution>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+namespace detail
+{
+template <class V>
+struct vec_traits;
+
+template <std::size_t Dim, class T>
+struct vec_traits<Vec<Dim, T>> {
+	static constexpr std::size_t dim = Dim;
+	using value_type                 = T;
+};
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> const& lower(Vec<Dim, T> const& a) noexcept
+{
+	return a;
+}
+
+template <class Geometry>
+[[nodiscard]] constexpr auto lower(Geometry const& a)
+{
+	return min(a);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> const& upper(Vec<Dim, T> const& a) noexcept
+{
+	return a;
+}
+
+template <class Geometry>
+[[nodiscard]] constexpr auto upper(Geometry const& a)
+{
+	return max(a);
+}
+
+template <class InputIt>
+using bounding_aabb_t = decltype(AABB(lower(*std::declval<InputIt>()),
+                                      upper(*std::declval<InputIt>())));
+
+/*!
+ * @brief Grows [`lo`, `hi`] to enclose all elements in [first, last).
+ *
+ * The bounds are kept in plain arrays and updated with branch free selects, so the inner
+ * loop compiles to packed min/max instructions.
+ */
+template <class InputIt, std::size_t Dim, class T>
+void expandBounds(InputIt first, InputIt last, Vec<Dim, T>& lo, Vec<Dim, T>& hi)
+{
+	T l[Dim];
+	T h[Dim];
+	for (std::size_t i{}; Dim > i; ++i) {
+		l[i] = lo[i];
+		h[i] = hi[i];
+	}
+
+	for (; first != last; ++first) {
+		auto const& a = lower(*first);
+		auto const& b = upper(*first);
+		for (std::size_t i{}; Dim > i; ++i) {
+			l[i] = a[i] < l[i] ? a[i] : l[i];
+			h[i] = h[i] < b[i] ? b[i] : h[i];
+		}
+	}
+
+	for (std::size_t i{}; Dim > i; ++i) {
+		lo[i] = l[i];
+		hi[i] = h[i];
+	}
+}
+
+/*!
+ * @brief Reduces [first, last) by running `kernel(chunk_first, chunk_last)` on
+ * contiguous chunks according to `policy` and combining the results with `reduce`.
+ *
+ * The chunks are large enough that the serial kernel dominates, and there are a few
+ * per hardware thread for load balancing.
+ */
+template <class ExecutionPolicy, class RandomIt, class R, class Reduce, class Kernel>
+[[nodiscard]] R chunkedReduce(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+                              R init, Reduce reduce, Kernel kernel)
+{
+	constexpr std::size_t min_chunk = 4096;
+
+	auto const        n       = static_cast<std::size_t>(std::distance(first, last));
+	std::size_t const threads = std::max(1u, std::thread::hardware_concurrency());
+	std::size_t const chunk   = std::max(min_chunk, (n + 4 * threads - 1) / (4 * threads));
+	std::size_t const chunks  = (n + chunk - 1) / chunk;
+
+	if (1 >= chunks) {
+		return reduce(std::move(init), kernel(first, last));
+	}
+
+	std::vector<std::size_t> idx(chunks);
+	std::iota(idx.begin(), idx.end(), std::size_t(0));
+
+	return std::transform_reduce(
+	    std::forward<ExecutionPolicy>(policy), idx.begin(), idx.end(), std::move(init),
+	    reduce, [first, n, chunk, &kernel](std::size_t i) {
+		    auto b = first + static_cast<std::ptrdiff_t>(i * chunk);
+		    auto e = first + static_cast<std::ptrdiff_t>(std::min(n, (i + 1) * chunk));
+		    return kernel(b, e);
+	    });
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr AABB<Dim, T> emptyAABB() noexcept
+{
+	return AABB<Dim, T>(Vec<Dim, T>(std::numeric_limits<T>::max()),
+	                    Vec<Dim, T>(std::numeric_limits<T>::lowest()));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool insideWithTolerance(Sphere<Dim, T> const& s,
+                                                 Vec<Dim, T> const&    p) noexcept
+{
+	T const r2 = s.radius * s.radius;
+	return T(0) <= s.radius &&
+	       distanceSquared(s.center, p) <=
+	           r2 + r2 * (T(64) * std::numeric_limits<T>::epsilon()) +
+	               std::numeric_limits<T>::min();
+}
+
+/*!
+ * @brief The smallest sphere with all `n` points of `s` on its boundary.
+ *
+ * The center lies in the affine hull of the points, `c = s[0] + sum_j l_j (s[j] - s[0])`,
+ * where the weights solve the Gram system `sum_k l_k dot(a_j, a_k) = |a_j|^2 / 2`. If
+ * the points are affinely dependent the system is singular, and the smallest sphere
+ * through any `n - 1` of them that contains the last one is used instead.
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] Sphere<Dim, T> circumsphere(Vec<Dim, T> const* s, std::size_t n)
+{
+	if (0 == n) {
+		return Sphere<Dim, T>(Vec<Dim, T>(), T(-1));
+	} else if (1 == n) {
+		return Sphere<Dim, T>(s[0], T(0));
+	}
+
+	std::size_t const m = n - 1;
+
+	Vec<Dim, T> a[Dim];
+	T           g[Dim][Dim + 1];
+	T           scale{};
+	for (std::size_t j{}; m > j; ++j) {
+		a[j]  = s[j + 1] - s[0];
+		scale = std::max(scale, dot(a[j], a[j]));
+	}
+	for (std::size_t j{}; m > j; ++j) {
+		for (std::size_t k{}; m > k; ++k) {
+			g[j][k] = dot(a[j], a[k]);
+		}
+		g[j][m] = dot(a[j], a[j]) * T(0.5);
+	}
+
+	// Gaussian elimination with partial pivoting
+	bool singular = false;
+	for (std::size_t c{}; m > c && !singular; ++c) {
+		std::size_t p = c;
+		for (std::size_t r = c + 1; m > r; ++r) {
+			if (std::abs(g[r][c]) > std::abs(g[p][c])) {
+				p = r;
+			}
+		}
+		if (std::abs(g[p][c]) <= scale * T(1e3) * std::numeric_limits<T>::epsilon()) {
+			singular = true;
+			break;
+		}
+		for (std::size_t k{}; m >= k; ++k) {
+			std::swap(g[c][k], g[p][k]);
+		}
+		for (std::size_t r = c + 1; m > r; ++r) {
+			T const f = g[r][c] / g[c][c];
+			for (std::size_t k = c; m >= k; ++k) {
+				g[r][k] -= f * g[c][k];
+			}
+		}
+	}
+
+	if (!singular) {
+		T l[Dim];
+		for (std::size_t j = m; 0 < j--;) {
+			T v = g[j][m];
+			for (std::size_t k = j + 1; m > k; ++k) {
+				v -= g[j][k] * l[k];
+			}
+			l[j] = v / g[j][j];
+		}
+
+		Vec<Dim, T> c = s[0];
+		for (std::size_t j{}; m > j; ++j) {
+			c += a[j] * l[j];
+		}
+		return Sphere<Dim, T>(c, distance(c, s[0]));
+	}
+
+	Sphere<Dim, T> best(Vec<Dim, T>(), T(-1));
+	Vec<Dim, T>    sub[Dim + 1];
+	for (std::size_t skip{}; n > skip; ++skip) {
+		for (std::size_t i{}, j{}; n > i; ++i) {
+			if (i != skip) {
+				sub[j++] = s[i];
+			}
+		}
+		auto const cand = circumsphere(sub, m);
+		if ((T(0) > best.radius || cand.radius < best.radius) &&
+		    insideWithTolerance(cand, s[skip])) {
+			best = cand;
+		}
+	}
+	return best;
+}
+
+/*!
+ * @brief Welzl's algorithm with the move-to-front heuristic.
+ *
+ * Returns the smallest sphere enclosing the first `n` points of `p` that has the `ns`
+ * points of `support` on its boundary. At most `Dim + 1` points are ever on the support,
+ * which bounds the recursion depth.
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] Sphere<Dim, T> welzl(Vec<Dim, T>* p, std::size_t n, Vec<Dim, T>* support,
+                                   std::size_t ns)
+{
+	Sphere<Dim, T> s = circumsphere(support, ns);
+	if (Dim + 1 == ns) {
+		return s;
+	}
+
+	for (std::size_t i{}; n > i; ++i) {
+		if (!insideWithTolerance(s, p[i])) {
+			support[ns] = p[i];
+			s           = welzl(p, i, support, ns + 1);
+			std::rotate(p, p + i, p + i + 1);
+		}
+	}
+	return s;
+}
+}  // namespace detail
+
+/**************************************************************************************
+|                                                                                     |
+|                                        AABB                                         |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Computes the smallest AABB enclosing all points (or geometries that have
+ * `min`/`max`) in [first, last).
+ *
+ * An empty range gives an inverted AABB, with `min` at the largest and `max` at the
+ * lowest representable value, that any later merge overrides.
+ */
+template <
+    class InputIt,
+    std::enable_if_t<!std::is_execution_policy_v<std::decay_t<InputIt>>, bool> = true>
+[[nodiscard]] detail::bounding_aabb_t<InputIt> boundingAABB(InputIt first, InputIt last)
+{
+	using A = detail::bounding_aabb_t<InputIt>;
+
+	A res = detail::emptyAABB<detail::vec_traits<decltype(A::min)>::dim,
+	                          typename A::value_type>();
+	detail::expandBounds(first, last, res.min, res.max);
+	return res;
+}
+
+/*!
+ * @brief Same as above, but executed according to `policy`.
+ *
+ * The range is split into contiguous chunks that are reduced with the serial kernel
+ * and the chunk bounds are then merged.
+ */
+template <
+    class ExecutionPolicy, class RandomIt,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+[[nodiscard]] detail::bounding_aabb_t<RandomIt> boundingAABB(ExecutionPolicy&& policy,
+                                                             RandomIt         first,
+                                                             RandomIt         last)
+{
+	using A = detail::bounding_aabb_t<RandomIt>;
+
+	A const empty = detail::emptyAABB<detail::vec_traits<decltype(A::min)>::dim,
+	                                  typename A::value_type>();
+
+	return detail::chunkedReduce(
+	    std::forward<ExecutionPolicy>(policy), first, last, empty,
+	    [](A a, A const& b) {
+		    a.min = min(a.min, b.min);
+		    a.max = max(a.max, b.max);
+		    return a;
+	    },
+	    [&empty](RandomIt b, RandomIt e) {
+		    A res = empty;
+		    detail::expandBounds(b, e, res.min, res.max);
+		    return res;
+	    });
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                       Sphere                                        |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Computes the minimal enclosing sphere of the points in [first, last).
+ *
+ * Uses Welzl's algorithm with the move-to-front heuristic on a shuffled copy of the
+ * points, which is exact and runs in expected linear time. The shuffle uses a fixed
+ * seed, so the result is deterministic. An empty range gives a sphere with negative
+ * radius.
+ */
+template <class InputIt>
+[[nodiscard]] auto boundingSphere(InputIt first, InputIt last)
+{
+	using V = std::decay_t<decltype(*first)>;
+
+	constexpr std::size_t Dim = detail::vec_traits<V>::dim;
+
+	std::vector<V> points(first, last);
+	std::shuffle(points.begin(), points.end(), std::minstd_rand(5489u));
+
+	V support[Dim + 1];
+	return detail::welzl(points.data(), points.size(), support, 0);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                         OBB                                         |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Computes a tight OBB enclosing the points in [first, last).
+ *
+ * The axes are the eigenvectors of the covariance matrix of the points (principal
+ * component analysis) and the extents are found by projecting the points onto them.
+ * PCA can be fooled by unevenly distributed points, so if the AABB of the points has
+ * a smaller volume it is returned instead (as an OBB with identity rotation).
+ *
+ * The rotation maps from the local frame of the box to world, column `i` is the axis of
+ * `half_length[i]`. In 2D and 3D the frame is right handed.
+ */
+template <class ForwardIt>
+[[nodiscard]] auto boundingOBB(ForwardIt first, ForwardIt last)
+{
+	using V = std::decay_t<decltype(*first)>;
+	using T = typename detail::vec_traits<V>::value_type;
+
+	constexpr std::size_t Dim = detail::vec_traits<V>::dim;
+
+	using R = OBB<Dim, T>;
+
+	if (first == last) {
+		return R(Vec<Dim, T>(), Vec<Dim, T>(), Mat<Dim, Dim, T>());
+	}
+
+	// Mean and covariance, shifted by the first point for numerical stability
+
+	V const     origin = *first;
+	Vec<Dim, T> sum{};
+	T           c[Dim][Dim]{};
+	std::size_t n{};
+	for (auto it = first; it != last; ++it, ++n) {
+		V const d = *it - origin;
+		sum += d;
+		for (std::size_t i{}; Dim > i; ++i) {
+			for (std::size_t j = i; Dim > j; ++j) {
+				c[i][j] += d[i] * d[j];
+			}
+		}
+	}
+
+	Vec<Dim, T> const mean = sum / static_cast<T>(n);
+
+	Mat<Dim, Dim, T> cov;
+	for (std::size_t i{}; Dim > i; ++i) {
+		for (std::size_t j = i; Dim > j; ++j) {
+			cov[i][j] = cov[j][i] = c[i][j] / static_cast<T>(n) - mean[i] * mean[j];
+		}
+	}
+
+	Vec<Dim, T>      values;
+	Mat<Dim, Dim, T> axes;
+	detail::symmetricEigen(cov, values, axes);
+
+	if constexpr (2 == Dim) {
+		if (T(0) > axes[0][0] * axes[1][1] - axes[0][1] * axes[1][0]) {
+			axes[1] = -axes[1];
+		}
+	} else if constexpr (3 == Dim) {
+		if (T(0) > dot(cross(axes[0], axes[1]), axes[2])) {
+			axes[2] = -axes[2];
+		}
+	}
+
+	Vec<Dim, T> lo(std::numeric_limits<T>::max());
+	Vec<Dim, T> hi(std::numeric_limits<T>::lowest());
+	Vec<Dim, T> box_lo(std::numeric_limits<T>::max());
+	Vec<Dim, T> box_hi(std::numeric_limits<T>::lowest());
+	for (auto it = first; it != last; ++it) {
+		V const d = *it - origin;
+		for (std::size_t i{}; Dim > i; ++i) {
+			T const p = dot(d, axes[i]);
+			lo[i]     = std::min(lo[i], p);
+			hi[i]     = std::max(hi[i], p);
+			box_lo[i] = std::min(box_lo[i], d[i]);
+			box_hi[i] = std::max(box_hi[i], d[i]);
+		}
+	}
+
+	T pca_volume(1);
+	T box_volume(1);
+	for (std::size_t i{}; Dim > i; ++i) {
+		pca_volume *= hi[i] - lo[i];
+		box_volume *= box_hi[i] - box_lo[i];
+	}
+
+	if (box_volume <= pca_volume) {
+		return R(origin + (box_lo + box_hi) * T(0.5), (box_hi - box_lo) * T(0.5),
+		         Mat<Dim, Dim, T>());
+	}
+
+	Vec<Dim, T> center = origin;
+	for (std::size_t i{}; Dim > i; ++i) {
+		center += axes[i] * ((lo[i] + hi[i]) * T(0.5));
+	}
+	return R(center, (hi - lo) * T(0.5), axes);
+}
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_BOUNDING_VOLUME_HPP
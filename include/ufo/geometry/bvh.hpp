@@ -0,0 +1,1463 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_BVH_HPP
+#define UFO_GEOMETRY_BVH_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/bounding_volume.hpp>
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/fun.hpp>
+#include <ufo/geometry/intersects.hpp>
+#include <ufo/geometry/space_filling_curve.hpp>
+#include <ufo/geometry/type_traits.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+enum class BVHBuild {
+	// Top-down, splitting at the median centroid along the axis where they spread the most
+	MEDIAN,
+	// Top-down, splitting where the binned surface area heuristic is the lowest. The
+	// slowest to build, but gives the fastest queries
+	SAH,
+	// Linear BVH, splitting the centroids sorted along a Morton curve where their codes
+	// first differ. The fastest to build
+	LBVH
+};
+
+namespace detail
+{
+/*!
+ * @brief Half the surface area of `a`, or half the perimeter in 2D.
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T halfArea(AABB<Dim, T> const& a) noexcept
+{
+	auto const e = a.max - a.min;
+	T          res{};
+	if constexpr (2 >= Dim) {
+		for (std::size_t i{}; Dim > i; ++i) {
+			res += e[i];
+		}
+	} else {
+		for (std::size_t i{}; Dim > i; ++i) {
+			for (std::size_t j = i + 1; Dim > j; ++j) {
+				res += e[i] * e[j];
+			}
+		}
+	}
+	return res;
+}
+}  // namespace detail
+
+/*!
+ * @brief A bounding volume hierarchy over a set of geometries.
+ *
+ * The nodes are stored in depth-first order in a single array, so the first child of an
+ * internal node directly follows it and only the index of the second child is stored.
+ * The geometries are reordered on construction such that each leaf references a
+ * contiguous range of them. Queries report the position the geometry had in the input.
+ *
+ * Works for any geometry with `min` and `max` in `fun.hpp`, as well as for `Vec`.
+ *
+ * The tree is built with one of the `BVHBuild` methods. Given a parallel execution
+ * policy, the splits near the root are computed in parallel, and then the subtrees below
+ * them are built in parallel.
+ *
+ * Geometries can be moved with `update`, after which `refit` corrects the bounds of the
+ * affected nodes and `restructure` also rebuilds the parts of the tree that have
+ * degraded.
+ */
+template <class Geometry>
+class BVH
+{
+ public:
+	using geometry_type = Geometry;
+	using value_type    = typename geometry_traits<Geometry>::value_type;
+	using size_type     = std::size_t;
+
+	static constexpr std::size_t dimension = geometry_traits<Geometry>::dimension;
+
+	using bounds_type = AABB<dimension, value_type>;
+
+	/*!
+	 * @brief The maximum depth of the tree, which bounds the traversal stack.
+	 */
+	static constexpr std::size_t MAX_DEPTH = 64;
+
+	struct Node {
+		bounds_type bounds;
+		// Leaf: first geometry. Internal: index of the second child.
+		std::uint32_t offset{};
+		// Number of geometries, zero for internal nodes.
+		std::uint32_t count{};
+
+		[[nodiscard]] constexpr bool leaf() const noexcept { return 0 != count; }
+	};
+
+	/*!
+	 * @brief Number of bins per axis evaluated by `BVHBuild::SAH`.
+	 */
+	static constexpr std::size_t SAH_BINS = 16;
+
+	BVH() = default;
+
+	template <class InputIt>
+	BVH(InputIt first, InputIt last, size_type leaf_size = 4)
+	    : BVH(first, last, BVHBuild::MEDIAN, leaf_size)
+	{
+	}
+
+	template <class InputIt>
+	BVH(InputIt first, InputIt last, BVHBuild method, size_type leaf_size = 4)
+	    : geometry_(first, last)
+	{
+		build(std::execution::seq, method, leaf_size);
+	}
+
+	/*!
+	 * @brief Builds the tree over [first, last) according to `policy`.
+	 *
+	 * @param leaf_size The maximum number of geometries in a leaf, unless they cannot be
+	 * split or the tree reaches `MAX_DEPTH`
+	 */
+	template <
+	    class ExecutionPolicy, class RandomIt,
+	    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+	        true>
+	BVH(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+	    BVHBuild method = BVHBuild::SAH, size_type leaf_size = 4)
+	    : geometry_(first, last)
+	{
+		build(std::forward<ExecutionPolicy>(policy), method, leaf_size);
+	}
+
+	BVH(std::initializer_list<Geometry> init, size_type leaf_size = 4)
+	    : BVH(init, BVHBuild::MEDIAN, leaf_size)
+	{
+	}
+
+	BVH(std::initializer_list<Geometry> init, BVHBuild method, size_type leaf_size = 4)
+	    : geometry_(init)
+	{
+		build(std::execution::seq, method, leaf_size);
+	}
+
+	[[nodiscard]] size_type size() const noexcept { return geometry_.size(); }
+
+	[[nodiscard]] bool empty() const noexcept { return geometry_.empty(); }
+
+	[[nodiscard]] bounds_type bounds() const
+	{
+		return empty() ? detail::emptyAABB<dimension, value_type>() : nodes_[0].bounds;
+	}
+
+	[[nodiscard]] std::vector<Node> const& nodes() const noexcept { return nodes_; }
+
+	/*!
+	 * @brief The geometries in tree order.
+	 */
+	[[nodiscard]] std::vector<Geometry> const& geometry() const noexcept
+	{
+		return geometry_;
+	}
+
+	/*!
+	 * @brief The input position of each geometry in tree order.
+	 */
+	[[nodiscard]] std::vector<size_type> const& index() const noexcept { return index_; }
+
+	/*!
+	 * @brief Calls `f(geometry, index)` for every geometry in a leaf whose bounds, and
+	 * the bounds of all its ancestors, satisfy `descend`.
+	 */
+	template <class Descend, class F>
+	void traverse(Descend descend, F f) const
+	{
+		(void)traverseAny(descend, [&f](Geometry const& g, size_type i) {
+			f(g, i);
+			return false;
+		});
+	}
+
+	/*!
+	 * @brief Same as `traverse`, but stops as soon as `f(geometry, index)` returns
+	 * `true`.
+	 *
+	 * @return Whether `f` returned `true` for any geometry.
+	 */
+	template <class Descend, class F>
+	[[nodiscard]] bool traverseAny(Descend descend, F f) const
+	{
+		if (empty()) {
+			return false;
+		}
+
+		std::array<std::uint32_t, MAX_DEPTH> stack;
+		std::size_t                          top{};
+		stack[top++] = 0;
+		while (top) {
+			std::uint32_t const i    = stack[--top];
+			Node const&         node = nodes_[i];
+			if (!descend(node.bounds)) {
+				continue;
+			}
+
+			if (node.leaf()) {
+				for (std::uint32_t j = node.offset; node.offset + node.count > j; ++j) {
+					if (f(geometry_[j], index_[j])) {
+						return true;
+					}
+				}
+			} else {
+				stack[top++] = node.offset;
+				stack[top++] = i + 1;
+			}
+		}
+		return false;
+	}
+
+	/*!
+	 * @brief Finds the geometry minimizing `distance(geometry)`, by visiting the closest
+	 * child first and pruning the nodes where `bound(node_bounds)` is not smaller than the
+	 * best distance found so far.
+	 *
+	 * `bound` has to be a lower bound of `distance` for every geometry inside the node.
+	 * Only distances smaller than `max` are considered.
+	 *
+	 * @return The input position of the closest geometry and its distance, or `size()`
+	 * and `max` if no geometry is closer than `max`.
+	 */
+	template <class Bound, class Distance>
+	[[nodiscard]] std::pair<size_type, value_type> traverseNearest(
+	    Bound bound, Distance distance,
+	    value_type max = std::numeric_limits<value_type>::infinity()) const
+	{
+		std::pair<size_type, value_type> res(size(), max);
+		if (empty() || !(bound(nodes_[0].bounds) < max)) {
+			return res;
+		}
+
+		std::array<std::pair<std::uint32_t, value_type>, MAX_DEPTH> stack;
+		std::size_t                                                 top{};
+		stack[top++] = {0, value_type(0)};
+		while (top) {
+			auto const [i, lower] = stack[--top];
+			if (!(lower < res.second)) {
+				continue;
+			}
+
+			Node const& node = nodes_[i];
+			if (node.leaf()) {
+				for (std::uint32_t j = node.offset; node.offset + node.count > j; ++j) {
+					value_type const d = distance(geometry_[j], index_[j]);
+					if (d < res.second) {
+						res = {index_[j], d};
+					}
+				}
+				continue;
+			}
+
+			std::uint32_t a  = i + 1;
+			std::uint32_t b  = node.offset;
+			value_type    da = bound(nodes_[a].bounds);
+			value_type    db = bound(nodes_[b].bounds);
+			if (db < da) {
+				std::swap(a, b);
+				std::swap(da, db);
+			}
+			// The closer child is pushed last so it is visited first
+			if (db < res.second) {
+				stack[top++] = {b, db};
+			}
+			if (da < res.second) {
+				stack[top++] = {a, da};
+			}
+		}
+		return res;
+	}
+
+	/*!
+	 * @brief Writes the input position of every geometry intersecting `query` to
+	 * `d_first`.
+	 *
+	 * @return Output iterator to the element past the last element written.
+	 */
+	template <class Query, class OutputIt>
+	OutputIt intersects(Query const& query, OutputIt d_first) const
+	{
+		traverse([&query](bounds_type const& b) { return ufo::intersects(b, query); },
+		         [&query, &d_first](Geometry const& g, size_type i) {
+			         if (ufo::intersects(g, query)) {
+				         *d_first++ = i;
+			         }
+		         });
+		return d_first;
+	}
+
+	/*!
+	 * @brief The geometry closest to `query`, considering only distances smaller than
+	 * `max`.
+	 *
+	 * @return The input position of the closest geometry and the distance to it, or
+	 * `size()` and `max` if no geometry is closer than `max`.
+	 */
+	template <class Query>
+	[[nodiscard]] std::pair<size_type, value_type> nearest(
+	    Query const& query,
+	    value_type   max = std::numeric_limits<value_type>::infinity()) const
+	{
+		return traverseNearest(
+		    [&query](bounds_type const& b) { return ufo::distance(b, query); },
+		    [&query](Geometry const& g, size_type) { return ufo::distance(g, query); },
+		    max);
+	}
+
+	/*!
+	 * @brief Replaces the geometry at input position `i` by `g`.
+	 *
+	 * The tree is not changed until `refit` or `restructure` is called, and until then
+	 * queries may miss `g`.
+	 */
+	void update(size_type i, Geometry const& g)
+	{
+		if (!tracked()) {
+			track();
+		}
+
+		std::uint32_t const pos = position_[i];
+		geometry_[pos]          = g;
+		// Stops at the first ancestor already marked, since its ancestors are as well. The
+		// root is its own parent.
+		for (std::uint32_t n = leaf_[pos]; !dirty_[n]; n = parent_[n]) {
+			dirty_[n] = 1;
+		}
+	}
+
+	/*!
+	 * @brief Recomputes the bounds of all nodes containing updated geometries, keeping
+	 * the structure of the tree.
+	 */
+	void refit() { refit(std::execution::seq); }
+
+	/*!
+	 * @brief Recomputes the bounds of all nodes containing updated geometries according to
+	 * `policy`, keeping the structure of the tree.
+	 *
+	 * The updated subtrees near the root are split until there are enough to refit in
+	 * parallel, and their ancestors are refitted last.
+	 */
+	template <
+	    class ExecutionPolicy,
+	    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+	        true>
+	void refit(ExecutionPolicy&& policy)
+	{
+		if (!tracked() || !dirty_[0]) {
+			return;
+		}
+
+		std::size_t target = 1;
+		if constexpr (!std::is_same_v<std::execution::sequenced_policy,
+		                              std::decay_t<ExecutionPolicy>>) {
+			target = 8 * std::max(1u, std::thread::hardware_concurrency());
+		}
+
+		std::vector<std::uint32_t> expanded;
+		std::vector<std::uint32_t> frontier{0};
+		while (target > frontier.size()) {
+			std::size_t const          before = expanded.size();
+			std::vector<std::uint32_t> next;
+			for (std::uint32_t i : frontier) {
+				Node const& node = nodes_[i];
+				if (node.leaf()) {
+					next.push_back(i);
+					continue;
+				}
+				expanded.push_back(i);
+				for (std::uint32_t c : {i + 1, node.offset}) {
+					if (dirty_[c]) {
+						next.push_back(c);
+					}
+				}
+			}
+			if (expanded.size() == before) {
+				break;
+			}
+			frontier = std::move(next);
+		}
+
+		std::for_each(policy, frontier.begin(), frontier.end(),
+		              [this](std::uint32_t i) { refitSubtree(i); });
+
+		// The children of a node are expanded after it
+		for (auto it = expanded.rbegin(); expanded.rend() != it; ++it) {
+			Node& node      = nodes_[*it];
+			node.bounds.min = min(nodes_[*it + 1].bounds.min, nodes_[node.offset].bounds.min);
+			node.bounds.max = max(nodes_[*it + 1].bounds.max, nodes_[node.offset].bounds.max);
+			dirty_[*it]     = 0;
+		}
+	}
+
+	/*!
+	 * @brief Refits the tree and then rebuilds the subtrees that have degraded too much.
+	 *
+	 * @see restructure(ExecutionPolicy&&, value_type, BVHBuild)
+	 */
+	size_type restructure(value_type threshold = 2, BVHBuild method = BVHBuild::SAH)
+	{
+		return restructure(std::execution::seq, threshold, method);
+	}
+
+	/*!
+	 * @brief Refits the tree and then rebuilds the subtrees that have degraded too much,
+	 * according to `policy`.
+	 *
+	 * Refitting keeps the structure of the tree, which gets worse as the geometries move.
+	 * A subtree is rebuilt with `method` once its surface area heuristic cost exceeds
+	 * `threshold` times the cost it had when the tree was built or last restructured. Only
+	 * the topmost such subtrees are rebuilt, so calling this periodically keeps the tree
+	 * close to a full rebuild for a fraction of the time.
+	 *
+	 * @return The number of subtrees rebuilt.
+	 */
+	template <
+	    class ExecutionPolicy,
+	    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+	        true>
+	size_type restructure(ExecutionPolicy&& policy, value_type threshold = 2,
+	                      BVHBuild method = BVHBuild::SAH)
+	{
+		refit(policy);
+		if (!tracked()) {
+			return 0;
+		}
+
+		auto const                           current = cost();
+		std::vector<std::uint32_t>           roots;
+		std::array<std::uint32_t, MAX_DEPTH> stack;
+		std::size_t                          top{};
+		stack[top++] = 0;
+		while (top) {
+			std::uint32_t const i    = stack[--top];
+			Node const&         node = nodes_[i];
+			if (node.leaf()) {
+				continue;
+			}
+			if (threshold * cost_[i] < current[i]) {
+				roots.push_back(i);
+			} else {
+				stack[top++] = node.offset;
+				stack[top++] = i + 1;
+			}
+		}
+
+		// Rebuilding a subtree moves the nodes after it, so the last one goes first
+		std::sort(roots.begin(), roots.end());
+		for (auto it = roots.rbegin(); roots.rend() != it; ++it) {
+			rebuildSubtree(policy, method, *it);
+		}
+		if (!roots.empty()) {
+			track();
+		}
+		return roots.size();
+	}
+
+ private:
+	/*!
+	 * @brief The bounds and centroids of the geometries, and for `BVHBuild::LBVH` their
+	 * Morton codes in tree order, shared by all splits of a build.
+	 */
+	struct Builder {
+		BVHBuild                                method;
+		size_type                               leaf_size;
+		std::vector<size_type>&                 index;
+		std::vector<bounds_type>                bounds{};
+		std::vector<Vec<dimension, value_type>> centers{};
+		std::vector<std::uint32_t>              codes{};
+
+		template <class ExecutionPolicy>
+		[[nodiscard]] bounds_type centroidBounds(ExecutionPolicy&& policy,
+		                                         std::uint32_t     first,
+		                                         std::uint32_t     last) const
+		{
+			return detail::chunkedReduce(
+			    policy, index.begin() + first, index.begin() + last,
+			    detail::emptyAABB<dimension, value_type>(),
+			    [](bounds_type a, bounds_type const& b) {
+				    return bounds_type(min(a.min, b.min), max(a.max, b.max));
+			    },
+			    [this](auto f, auto l) {
+				    auto res = detail::emptyAABB<dimension, value_type>();
+				    for (; f != l; ++f) {
+					    res.min = min(res.min, centers[*f]);
+					    res.max = max(res.max, centers[*f]);
+				    }
+				    return res;
+			    });
+		}
+
+		/*!
+		 * @brief Splits the geometries at positions [first, last) of `index` in two,
+		 * reordering them.
+		 *
+		 * @return The position where the second half starts, or `last` for a leaf.
+		 */
+		template <class ExecutionPolicy>
+		[[nodiscard]] std::uint32_t split(ExecutionPolicy&& policy, std::uint32_t first,
+		                                  std::uint32_t last, std::uint32_t depth)
+		{
+			std::uint32_t const n = last - first;
+			if (leaf_size >= n || MAX_DEPTH <= depth + 1) {
+				return last;
+			}
+
+			if (BVHBuild::LBVH == method) {
+				// The codes are sorted, so the first half has a zero at the highest bit where
+				// the codes differ. Equal codes are split in half.
+				std::uint32_t const diff = codes[first] ^ codes[last - 1];
+				if (0 == diff) {
+					return first + n / 2;
+				}
+				std::uint32_t mask = std::uint32_t(1) << 31;
+				while (!(diff & mask)) {
+					mask >>= 1;
+				}
+				auto const mid =
+				    std::partition_point(codes.begin() + first, codes.begin() + last,
+				                         [mask](std::uint32_t c) { return !(c & mask); });
+				return static_cast<std::uint32_t>(mid - codes.begin());
+			}
+
+			auto const  centroids = centroidBounds(policy, first, last);
+			auto const  extent    = centroids.length();
+			std::size_t axis{};
+			for (std::size_t a = 1; dimension > a; ++a) {
+				axis = extent[axis] < extent[a] ? a : axis;
+			}
+			if (!(value_type(0) < extent[axis])) {
+				return last;
+			}
+
+			if (BVHBuild::MEDIAN == method) {
+				std::uint32_t const mid = first + n / 2;
+				std::nth_element(policy, index.begin() + first, index.begin() + mid,
+				                 index.begin() + last, [this, axis](size_type a, size_type b) {
+					                 return centers[a][axis] < centers[b][axis];
+				                 });
+				return mid;
+			}
+
+			Vec<dimension, value_type> scale;
+			for (std::size_t a{}; dimension > a; ++a) {
+				scale[a] = value_type(0) < extent[a] ? value_type(SAH_BINS) / extent[a] : 0;
+			}
+			auto const bin = [&centroids, &scale](Vec<dimension, value_type> const& c,
+			                                      std::size_t                        a) {
+				auto const b = (c[a] - centroids.min[a]) * scale[a];
+				return std::min(SAH_BINS - 1, static_cast<std::size_t>(b));
+			};
+
+			struct Bin {
+				bounds_type   bounds = detail::emptyAABB<dimension, value_type>();
+				std::uint32_t count{};
+			};
+			using Bins = std::array<Bin, dimension * SAH_BINS>;
+
+			Bins const bins = detail::chunkedReduce(
+			    policy, index.begin() + first, index.begin() + last, Bins{},
+			    [](Bins a, Bins const& b) {
+				    for (std::size_t i{}; a.size() > i; ++i) {
+					    a[i].bounds.min = min(a[i].bounds.min, b[i].bounds.min);
+					    a[i].bounds.max = max(a[i].bounds.max, b[i].bounds.max);
+					    a[i].count += b[i].count;
+				    }
+				    return a;
+			    },
+			    [this, &extent, &bin](auto f, auto l) {
+				    Bins res{};
+				    for (; f != l; ++f) {
+					    for (std::size_t a{}; dimension > a; ++a) {
+						    if (value_type(0) < extent[a]) {
+							    Bin& b       = res[a * SAH_BINS + bin(centers[*f], a)];
+							    b.bounds.min = min(b.bounds.min, bounds[*f].min);
+							    b.bounds.max = max(b.bounds.max, bounds[*f].max);
+							    ++b.count;
+						    }
+					    }
+				    }
+				    return res;
+			    });
+
+			// Cost of splitting after each bin, the number of geometries on each side times
+			// the area of their bounds
+			value_type  best_cost = std::numeric_limits<value_type>::infinity();
+			std::size_t best_bin{};
+			for (std::size_t a{}; dimension > a; ++a) {
+				if (!(value_type(0) < extent[a])) {
+					continue;
+				}
+
+				std::array<value_type, SAH_BINS>    right_cost{};
+				std::array<std::uint32_t, SAH_BINS> right_count{};
+				Bin                                 acc;
+				for (std::size_t i = SAH_BINS - 1; 0 < i; --i) {
+					Bin const& b   = bins[a * SAH_BINS + i];
+					acc.bounds.min = min(acc.bounds.min, b.bounds.min);
+					acc.bounds.max = max(acc.bounds.max, b.bounds.max);
+					acc.count += b.count;
+					right_count[i - 1] = acc.count;
+					right_cost[i - 1]  = acc.count * detail::halfArea(acc.bounds);
+				}
+
+				acc = Bin{};
+				for (std::size_t i{}; SAH_BINS - 1 > i; ++i) {
+					Bin const& b   = bins[a * SAH_BINS + i];
+					acc.bounds.min = min(acc.bounds.min, b.bounds.min);
+					acc.bounds.max = max(acc.bounds.max, b.bounds.max);
+					acc.count += b.count;
+					if (0 == acc.count || 0 == right_count[i]) {
+						continue;
+					}
+					value_type const cost =
+					    acc.count * detail::halfArea(acc.bounds) + right_cost[i];
+					if (cost < best_cost) {
+						best_cost = cost;
+						axis      = a;
+						best_bin  = i;
+					}
+				}
+			}
+
+			auto const mid = std::partition(
+			    policy, index.begin() + first, index.begin() + last,
+			    [this, &bin, axis, best_bin](size_type i) {
+				    return best_bin >= bin(centers[i], axis);
+			    });
+			return static_cast<std::uint32_t>(mid - index.begin());
+		}
+
+		/*!
+		 * @brief Builds the subtree over the geometries at positions [first, last) of
+		 * `index` serially.
+		 *
+		 * @return The nodes in depth-first order, with the offsets of internal nodes
+		 * relative to the first.
+		 */
+		[[nodiscard]] std::vector<Node> buildSubtree(std::uint32_t first, std::uint32_t last,
+		                                             std::uint32_t depth)
+		{
+			struct Task {
+				std::uint32_t first;
+				std::uint32_t last;
+				std::uint32_t parent;
+				std::uint32_t depth;
+			};
+
+			// The parent of the root is never patched, since it has no second child
+			constexpr std::uint32_t no_parent = std::numeric_limits<std::uint32_t>::max();
+
+			std::vector<Node> nodes;
+			nodes.reserve(2 * (last - first) / leaf_size + 1);
+			std::vector<Task> tasks;
+			tasks.push_back({first, last, no_parent, depth});
+			while (!tasks.empty()) {
+				Task const task = tasks.back();
+				tasks.pop_back();
+
+				auto const i = static_cast<std::uint32_t>(nodes.size());
+				if (no_parent != task.parent) {
+					nodes[task.parent].offset = i;
+				}
+
+				Node&               node = nodes.emplace_back();
+				std::uint32_t const mid =
+				    split(std::execution::seq, task.first, task.last, task.depth);
+				if (task.last == mid) {
+					node.offset = task.first;
+					node.count  = task.last - task.first;
+					continue;
+				}
+
+				// The first child is built next, so it ends up directly after this node
+				tasks.push_back({mid, task.last, i, task.depth + 1});
+				tasks.push_back({task.first, mid, no_parent, task.depth + 1});
+			}
+
+			// Bottom-up, since the children of a node come after it
+			for (std::size_t i = nodes.size(); 0 < i--;) {
+				Node& node = nodes[i];
+				if (node.leaf()) {
+					node.bounds = detail::emptyAABB<dimension, value_type>();
+					for (std::uint32_t j = node.offset; node.offset + node.count > j; ++j) {
+						node.bounds.min = min(node.bounds.min, bounds[index[j]].min);
+						node.bounds.max = max(node.bounds.max, bounds[index[j]].max);
+					}
+				} else {
+					node.bounds.min = min(nodes[i + 1].bounds.min, nodes[node.offset].bounds.min);
+					node.bounds.max = max(nodes[i + 1].bounds.max, nodes[node.offset].bounds.max);
+				}
+			}
+			return nodes;
+		}
+
+		/*!
+		 * @brief Computes the bounds and centroids of the `index.size()` geometries
+		 * starting at `geometry`, and for `BVHBuild::LBVH` sorts `index` by Morton code.
+		 */
+		template <class ExecutionPolicy, class RandomIt>
+		void prepare(ExecutionPolicy&& policy, RandomIt geometry)
+		{
+			auto const n = static_cast<std::uint32_t>(index.size());
+			bounds.resize(n);
+			centers.resize(n);
+			std::transform(policy, geometry, geometry + n, bounds.begin(),
+			               [](Geometry const& g) {
+				               return bounds_type(detail::lower(g), detail::upper(g));
+			               });
+			std::transform(policy, bounds.begin(), bounds.end(), centers.begin(),
+			               [](bounds_type const& a) { return a.center(); });
+
+			if (BVHBuild::LBVH != method) {
+				return;
+			}
+
+			auto const centroids = centroidBounds(policy, 0, n);
+
+			// Sorted by code and then by position, so the tree does not depend on the policy
+			std::vector<std::pair<std::uint32_t, std::uint32_t>> keys(n);
+			std::transform(policy, index.begin(), index.end(), keys.begin(),
+			               [this, &centroids](size_type i) {
+				               return std::pair(detail::mortonCode(centers[i], centroids),
+				                                static_cast<std::uint32_t>(i));
+			               });
+			std::sort(policy, keys.begin(), keys.end());
+
+			codes.resize(n);
+			std::transform(policy, keys.begin(), keys.end(), codes.begin(),
+			               [](auto const& k) { return k.first; });
+			std::transform(policy, keys.begin(), keys.end(), index.begin(),
+			               [](auto const& k) { return size_type(k.second); });
+		}
+
+		/*!
+		 * @brief Builds the tree over all geometries in `index`, with the root at `depth`.
+		 *
+		 * @return The nodes in depth-first order, with the offsets of internal nodes
+		 * relative to the first.
+		 */
+		template <class ExecutionPolicy>
+		[[nodiscard]] std::vector<Node> build(ExecutionPolicy&& policy, std::uint32_t depth)
+		{
+			auto const n = static_cast<std::uint32_t>(index.size());
+
+			// Ranges larger than `grain` are split here, with each split running according
+			// to `policy`, until there are enough ranges to build their subtrees in parallel
+			size_type grain = n;
+			if constexpr (!std::is_same_v<std::execution::sequenced_policy,
+			                              std::decay_t<ExecutionPolicy>>) {
+				constexpr size_type min_grain = 1024;
+				size_type const threads = std::max(1u, std::thread::hardware_concurrency());
+				grain                   = std::max(min_grain, n / (8 * threads));
+			}
+
+			struct Top {
+				std::uint32_t first;
+				std::uint32_t last;
+				std::uint32_t depth;
+				// Index of the first child, the second follows it. Zero if a subtree root.
+				std::uint32_t child;
+			};
+
+			std::vector<Top>           top{{0, n, depth, 0}};
+			std::vector<std::uint32_t> roots;
+			for (std::size_t i{}; top.size() > i; ++i) {
+				Top const           t   = top[i];
+				std::uint32_t const mid = grain < t.last - t.first
+				                              ? split(policy, t.first, t.last, t.depth)
+				                              : t.last;
+				if (t.last == mid) {
+					roots.push_back(static_cast<std::uint32_t>(i));
+					continue;
+				}
+				top[i].child = static_cast<std::uint32_t>(top.size());
+				top.push_back({t.first, mid, t.depth + 1, 0});
+				top.push_back({mid, t.last, t.depth + 1, 0});
+			}
+
+			std::vector<std::vector<Node>> subtrees(roots.size());
+			std::vector<std::uint32_t>     ids(roots.size());
+			std::iota(ids.begin(), ids.end(), std::uint32_t(0));
+			std::for_each(policy, ids.begin(), ids.end(), [&](std::uint32_t i) {
+				Top const& t = top[roots[i]];
+				subtrees[i]  = buildSubtree(t.first, t.last, t.depth);
+			});
+
+			// Depth-first position of each node in `top`, whose children come after it
+			std::vector<std::uint32_t> count(top.size());
+			std::vector<std::uint32_t> pos(top.size());
+			for (std::size_t i{}; roots.size() > i; ++i) {
+				count[roots[i]] = static_cast<std::uint32_t>(subtrees[i].size());
+			}
+			for (std::size_t i = top.size(); 0 < i--;) {
+				if (std::uint32_t const c = top[i].child) {
+					count[i] = 1 + count[c] + count[c + 1];
+				}
+			}
+			for (std::size_t i{}; top.size() > i; ++i) {
+				if (std::uint32_t const c = top[i].child) {
+					pos[c]     = pos[i] + 1;
+					pos[c + 1] = pos[i] + 1 + count[c];
+				}
+			}
+
+			std::vector<Node> nodes(count[0]);
+			std::for_each(policy, ids.begin(), ids.end(), [&](std::uint32_t i) {
+				std::uint32_t const base = pos[roots[i]];
+				for (std::size_t j{}; subtrees[i].size() > j; ++j) {
+					Node& node = nodes[base + j];
+					node       = subtrees[i][j];
+					node.offset += node.leaf() ? 0 : base;
+				}
+			});
+			for (std::size_t i = top.size(); 0 < i--;) {
+				if (std::uint32_t const c = top[i].child) {
+					Node&       node   = nodes[pos[i]];
+					Node const& first  = nodes[pos[c]];
+					Node const& second = nodes[pos[c + 1]];
+					node.bounds.min    = min(first.bounds.min, second.bounds.min);
+					node.bounds.max    = max(first.bounds.max, second.bounds.max);
+					node.offset        = pos[c + 1];
+					node.count         = 0;
+				}
+			}
+			return nodes;
+		}
+	};
+
+	template <class ExecutionPolicy>
+	void build(ExecutionPolicy&& policy, BVHBuild method, size_type leaf_size)
+	{
+		nodes_.clear();
+		parent_.clear();
+		index_.resize(geometry_.size());
+		std::iota(index_.begin(), index_.end(), size_type(0));
+		leaf_size_ = std::max(size_type(1), leaf_size);
+		if (geometry_.empty()) {
+			return;
+		}
+
+		Builder b{method, leaf_size_, index_};
+		b.prepare(policy, geometry_.begin());
+		nodes_ = b.build(policy, 1);
+
+		std::vector<Geometry> ordered(geometry_.size());
+		std::transform(policy, index_.begin(), index_.end(), ordered.begin(),
+		               [this](size_type i) { return std::move(geometry_[i]); });
+		geometry_ = std::move(ordered);
+	}
+
+	/*!
+	 * @brief Sets up the bookkeeping for `update`, `refit`, and `restructure`. It is only
+	 * done once needed, so trees that never change do not pay for it.
+	 */
+	void track()
+	{
+		parent_.assign(nodes_.size(), 0);
+		leaf_.resize(geometry_.size());
+		position_.resize(geometry_.size());
+		dirty_.assign(nodes_.size(), 0);
+		for (std::uint32_t i{}; nodes_.size() > i; ++i) {
+			Node const& node = nodes_[i];
+			if (node.leaf()) {
+				std::fill_n(leaf_.begin() + node.offset, node.count, i);
+			} else {
+				parent_[i + 1]       = i;
+				parent_[node.offset] = i;
+			}
+		}
+		for (size_type i{}; index_.size() > i; ++i) {
+			position_[index_[i]] = static_cast<std::uint32_t>(i);
+		}
+		cost_ = cost();
+	}
+
+	[[nodiscard]] bool tracked() const noexcept
+	{
+		return !nodes_.empty() && parent_.size() == nodes_.size();
+	}
+
+	/*!
+	 * @brief The surface area heuristic of each subtree, the sum of the areas of its
+	 * internal nodes plus the areas of its leaves times their number of geometries.
+	 */
+	[[nodiscard]] std::vector<value_type> cost() const
+	{
+		std::vector<value_type> res(nodes_.size());
+		for (std::size_t i = nodes_.size(); 0 < i--;) {
+			Node const& node = nodes_[i];
+			res[i]           = detail::halfArea(node.bounds) *
+			         (node.leaf() ? value_type(node.count) : value_type(1));
+			if (!node.leaf()) {
+				res[i] += res[i + 1] + res[node.offset];
+			}
+		}
+		return res;
+	}
+
+	/*!
+	 * @brief Recomputes the bounds of the dirty nodes in the subtree of `root`, children
+	 * before parents, and clears them.
+	 */
+	void refitSubtree(std::uint32_t root)
+	{
+		std::array<std::pair<std::uint32_t, bool>, 2 * MAX_DEPTH> stack;
+		std::size_t                                               top{};
+		stack[top++] = {root, false};
+		while (top) {
+			auto const [i, expanded] = stack[--top];
+			Node& node               = nodes_[i];
+			if (!node.leaf() && !expanded) {
+				stack[top++] = {i, true};
+				for (std::uint32_t c : {i + 1, node.offset}) {
+					if (dirty_[c]) {
+						stack[top++] = {c, false};
+					}
+				}
+				continue;
+			}
+
+			if (node.leaf()) {
+				node.bounds = detail::emptyAABB<dimension, value_type>();
+				for (std::uint32_t j = node.offset; node.offset + node.count > j; ++j) {
+					node.bounds.min = min(node.bounds.min, detail::lower(geometry_[j]));
+					node.bounds.max = max(node.bounds.max, detail::upper(geometry_[j]));
+				}
+			} else {
+				node.bounds.min = min(nodes_[i + 1].bounds.min, nodes_[node.offset].bounds.min);
+				node.bounds.max = max(nodes_[i + 1].bounds.max, nodes_[node.offset].bounds.max);
+			}
+			dirty_[i] = 0;
+		}
+	}
+
+	/*!
+	 * @brief Rebuilds the subtree of `root` from scratch in place.
+	 *
+	 * The subtree covers the contiguous nodes [root, end) and geometries [first, last),
+	 * so only those are rebuilt. The nodes after it are moved if the new subtree has a
+	 * different number of nodes.
+	 */
+	template <class ExecutionPolicy>
+	void rebuildSubtree(ExecutionPolicy&& policy, BVHBuild method, std::uint32_t root)
+	{
+		std::uint32_t i = root;
+		while (!nodes_[i].leaf()) {
+			++i;
+		}
+		std::uint32_t const first = nodes_[i].offset;
+		for (i = root; !nodes_[i].leaf();) {
+			i = nodes_[i].offset;
+		}
+		std::uint32_t const last = nodes_[i].offset + nodes_[i].count;
+		std::uint32_t const end  = i + 1;
+
+		std::uint32_t depth = 1;
+		for (i = root; 0 != i; i = parent_[i]) {
+			++depth;
+		}
+
+		std::vector<size_type> order(last - first);
+		std::iota(order.begin(), order.end(), size_type(0));
+		Builder b{method, leaf_size_, order};
+		b.prepare(policy, geometry_.begin() + first);
+		auto subtree = b.build(policy, depth);
+		for (Node& node : subtree) {
+			node.offset += node.leaf() ? first : root;
+		}
+
+		// Internal nodes before the subtree point past it if their second child is after
+		auto const delta = static_cast<std::int64_t>(subtree.size()) -
+		                   static_cast<std::int64_t>(end - root);
+		for (std::uint32_t j{}; root > j; ++j) {
+			if (!nodes_[j].leaf() && end <= nodes_[j].offset) {
+				nodes_[j].offset = static_cast<std::uint32_t>(nodes_[j].offset + delta);
+			}
+		}
+		std::vector<Node> after(nodes_.begin() + end, nodes_.end());
+		for (Node& node : after) {
+			if (!node.leaf()) {
+				node.offset = static_cast<std::uint32_t>(node.offset + delta);
+			}
+		}
+		nodes_.resize(root);
+		nodes_.insert(nodes_.end(), subtree.begin(), subtree.end());
+		nodes_.insert(nodes_.end(), after.begin(), after.end());
+
+		std::vector<Geometry>  geometry(order.size());
+		std::vector<size_type> index(order.size());
+		for (std::size_t j{}; order.size() > j; ++j) {
+			geometry[j] = std::move(geometry_[first + order[j]]);
+			index[j]    = index_[first + order[j]];
+		}
+		std::move(geometry.begin(), geometry.end(), geometry_.begin() + first);
+		std::copy(index.begin(), index.end(), index_.begin() + first);
+	}
+
+	std::vector<Node>      nodes_;
+	std::vector<Geometry>  geometry_;
+	std::vector<size_type> index_;
+	size_type              leaf_size_ = 4;
+
+	// Bookkeeping for updates, see `track`
+	std::vector<std::uint32_t> parent_;
+	std::vector<std::uint32_t> leaf_;
+	std::vector<std::uint32_t> position_;
+	std::vector<char>          dirty_;
+	std::vector<value_type>    cost_;
+};
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Threshold                                      |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Checks if the squared distance between any geometry in `a` and `b` is at most
+ * `max`.
+ *
+ * Nodes further than `max` from the bounds of `b` are pruned, and the traversal stops at
+ * the first geometry within `max`.
+ */
+template <class Geometry, class Query>
+[[nodiscard]] bool distanceSquaredWithin(BVH<Geometry> const& a, Query const& b,
+                                         typename BVH<Geometry>::value_type max)
+{
+	using bounds_type = typename BVH<Geometry>::bounds_type;
+
+	bounds_type const bounds(detail::lower(b), detail::upper(b));
+	return a.traverseAny(
+	    [&bounds, max](bounds_type const& n) {
+		    return distanceSquaredWithin(n, bounds, max);
+	    },
+	    [&b, max](Geometry const& g, std::size_t) {
+		    return distanceSquaredWithin(g, b, max);
+	    });
+}
+
+/*!
+ * @brief Writes the input position of every geometry in `a` whose squared distance to
+ * `b` is at most `max` to `d_first`.
+ *
+ * @return Output iterator to the element past the last element written.
+ */
+template <class Geometry, class Query, class OutputIt>
+OutputIt distanceSquaredWithin(BVH<Geometry> const& a, Query const& b,
+                               typename BVH<Geometry>::value_type max, OutputIt d_first)
+{
+	using bounds_type = typename BVH<Geometry>::bounds_type;
+
+	bounds_type const bounds(detail::lower(b), detail::upper(b));
+	a.traverse(
+	    [&bounds, max](bounds_type const& n) {
+		    return distanceSquaredWithin(n, bounds, max);
+	    },
+	    [&b, max, &d_first](Geometry const& g, std::size_t i) {
+		    if (distanceSquaredWithin(g, b, max)) {
+			    *d_first++ = i;
+		    }
+	    });
+	return d_first;
+}
+
+/*!
+ * @brief Checks if the distance between any geometry in `a` and `b` is less than
+ * `threshold`.
+ */
+template <class Geometry, class Query>
+[[nodiscard]] bool distanceLessThan(BVH<Geometry> const& a, Query const& b,
+                                    typename BVH<Geometry>::value_type threshold)
+{
+	using T = typename BVH<Geometry>::value_type;
+	return T(0) < threshold &&
+	       distanceSquaredWithin(a, b, std::nextafter(threshold * threshold, T(0)));
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                   Dual traversal                                    |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief The closest pair of geometries between two `BVH`s.
+ */
+template <class T>
+struct NearestPair {
+	// Input position of the geometry in the first tree, its `size()` if nothing was found
+	std::size_t first;
+	// Input position of the geometry in the second tree, its `size()` if nothing was found
+	std::size_t second;
+	T           distance;
+};
+
+namespace detail
+{
+/*!
+ * @brief Whether to descend into `x` rather than `y` when traversing a pair of nodes,
+ * the larger of the two unless it is a leaf.
+ */
+template <class NodeA, class NodeB>
+[[nodiscard]] constexpr bool splitFirst(NodeA const& x, NodeB const& y) noexcept
+{
+	return y.leaf() || (!x.leaf() && halfArea(y.bounds) <= halfArea(x.bounds));
+}
+
+/*!
+ * @brief Calls `f(geometry_a, index_a, geometry_b, index_b)` for every pair of
+ * geometries from `a` and `b` whose leaves, and all their ancestors, have overlapping
+ * bounds, until `f` returns `true`.
+ *
+ * Of each pair of nodes the larger one is split, see `splitFirst`, so the two trees are
+ * descended together and pairs of distant subtrees are pruned at once.
+ *
+ * @return Whether `f` returned `true` for any pair.
+ */
+template <class A, class B, class F>
+[[nodiscard]] bool traverseOverlapping(BVH<A> const& a, BVH<B> const& b, F f)
+{
+	if (a.empty() || b.empty()) {
+		return false;
+	}
+
+	auto const& na = a.nodes();
+	auto const& nb = b.nodes();
+
+	// Every split goes one level down in one of the trees and leaves one pair behind
+	std::array<std::pair<std::uint32_t, std::uint32_t>, 2 * BVH<A>::MAX_DEPTH> stack;
+	std::size_t                                                            top{};
+	stack[top++] = {0, 0};
+	while (top) {
+		auto const [i, j] = stack[--top];
+		auto const& x     = na[i];
+		auto const& y     = nb[j];
+		if (!intersects(x.bounds, y.bounds)) {
+			continue;
+		}
+
+		if (x.leaf() && y.leaf()) {
+			for (std::uint32_t k = x.offset; x.offset + x.count > k; ++k) {
+				for (std::uint32_t l = y.offset; y.offset + y.count > l; ++l) {
+					if (f(a.geometry()[k], a.index()[k], b.geometry()[l], b.index()[l])) {
+						return true;
+					}
+				}
+			}
+		} else if (splitFirst(x, y)) {
+			stack[top++] = {x.offset, j};
+			stack[top++] = {i + 1, j};
+		} else {
+			stack[top++] = {i, y.offset};
+			stack[top++] = {i, j + 1};
+		}
+	}
+	return false;
+}
+
+/*!
+ * @brief Same as `traverseOverlapping(a, a, f)`, but visits each unordered pair of
+ * different geometries once.
+ *
+ * A node is paired with itself by pairing its children with themselves and with each
+ * other.
+ */
+template <class Geometry, class F>
+[[nodiscard]] bool traverseSelfOverlapping(BVH<Geometry> const& a, F f)
+{
+	if (a.empty()) {
+		return false;
+	}
+
+	auto const& n = a.nodes();
+	auto const& g = a.geometry();
+	auto const& x = a.index();
+
+	// Pairing a node with itself leaves two pairs behind, but only goes down once
+	std::array<std::pair<std::uint32_t, std::uint32_t>, 2 * BVH<Geometry>::MAX_DEPTH>
+	            stack;
+	std::size_t top{};
+	stack[top++] = {0, 0};
+	while (top) {
+		auto const [i, j] = stack[--top];
+		auto const& p     = n[i];
+		auto const& q     = n[j];
+		if (i == j) {
+			if (p.leaf()) {
+				for (std::uint32_t k = p.offset; p.offset + p.count > k; ++k) {
+					for (std::uint32_t l = k + 1; p.offset + p.count > l; ++l) {
+						if (f(g[k], x[k], g[l], x[l])) {
+							return true;
+						}
+					}
+				}
+			} else {
+				stack[top++] = {i + 1, p.offset};
+				stack[top++] = {p.offset, p.offset};
+				stack[top++] = {i + 1, i + 1};
+			}
+			continue;
+		}
+
+		if (!intersects(p.bounds, q.bounds)) {
+			continue;
+		}
+
+		if (p.leaf() && q.leaf()) {
+			for (std::uint32_t k = p.offset; p.offset + p.count > k; ++k) {
+				for (std::uint32_t l = q.offset; q.offset + q.count > l; ++l) {
+					if (f(g[k], x[k], g[l], x[l])) {
+						return true;
+					}
+				}
+			}
+		} else if (splitFirst(p, q)) {
+			stack[top++] = {p.offset, j};
+			stack[top++] = {i + 1, j};
+		} else {
+			stack[top++] = {i, q.offset};
+			stack[top++] = {i, j + 1};
+		}
+	}
+	return false;
+}
+}  // namespace detail
+
+/*!
+ * @brief Checks if any geometry in `a` intersects any geometry in `b`.
+ *
+ * The pairs of geometries are tested with `intersects`, or the generic convex kernel
+ * when there is no dedicated overload.
+ */
+template <class A, class B>
+[[nodiscard]] bool intersects(BVH<A> const& a, BVH<B> const& b)
+{
+	return detail::traverseOverlapping(
+	    a, b, [](A const& x, std::size_t, B const& y, std::size_t) {
+		    return detail::intersectsKernel(x, y);
+	    });
+}
+
+/*!
+ * @brief Writes every intersecting pair of geometries from `a` and `b` to `d_first`, as
+ * `std::pair<std::size_t, std::size_t>` of their input positions.
+ *
+ * @return Output iterator to the element past the last element written.
+ */
+template <class A, class B, class OutputIt>
+OutputIt intersects(BVH<A> const& a, BVH<B> const& b, OutputIt d_first)
+{
+	(void)detail::traverseOverlapping(
+	    a, b, [&d_first](A const& x, std::size_t i, B const& y, std::size_t j) {
+		    if (detail::intersectsKernel(x, y)) {
+			    *d_first++ = std::pair<std::size_t, std::size_t>(i, j);
+		    }
+		    return false;
+	    });
+	return d_first;
+}
+
+/*!
+ * @brief Writes every intersecting pair of different geometries in `a` to `d_first`, as
+ * `std::pair<std::size_t, std::size_t>` of their input positions with the smaller first.
+ *
+ * @return Output iterator to the element past the last element written.
+ */
+template <class Geometry, class OutputIt>
+OutputIt selfIntersects(BVH<Geometry> const& a, OutputIt d_first)
+{
+	return selfIntersects(a, std::vector<std::pair<std::size_t, std::size_t>>{}, d_first);
+}
+
+/*!
+ * @brief Same as above, but skips the pairs in `excluded`, in either order.
+ *
+ * Used for self-collision, where geometries that always touch, such as adjacent links of
+ * a robot, are not collisions.
+ */
+template <class Geometry, class OutputIt>
+OutputIt selfIntersects(BVH<Geometry> const&                                   a,
+                        std::vector<std::pair<std::size_t, std::size_t>> const& excluded,
+                        OutputIt                                                d_first)
+{
+	std::vector<std::pair<std::size_t, std::size_t>> skip;
+	skip.reserve(excluded.size());
+	for (auto const& [i, j] : excluded) {
+		skip.emplace_back(std::min(i, j), std::max(i, j));
+	}
+	std::sort(skip.begin(), skip.end());
+
+	(void)detail::traverseSelfOverlapping(
+	    a, [&skip, &d_first](Geometry const& x, std::size_t i, Geometry const& y,
+	                         std::size_t j) {
+		    std::pair<std::size_t, std::size_t> const p(std::min(i, j), std::max(i, j));
+		    if (!std::binary_search(skip.begin(), skip.end(), p) &&
+		        detail::intersectsKernel(x, y)) {
+			    *d_first++ = p;
+		    }
+		    return false;
+	    });
+	return d_first;
+}
+
+/*!
+ * @brief The closest pair of geometries from `a` and `b`, considering only distances
+ * smaller than `max`.
+ *
+ * Both trees are descended together, visiting the closer pair of nodes first and
+ * pruning the pairs whose bounds are not closer than the best distance found so far.
+ * The pairs of geometries are measured with `distance`, or the generic convex kernel
+ * when there is no dedicated overload.
+ */
+template <class A, class B>
+[[nodiscard]] NearestPair<typename BVH<A>::value_type> nearest(
+    BVH<A> const& a, BVH<B> const& b,
+    typename BVH<A>::value_type max =
+        std::numeric_limits<typename BVH<A>::value_type>::infinity())
+{
+	using T = typename BVH<A>::value_type;
+
+	NearestPair<T> res{a.size(), b.size(), max};
+	if (a.empty() || b.empty()) {
+		return res;
+	}
+
+	auto const& na = a.nodes();
+	auto const& nb = b.nodes();
+
+	T const root = distance(na[0].bounds, nb[0].bounds);
+	if (!(root < max)) {
+		return res;
+	}
+
+	struct Pair {
+		std::uint32_t i;
+		std::uint32_t j;
+		T             lower;
+	};
+
+	std::array<Pair, 2 * BVH<A>::MAX_DEPTH> stack;
+	std::size_t                             top{};
+	stack[top++] = {0, 0, root};
+	while (top) {
+		Pair const p = stack[--top];
+		if (!(p.lower < res.distance)) {
+			continue;
+		}
+
+		auto const& x = na[p.i];
+		auto const& y = nb[p.j];
+		if (x.leaf() && y.leaf()) {
+			for (std::uint32_t k = x.offset; x.offset + x.count > k; ++k) {
+				for (std::uint32_t l = y.offset; y.offset + y.count > l; ++l) {
+					T const d =
+					    static_cast<T>(detail::distanceKernel(a.geometry()[k], b.geometry()[l]));
+					if (d < res.distance) {
+						res = {a.index()[k], b.index()[l], d};
+					}
+				}
+			}
+			continue;
+		}
+
+		Pair first;
+		Pair second;
+		if (detail::splitFirst(x, y)) {
+			first  = {p.i + 1, p.j, distance(na[p.i + 1].bounds, y.bounds)};
+			second = {x.offset, p.j, distance(na[x.offset].bounds, y.bounds)};
+		} else {
+			first  = {p.i, p.j + 1, distance(x.bounds, nb[p.j + 1].bounds)};
+			second = {p.i, y.offset, distance(x.bounds, nb[y.offset].bounds)};
+		}
+		if (second.lower < first.lower) {
+			std::swap(first, second);
+		}
+		// The closer pair is pushed last so it is visited first
+		if (second.lower < res.distance) {
+			stack[top++] = second;
+		}
+		if (first.lower < res.distance) {
+			stack[top++] = first;
+		}
+	}
+	return res;
+}
+
+/*!
+ * @brief The distance between the closest geometries of `a` and `b`, infinity if either
+ * is empty.
+ */
+template <class A, class B>
+[[nodiscard]] typename BVH<A>::value_type distance(BVH<A> const& a, BVH<B> const& b)
+{
+	return nearest(a, b).distance;
+}
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_BVH_HPP
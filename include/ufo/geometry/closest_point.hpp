@@ -45,16 +45,28 @@
 // UFO
 #include <ufo/geometry/aabb.hpp>
 #include <ufo/geometry/capsule.hpp>
+#include <ufo/geometry/cylinder.hpp>
+#include <ufo/geometry/detail/gjk.hpp>
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/line.hpp>
 #include <ufo/geometry/line_segment.hpp>
 #include <ufo/geometry/obb.hpp>
 #include <ufo/geometry/plane.hpp>
 #include <ufo/geometry/ray.hpp>
+#include <ufo/geometry/signed_distance.hpp>
 #include <ufo/geometry/sphere.hpp>
+#include <ufo/geometry/support.hpp>
 #include <ufo/geometry/triangle.hpp>
+#include <ufo/geometry/type_traits.hpp>
 #include <ufo/math/vec.hpp>
 
 // STL
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <type_traits>
 
 namespace ufo
 {
@@ -593,7 +605,7 @@ template <std::size_t Dim, class T>
 template <class T>
 [[nodiscard]] constexpr Vec<3, T> closestPoint(Plane<T> const& a, Vec<3, T> const& b)
 {
-	auto distance = dot(a.normal, b) - a.distance;
+	auto distance = dot(a.normal, b) + a.distance;
 	return b - a.normal * distance;
 }
 
@@ -821,6 +833,451 @@ template <std::size_t Dim, class T>
 // {
 // 	// TODO: Implement
 // }
+
+/**************************************************************************************
+|                                                                                     |
+|                                   Closest points                                    |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief The closest pair of points between two geometries.
+ *
+ * `point_a` is on the first geometry and `point_b` on the second. If the geometries
+ * overlap, both are the same point of the overlap and `distance_squared` is zero.
+ */
+template <std::size_t Dim = 3, class T = float>
+struct ClosestPoints {
+	static_assert(std::is_floating_point_v<T>, "T is required to be floating point.");
+
+	using value_type = T;
+
+	Vec<Dim, T> point_a;
+	Vec<Dim, T> point_b;
+	T           distance_squared{};
+};
+
+/*!
+ * @brief Compare two ClosestPoints.
+ *
+ * @param lhs,rhs The ClosestPoints to compare
+ * @return `true` if they compare equal, `false` otherwise.
+ */
+template <std::size_t Dim, class T>
+bool operator==(ClosestPoints<Dim, T> const& lhs, ClosestPoints<Dim, T> const& rhs)
+{
+	return lhs.point_a == rhs.point_a && lhs.point_b == rhs.point_b &&
+	       lhs.distance_squared == rhs.distance_squared;
+}
+
+/*!
+ * @brief Compare two ClosestPoints.
+ *
+ * @param lhs,rhs The ClosestPoints to compare
+ * @return `true` if they do not compare equal, `false` otherwise.
+ */
+template <std::size_t Dim, class T>
+bool operator!=(ClosestPoints<Dim, T> const& lhs, ClosestPoints<Dim, T> const& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <std::size_t Dim, class T>
+std::ostream& operator<<(std::ostream& out, ClosestPoints<Dim, T> const& cp)
+{
+	return out << "Point A: " << cp.point_a << ", Point B: " << cp.point_b
+	           << ", Distance squared: " << cp.distance_squared;
+}
+
+namespace detail
+{
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr ClosestPoints<Dim, T> swapped(ClosestPoints<Dim, T> const& cp)
+{
+	return {cp.point_b, cp.point_a, cp.distance_squared};
+}
+
+/*!
+ * @brief Grows the closest points between two cores by the radii `ra` and `rb`, e.g.,
+ * from the centers to the surfaces of two spheres.
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] ClosestPoints<Dim, T> inflate(ClosestPoints<Dim, T> cp, T ra, T rb)
+{
+	T const r = ra + rb;
+	if (T(0) == r) {
+		return cp;
+	}
+
+	T const l = std::sqrt(cp.distance_squared);
+	if (r < l) {
+		auto const dir      = (cp.point_b - cp.point_a) / l;
+		cp.point_a         += dir * ra;
+		cp.point_b         -= dir * rb;
+		cp.distance_squared = (l - r) * (l - r);
+	} else {
+		// Overlapping, pick the point between the cores weighted by the radii
+		cp.point_a += (cp.point_b - cp.point_a) * (ra / r);
+		cp.point_b          = cp.point_a;
+		cp.distance_squared = T(0);
+	}
+	return cp;
+}
+
+// Ericson, Real-Time Collision Detection, 5.1.9
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr ClosestPoints<Dim, T> closestPointsSegment(
+    Vec<Dim, T> const& start_a, Vec<Dim, T> const& end_a, Vec<Dim, T> const& start_b,
+    Vec<Dim, T> const& end_b)
+{
+	constexpr T eps = std::numeric_limits<T>::epsilon();
+
+	auto const d1 = end_a - start_a;
+	auto const d2 = end_b - start_b;
+	auto const r  = start_a - start_b;
+	T const    a  = dot(d1, d1);
+	T const    e  = dot(d2, d2);
+	T const    f  = dot(d2, r);
+
+	T s{};
+	T t{};
+	if (eps >= a && eps >= e) {
+		// Both degenerate into points
+	} else if (eps >= a) {
+		t = std::clamp(f / e, T(0), T(1));
+	} else {
+		T const c = dot(d1, r);
+		if (eps >= e) {
+			s = std::clamp(-c / a, T(0), T(1));
+		} else {
+			T const b     = dot(d1, d2);
+			T const denom = a * e - b * b;
+			// Parallel segments have no unique pair, any `s` works
+			s = T(0) != denom ? std::clamp((b * f - c * e) / denom, T(0), T(1)) : T(0);
+			t = (b * s + f) / e;
+			if (T(0) > t) {
+				t = T(0);
+				s = std::clamp(-c / a, T(0), T(1));
+			} else if (T(1) < t) {
+				t = T(1);
+				s = std::clamp((b - c) / a, T(0), T(1));
+			}
+		}
+	}
+
+	ClosestPoints<Dim, T> res;
+	res.point_a          = start_a + d1 * s;
+	res.point_b          = start_b + d2 * t;
+	res.distance_squared = distanceSquared(res.point_a, res.point_b);
+	return res;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr ClosestPoints<Dim, T> closestPointsPoint(Vec<Dim, T> const& a,
+                                                                 Vec<Dim, T> const& b)
+{
+	return {a, b, distanceSquared(a, b)};
+}
+}  // namespace detail
+
+/*!
+ * @brief Computes the closest pair of points between `a` and `b` together with their
+ * squared distance, in a single pass.
+ *
+ * Pairs without a dedicated overload that both have `support` functions use GJK, which
+ * already tracks the witness points. Rounded geometries (spheres and capsules) run on
+ * their cores and are grown by their radii afterwards.
+ *
+ * A plane is paired with a point or any 3D geometry that has a `support` function. Rays
+ * and lines are only paired with points, and so are all 2D geometries except for
+ * AABBs, spheres, line segments and capsules.
+ */
+template <class A, class B, std::enable_if_t<is_convex_pair_v<A, B>, bool> = true>
+[[nodiscard]] auto closestPoints(A const& a, B const& b)
+{
+	using T = typename geometry_traits<A>::value_type;
+
+	auto const& ca = detail::roundedCore(a);
+	auto const& cb = detail::roundedCore(b);
+	auto const  cp =
+	    detail::gjkDistance<T>([&ca](Vec<3, T> const& d) { return support(ca, d); },
+	                           [&cb](Vec<3, T> const& d) { return support(cb, d); },
+	                           Vec<3, T>(T(1), T(0), T(0)));
+	return detail::inflate(ClosestPoints<3, T>{cp.point_a, cp.point_b, cp.distance_squared},
+	                       detail::roundedRadius(a), detail::roundedRadius(b));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr ClosestPoints<Dim, T> closestPoints(Vec<Dim, T> const& a,
+                                                            Vec<Dim, T> const& b)
+{
+	return detail::closestPointsPoint(a, b);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr ClosestPoints<Dim, T> closestPoints(AABB<Dim, T> const& a,
+                                                            AABB<Dim, T> const& b)
+{
+	ClosestPoints<Dim, T> res;
+	for (std::size_t i{}; Dim > i; ++i) {
+		T const lo = std::max(a.min[i], b.min[i]);
+		T const hi = std::min(a.max[i], b.max[i]);
+		if (lo <= hi) {
+			// Overlapping along this axis
+			res.point_a[i] = res.point_b[i] = (lo + hi) / T(2);
+		} else if (a.max[i] < b.min[i]) {
+			res.point_a[i] = a.max[i];
+			res.point_b[i] = b.min[i];
+		} else {
+			res.point_a[i] = a.min[i];
+			res.point_b[i] = b.max[i];
+		}
+		T const d             = res.point_b[i] - res.point_a[i];
+		res.distance_squared += d * d;
+	}
+	return res;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] ClosestPoints<Dim, T> closestPoints(AABB<Dim, T> const&   a,
+                                                  Sphere<Dim, T> const& b)
+{
+	return detail::inflate(closestPoints(a, b.center), T(0), b.radius);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr ClosestPoints<Dim, T> closestPoints(AABB<Dim, T> const& a,
+                                                            Vec<Dim, T> const&  b)
+{
+	return detail::closestPointsPoint(closestPoint(a, b), b);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] ClosestPoints<Dim, T> closestPoints(Sphere<Dim, T> const& a,
+                                                  Sphere<Dim, T> const& b)
+{
+	return detail::inflate(detail::closestPointsPoint(a.center, b.center), a.radius,
+	                       b.radius);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] ClosestPoints<Dim, T> closestPoints(Sphere<Dim, T> const& a,
+                                                  Vec<Dim, T> const&    b)
+{
+	return detail::inflate(detail::closestPointsPoint(a.center, b), a.radius, T(0));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr ClosestPoints<Dim, T> closestPoints(
+    LineSegment<Dim, T> const& a, LineSegment<Dim, T> const& b)
+{
+	return detail::closestPointsSegment(a.start, a.end, b.start, b.end);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr ClosestPoints<Dim, T> closestPoints(LineSegment<Dim, T> const& a,
+                                                            Vec<Dim, T> const&         b)
+{
+	return detail::closestPointsPoint(detail::closestPointSegment(a.start, a.end, b), b);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] ClosestPoints<Dim, T> closestPoints(Capsule<Dim, T> const& a,
+                                                  Capsule<Dim, T> const& b)
+{
+	return detail::inflate(detail::closestPointsSegment(a.start, a.end, b.start, b.end),
+	                       a.radius, b.radius);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] ClosestPoints<Dim, T> closestPoints(Capsule<Dim, T> const& a,
+                                                  Sphere<Dim, T> const&  b)
+{
+	return detail::inflate(
+	    detail::closestPointsPoint(detail::closestPointSegment(a.start, a.end, b.center),
+	                               b.center),
+	    a.radius, b.radius);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] ClosestPoints<Dim, T> closestPoints(Capsule<Dim, T> const& a,
+                                                  Vec<Dim, T> const&     b)
+{
+	return detail::inflate(
+	    detail::closestPointsPoint(detail::closestPointSegment(a.start, a.end, b), b),
+	    a.radius, T(0));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr ClosestPoints<Dim, T> closestPoints(OBB<Dim, T> const& a,
+                                                            Vec<Dim, T> const& b)
+{
+	auto const  d = b - a.center;
+	Vec<Dim, T> q = a.center;
+	for (std::size_t i{}; Dim > i; ++i) {
+		T const l = dot(a.rotation[i], d);
+		q += a.rotation[i] * std::clamp(l, -a.half_length[i], a.half_length[i]);
+	}
+	return detail::closestPointsPoint(q, b);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr ClosestPoints<Dim, T> closestPoints(Triangle<Dim, T> const& a,
+                                                            Vec<Dim, T> const&      b)
+{
+	return detail::closestPointsPoint(detail::closestPointTriangle(a, b), b);
+}
+
+template <class T>
+[[nodiscard]] constexpr ClosestPoints<3, T> closestPoints(Plane<T> const&  a,
+                                                          Vec<3, T> const& b)
+{
+	return detail::closestPointsPoint(closestPoint(a, b), b);
+}
+
+template <class T>
+[[nodiscard]] constexpr ClosestPoints<2, T> closestPoints(Line<2, T> const& a,
+                                                          Vec<2, T> const&  b)
+{
+	return detail::closestPointsPoint(b - a.normal * (dot(a.normal, b) - a.distance), b);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr ClosestPoints<Dim, T> closestPoints(Ray<Dim, T> const& a,
+                                                            Vec<Dim, T> const& b)
+{
+	return detail::closestPointsPoint(closestPoint(a, b), b);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] ClosestPoints<Dim, T> closestPoints(Cylinder<Dim, T> const& a,
+                                                  Vec<Dim, T> const&      b)
+{
+	auto const sd = signedDistanceAndGradient(a, b);
+	if (T(0) >= sd.distance) {
+		return {b, b, T(0)};
+	}
+	return detail::closestPointsPoint(b - sd.gradient * sd.distance, b);
+}
+
+/*!
+ * @brief Closest points between a plane and a geometry with a `support` function.
+ *
+ * The points of `b` furthest along and against the normal bound its signed distance to
+ * the plane. If they are on opposite sides, the point between them on the plane is in
+ * both.
+ */
+template <class T, class B,
+          std::enable_if_t<std::conjunction_v<has_support<B>,
+                                              detail::is_same_space3<Plane<T>, B>>,
+                           bool> = true>
+[[nodiscard]] ClosestPoints<3, T> closestPoints(Plane<T> const& a, B const& b)
+{
+	auto const lo = support(b, -a.normal);
+	auto const hi = support(b, a.normal);
+	T const    dl = dot(a.normal, lo) + a.distance;
+	T const    dh = dot(a.normal, hi) + a.distance;
+	if (T(0) < dl) {
+		return {lo - a.normal * dl, lo, dl * dl};
+	} else if (T(0) > dh) {
+		return {hi - a.normal * dh, hi, dh * dh};
+	}
+	auto const p = dl < dh ? lo + (hi - lo) * (dl / (dl - dh)) : lo;
+	return {p, p, T(0)};
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr ClosestPoints<Dim, T> closestPoints(Vec<Dim, T> const&  a,
+                                                            AABB<Dim, T> const& b)
+{
+	return detail::swapped(closestPoints(b, a));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] ClosestPoints<Dim, T> closestPoints(Sphere<Dim, T> const& a,
+                                                  AABB<Dim, T> const&   b)
+{
+	return detail::swapped(closestPoints(b, a));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] ClosestPoints<Dim, T> closestPoints(Vec<Dim, T> const&    a,
+                                                  Sphere<Dim, T> const& b)
+{
+	return detail::swapped(closestPoints(b, a));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr ClosestPoints<Dim, T> closestPoints(Vec<Dim, T> const&         a,
+                                                            LineSegment<Dim, T> const& b)
+{
+	return detail::swapped(closestPoints(b, a));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] ClosestPoints<Dim, T> closestPoints(Sphere<Dim, T> const&  a,
+                                                  Capsule<Dim, T> const& b)
+{
+	return detail::swapped(closestPoints(b, a));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] ClosestPoints<Dim, T> closestPoints(Vec<Dim, T> const&     a,
+                                                  Capsule<Dim, T> const& b)
+{
+	return detail::swapped(closestPoints(b, a));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr ClosestPoints<Dim, T> closestPoints(Vec<Dim, T> const& a,
+                                                            OBB<Dim, T> const& b)
+{
+	return detail::swapped(closestPoints(b, a));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr ClosestPoints<Dim, T> closestPoints(Vec<Dim, T> const&      a,
+                                                            Triangle<Dim, T> const& b)
+{
+	return detail::swapped(closestPoints(b, a));
+}
+
+template <class T>
+[[nodiscard]] constexpr ClosestPoints<3, T> closestPoints(Vec<3, T> const& a,
+                                                          Plane<T> const&  b)
+{
+	return detail::swapped(closestPoints(b, a));
+}
+
+template <class T>
+[[nodiscard]] constexpr ClosestPoints<2, T> closestPoints(Vec<2, T> const&  a,
+                                                          Line<2, T> const& b)
+{
+	return detail::swapped(closestPoints(b, a));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr ClosestPoints<Dim, T> closestPoints(Vec<Dim, T> const& a,
+                                                            Ray<Dim, T> const& b)
+{
+	return detail::swapped(closestPoints(b, a));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] ClosestPoints<Dim, T> closestPoints(Vec<Dim, T> const&      a,
+                                                  Cylinder<Dim, T> const& b)
+{
+	return detail::swapped(closestPoints(b, a));
+}
+
+template <class T, class A,
+          std::enable_if_t<std::conjunction_v<has_support<A>,
+                                              detail::is_same_space3<A, Plane<T>>>,
+                           bool> = true>
+[[nodiscard]] ClosestPoints<3, T> closestPoints(A const& a, Plane<T> const& b)
+{
+	return detail::swapped(closestPoints(b, a));
+}
 }  // namespace ufo
 
 #endif  // UFO_GEOMETRY_CLOSEST_POINT_HPP
\ No newline at end of file
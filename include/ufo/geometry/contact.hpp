@@ -0,0 +1,781 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_CONTACT_HPP
+#define UFO_GEOMETRY_CONTACT_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/capsule.hpp>
+#include <ufo/geometry/closest_point.hpp>
+#include <ufo/geometry/line_segment.hpp>
+#include <ufo/geometry/obb.hpp>
+#include <ufo/geometry/signed_distance.hpp>
+#include <ufo/geometry/sphere.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+namespace ufo
+{
+/*!
+ * @brief A point of contact between two geometries.
+ *
+ * `position` is on the surface of the second geometry and `position + normal * depth`
+ * on the surface of the first, where `normal` is the normal of the manifold.
+ */
+template <class T = float>
+struct ContactPoint {
+	static_assert(std::is_floating_point_v<T>, "T is required to be floating point.");
+
+	using value_type = T;
+
+	Vec<3, T> position;
+	T         depth{};
+};
+
+/*!
+ * @brief Compare two ContactPoints.
+ *
+ * @param lhs,rhs The ContactPoints to compare
+ * @return `true` if they compare equal, `false` otherwise.
+ */
+template <class T>
+bool operator==(ContactPoint<T> const& lhs, ContactPoint<T> const& rhs)
+{
+	return lhs.position == rhs.position && lhs.depth == rhs.depth;
+}
+
+/*!
+ * @brief Compare two ContactPoints.
+ *
+ * @param lhs,rhs The ContactPoints to compare
+ * @return `true` if they do not compare equal, `false` otherwise.
+ */
+template <class T>
+bool operator!=(ContactPoint<T> const& lhs, ContactPoint<T> const& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& out, ContactPoint<T> const& cp)
+{
+	return out << "Position: " << cp.position << ", Depth: " << cp.depth;
+}
+
+/*!
+ * @brief The contact between two overlapping geometries.
+ *
+ * `normal` points from the first geometry towards the second, translating the second by
+ * `normal * depth` separates them. A manifold without points means the geometries do
+ * not overlap.
+ */
+template <class T = float>
+struct ContactManifold {
+	static_assert(std::is_floating_point_v<T>, "T is required to be floating point.");
+
+	using value_type     = T;
+	using size_type      = std::size_t;
+	using iterator       = ContactPoint<T>*;
+	using const_iterator = ContactPoint<T> const*;
+
+	static constexpr size_type const MAX_POINTS = 4;
+
+	Vec<3, T>                               normal;
+	T                                       depth{};
+	std::array<ContactPoint<T>, MAX_POINTS> points{};
+	size_type                               num_points{};
+
+	[[nodiscard]] constexpr bool empty() const noexcept { return 0 == num_points; }
+
+	[[nodiscard]] constexpr size_type size() const noexcept { return num_points; }
+
+	[[nodiscard]] constexpr iterator begin() noexcept { return points.data(); }
+
+	[[nodiscard]] constexpr const_iterator begin() const noexcept { return points.data(); }
+
+	[[nodiscard]] constexpr iterator end() noexcept { return points.data() + num_points; }
+
+	[[nodiscard]] constexpr const_iterator end() const noexcept
+	{
+		return points.data() + num_points;
+	}
+
+	[[nodiscard]] constexpr ContactPoint<T>& operator[](size_type pos) noexcept
+	{
+		return points[pos];
+	}
+
+	[[nodiscard]] constexpr ContactPoint<T> const& operator[](size_type pos) const noexcept
+	{
+		return points[pos];
+	}
+
+	/*!
+	 * @brief Adds a point if there is room, and keeps `depth` the deepest of the points.
+	 */
+	constexpr void add(Vec<3, T> const& position, T depth) noexcept
+	{
+		if (MAX_POINTS > num_points) {
+			points[num_points++] = {position, depth};
+			this->depth          = std::max(this->depth, depth);
+		}
+	}
+};
+
+/*!
+ * @brief Compare two ContactManifolds.
+ *
+ * @param lhs,rhs The ContactManifolds to compare
+ * @return `true` if they compare equal, `false` otherwise.
+ */
+template <class T>
+bool operator==(ContactManifold<T> const& lhs, ContactManifold<T> const& rhs)
+{
+	return lhs.normal == rhs.normal && lhs.depth == rhs.depth &&
+	       std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+/*!
+ * @brief Compare two ContactManifolds.
+ *
+ * @param lhs,rhs The ContactManifolds to compare
+ * @return `true` if they do not compare equal, `false` otherwise.
+ */
+template <class T>
+bool operator!=(ContactManifold<T> const& lhs, ContactManifold<T> const& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& out, ContactManifold<T> const& cm)
+{
+	out << "Normal: " << cm.normal << ", Depth: " << cm.depth << ", Points: [";
+	for (std::size_t i{}; cm.size() > i; ++i) {
+		out << (0 == i ? "" : ", ") << "(" << cm[i] << ")";
+	}
+	return out << "]";
+}
+
+namespace detail
+{
+/*!
+ * @brief The same contact with the geometries in the other order.
+ */
+template <class T>
+[[nodiscard]] constexpr ContactManifold<T> flipped(ContactManifold<T> const& cm)
+{
+	ContactManifold<T> res;
+	res.normal = -cm.normal;
+	for (auto const& p : cm) {
+		res.add(p.position + cm.normal * p.depth, p.depth);
+	}
+	return res;
+}
+
+template <class T>
+[[nodiscard]] constexpr OBB<3, T> toOBB(AABB<3, T> const& a)
+{
+	return OBB<3, T>(a.center(), a.halfLength());
+}
+
+/*!
+ * @brief Contact between the spheres around `a` and `b`.
+ */
+template <class T>
+[[nodiscard]] ContactManifold<T> contactSpheres(Vec<3, T> const& a, T ra,
+                                                Vec<3, T> const& b, T rb)
+{
+	ContactManifold<T> res;
+	T const            r  = ra + rb;
+	T const            l2 = distanceSquared(a, b);
+	if (r * r < l2) {
+		return res;
+	}
+
+	T const l  = std::sqrt(l2);
+	res.normal = T(0) < l ? (b - a) / l : Vec<3, T>(T(1), T(0), T(0));
+	res.add(b - res.normal * rb, r - l);
+	return res;
+}
+
+/*!
+ * @brief Contact between the box `a` and the sphere with center `c` and radius `r`.
+ */
+template <class T>
+[[nodiscard]] ContactManifold<T> contactBoxSphere(OBB<3, T> const& a,
+                                                  Vec<3, T> const& c, T r)
+{
+	ContactManifold<T> res;
+
+	auto const d = c - a.center;
+	Vec<3, T>  local;
+	Vec<3, T>  q = a.center;
+	bool       inside{true};
+	for (std::size_t i{}; 3 > i; ++i) {
+		local[i] = dot(a.rotation[i], d);
+		T const x = std::clamp(local[i], -a.half_length[i], a.half_length[i]);
+		inside    = inside && x == local[i];
+		q += a.rotation[i] * x;
+	}
+
+	if (!inside) {
+		T const l2 = distanceSquared(q, c);
+		if (r * r < l2) {
+			return res;
+		}
+		T const l  = std::sqrt(l2);
+		res.normal = (c - q) / l;
+		res.add(c - res.normal * r, r - l);
+		return res;
+	}
+
+	// The center is inside, push it out through the closest face
+	std::size_t axis{};
+	T           best = std::numeric_limits<T>::max();
+	for (std::size_t i{}; 3 > i; ++i) {
+		T const f = a.half_length[i] - std::abs(local[i]);
+		if (best > f) {
+			best = f;
+			axis = i;
+		}
+	}
+	res.normal = T(0) > local[axis] ? -a.rotation[axis] : a.rotation[axis];
+	res.add(c - res.normal * r, r + best);
+	return res;
+}
+
+/*!
+ * @brief Contact between two capsules given by their segments and radii.
+ *
+ * Segments that are close to parallel get two points at the ends of their common part,
+ * such that a capsule lying on another is supported along its length.
+ */
+template <class T>
+[[nodiscard]] ContactManifold<T> contactCapsules(Vec<3, T> const& sa, Vec<3, T> const& ea,
+                                                 T ra, Vec<3, T> const& sb,
+                                                 Vec<3, T> const& eb, T rb)
+{
+	T const r  = ra + rb;
+	auto    cp = detail::closestPointsSegment(sa, ea, sb, eb);
+	if (r * r < cp.distance_squared) {
+		return {};
+	}
+
+	auto const da = ea - sa;
+	auto const db = eb - sb;
+	T const    la = dot(da, da);
+	T const    lb = dot(db, db);
+
+	ContactManifold<T> res;
+	T const            l = std::sqrt(cp.distance_squared);
+	if (T(0) < l) {
+		res.normal = (cp.point_b - cp.point_a) / l;
+	} else if (auto const n = cross(da, db); T(0) < dot(n, n)) {
+		res.normal = normalize(n);
+	} else {
+		// Through each other along the same line, any orthogonal direction separates
+		auto const axis = T(0) < lb ? db : Vec<3, T>(T(1), T(0), T(0));
+		res.normal      = orthogonal(T(0) < la ? da : axis);
+	}
+
+	T const c = dot(da, db);
+	if (T(0) < la && T(0) < lb && T(0.999) * la * lb <= c * c) {
+		// Close to parallel, the common part along `a`
+		T const t0 = std::max(T(0), std::min(dot(sb - sa, da), dot(eb - sa, da)) / la);
+		T const t1 = std::min(T(1), std::max(dot(sb - sa, da), dot(eb - sa, da)) / la);
+		if (t0 < t1) {
+			for (T t : {t0, t1}) {
+				auto const pa = sa + da * t;
+				auto const pb = detail::closestPointSegment(sb, eb, pa);
+				T const    d  = r - dot(res.normal, pb - pa);
+				if (T(0) <= d) {
+					res.add(pb - res.normal * rb, d);
+				}
+			}
+			if (!res.empty()) {
+				return res;
+			}
+		}
+	}
+
+	res.add(cp.point_b - res.normal * rb, r - l);
+	return res;
+}
+
+/*!
+ * @brief Half the extent of the projection of `a` onto `axis`.
+ */
+template <class T>
+[[nodiscard]] constexpr T projectedRadius(OBB<3, T> const& a, Vec<3, T> const& axis)
+{
+	T res{};
+	for (std::size_t i{}; 3 > i; ++i) {
+		res += a.half_length[i] * std::abs(dot(a.rotation[i], axis));
+	}
+	return res;
+}
+
+/*!
+ * @brief Contact between the box `a` and a capsule.
+ *
+ * While the segment of the capsule is outside the box, the normal is along the closest
+ * points and the ends of the segment that also touch are added. Once the segment has
+ * entered the box, the normal is the separating axis candidate with the least overlap.
+ */
+template <class T>
+[[nodiscard]] ContactManifold<T> contactBoxCapsule(OBB<3, T> const&     a,
+                                                   Capsule<3, T> const& b)
+{
+	ContactManifold<T> res;
+
+	auto const cp = closestPoints(a, LineSegment<3, T>(b.start, b.end));
+	if (b.radius * b.radius < cp.distance_squared) {
+		return res;
+	}
+
+	if (T(0) < cp.distance_squared) {
+		T const l  = std::sqrt(cp.distance_squared);
+		res.normal = (cp.point_b - cp.point_a) / l;
+		// Ends that touch the same face as the closest points, such that a capsule lying
+		// on a face is supported at both ends
+		T const     eps = T(1e-6) * (b.radius + norm(b.end - b.start));
+		std::size_t num{};
+		bool        closest{};
+		for (auto const& e : {b.start, b.end}) {
+			auto const q = closestPoints(a, e);
+			T const    d = dot(res.normal, e - q.point_a);
+			if (b.radius * b.radius > q.distance_squared &&
+			    T(0.999) * T(0.999) * q.distance_squared <= d * d) {
+				T const le = std::sqrt(q.distance_squared);
+				res.add(e - (e - q.point_a) * (b.radius / le), b.radius - le);
+				++num;
+				closest = closest || eps * eps >= distanceSquared(e, cp.point_b);
+			}
+		}
+		if (2 > num && !closest) {
+			res.add(cp.point_b - res.normal * b.radius, b.radius - l);
+		}
+		return res;
+	}
+
+	auto const dir = b.end - b.start;
+	auto const mid = (b.start + b.end) * T(0.5);
+	auto const t   = mid - a.center;
+
+	std::array<Vec<3, T>, 6> axes;
+	std::size_t              num_axes{};
+	for (std::size_t i{}; 3 > i; ++i) {
+		axes[num_axes++] = a.rotation[i];
+		auto const n     = cross(a.rotation[i], dir);
+		if (T(1e-6) * dot(dir, dir) < dot(n, n)) {
+			axes[num_axes++] = normalize(n);
+		}
+	}
+
+	T best = std::numeric_limits<T>::max();
+	for (std::size_t i{}; num_axes > i; ++i) {
+		T const s = dot(t, axes[i]);
+		T const o = projectedRadius(a, axes[i]) + std::abs(dot(dir, axes[i])) * T(0.5) +
+		            b.radius - std::abs(s);
+		if (best > o) {
+			best       = o;
+			res.normal = T(0) > s ? -axes[i] : axes[i];
+		}
+	}
+
+	// The deepest end is `best` inside, the other end only if it is inside as well
+	T const top = dot(res.normal, a.center) + projectedRadius(a, res.normal);
+	for (auto const& e : {b.start, b.end}) {
+		auto const p = e - res.normal * b.radius;
+		T const    d = top - dot(res.normal, p);
+		if (T(0) <= d) {
+			res.add(p, d);
+		}
+	}
+	return res;
+}
+
+/*!
+ * @brief Clips the convex polygon `poly` to the half-space `dot(n, p) <= d`.
+ */
+template <class T, std::size_t N>
+constexpr void clipPolygon(std::array<Vec<3, T>, N>& poly, std::size_t& size,
+                           Vec<3, T> const& n, T d)
+{
+	std::array<Vec<3, T>, N> res;
+	std::size_t              res_size{};
+	for (std::size_t i{}; size > i; ++i) {
+		auto const& p  = poly[i];
+		auto const& q  = poly[(i + 1) % size];
+		T const     dp = dot(n, p) - d;
+		T const     dq = dot(n, q) - d;
+		if (T(0) >= dp) {
+			res[res_size++] = p;
+		}
+		if ((T(0) > dp) != (T(0) > dq) && T(0) != dp && T(0) != dq) {
+			res[res_size++] = p + (q - p) * (dp / (dp - dq));
+		}
+	}
+	poly = res;
+	size = res_size;
+}
+
+/*!
+ * @brief Contact between two boxes.
+ *
+ * Separating axis test over the face normals and edge cross products of both boxes,
+ * which exits on the first separating axis. The axis of least overlap is the normal,
+ * where face axes are preferred over edge axes of slightly less overlap for stable
+ * manifolds. For a face axis, the most anti-parallel face of the other box is clipped
+ * against the sides of the reference face, otherwise the closest points of the two
+ * edges are the single point of contact.
+ */
+template <class T>
+[[nodiscard]] ContactManifold<T> contactBoxes(OBB<3, T> const& a, OBB<3, T> const& b)
+{
+	constexpr T eps = T(1e-6);
+
+	ContactManifold<T> res;
+
+	T R[3][3];
+	T abs_R[3][3];
+	for (std::size_t i{}; 3 > i; ++i) {
+		for (std::size_t j{}; 3 > j; ++j) {
+			R[i][j]     = dot(a.rotation[i], b.rotation[j]);
+			abs_R[i][j] = std::abs(R[i][j]);
+		}
+	}
+
+	auto const t = b.center - a.center;
+
+	// 0-2 are the faces of `a`, 3-5 the faces of `b`, and 6-14 the edge pairs
+	T           best = std::numeric_limits<T>::max();
+	std::size_t best_axis{};
+	Vec<3, T>   best_normal;
+	auto test = [&](std::size_t axis, Vec<3, T> const& n, T s, T ra, T rb, T len) {
+		T const o = (ra + rb - std::abs(s)) / len;
+		if (T(0) > o) {
+			return false;
+		}
+		// Prefer faces over edges
+		if (6 > axis ? best > o : T(0.95) * best > o + eps) {
+			best        = o;
+			best_axis   = axis;
+			best_normal = T(0) > s ? -n : n;
+		}
+		return true;
+	};
+
+	for (std::size_t i{}; 3 > i; ++i) {
+		T const rb = b.half_length[0] * abs_R[i][0] + b.half_length[1] * abs_R[i][1] +
+		             b.half_length[2] * abs_R[i][2];
+		if (!test(i, a.rotation[i], dot(t, a.rotation[i]), a.half_length[i], rb, T(1))) {
+			return res;
+		}
+	}
+
+	for (std::size_t j{}; 3 > j; ++j) {
+		T const ra = a.half_length[0] * abs_R[0][j] + a.half_length[1] * abs_R[1][j] +
+		             a.half_length[2] * abs_R[2][j];
+		if (!test(3 + j, b.rotation[j], dot(t, b.rotation[j]), ra, b.half_length[j],
+		          T(1))) {
+			return res;
+		}
+	}
+
+	for (std::size_t i{}; 3 > i; ++i) {
+		std::size_t const i1 = (i + 1) % 3;
+		std::size_t const i2 = (i + 2) % 3;
+		for (std::size_t j{}; 3 > j; ++j) {
+			std::size_t const j1 = (j + 1) % 3;
+			std::size_t const j2 = (j + 2) % 3;
+
+			auto const n   = cross(a.rotation[i], b.rotation[j]);
+			T const    len = norm(n);
+			// Parallel edges are covered by the face axes
+			if (T(1e-3) > len) {
+				continue;
+			}
+			T const ra = a.half_length[i1] * abs_R[i2][j] + a.half_length[i2] * abs_R[i1][j];
+			T const rb = b.half_length[j1] * abs_R[i][j2] + b.half_length[j2] * abs_R[i][j1];
+			if (!test(6 + 3 * i + j, n / len, dot(t, n), ra, rb, len)) {
+				return res;
+			}
+		}
+	}
+
+	res.normal = best_normal;
+
+	if (6 <= best_axis) {
+		// Edge against edge, the edges of each box furthest towards the other
+		std::size_t const i = (best_axis - 6) / 3;
+		std::size_t const j = (best_axis - 6) % 3;
+
+		auto pa = a.center;
+		auto pb = b.center;
+		for (std::size_t k{}; 3 > k; ++k) {
+			if (i != k) {
+				T const s = T(0) > dot(a.rotation[k], res.normal) ? -T(1) : T(1);
+				pa += a.rotation[k] * (s * a.half_length[k]);
+			}
+			if (j != k) {
+				T const s = T(0) < dot(b.rotation[k], res.normal) ? -T(1) : T(1);
+				pb += b.rotation[k] * (s * b.half_length[k]);
+			}
+		}
+		auto const ea = a.rotation[i] * a.half_length[i];
+		auto const eb = b.rotation[j] * b.half_length[j];
+		auto const cp = closestPointsSegment(pa - ea, pa + ea, pb - eb, pb + eb);
+		res.add(cp.point_b, best);
+		return res;
+	}
+
+	// Face of the reference box against the most anti-parallel face of the incident box
+	bool const        a_ref = 3 > best_axis;
+	OBB<3, T> const&  ref   = a_ref ? a : b;
+	OBB<3, T> const&  inc   = a_ref ? b : a;
+	std::size_t const axis  = a_ref ? best_axis : best_axis - 3;
+	auto const        n     = a_ref ? res.normal : -res.normal;  // Out of the reference
+
+	std::size_t inc_axis{};
+	T           inc_best{};
+	for (std::size_t k{}; 3 > k; ++k) {
+		T const d = std::abs(dot(inc.rotation[k], n));
+		if (inc_best < d) {
+			inc_best = d;
+			inc_axis = k;
+		}
+	}
+	T const           s  = T(0) < dot(inc.rotation[inc_axis], n) ? -T(1) : T(1);
+	std::size_t const u  = (inc_axis + 1) % 3;
+	std::size_t const v  = (inc_axis + 2) % 3;
+	auto const        hw = inc.rotation[inc_axis] * (s * inc.half_length[inc_axis]);
+	auto const        hu = inc.rotation[u] * inc.half_length[u];
+	auto const        hv = inc.rotation[v] * inc.half_length[v];
+	auto const        c  = inc.center + hw;
+
+	std::array<Vec<3, T>, 8> poly{c + hu + hv, c - hu + hv, c - hu - hv, c + hu - hv};
+	std::size_t              size = 4;
+	for (std::size_t k{}; 3 > k && 0 < size; ++k) {
+		if (axis != k) {
+			auto const& side = ref.rotation[k];
+			T const     d    = dot(side, ref.center);
+			clipPolygon(poly, size, side, d + ref.half_length[k]);
+			clipPolygon(poly, size, -side, ref.half_length[k] - d);
+		}
+	}
+
+	T const                  face = dot(n, ref.center) + ref.half_length[axis];
+	std::array<Vec<3, T>, 8> pos;
+	std::array<T, 8>         depth;
+	std::size_t              num{};
+	for (std::size_t k{}; size > k; ++k) {
+		T const d = face - dot(n, poly[k]);
+		if (T(0) <= d) {
+			pos[num]   = a_ref ? poly[k] : poly[k] - res.normal * d;
+			depth[num] = d;
+			++num;
+		}
+	}
+
+	if (ContactManifold<T>::MAX_POINTS >= num) {
+		for (std::size_t k{}; num > k; ++k) {
+			res.add(pos[k], depth[k]);
+		}
+		return res;
+	}
+
+	// Keep the deepest point, the point furthest from it, and the points furthest to
+	// either side of the line between them
+	std::size_t const p0 =
+	    std::max_element(depth.begin(), depth.begin() + num) - depth.begin();
+	std::size_t p1 = p0;
+	T           d1{};
+	for (std::size_t k{}; num > k; ++k) {
+		if (T const d = distanceSquared(pos[k], pos[p0]); d1 < d) {
+			d1 = d;
+			p1 = k;
+		}
+	}
+	std::size_t p2 = p0;
+	std::size_t p3 = p0;
+	T           d2{};
+	T           d3{};
+	for (std::size_t k{}; num > k; ++k) {
+		T const area = dot(cross(pos[p1] - pos[p0], pos[k] - pos[p0]), n);
+		if (d2 < area) {
+			d2 = area;
+			p2 = k;
+		} else if (d3 > area) {
+			d3 = area;
+			p3 = k;
+		}
+	}
+	for (std::size_t k : {p0, p1, p2, p3}) {
+		res.add(pos[k], depth[k]);
+	}
+	return res;
+}
+}  // namespace detail
+
+/**************************************************************************************
+|                                                                                     |
+|                                       Contact                                       |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Computes the contact manifold between `a` and `b`.
+ *
+ * The overlap test is part of the computation, an empty manifold is returned as soon as
+ * the geometries are found to be separated. Box pairs use the separating axis test and
+ * clip the faces along the axis of least overlap, spheres and capsules use closed forms.
+ */
+template <class T>
+[[nodiscard]] ContactManifold<T> contact(AABB<3, T> const& a, AABB<3, T> const& b)
+{
+	return detail::contactBoxes(detail::toOBB(a), detail::toOBB(b));
+}
+
+template <class T>
+[[nodiscard]] ContactManifold<T> contact(AABB<3, T> const& a, OBB<3, T> const& b)
+{
+	return detail::contactBoxes(detail::toOBB(a), b);
+}
+
+template <class T>
+[[nodiscard]] ContactManifold<T> contact(AABB<3, T> const& a, Sphere<3, T> const& b)
+{
+	return detail::contactBoxSphere(detail::toOBB(a), b.center, b.radius);
+}
+
+template <class T>
+[[nodiscard]] ContactManifold<T> contact(AABB<3, T> const& a, Capsule<3, T> const& b)
+{
+	return detail::contactBoxCapsule(detail::toOBB(a), b);
+}
+
+template <class T>
+[[nodiscard]] ContactManifold<T> contact(OBB<3, T> const& a, AABB<3, T> const& b)
+{
+	return detail::contactBoxes(a, detail::toOBB(b));
+}
+
+template <class T>
+[[nodiscard]] ContactManifold<T> contact(OBB<3, T> const& a, OBB<3, T> const& b)
+{
+	return detail::contactBoxes(a, b);
+}
+
+template <class T>
+[[nodiscard]] ContactManifold<T> contact(OBB<3, T> const& a, Sphere<3, T> const& b)
+{
+	return detail::contactBoxSphere(a, b.center, b.radius);
+}
+
+template <class T>
+[[nodiscard]] ContactManifold<T> contact(OBB<3, T> const& a, Capsule<3, T> const& b)
+{
+	return detail::contactBoxCapsule(a, b);
+}
+
+template <class T>
+[[nodiscard]] ContactManifold<T> contact(Sphere<3, T> const& a, AABB<3, T> const& b)
+{
+	return detail::flipped(contact(b, a));
+}
+
+template <class T>
+[[nodiscard]] ContactManifold<T> contact(Sphere<3, T> const& a, OBB<3, T> const& b)
+{
+	return detail::flipped(contact(b, a));
+}
+
+template <class T>
+[[nodiscard]] ContactManifold<T> contact(Sphere<3, T> const& a, Sphere<3, T> const& b)
+{
+	return detail::contactSpheres(a.center, a.radius, b.center, b.radius);
+}
+
+template <class T>
+[[nodiscard]] ContactManifold<T> contact(Sphere<3, T> const& a, Capsule<3, T> const& b)
+{
+	return detail::contactSpheres(
+	    a.center, a.radius, detail::closestPointSegment(b.start, b.end, a.center),
+	    b.radius);
+}
+
+template <class T>
+[[nodiscard]] ContactManifold<T> contact(Capsule<3, T> const& a, AABB<3, T> const& b)
+{
+	return detail::flipped(contact(b, a));
+}
+
+template <class T>
+[[nodiscard]] ContactManifold<T> contact(Capsule<3, T> const& a, OBB<3, T> const& b)
+{
+	return detail::flipped(contact(b, a));
+}
+
+template <class T>
+[[nodiscard]] ContactManifold<T> contact(Capsule<3, T> const& a, Sphere<3, T> const& b)
+{
+	return detail::flipped(contact(b, a));
+}
+
+template <class T>
+[[nodiscard]] ContactManifold<T> contact(Capsule<3, T> const& a, Capsule<3, T> const& b)
+{
+	return detail::contactCapsules(a.start, a.end, a.radius, b.start, b.end, b.radius);
+}
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_CONTACT_HPP
@@ -44,23 +44,88 @@
 
 // UFO
 #include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/aabc.hpp>
 #include <ufo/geometry/capsule.hpp>
+#include <ufo/geometry/cone.hpp>
+#include <ufo/geometry/convex_polyhedron.hpp>
+#include <ufo/geometry/cylinder.hpp>
+#include <ufo/geometry/detail/spherical_sector.hpp>
 #include <ufo/geometry/dynamic_geometry.hpp>
+#include <ufo/geometry/ellipsoid.hpp>
 #include <ufo/geometry/frustum.hpp>
+#include <ufo/geometry/fun.hpp>
 #include <ufo/geometry/line_segment.hpp>
 #include <ufo/geometry/obb.hpp>
 #include <ufo/geometry/plane.hpp>
+#include <ufo/geometry/polygon.hpp>
 #include <ufo/geometry/ray.hpp>
 #include <ufo/geometry/sphere.hpp>
+#include <ufo/geometry/spherical_sector.hpp>
 #include <ufo/geometry/triangle.hpp>
 #include <ufo/math/vec.hpp>
 
 // STL
 #include <algorithm>
 #include <cmath>
+#include <execution>
+#include <limits>
+#include <type_traits>
 
 namespace ufo
 {
+namespace detail
+{
+/*!
+ * @brief Point in cylinder test with the axis normalized once, for testing many points.
+ */
+template <std::size_t Dim, class T>
+struct CylinderPointTest {
+	Vec<Dim, T> start;
+	Vec<Dim, T> axis;
+	T           length;
+	T           radius_sq;
+
+	constexpr explicit CylinderPointTest(Cylinder<Dim, T> const& a)
+	    : start(a.start), length(norm(a.end - a.start)), radius_sq(a.radius * a.radius)
+	{
+		axis = T(0) < length ? (a.end - a.start) / length : Vec<Dim, T>();
+	}
+
+	[[nodiscard]] constexpr bool operator()(Vec<Dim, T> const& p) const
+	{
+		auto const v = p - start;
+		T const    s = dot(v, axis);
+		return T(0) <= s && length >= s && radius_sq >= dot(v, v) - s * s;
+	}
+};
+
+/*!
+ * @brief Point in cone test with the axis normalized once, for testing many points.
+ */
+template <std::size_t Dim, class T>
+struct ConePointTest {
+	Vec<Dim, T> tip;
+	Vec<Dim, T> axis;
+	T           height;
+	T           slope_sq;
+
+	constexpr explicit ConePointTest(Cone<Dim, T> const& a)
+	    : tip(a.tip), height(norm(a.base_center - a.tip))
+	{
+		axis     = T(0) < height ? (a.base_center - a.tip) / height : Vec<Dim, T>();
+		slope_sq = T(0) < height ? (a.radius * a.radius) / (height * height) : T(0);
+	}
+
+	[[nodiscard]] constexpr bool operator()(Vec<Dim, T> const& p) const
+	{
+		auto const v = p - tip;
+		T const    s = dot(v, axis);
+		// Squared distance to the axis against the squared radius at `s`
+		return T(0) <= s && height >= s && slope_sq * s * s >= dot(v, v) - s * s;
+	}
+};
+}  // namespace detail
+
 /**************************************************************************************
 |                                                                                     |
 |                                  Dynamic Geometry                                   |
@@ -154,6 +219,18 @@ template <std::size_t Dim, class T>
 	return all(lessThanEqual(min(a), min(b))) && all(lessThanEqual(max(b), max(a)));
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(AABB<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	for (std::size_t i{}; Dim > i; ++i) {
+		T const hl = b.half_length;
+		if (a.min[i] > b.center[i] - hl || a.max[i] < b.center[i] + hl) {
+			return false;
+		}
+	}
+	return true;
+}
+
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr bool contains(AABB<Dim, T> const& a, Sphere<Dim, T> const& b)
 {
@@ -205,7 +282,113 @@ template <std::size_t Dim, class T>
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr bool contains(AABB<Dim, T> const& a, Vec<Dim, T> const& b)
 {
-	return all(min(a) <= b && b <= max(a));
+	return all(lessThanEqual(min(a), b)) && all(lessThanEqual(b, max(a)));
+}
+
+template <class T>
+[[nodiscard]] bool contains(AABB<3, T> const& a, ConvexPolyhedron<T> const& b)
+{
+	return !b.empty() && contains(a, AABB<3, T>(min(b), max(b)));
+}
+
+template <class T>
+[[nodiscard]] bool contains(AABB<2, T> const& a, Polygon<T> const& b)
+{
+	return !b.empty() && contains(a, b.bounds());
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(AABB<Dim, T> const& a, Ellipsoid<Dim, T> const& b)
+{
+	return contains(a, AABB<Dim, T>(min(b), max(b)));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(AABB<Dim, T> const& a, Cylinder<Dim, T> const& b)
+{
+	return contains(a, AABB<Dim, T>(min(b), max(b)));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(AABB<Dim, T> const& a, Cone<Dim, T> const& b)
+{
+	return contains(a, AABB<Dim, T>(min(b), max(b)));
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        AABC                                         |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(AABC<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	for (std::size_t i{}; Dim > i; ++i) {
+		if (a.half_length < std::abs(b.center[i] - a.center[i]) + b.half_length) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(AABC<Dim, T> const& a, AABB<Dim, T> const& b)
+{
+	for (std::size_t i{}; Dim > i; ++i) {
+		T const hl = a.half_length;
+		if (a.center[i] - hl > b.min[i] || a.center[i] + hl < b.max[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(AABC<Dim, T> const& a, Sphere<Dim, T> const& b)
+{
+	for (std::size_t i{}; Dim > i; ++i) {
+		if (a.half_length < std::abs(b.center[i] - a.center[i]) + b.radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(AABC<Dim, T> const& a, Capsule<Dim, T> const& b)
+{
+	return contains(AABB<Dim, T>(a), b);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(AABC<Dim, T> const&        a,
+                                      LineSegment<Dim, T> const& b)
+{
+	return contains(a, b.start) && contains(a, b.end);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(AABC<Dim, T> const& a, OBB<Dim, T> const& b)
+{
+	return contains(AABB<Dim, T>(a), b);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(AABC<Dim, T> const& a, Triangle<Dim, T> const& b)
+{
+	return contains(AABB<Dim, T>(a), b);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(AABC<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	for (std::size_t i{}; Dim > i; ++i) {
+		if (a.half_length < std::abs(b[i] - a.center[i])) {
+			return false;
+		}
+	}
+	return true;
 }
 
 /**************************************************************************************
@@ -225,6 +408,18 @@ template <std::size_t Dim, class T>
 	return true;
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(Sphere<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	// The corner furthest from the center
+	T distance_squared{};
+	for (std::size_t i{}; Dim > i; ++i) {
+		T d = std::abs(b.center[i] - a.center[i]) + b.half_length;
+		distance_squared += d * d;
+	}
+	return distance_squared <= a.radius * a.radius;
+}
+
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr bool contains(Sphere<Dim, T> const& a, Sphere<Dim, T> const& b)
 {
@@ -288,7 +483,17 @@ template <std::size_t Dim, class T>
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr bool contains(Sphere<Dim, T> const& a, Vec<Dim, T> const& b)
 {
-	return distanceSquared(a, b) <= a.radius * a.radius;
+	return distanceSquared(a.center, b) <= a.radius * a.radius;
+}
+
+template <class T>
+[[nodiscard]] bool contains(Sphere<3, T> const& a, ConvexPolyhedron<T> const& b)
+{
+	T const r2 = a.radius * a.radius;
+	return !b.empty() &&
+	       std::all_of(b.vertices.begin(), b.vertices.end(), [&a, r2](auto const& v) {
+		       return distanceSquared(a.center, v) <= r2;
+	       });
 }
 
 /**************************************************************************************
@@ -308,6 +513,12 @@ template <std::size_t Dim, class T>
 	return true;
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(Capsule<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	return contains(a, AABB<Dim, T>(b));
+}
+
 // template <std::size_t Dim, class T>
 // [[nodiscard]] constexpr bool contains(Capsule<Dim, T> const& a, Sphere<Dim, T> const&
 // b)
@@ -832,6 +1043,308 @@ template <std::size_t Dim, class T>
 // 	// TODO: Implement
 // }
 
+/**************************************************************************************
+|                                                                                     |
+|                                  Convex polyhedron                                  |
+|                                                                                     |
+**************************************************************************************/
+
+template <class T>
+[[nodiscard]] bool contains(ConvexPolyhedron<T> const& a, AABB<3, T> const& b)
+{
+	// The box is inside if it is fully behind all planes
+	auto const c   = b.center();
+	auto const h   = b.halfLength();
+	T          sep = std::numeric_limits<T>::lowest();
+	for (auto const& p : a.planes) {
+		T r = std::abs(h.x * p.normal.x) + std::abs(h.y * p.normal.y) +
+		      std::abs(h.z * p.normal.z);
+		T d = p.normal.x * c.x + p.normal.y * c.y + p.normal.z * c.z + p.distance + r;
+		sep = sep < d ? d : sep;
+	}
+	return !a.empty() && T(0) >= sep;
+}
+
+template <class T>
+[[nodiscard]] bool contains(ConvexPolyhedron<T> const& a, Sphere<3, T> const& b)
+{
+	return !a.empty() && -b.radius >= a.signedDistance(b.center);
+}
+
+template <class T>
+[[nodiscard]] bool contains(ConvexPolyhedron<T> const& a, ConvexPolyhedron<T> const& b)
+{
+	return !a.empty() && !b.empty() &&
+	       std::all_of(b.vertices.begin(), b.vertices.end(),
+	                   [&a](auto const& v) { return T(0) >= a.signedDistance(v); });
+}
+
+template <class T>
+[[nodiscard]] bool contains(ConvexPolyhedron<T> const& a, Vec<3, T> const& b)
+{
+	return !a.empty() && T(0) >= a.signedDistance(b);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Ellipsoid                                      |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(Ellipsoid<Dim, T> const& a, AABB<Dim, T> const& b)
+{
+	for (auto c : corners(b)) {
+		if (T(1) < a.mahalanobisSquared(c)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(Ellipsoid<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	return T(1) >= a.mahalanobisSquared(b);
+}
+
+/*!
+ * @brief Mahalanobis gating, checks if each point in [first, last) is inside `a` and
+ * stores the results in the range beginning at `d_first`.
+ *
+ * @return Output iterator to the element past the last result.
+ */
+template <std::size_t Dim, class T, class InputIt, class OutputIt>
+OutputIt contains(Ellipsoid<Dim, T> const& a, InputIt first, InputIt last,
+                  OutputIt d_first)
+{
+	return std::transform(first, last, d_first, [&a](Vec<Dim, T> const& p) {
+		return T(1) >= a.mahalanobisSquared(p);
+	});
+}
+
+/*!
+ * @brief Same as above, but executed according to `policy`.
+ */
+template <
+    class ExecutionPolicy, std::size_t Dim, class T, class ForwardIt1, class ForwardIt2,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+ForwardIt2 contains(ExecutionPolicy&& policy, Ellipsoid<Dim, T> const& a,
+                    ForwardIt1 first, ForwardIt1 last, ForwardIt2 d_first)
+{
+	return std::transform(
+	    std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	    [&a](Vec<Dim, T> const& p) { return T(1) >= a.mahalanobisSquared(p); });
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                       Polygon                                       |
+|                                                                                     |
+**************************************************************************************/
+
+template <class T>
+[[nodiscard]] bool contains(Polygon<T> const& a, AABB<2, T> const& b)
+{
+	if (a.convex()) {
+		return a.contains(b.min) && a.contains(b.max) &&
+		       a.contains(Vec<2, T>(b.min.x, b.max.y)) &&
+		       a.contains(Vec<2, T>(b.max.x, b.min.y));
+	}
+	return !a.intersectsBoundary(b) && a.contains(b.center());
+}
+
+template <class T>
+[[nodiscard]] bool contains(Polygon<T> const& a, Vec<2, T> const& b)
+{
+	return a.contains(b);
+}
+
+/*!
+ * @brief Point-in-polygon test for all points in [first, last), the results are stored
+ * in the range beginning at `d_first`.
+ *
+ * @return Output iterator to the element past the last result.
+ */
+template <class T, class InputIt, class OutputIt>
+OutputIt contains(Polygon<T> const& a, InputIt first, InputIt last, OutputIt d_first)
+{
+	return std::transform(first, last, d_first,
+	                      [&a](Vec<2, T> const& p) { return a.contains(p); });
+}
+
+/*!
+ * @brief Same as above, but executed according to `policy`.
+ */
+template <
+    class ExecutionPolicy, class T, class ForwardIt1, class ForwardIt2,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+ForwardIt2 contains(ExecutionPolicy&& policy, Polygon<T> const& a, ForwardIt1 first,
+                    ForwardIt1 last, ForwardIt2 d_first)
+{
+	return std::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                      [&a](Vec<2, T> const& p) { return a.contains(p); });
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Cylinder                                       |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(Cylinder<Dim, T> const& a, AABB<Dim, T> const& b)
+{
+	detail::CylinderPointTest<Dim, T> const test(a);
+	for (auto c : corners(b)) {
+		if (!test(c)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(Cylinder<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	return detail::CylinderPointTest<Dim, T>(a)(b);
+}
+
+/*!
+ * @brief Checks if each point in [first, last) is inside `a` and stores the results in
+ * the range beginning at `d_first`.
+ *
+ * @return Output iterator to the element past the last result.
+ */
+template <std::size_t Dim, class T, class InputIt, class OutputIt>
+OutputIt contains(Cylinder<Dim, T> const& a, InputIt first, InputIt last,
+                  OutputIt d_first)
+{
+	return std::transform(first, last, d_first, detail::CylinderPointTest<Dim, T>(a));
+}
+
+/*!
+ * @brief Same as above, but executed according to `policy`.
+ */
+template <
+    class ExecutionPolicy, std::size_t Dim, class T, class ForwardIt1, class ForwardIt2,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+ForwardIt2 contains(ExecutionPolicy&& policy, Cylinder<Dim, T> const& a, ForwardIt1 first,
+                    ForwardIt1 last, ForwardIt2 d_first)
+{
+	return std::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                      detail::CylinderPointTest<Dim, T>(a));
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        Cone                                         |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(Cone<Dim, T> const& a, AABB<Dim, T> const& b)
+{
+	detail::ConePointTest<Dim, T> const test(a);
+	for (auto c : corners(b)) {
+		if (!test(c)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool contains(Cone<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	return detail::ConePointTest<Dim, T>(a)(b);
+}
+
+/*!
+ * @brief Checks if each point in [first, last) is inside `a` and stores the results in
+ * the range beginning at `d_first`.
+ *
+ * @return Output iterator to the element past the last result.
+ */
+template <std::size_t Dim, class T, class InputIt, class OutputIt>
+OutputIt contains(Cone<Dim, T> const& a, InputIt first, InputIt last, OutputIt d_first)
+{
+	return std::transform(first, last, d_first, detail::ConePointTest<Dim, T>(a));
+}
+
+/*!
+ * @brief Same as above, but executed according to `policy`.
+ */
+template <
+    class ExecutionPolicy, std::size_t Dim, class T, class ForwardIt1, class ForwardIt2,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+ForwardIt2 contains(ExecutionPolicy&& policy, Cone<Dim, T> const& a, ForwardIt1 first,
+                    ForwardIt1 last, ForwardIt2 d_first)
+{
+	return std::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                      detail::ConePointTest<Dim, T>(a));
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                  Spherical sector                                   |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Checks if all of `b` is inside `a`.
+ *
+ * Exact when the sensor axes of `a` are aligned with the world axes, otherwise `b` can
+ * be reported as not contained when it is close to the boundary.
+ */
+template <class T>
+[[nodiscard]] bool contains(SphericalSector<T> const& a, AABB<3, T> const& b)
+{
+	return detail::SphericalSectorTest<T>(a).contains(b);
+}
+
+template <class T>
+[[nodiscard]] bool contains(SphericalSector<T> const& a, Vec<3, T> const& b)
+{
+	return detail::SphericalSectorTest<T>(a).contains(b);
+}
+
+/*!
+ * @brief Checks if each point or AABB in [first, last) is inside `a` and stores the
+ * results in the range beginning at `d_first`.
+ *
+ * The angles of `a` are only converted once, for all elements.
+ *
+ * @return Output iterator to the element past the last result.
+ */
+template <class T, class InputIt, class OutputIt>
+OutputIt contains(SphericalSector<T> const& a, InputIt first, InputIt last,
+                  OutputIt d_first)
+{
+	detail::SphericalSectorTest<T> const test(a);
+	return std::transform(first, last, d_first,
+	                      [&test](auto const& b) { return test.contains(b); });
+}
+
+/*!
+ * @brief Same as above, but executed according to `policy`.
+ */
+template <
+    class ExecutionPolicy, class T, class ForwardIt1, class ForwardIt2,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+ForwardIt2 contains(ExecutionPolicy&& policy, SphericalSector<T> const& a,
+                    ForwardIt1 first, ForwardIt1 last, ForwardIt2 d_first)
+{
+	detail::SphericalSectorTest<T> const test(a);
+	return std::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                      [&test](auto const& b) { return test.contains(b); });
+}
+
 /**************************************************************************************
 |                                                                                     |
 |                                         Vec                                         |
@@ -0,0 +1,507 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_CONVEX_HULL_HPP
+#define UFO_GEOMETRY_CONVEX_HULL_HPP
+
+// UFO
+#include <ufo/geometry/bounding_volume.hpp>
+#include <ufo/geometry/convex_polyhedron.hpp>
+#include <ufo/geometry/plane.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+namespace detail
+{
+/*!
+ * @brief Serial 3D Quickhull.
+ *
+ * Faces are triangles with outward normals, each owning the set of points in front of
+ * it. The point furthest in front of a face is added to the hull by removing all faces
+ * that can see it (found by flood fill from that face) and connecting the horizon to
+ * the point. Points in front of the removed faces are reassigned to the new faces, the
+ * others are inside and dropped.
+ */
+template <class T>
+class QuickHull
+{
+ public:
+	QuickHull(std::vector<Vec<3, T>> const& points, T eps) : points_(points), eps_(eps) {}
+
+	/*!
+	 * @brief Builds the hull, returns `false` if the points do not span a volume.
+	 */
+	bool build()
+	{
+		if (!initialSimplex()) {
+			return false;
+		}
+
+		for (std::size_t f{}; faces_.size() > f; ++f) {
+			if (faces_[f].alive && !faces_[f].outside.empty()) {
+				addPoint(f);
+			}
+		}
+		return true;
+	}
+
+	[[nodiscard]] ConvexPolyhedron<T> polyhedron() const
+	{
+		ConvexPolyhedron<T> res;
+
+		std::vector<bool> used(points_.size(), false);
+		for (auto const& f : faces_) {
+			if (!f.alive) {
+				continue;
+			}
+
+			for (auto v : f.v) {
+				used[v] = true;
+			}
+
+			if (T(0) == f.normal.x && T(0) == f.normal.y && T(0) == f.normal.z) {
+				continue;
+			}
+
+			// Triangulated faces give many copies of the same plane
+			bool duplicate = std::any_of(
+			    res.planes.begin(), res.planes.end(), [this, &f](Plane<T> const& p) {
+				    return T(1) - T(1e3) * std::numeric_limits<T>::epsilon() <
+				               dot(p.normal, f.normal) &&
+				           std::abs(p.distance + f.offset) <= eps_;
+			    });
+			if (!duplicate) {
+				res.planes.emplace_back(f.normal, -f.offset);
+			}
+		}
+
+		for (std::size_t i{}; points_.size() > i; ++i) {
+			if (used[i]) {
+				res.vertices.push_back(points_[i]);
+			}
+		}
+		return res;
+	}
+
+ private:
+	struct Face {
+		std::array<std::uint32_t, 3> v;
+		Vec<3, T>                    normal;
+		T                            offset{};
+		std::vector<std::uint32_t>   outside;
+		std::uint32_t                furthest{};
+		T                            furthest_dist{};
+		bool                         alive = true;
+	};
+
+	[[nodiscard]] static constexpr std::uint64_t key(std::uint32_t a,
+	                                                 std::uint32_t b) noexcept
+	{
+		return (static_cast<std::uint64_t>(a) << 32) | b;
+	}
+
+	[[nodiscard]] T dist(Face const& f, std::uint32_t p) const noexcept
+	{
+		return dot(f.normal, points_[p]) - f.offset;
+	}
+
+	std::size_t addFace(std::uint32_t a, std::uint32_t b, std::uint32_t c)
+	{
+		Face f;
+		f.v      = {a, b, c};
+		auto n   = cross(points_[b] - points_[a], points_[c] - points_[a]);
+		T    len = norm(n);
+		if (T(0) < len) {
+			f.normal = n / len;
+			f.offset = dot(f.normal, points_[a]);
+		} else {
+			f.normal = Vec<3, T>(T(0), T(0), T(0));
+		}
+
+		std::size_t const idx = faces_.size();
+		faces_.push_back(std::move(f));
+		edges_[key(a, b)] = idx;
+		edges_[key(b, c)] = idx;
+		edges_[key(c, a)] = idx;
+		return idx;
+	}
+
+	void assign(std::size_t f, std::uint32_t p)
+	{
+		T const d = dist(faces_[f], p);
+		if (faces_[f].outside.empty() || d > faces_[f].furthest_dist) {
+			faces_[f].furthest      = p;
+			faces_[f].furthest_dist = d;
+		}
+		faces_[f].outside.push_back(p);
+	}
+
+	bool initialSimplex()
+	{
+		auto const n = static_cast<std::uint32_t>(points_.size());
+		if (4 > n) {
+			return false;
+		}
+
+		// Extreme points along the axes, the pair furthest apart spans the first edge
+		std::uint32_t ext[6]{};
+		for (std::uint32_t i{}; n > i; ++i) {
+			for (std::size_t k{}; 3 > k; ++k) {
+				if (points_[i][k] < points_[ext[2 * k]][k]) {
+					ext[2 * k] = i;
+				}
+				if (points_[i][k] > points_[ext[2 * k + 1]][k]) {
+					ext[2 * k + 1] = i;
+				}
+			}
+		}
+
+		std::uint32_t i0{}, i1{};
+		T             best{-1};
+		for (std::size_t a{}; 6 > a; ++a) {
+			for (std::size_t b = a + 1; 6 > b; ++b) {
+				T d = distanceSquared(points_[ext[a]], points_[ext[b]]);
+				if (d > best) {
+					best = d;
+					i0   = ext[a];
+					i1   = ext[b];
+				}
+			}
+		}
+		if (eps_ * eps_ >= best) {
+			return false;
+		}
+
+		auto const    dir = normalize(points_[i1] - points_[i0]);
+		std::uint32_t i2{};
+		best = T(-1);
+		for (std::uint32_t i{}; n > i; ++i) {
+			auto const v = points_[i] - points_[i0];
+			T          d = normSquared(v - dir * dot(v, dir));
+			if (d > best) {
+				best = d;
+				i2   = i;
+			}
+		}
+		if (eps_ * eps_ >= best) {
+			return false;
+		}
+
+		auto const normal =
+		    normalize(cross(points_[i1] - points_[i0], points_[i2] - points_[i0]));
+		std::uint32_t i3{};
+		best = T(-1);
+		for (std::uint32_t i{}; n > i; ++i) {
+			T d = std::abs(dot(normal, points_[i] - points_[i0]));
+			if (d > best) {
+				best = d;
+				i3   = i;
+			}
+		}
+		if (eps_ >= best) {
+			return false;
+		}
+
+		// Orient the faces outwards, i3 is behind (i0, i1, i2) if the normal points away
+		if (T(0) < dot(normal, points_[i3] - points_[i0])) {
+			std::swap(i1, i2);
+		}
+
+		std::size_t const f[4] = {addFace(i0, i1, i2), addFace(i0, i3, i1),
+		                          addFace(i1, i3, i2), addFace(i2, i3, i0)};
+
+		for (std::uint32_t i{}; n > i; ++i) {
+			if (i == i0 || i == i1 || i == i2 || i == i3) {
+				continue;
+			}
+			for (auto j : f) {
+				if (eps_ < dist(faces_[j], i)) {
+					assign(j, i);
+					break;
+				}
+			}
+		}
+		return true;
+	}
+
+	void addPoint(std::size_t start)
+	{
+		std::uint32_t const eye = faces_[start].furthest;
+
+		// Flood fill the faces visible from the eye
+
+		std::vector<std::size_t> visible{start};
+		faces_[start].alive = false;
+		for (std::size_t i{}; visible.size() > i; ++i) {
+			auto const& f = faces_[visible[i]];
+			for (std::size_t e{}; 3 > e; ++e) {
+				auto it = edges_.find(key(f.v[(e + 1) % 3], f.v[e]));
+				if (edges_.end() == it) {
+					continue;
+				}
+				auto& g = faces_[it->second];
+				if (g.alive && eps_ < dist(g, eye)) {
+					g.alive = false;
+					visible.push_back(it->second);
+				}
+			}
+		}
+
+		// Horizon edges are edges of visible faces whose twin face is still alive
+
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> horizon;
+		for (auto i : visible) {
+			auto const& f = faces_[i];
+			for (std::size_t e{}; 3 > e; ++e) {
+				auto it = edges_.find(key(f.v[(e + 1) % 3], f.v[e]));
+				if (edges_.end() != it && faces_[it->second].alive) {
+					horizon.emplace_back(f.v[e], f.v[(e + 1) % 3]);
+				}
+			}
+		}
+
+		std::vector<std::uint32_t> orphans;
+		for (auto i : visible) {
+			auto& f = faces_[i];
+			for (std::size_t e{}; 3 > e; ++e) {
+				auto it = edges_.find(key(f.v[e], f.v[(e + 1) % 3]));
+				if (edges_.end() != it && it->second == i) {
+					edges_.erase(it);
+				}
+			}
+			orphans.insert(orphans.end(), f.outside.begin(), f.outside.end());
+			f.outside.clear();
+			f.outside.shrink_to_fit();
+		}
+
+		std::size_t const first_new = faces_.size();
+		for (auto [a, b] : horizon) {
+			addFace(a, b, eye);
+		}
+
+		for (auto p : orphans) {
+			if (eye == p) {
+				continue;
+			}
+			for (std::size_t j = first_new; faces_.size() > j; ++j) {
+				if (eps_ < dist(faces_[j], p)) {
+					assign(j, p);
+					break;
+				}
+			}
+		}
+	}
+
+ private:
+	std::vector<Vec<3, T>> const&                  points_;
+	T                                              eps_;
+	std::vector<Face>                              faces_;
+	std::unordered_map<std::uint64_t, std::size_t> edges_;
+};
+
+/*!
+ * @brief Hull of points that do not span a volume, the (flat) bounding OBB as a
+ * polyhedron.
+ */
+template <class T>
+[[nodiscard]] ConvexPolyhedron<T> flatHull(std::vector<Vec<3, T>> const& points)
+{
+	ConvexPolyhedron<T> res;
+	if (points.empty()) {
+		return res;
+	}
+
+	auto const o = boundingOBB(points.begin(), points.end());
+	for (std::size_t i{}; 3 > i; ++i) {
+		auto const n = o.rotation[i];
+		T const    c = dot(n, o.center);
+		res.planes.emplace_back(n, -(c + o.half_length[i]));
+		res.planes.emplace_back(-n, c - o.half_length[i]);
+	}
+	for (int i{}; 8 > i; ++i) {
+		Vec<3, T> v = o.center;
+		for (std::size_t k{}; 3 > k; ++k) {
+			v += o.rotation[k] * (((i >> k) & 1) ? o.half_length[k] : -o.half_length[k]);
+		}
+		res.vertices.push_back(v);
+	}
+	return res;
+}
+}  // namespace detail
+
+/*!
+ * @brief Computes the convex hull of the points in [first, last) using Quickhull.
+ *
+ * Before running Quickhull, the points are culled against the hull of their extreme
+ * points in 13 directions (Akl-Toussaint). For dense clusters this removes almost all
+ * points, and it is the part that runs according to `policy`.
+ *
+ * Points that do not span a volume (coplanar, collinear or fewer than four) give their
+ * flat bounding OBB as a polyhedron with zero thickness.
+ */
+template <
+    class ExecutionPolicy, class RandomIt,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+[[nodiscard]] auto convexHull(ExecutionPolicy&& policy, RandomIt first, RandomIt last)
+{
+	using V = std::decay_t<decltype(*first)>;
+	using T = typename detail::vec_traits<V>::value_type;
+
+	static_assert(3 == detail::vec_traits<V>::dim,
+	              "Convex hull is only implemented in 3D.");
+
+	if (first == last) {
+		return ConvexPolyhedron<T>();
+	}
+
+	auto const bounds = boundingAABB(policy, first, last);
+	T          scale{};
+	for (std::size_t i{}; 3 > i; ++i) {
+		scale += std::max(std::abs(bounds.min[i]), std::abs(bounds.max[i]));
+	}
+	T const eps = T(3) * scale * std::numeric_limits<T>::epsilon();
+
+	// Akl-Toussaint culling
+
+	constexpr std::size_t num_dirs = 13;
+
+	std::array<Vec<3, T>, num_dirs> const dirs{
+	    Vec<3, T>(1, 0, 0),  Vec<3, T>(0, 1, 0),   Vec<3, T>(0, 0, 1),
+	    Vec<3, T>(1, 1, 0),  Vec<3, T>(1, -1, 0),  Vec<3, T>(1, 0, 1),
+	    Vec<3, T>(1, 0, -1), Vec<3, T>(0, 1, 1),   Vec<3, T>(0, 1, -1),
+	    Vec<3, T>(1, 1, 1),  Vec<3, T>(1, -1, 1),  Vec<3, T>(1, 1, -1),
+	    Vec<3, T>(1, -1, -1)};
+
+	using Extremes = std::array<std::pair<T, V>, 2 * num_dirs>;
+
+	Extremes init;
+	for (std::size_t i{}; num_dirs > i; ++i) {
+		init[2 * i]     = {std::numeric_limits<T>::max(), V()};
+		init[2 * i + 1] = {std::numeric_limits<T>::lowest(), V()};
+	}
+
+	Extremes const extremes = detail::chunkedReduce(
+	    policy, first, last, init,
+	    [](Extremes a, Extremes const& b) {
+		    for (std::size_t i{}; num_dirs > i; ++i) {
+			    if (b[2 * i].first < a[2 * i].first) {
+				    a[2 * i] = b[2 * i];
+			    }
+			    if (b[2 * i + 1].first > a[2 * i + 1].first) {
+				    a[2 * i + 1] = b[2 * i + 1];
+			    }
+		    }
+		    return a;
+	    },
+	    [&dirs, &init](RandomIt b, RandomIt e) {
+		    Extremes res = init;
+		    for (; b != e; ++b) {
+			    for (std::size_t i{}; num_dirs > i; ++i) {
+				    T const d = dot(dirs[i], *b);
+				    if (d < res[2 * i].first) {
+					    res[2 * i] = {d, *b};
+				    }
+				    if (d > res[2 * i + 1].first) {
+					    res[2 * i + 1] = {d, *b};
+				    }
+			    }
+		    }
+		    return res;
+	    });
+
+	std::vector<V> extreme_points;
+	for (auto const& [d, p] : extremes) {
+		extreme_points.push_back(p);
+	}
+
+	detail::QuickHull<T> inner_hull(extreme_points, eps);
+
+	std::vector<V> points;
+	if (inner_hull.build()) {
+		auto const inner = inner_hull.polyhedron();
+
+		// Keep points on or outside of the inner hull, with some margin
+		points.resize(static_cast<std::size_t>(std::distance(first, last)));
+		auto end = std::copy_if(policy, first, last, points.begin(),
+		                        [&inner, eps](V const& p) {
+			                        return -T(4) * eps <= inner.signedDistance(p);
+		                        });
+		points.erase(end, points.end());
+	} else {
+		points.assign(first, last);
+	}
+
+	detail::QuickHull<T> hull(points, eps);
+	if (!hull.build()) {
+		return detail::flatHull(points);
+	}
+	return hull.polyhedron();
+}
+
+/*!
+ * @brief Computes the convex hull of the points in [first, last) using Quickhull.
+ */
+template <
+    class RandomIt,
+    std::enable_if_t<!std::is_execution_policy_v<std::decay_t<RandomIt>>, bool> = true>
+[[nodiscard]] auto convexHull(RandomIt first, RandomIt last)
+{
+	return convexHull(std::execution::seq, first, last);
+}
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_CONVEX_HULL_HPP
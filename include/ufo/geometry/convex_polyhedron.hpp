@@ -0,0 +1,165 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_CONVEX_POLYHEDRON_HPP
+#define UFO_GEOMETRY_CONVEX_POLYHEDRON_HPP
+
+// UFO
+#include <ufo/geometry/plane.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief A convex polyhedron stored both as half-spaces and as vertices.
+ *
+ * The normals of the planes point outwards, so a point `x` is inside if
+ * `dot(normal, x) + distance <= 0` for all planes. The planes are used for containment
+ * and culling, the vertices for the support function and bounds.
+ *
+ * Use `convexHull` (in `convex_hull.hpp`) to build one from a point set.
+ */
+template <class T = float>
+struct ConvexPolyhedron {
+	static_assert(std::is_floating_point_v<T>, "T is required to be floating point.");
+
+	using value_type = T;
+
+	std::vector<Plane<T>>  planes;
+	std::vector<Vec<3, T>> vertices;
+
+	ConvexPolyhedron() = default;
+
+	ConvexPolyhedron(std::vector<Plane<T>> planes, std::vector<Vec<3, T>> vertices)
+	    : planes(std::move(planes)), vertices(std::move(vertices))
+	{
+	}
+
+	template <class U>
+	explicit ConvexPolyhedron(ConvexPolyhedron<U> const& other)
+	    : planes(other.planes.begin(), other.planes.end())
+	    , vertices(other.vertices.begin(), other.vertices.end())
+	{
+	}
+
+	[[nodiscard]] bool empty() const noexcept { return vertices.empty(); }
+
+	/*!
+	 * @brief The vertex furthest in `direction`.
+	 *
+	 * @note The polyhedron must not be empty.
+	 */
+	[[nodiscard]] Vec<3, T> support(Vec<3, T> const& direction) const
+	{
+		std::size_t best{};
+		T           best_dist = std::numeric_limits<T>::lowest();
+		for (std::size_t i{}; vertices.size() > i; ++i) {
+			T d = dot(vertices[i], direction);
+			if (d > best_dist) {
+				best_dist = d;
+				best      = i;
+			}
+		}
+		return vertices[best];
+	}
+
+	/*!
+	 * @brief The largest signed distance from `point` to any of the planes.
+	 *
+	 * Non-positive if `point` is inside. The planes are reduced without branches, so the
+	 * loop is vectorized.
+	 */
+	[[nodiscard]] T signedDistance(Vec<3, T> const& point) const noexcept
+	{
+		T res = std::numeric_limits<T>::lowest();
+		for (auto const& p : planes) {
+			T d = p.normal.x * point.x + p.normal.y * point.y + p.normal.z * point.z +
+			      p.distance;
+			res = res < d ? d : res;
+		}
+		return res;
+	}
+};
+
+/*!
+ * @brief Compare two ConvexPolyhedrons.
+ *
+ * @param lhs,rhs The ConvexPolyhedrons to compare
+ * @return `true` if they compare equal, `false` otherwise.
+ */
+template <class T>
+bool operator==(ConvexPolyhedron<T> const& lhs, ConvexPolyhedron<T> const& rhs)
+{
+	return lhs.planes == rhs.planes && lhs.vertices == rhs.vertices;
+}
+
+/*!
+ * @brief Compare two ConvexPolyhedrons.
+ *
+ * @param lhs,rhs The ConvexPolyhedrons to compare
+ * @return `true` if they do not compare equal, `false` otherwise.
+ */
+template <class T>
+bool operator!=(ConvexPolyhedron<T> const& lhs, ConvexPolyhedron<T> const& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& out, ConvexPolyhedron<T> const& polyhedron)
+{
+	return out << "Planes: " << polyhedron.planes.size()
+	           << ", Vertices: " << polyhedron.vertices.size();
+}
+
+using ConvexPolyhedronf = ConvexPolyhedron<float>;
+using ConvexPolyhedrond = ConvexPolyhedron<double>;
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_CONVEX_POLYHEDRON_HPP
@@ -43,46 +43,97 @@
 #define UFO_GEOMETRY_CYLINDER_HPP
 
 // UFO
-#include <ufo/geometry/point.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <cstddef>
+#include <ostream>
+#include <type_traits>
 
 namespace ufo
 {
+/*!
+ * @brief A capped cylinder, all points within `radius` of the axis from `start` to
+ * `end` whose projection onto the axis falls between `start` and `end`.
+ */
+template <std::size_t Dim = 3, class T = float>
 struct Cylinder {
-	Point start;
-	Point end;
-	float radius{};
+	static_assert(std::is_floating_point_v<T>, "T is required to be floating point.");
+
+	using value_type = T;
+
+	Vec<Dim, T> start;
+	Vec<Dim, T> end;
+	T           radius{};
 
 	constexpr Cylinder() noexcept = default;
 
-	constexpr Cylinder(Point start, Point end, float radius) noexcept
+	constexpr Cylinder(Vec<Dim, T> const& start, Vec<Dim, T> const& end, T radius) noexcept
 	    : start(start), end(end), radius(radius)
 	{
 	}
 
-	constexpr bool operator==(Cylinder const& rhs) const noexcept
-	{
-		return rhs.start == start && rhs.end == end && rhs.radius == radius;
-	}
+	constexpr Cylinder(Cylinder const&) noexcept = default;
 
-	constexpr bool operator!=(Cylinder const& rhs) const noexcept
+	template <class U>
+	constexpr explicit Cylinder(Cylinder<Dim, U> const& other) noexcept
+	    : start(other.start), end(other.end), radius(static_cast<T>(other.radius))
 	{
-		return !(*this == rhs);
 	}
+};
 
-	constexpr Point min() const noexcept
-	{
-		// FIXME: Make correct
-		return Point(std::min(start.x, end.x) - radius, std::min(start.y, end.y) - radius,
-		             std::min(start.z, end.z) - radius);
-	}
+//
+// Deduction guide
+//
 
-	constexpr Point max() const noexcept
-	{
-		// FIXME: Make correct
-		return Point(std::max(start.x, end.x) + radius, std::max(start.y, end.y) + radius,
-		             std::max(start.z, end.z) + radius);
-	}
-};
+template <std::size_t Dim, class T>
+Cylinder(Vec<Dim, T>, Vec<Dim, T>, T) -> Cylinder<Dim, T>;
+
+/*!
+ * @brief Compare two Cylinders.
+ *
+ * @param lhs,rhs The Cylinders to compare
+ * @return `true` if they compare equal, `false` otherwise.
+ */
+template <std::size_t Dim, class T>
+bool operator==(Cylinder<Dim, T> const& lhs, Cylinder<Dim, T> const& rhs)
+{
+	return lhs.start == rhs.start && lhs.end == rhs.end && lhs.radius == rhs.radius;
+}
+
+/*!
+ * @brief Compare two Cylinders.
+ *
+ * @param lhs,rhs The Cylinders to compare
+ * @return `true` if they do not compare equal, `false` otherwise.
+ */
+template <std::size_t Dim, class T>
+bool operator!=(Cylinder<Dim, T> const& lhs, Cylinder<Dim, T> const& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <std::size_t Dim, class T>
+std::ostream& operator<<(std::ostream& out, Cylinder<Dim, T> const& cylinder)
+{
+	return out << "Start: " << cylinder.start << ", End: " << cylinder.end
+	           << ", Radius: " << cylinder.radius;
+}
+
+template <class T>
+using Cylinder2 = Cylinder<2, T>;
+template <class T>
+using Cylinder3 = Cylinder<3, T>;
+template <class T>
+using Cylinder4 = Cylinder<4, T>;
+
+using Cylinder2f = Cylinder<2, float>;
+using Cylinder3f = Cylinder<3, float>;
+using Cylinder4f = Cylinder<4, float>;
+
+using Cylinder2d = Cylinder<2, double>;
+using Cylinder3d = Cylinder<3, double>;
+using Cylinder4d = Cylinder<4, double>;
 }  // namespace ufo
 
 #endif  // UFO_GEOMETRY_CYLINDER_HPP
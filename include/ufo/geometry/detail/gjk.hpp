@@ -0,0 +1,493 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_DETAIL_GJK_HPP
+#define UFO_GEOMETRY_DETAIL_GJK_HPP
+
+// UFO
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace ufo::detail
+{
+template <class T>
+struct GJKSimplex {
+	// Newest point first
+	Vec<3, T>   p[4];
+	std::size_t size{};
+
+	constexpr void pushFront(Vec<3, T> const& v) noexcept
+	{
+		for (std::size_t i = size; 0 < i; --i) {
+			p[i] = p[i - 1];
+		}
+		p[0] = v;
+		++size;
+	}
+
+	constexpr void set(Vec<3, T> const& a) noexcept
+	{
+		p[0] = a;
+		size = 1;
+	}
+
+	constexpr void set(Vec<3, T> const& a, Vec<3, T> const& b) noexcept
+	{
+		p[0] = a;
+		p[1] = b;
+		size = 2;
+	}
+
+	constexpr void set(Vec<3, T> const& a, Vec<3, T> const& b,
+	                   Vec<3, T> const& c) noexcept
+	{
+		p[0] = a;
+		p[1] = b;
+		p[2] = c;
+		size = 3;
+	}
+};
+
+template <class T>
+constexpr bool gjkLine(GJKSimplex<T>& s, Vec<3, T>& d) noexcept
+{
+	auto const a  = s.p[0];
+	auto const b  = s.p[1];
+	auto const ab = b - a;
+	auto const ao = -a;
+
+	if (T(0) < dot(ab, ao)) {
+		d = cross(cross(ab, ao), ab);
+	} else {
+		s.set(a);
+		d = ao;
+	}
+	return false;
+}
+
+template <class T>
+constexpr bool gjkTriangle(GJKSimplex<T>& s, Vec<3, T>& d) noexcept
+{
+	auto const a   = s.p[0];
+	auto const b   = s.p[1];
+	auto const c   = s.p[2];
+	auto const ab  = b - a;
+	auto const ac  = c - a;
+	auto const ao  = -a;
+	auto const abc = cross(ab, ac);
+
+	if (T(0) < dot(cross(abc, ac), ao)) {
+		if (T(0) < dot(ac, ao)) {
+			s.set(a, c);
+			d = cross(cross(ac, ao), ac);
+			return false;
+		}
+		s.set(a, b);
+		return gjkLine(s, d);
+	}
+
+	if (T(0) < dot(cross(ab, abc), ao)) {
+		s.set(a, b);
+		return gjkLine(s, d);
+	}
+
+	if (T(0) < dot(abc, ao)) {
+		d = abc;
+	} else {
+		s.set(a, c, b);
+		d = -abc;
+	}
+	return false;
+}
+
+template <class T>
+constexpr bool gjkTetrahedron(GJKSimplex<T>& s, Vec<3, T>& d) noexcept
+{
+	auto const a   = s.p[0];
+	auto const b   = s.p[1];
+	auto const c   = s.p[2];
+	auto const e   = s.p[3];
+	auto const ab  = b - a;
+	auto const ac  = c - a;
+	auto const ae  = e - a;
+	auto const ao  = -a;
+	auto const abc = cross(ab, ac);
+	auto const ace = cross(ac, ae);
+	auto const aeb = cross(ae, ab);
+
+	if (T(0) < dot(abc, ao)) {
+		s.set(a, b, c);
+		return gjkTriangle(s, d);
+	}
+	if (T(0) < dot(ace, ao)) {
+		s.set(a, c, e);
+		return gjkTriangle(s, d);
+	}
+	if (T(0) < dot(aeb, ao)) {
+		s.set(a, e, b);
+		return gjkTriangle(s, d);
+	}
+	return true;
+}
+
+/*!
+ * @brief Boolean Gilbert-Johnson-Keerthi test, `true` if the convex sets with support
+ * functions `support_a` and `support_b` overlap.
+ *
+ * A support function maps a direction to the point of the set furthest in that
+ * direction. Touching sets are reported as overlapping. If the iteration limit is hit,
+ * which only happens for (numerically) touching sets, `true` is returned.
+ *
+ * @param initial Initial search direction, e.g., from the center of `b` to `a`.
+ */
+template <class T, class SupportA, class SupportB>
+[[nodiscard]] constexpr bool gjk(SupportA support_a, SupportB support_b,
+                                 Vec<3, T> initial)
+{
+	constexpr int max_iterations = 64;
+
+	if (T(0) == dot(initial, initial)) {
+		initial = Vec<3, T>(T(1), T(0), T(0));
+	}
+
+	GJKSimplex<T> s;
+	s.pushFront(support_a(initial) - support_b(-initial));
+	Vec<3, T> d = -s.p[0];
+
+	for (int i{}; max_iterations > i; ++i) {
+		if (T(0) == dot(d, d)) {
+			// The origin is on the simplex
+			return true;
+		}
+
+		auto const a = support_a(d) - support_b(-d);
+		if (T(0) > dot(a, d)) {
+			return false;
+		}
+		s.pushFront(a);
+
+		bool contains{};
+		switch (s.size) {
+			case 2: contains = gjkLine(s, d); break;
+			case 3: contains = gjkTriangle(s, d); break;
+			default: contains = gjkTetrahedron(s, d); break;
+		}
+		if (contains) {
+			return true;
+		}
+	}
+	return true;
+}
+
+template <class T>
+struct GJKDistance {
+	Vec<3, T> point_a;
+	Vec<3, T> point_b;
+	T         distance_squared{};
+};
+
+template <class T>
+struct GJKVertex {
+	Vec<3, T> w;  // a - b
+	Vec<3, T> a;
+	Vec<3, T> b;
+};
+
+// Barycentric sub-simplex of the simplex closest to the origin
+template <class T>
+struct GJKSubset {
+	std::size_t idx[4];
+	T           lambda[4];
+	std::size_t size{};
+};
+
+template <class T>
+constexpr GJKSubset<T> gjkClosestSegment(GJKVertex<T> const* v, std::size_t i,
+                                         std::size_t j) noexcept
+{
+	auto const ab = v[j].w - v[i].w;
+	T const    t  = -dot(v[i].w, ab);
+	T const    l  = dot(ab, ab);
+	if (T(0) >= t) {
+		return {{i}, {T(1)}, 1};
+	}
+	if (t >= l) {
+		return {{j}, {T(1)}, 1};
+	}
+	return {{i, j}, {T(1) - t / l, t / l}, 2};
+}
+
+// Ericson, Real-Time Collision Detection, 5.1.5, with the query point at the origin
+template <class T>
+constexpr GJKSubset<T> gjkClosestTriangle(GJKVertex<T> const* v, std::size_t i,
+                                          std::size_t j, std::size_t k) noexcept
+{
+	auto const a  = v[i].w;
+	auto const ab = v[j].w - a;
+	auto const ac = v[k].w - a;
+
+	T const d1 = -dot(ab, a);
+	T const d2 = -dot(ac, a);
+	if (T(0) >= d1 && T(0) >= d2) {
+		return {{i}, {T(1)}, 1};
+	}
+
+	T const d3 = -dot(ab, v[j].w);
+	T const d4 = -dot(ac, v[j].w);
+	if (T(0) <= d3 && d4 <= d3) {
+		return {{j}, {T(1)}, 1};
+	}
+
+	T const vc = d1 * d4 - d3 * d2;
+	if (T(0) >= vc && T(0) <= d1 && T(0) >= d3) {
+		T const t = d1 / (d1 - d3);
+		return {{i, j}, {T(1) - t, t}, 2};
+	}
+
+	T const d5 = -dot(ab, v[k].w);
+	T const d6 = -dot(ac, v[k].w);
+	if (T(0) <= d6 && d5 <= d6) {
+		return {{k}, {T(1)}, 1};
+	}
+
+	T const vb = d5 * d2 - d1 * d6;
+	if (T(0) >= vb && T(0) <= d2 && T(0) >= d6) {
+		T const t = d2 / (d2 - d6);
+		return {{i, k}, {T(1) - t, t}, 2};
+	}
+
+	T const va = d3 * d6 - d5 * d4;
+	if (T(0) >= va && T(0) <= d4 - d3 && T(0) <= d5 - d6) {
+		T const t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		return {{j, k}, {T(1) - t, t}, 2};
+	}
+
+	T const denom = T(1) / (va + vb + vc);
+	T const s     = vb * denom;
+	T const t     = vc * denom;
+	return {{i, j, k}, {T(1) - s - t, s, t}, 3};
+}
+
+template <class T>
+constexpr Vec<3, T> gjkPoint(GJKVertex<T> const* v, GJKSubset<T> const& s) noexcept
+{
+	Vec<3, T> res = v[s.idx[0]].w * s.lambda[0];
+	for (std::size_t i = 1; s.size > i; ++i) {
+		res += v[s.idx[i]].w * s.lambda[i];
+	}
+	return res;
+}
+
+template <class T>
+constexpr GJKSubset<T> gjkClosestTetrahedron(GJKVertex<T> const* v) noexcept
+{
+	constexpr T eps = T(128) * std::numeric_limits<T>::epsilon();
+
+	// Each face followed by the opposite vertex
+	constexpr std::size_t face[4][4] = {
+	    {0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}};
+
+	GJKSubset<T> best;
+	T            best_dist = std::numeric_limits<T>::infinity();
+	bool         outside{};
+	for (auto const& f : face) {
+		auto const a = v[f[0]].w;
+		auto const e = v[f[3]].w - a;
+		auto const n = cross(v[f[1]].w - a, v[f[2]].w - a);
+		T const    o = -dot(a, n);
+		T const    d = dot(e, n);
+		// A (numerically) flat tetrahedron has no inside, so every face is a candidate
+		bool const flat = d * d <= eps * eps * dot(n, n) * dot(e, e);
+		if (!flat && T(0) <= o * d) {
+			continue;
+		}
+		outside      = true;
+		auto const s = gjkClosestTriangle(v, f[0], f[1], f[2]);
+		auto const p = gjkPoint(v, s);
+		T const    l = dot(p, p);
+		if (best_dist > l) {
+			best_dist = l;
+			best      = s;
+		}
+	}
+
+	if (outside) {
+		return best;
+	}
+
+	// The origin is inside, barycentric coordinates by Cramer's rule
+	auto const a  = v[0].w;
+	auto const ab = v[1].w - a;
+	auto const ac = v[2].w - a;
+	auto const ad = v[3].w - a;
+	T const    iv = T(1) / dot(ab, cross(ac, ad));
+	T const    l1 = -dot(a, cross(ac, ad)) * iv;
+	T const    l2 = -dot(ab, cross(a, ad)) * iv;
+	T const    l3 = -dot(ab, cross(ac, a)) * iv;
+	return {{0, 1, 2, 3}, {T(1) - l1 - l2 - l3, l1, l2, l3}, 4};
+}
+
+/*!
+ * @brief Gilbert-Johnson-Keerthi distance between the convex sets with support functions
+ * `support_a` and `support_b`, together with the closest point on each.
+ *
+ * Overlapping sets have a distance of zero, in which case the two points coincide at a
+ * point of the overlap.
+ *
+ * With a finite `max_squared` the iteration stops as soon as it is decided whether the
+ * squared distance is at most `max_squared`. The returned squared distance is then only
+ * guaranteed to be on the same side of `max_squared` as the exact one.
+ *
+ * @param initial Initial search direction, e.g., from the center of `b` to `a`.
+ * @param max_squared Squared distance to decide against.
+ */
+template <class T, class SupportA, class SupportB>
+[[nodiscard]] constexpr GJKDistance<T> gjkDistance(
+    SupportA support_a, SupportB support_b, Vec<3, T> initial,
+    T max_squared = std::numeric_limits<T>::infinity())
+{
+	constexpr int max_iterations = 64;
+	constexpr T   eps            = T(128) * std::numeric_limits<T>::epsilon();
+	// Curved sets are only approached asymptotically, so stop on relative progress
+	T const rel = std::sqrt(std::numeric_limits<T>::epsilon());
+
+	if (T(0) == dot(initial, initial)) {
+		initial = Vec<3, T>(T(1), T(0), T(0));
+	}
+
+	GJKVertex<T> v[4];
+	v[0].a = support_a(initial);
+	v[0].b = support_b(-initial);
+	v[0].w = v[0].a - v[0].b;
+
+	GJKSubset<T> s{{0}, {T(1)}, 1};
+	Vec<3, T>    p = v[0].w;
+
+	bool const decide = std::numeric_limits<T>::infinity() != max_squared;
+
+	bool overlap{};
+	for (int it{}; max_iterations > it; ++it) {
+		T const pp = dot(p, p);
+		T       ww{};
+		for (std::size_t i{}; s.size > i; ++i) {
+			ww = std::max(ww, dot(v[s.idx[i]].w, v[s.idx[i]].w));
+		}
+		if (pp <= eps * eps * ww) {
+			overlap = true;
+			break;
+		}
+		// `p` is a point of the difference, so its length is an upper bound
+		if (decide && pp <= max_squared) {
+			break;
+		}
+
+		GJKVertex<T> n;
+		n.a = support_a(-p);
+		n.b = support_b(p);
+		n.w = n.a - n.b;
+
+		T const pw = dot(p, n.w);
+		// The difference is on the far side of the plane through `n.w` orthogonal to `p`,
+		// so its distance to the origin is a lower bound
+		if (decide && T(0) < pw && pw * pw > max_squared * pp) {
+			break;
+		}
+		if (pp - pw <= rel * pp) {
+			break;
+		}
+		bool duplicate{};
+		for (std::size_t i{}; s.size > i; ++i) {
+			duplicate = duplicate || n.w == v[s.idx[i]].w;
+		}
+		if (duplicate) {
+			break;
+		}
+
+		// Compact the simplex to the current subset and add the new vertex
+		GJKVertex<T> tmp[4];
+		for (std::size_t i{}; s.size > i; ++i) {
+			tmp[i] = v[s.idx[i]];
+		}
+		tmp[s.size] = n;
+
+		std::size_t const size = s.size + 1;
+		for (std::size_t i{}; size > i; ++i) {
+			v[i] = tmp[i];
+		}
+
+		switch (size) {
+			case 2: s = gjkClosestSegment(v, 0, 1); break;
+			case 3: s = gjkClosestTriangle(v, 0, 1, 2); break;
+			default: s = gjkClosestTetrahedron(v); break;
+		}
+
+		if (4 == s.size) {
+			overlap = true;
+			break;
+		}
+		p = gjkPoint(v, s);
+	}
+
+	// When overlapping, the barycentric combination of the origin gives the same point of
+	// the intersection on both sets
+	GJKDistance<T> res;
+	res.point_a = v[s.idx[0]].a * s.lambda[0];
+	res.point_b = v[s.idx[0]].b * s.lambda[0];
+	for (std::size_t i = 1; s.size > i; ++i) {
+		res.point_a += v[s.idx[i]].a * s.lambda[i];
+		res.point_b += v[s.idx[i]].b * s.lambda[i];
+	}
+	if (overlap) {
+		res.point_b          = res.point_a;
+		res.distance_squared = T(0);
+		return res;
+	}
+	res.distance_squared = dot(p, p);
+	return res;
+}
+}  // namespace ufo::detail
+
+#endif  // UFO_GEOMETRY_DETAIL_GJK_HPP
@@ -44,6 +44,7 @@
 
 // UFO
 #include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/aabc.hpp>
 #include <ufo/geometry/fun.hpp>
 #include <ufo/geometry/line_segment.hpp>
 #include <ufo/geometry/obb.hpp>
@@ -93,35 +94,35 @@ template <std::size_t Dim, class T>
 	return true;
 }
 
-// constexpr bool intersectsLine(AABC aabc, Ray const& ray, float t_near,
-//                               float t_far) noexcept
-// {
-// 	Point min = aabc.min();
-// 	Point max = aabc.max();
-
-// 	for (std::size_t i{}; 3 > i; ++i) {
-// 		if (0 != ray.direction[i]) {
-// 			float reciprocal_direction = 1.0f / ray.direction[i];
-// 			float t1                   = (min[i] - ray.origin[i]) * reciprocal_direction;
-// 			float t2                   = (max[i] - ray.origin[i]) * reciprocal_direction;
-
-// 			if (t1 < t2) {
-// 				t_near = std::max(t1, t_near);
-// 				t_far  = std::min(t2, t_far);
-// 			} else {
-// 				t_near = std::max(t2, t_near);
-// 				t_far  = std::min(t1, t_far);
-// 			}
-
-// 			if (t_near > t_far) {
-// 				return false;
-// 			}
-// 		} else if (min[i] > ray.origin[i] || max[i] < ray.origin[i]) {
-// 			return false;
-// 		}
-// 	}
-// 	return true;
-// }
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersectsLine(AABC<Dim, T> const& aabc,
+                                            Ray<Dim, T> const& ray, T t_near,
+                                            T t_far) noexcept
+{
+	for (std::size_t i{}; Dim > i; ++i) {
+		T o = ray.origin[i] - aabc.center[i];
+		if (T(0) != ray.direction[i]) {
+			T reciprocal_direction = T(1) / ray.direction[i];
+			T t1                   = (-aabc.half_length - o) * reciprocal_direction;
+			T t2                   = (aabc.half_length - o) * reciprocal_direction;
+
+			if (t1 < t2) {
+				t_near = std::max(t1, t_near);
+				t_far  = std::min(t2, t_far);
+			} else {
+				t_near = std::max(t2, t_near);
+				t_far  = std::min(t1, t_far);
+			}
+
+			if (t_near > t_far) {
+				return false;
+			}
+		} else if (aabc.half_length < std::abs(o)) {
+			return false;
+		}
+	}
+	return true;
+}
 
 //
 // Classify
@@ -144,19 +145,19 @@ template <class T>
 	return d - r;
 }
 
-// constexpr float classify(AABC aabc, Plane const& plane) noexcept
-// {
-// 	float r = std::abs(aabc.half_size * plane.normal.x) +
-// 	          std::abs(aabc.half_size * plane.normal.y) +
-// 	          std::abs(aabc.half_size * plane.normal.z);
-// 	float d = Point::dot(plane.normal, aabc.center) + plane.distance;
-// 	if (std::abs(d) < r) {
-// 		return 0;
-// 	} else if (d < 0) {
-// 		return d + r;
-// 	}
-// 	return d - r;
-// }
+template <class T>
+[[nodiscard]] constexpr T classify(AABC<3, T> const& aabc, Plane<T> const& plane) noexcept
+{
+	T r = aabc.half_length *
+	      (std::abs(plane.normal.x) + std::abs(plane.normal.y) + std::abs(plane.normal.z));
+	T d = ufo::dot(plane.normal, aabc.center) + plane.distance;
+	if (std::abs(d) < r) {
+		return T(0);
+	} else if (T(0) > d) {
+		return d + r;
+	}
+	return d - r;
+}
 
 // constexpr float classify(OBB const& obb, Plane const& plane) noexcept
 // {
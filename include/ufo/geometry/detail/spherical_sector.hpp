@@ -0,0 +1,249 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_DETAIL_SPHERICAL_SECTOR_HPP
+#define UFO_GEOMETRY_DETAIL_SPHERICAL_SECTOR_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/spherical_sector.hpp>
+#include <ufo/math/mat.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace ufo::detail
+{
+/*!
+ * @brief Point and box tests against a `SphericalSector` with the trigonometry done
+ * once, for testing many points or octree nodes.
+ *
+ * An elevation bound `e` is kept as `(cos(e), sin(e))`, since `z * cos(e) - rho *
+ * sin(e)` has the sign of the elevation minus `e` at height `z` and distance `rho` from
+ * the z-axis. The azimuth interval is kept as its middle direction and the cosine of
+ * half its span. Boxes are tested in the sensor frame, by the smallest box there
+ * enclosing them, so the box tests are exact when the sensor axes are aligned with the
+ * world axes and conservative otherwise.
+ */
+template <class T>
+struct SphericalSectorTest {
+	Vec<3, T>    origin;
+	Mat<3, 3, T> rotation;
+	T            min_range_sq;
+	T            max_range_sq;
+	Vec<2, T>    min_elevation;
+	Vec<2, T>    max_elevation;
+	Vec<2, T>    middle;
+	T            cos_half;
+	Vec<2, T>    start;
+	Vec<2, T>    end;
+
+	explicit SphericalSectorTest(SphericalSector<T> const& a)
+	    : origin(a.origin)
+	    , rotation(a.rotation)
+	    , min_range_sq(a.min_range * a.min_range)
+	    , max_range_sq(a.max_range * a.max_range)
+	    , middle(direction((a.min_azimuth + a.max_azimuth) / 2))
+	    , cos_half(a.fullAzimuth() ? T(-1) : std::cos((a.max_azimuth - a.min_azimuth) / 2))
+	    , start(direction(a.min_azimuth))
+	    , end(direction(a.max_azimuth))
+	{
+		// Exact at the poles, where the cosine would otherwise exclude the z-axis
+		T const quarter = SphericalSector<T>::FULL_TURN / 4;
+		min_elevation =
+		    -quarter < a.min_elevation ? direction(a.min_elevation) : Vec<2, T>(0, -1);
+		max_elevation =
+		    quarter > a.max_elevation ? direction(a.max_elevation) : Vec<2, T>(0, 1);
+	}
+
+	[[nodiscard]] constexpr Vec<3, T> toLocal(Vec<3, T> const& p) const
+	{
+		auto const v = p - origin;
+		return Vec<3, T>(dot(rotation[0], v), dot(rotation[1], v), dot(rotation[2], v));
+	}
+
+	[[nodiscard]] constexpr AABB<3, T> toLocal(AABB<3, T> const& a) const
+	{
+		auto const c = toLocal((a.min + a.max) / T(2));
+		auto const h = (a.max - a.min) / T(2);
+		Vec<3, T>  e;
+		for (std::size_t i{}; 3 > i; ++i) {
+			e[i] = dot(abs(rotation[i]), h);
+		}
+		return AABB<3, T>(c - e, c + e);
+	}
+
+	[[nodiscard]] bool contains(Vec<3, T> const& p) const
+	{
+		auto const l    = toLocal(p);
+		T const    r_sq = dot(l, l);
+		if (min_range_sq > r_sq || max_range_sq < r_sq) {
+			return false;
+		}
+
+		Vec<2, T> const q(l.x, l.y);
+		T const         rho = norm(q);
+		return T(0) <= l.z * min_elevation[0] - rho * min_elevation[1] &&
+		       T(0) >= l.z * max_elevation[0] - rho * max_elevation[1] &&
+		       inWedge(q, rho, middle, cos_half);
+	}
+
+	[[nodiscard]] bool intersects(Vec<3, T> const& p) const { return contains(p); }
+
+	/*!
+	 * @brief Checks if any point of `a` can be in the sector.
+	 *
+	 * The range, elevation, and azimuth intervals are tested one at a time, so boxes
+	 * close to the corners of the sector may be reported even though they are outside.
+	 * A box that intersects the sector is never missed.
+	 */
+	[[nodiscard]] bool intersects(AABB<3, T> const& a) const
+	{
+		auto const b    = toLocal(a);
+		auto const near = clamp(Vec<3, T>(), b.min, b.max);
+		auto const far  = max(abs(b.min), abs(b.max));
+		if (max_range_sq < dot(near, near) || min_range_sq > dot(far, far)) {
+			return false;
+		}
+
+		// Highest elevation in the box against the lower bound, and lowest against upper
+		T const rho_min = norm(Vec<2, T>(near.x, near.y));
+		T const rho_max = norm(Vec<2, T>(far.x, far.y));
+		T const s0      = min_elevation[1];
+		T const s1      = max_elevation[1];
+		if (T(0) > b.max.z * min_elevation[0] - (T(0) <= s0 ? rho_min : rho_max) * s0 ||
+		    T(0) < b.min.z * max_elevation[0] - (T(0) <= s1 ? rho_max : rho_min) * s1) {
+			return false;
+		}
+
+		return intersectsWedge(Vec<2, T>(b.min.x, b.min.y), Vec<2, T>(b.max.x, b.max.y),
+		                       middle, cos_half);
+	}
+
+	/*!
+	 * @brief Checks if all points of `a` are in the sector.
+	 *
+	 * Exact when the sensor axes are aligned with the world axes. Otherwise `a` is
+	 * replaced by a larger box, so some contained boxes are not reported.
+	 */
+	[[nodiscard]] bool contains(AABB<3, T> const& a) const
+	{
+		auto const b    = toLocal(a);
+		auto const near = clamp(Vec<3, T>(), b.min, b.max);
+		auto const far  = max(abs(b.min), abs(b.max));
+		if (min_range_sq > dot(near, near) || max_range_sq < dot(far, far)) {
+			return false;
+		}
+
+		// Lowest elevation in the box against the lower bound, and highest against upper
+		T const rho_min = norm(Vec<2, T>(near.x, near.y));
+		T const rho_max = norm(Vec<2, T>(far.x, far.y));
+		T const s0      = min_elevation[1];
+		T const s1      = max_elevation[1];
+		if (T(0) > b.min.z * min_elevation[0] - (T(0) <= s0 ? rho_max : rho_min) * s0 ||
+		    T(0) < b.max.z * max_elevation[0] - (T(0) <= s1 ? rho_min : rho_max) * s1) {
+			return false;
+		}
+
+		// Inside the wedge if it does not touch the wedge of the remaining directions
+		return T(-1) >= cos_half ||
+		       !intersectsWedge(Vec<2, T>(b.min.x, b.min.y), Vec<2, T>(b.max.x, b.max.y),
+		                        -middle, -cos_half);
+	}
+
+ private:
+	[[nodiscard]] static Vec<2, T> direction(T angle)
+	{
+		return Vec<2, T>(std::cos(angle), std::sin(angle));
+	}
+
+	[[nodiscard]] static bool inWedge(Vec<2, T> const& q, T length, Vec<2, T> const& mid,
+	                                  T cos_half)
+	{
+		return dot(q, mid) >= length * cos_half;
+	}
+
+	/*!
+	 * @brief Checks if the rectangle [lo, hi] intersects the wedge of directions within
+	 * the angle with cosine `cos_half` of `mid`, bounded by the rays along `start` and
+	 * `end`.
+	 *
+	 * A convex wedge intersects the rectangle if it contains a corner or one of its rays
+	 * hits the rectangle. The directions outside a reflex wedge form a convex wedge, which
+	 * holds the whole rectangle unless a corner is in the reflex wedge.
+	 */
+	[[nodiscard]] bool intersectsWedge(Vec<2, T> const& lo, Vec<2, T> const& hi,
+	                                   Vec<2, T> const& mid, T cos_half) const
+	{
+		for (Vec<2, T> q : {lo, Vec<2, T>(hi.x, lo.y), Vec<2, T>(lo.x, hi.y), hi}) {
+			if (inWedge(q, norm(q), mid, cos_half)) {
+				return true;
+			}
+		}
+		return T(0) <= cos_half && (hitsRay(start, lo, hi) || hitsRay(end, lo, hi));
+	}
+
+	[[nodiscard]] static constexpr bool hitsRay(Vec<2, T> const& dir, Vec<2, T> const& lo,
+	                                            Vec<2, T> const& hi)
+	{
+		T t_min{};
+		T t_max = std::numeric_limits<T>::max();
+		for (std::size_t i{}; 2 > i; ++i) {
+			if (T(0) == dir[i]) {
+				if (T(0) < lo[i] || T(0) > hi[i]) {
+					return false;
+				}
+				continue;
+			}
+			T const t1 = lo[i] / dir[i];
+			T const t2 = hi[i] / dir[i];
+			t_min      = std::max(t_min, std::min(t1, t2));
+			t_max      = std::min(t_max, std::max(t1, t2));
+		}
+		return t_min <= t_max;
+	}
+};
+}  // namespace ufo::detail
+
+#endif  // UFO_GEOMETRY_DETAIL_SPHERICAL_SECTOR_HPP
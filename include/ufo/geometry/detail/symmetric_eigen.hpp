@@ -0,0 +1,142 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_DETAIL_SYMMETRIC_EIGEN_HPP
+#define UFO_GEOMETRY_DETAIL_SYMMETRIC_EIGEN_HPP
+
+// UFO
+#include <ufo/math/mat.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+namespace ufo::detail
+{
+/*!
+ * @brief Eigen decomposition of a symmetric matrix using cyclic Jacobi rotations.
+ *
+ * @param a A symmetric matrix.
+ * @param[out] values The eigenvalues, in decreasing order.
+ * @param[out] vectors The eigenvectors, `vectors[i]` (column `i`) belongs to `values[i]`.
+ */
+template <std::size_t Dim, class T>
+void symmetricEigen(Mat<Dim, Dim, T> a, Vec<Dim, T>& values, Mat<Dim, Dim, T>& vectors)
+{
+	for (std::size_t i{}; Dim > i; ++i) {
+		for (std::size_t j{}; Dim > j; ++j) {
+			vectors[i][j] = i == j ? T(1) : T(0);
+		}
+	}
+
+	for (int sweep{}; 50 > sweep; ++sweep) {
+		T off{};
+		T diag{};
+		for (std::size_t p{}; Dim > p; ++p) {
+			diag += a[p][p] * a[p][p];
+			for (std::size_t q = p + 1; Dim > q; ++q) {
+				off += a[q][p] * a[q][p];
+			}
+		}
+		if (std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon() * diag >=
+		    off) {
+			break;
+		}
+
+		for (std::size_t p{}; Dim > p; ++p) {
+			for (std::size_t q = p + 1; Dim > q; ++q) {
+				T apq = a[q][p];
+				if (T(0) == apq) {
+					continue;
+				}
+
+				T theta = (a[q][q] - a[p][p]) / (T(2) * apq);
+				T t     = (T(0) <= theta ? T(1) : T(-1)) /
+				      (std::abs(theta) + std::sqrt(theta * theta + T(1)));
+				T c = T(1) / std::sqrt(t * t + T(1));
+				T s = t * c;
+
+				for (std::size_t k{}; Dim > k; ++k) {
+					T akp   = a[p][k];
+					T akq   = a[q][k];
+					a[p][k] = c * akp - s * akq;
+					a[q][k] = s * akp + c * akq;
+				}
+				for (std::size_t k{}; Dim > k; ++k) {
+					T apk   = a[k][p];
+					T aqk   = a[k][q];
+					a[k][p] = c * apk - s * aqk;
+					a[k][q] = s * apk + c * aqk;
+				}
+				for (std::size_t k{}; Dim > k; ++k) {
+					T vkp         = vectors[p][k];
+					T vkq         = vectors[q][k];
+					vectors[p][k] = c * vkp - s * vkq;
+					vectors[q][k] = s * vkp + c * vkq;
+				}
+			}
+		}
+	}
+
+	for (std::size_t i{}; Dim > i; ++i) {
+		values[i] = a[i][i];
+	}
+
+	// Selection sort, Dim is small
+	for (std::size_t i{}; Dim > i; ++i) {
+		std::size_t m = i;
+		for (std::size_t j = i + 1; Dim > j; ++j) {
+			if (values[j] > values[m]) {
+				m = j;
+			}
+		}
+		if (m != i) {
+			std::swap(values[i], values[m]);
+			std::swap(vectors[i], vectors[m]);
+		}
+	}
+}
+}  // namespace ufo::detail
+
+#endif  // UFO_GEOMETRY_DETAIL_SYMMETRIC_EIGEN_HPP
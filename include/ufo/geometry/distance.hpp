@@ -44,21 +44,63 @@
 
 // UFO
 #include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/aabc.hpp>
+#include <ufo/geometry/cone.hpp>
+#include <ufo/geometry/cylinder.hpp>
+#include <ufo/geometry/detail/gjk.hpp>
 #include <ufo/geometry/frustum.hpp>
+#include <ufo/geometry/fun.hpp>
 #include <ufo/geometry/line.hpp>
 #include <ufo/geometry/line_segment.hpp>
 #include <ufo/geometry/obb.hpp>
 #include <ufo/geometry/plane.hpp>
 #include <ufo/geometry/ray.hpp>
 #include <ufo/geometry/sphere.hpp>
+#include <ufo/geometry/support.hpp>
 #include <ufo/geometry/triangle.hpp>
+#include <ufo/geometry/type_traits.hpp>
 #include <ufo/math/vec.hpp>
 
 // STL
+#include <algorithm>
 #include <cmath>
+#include <execution>
+#include <type_traits>
+#include <utility>
 
 namespace ufo
 {
+namespace detail
+{
+/*!
+ * @brief Squared distance between two convex geometries with `support` functions.
+ */
+template <class A, class B, class T>
+[[nodiscard]] constexpr T convexDistanceSquared(A const& a, B const& b, Vec<3, T> initial)
+{
+	return gjkDistance<T>([&a](Vec<3, T> const& d) { return support(a, d); },
+	                      [&b](Vec<3, T> const& d) { return support(b, d); }, initial)
+	    .distance_squared;
+}
+
+/*!
+ * @brief The part of `ray` that can hold the closest point to a geometry inside the
+ * sphere with `center` and `radius`.
+ */
+template <class T>
+[[nodiscard]] constexpr LineSegment<3, T> clipRay(Ray<3, T> const& ray,
+                                                  Vec<3, T> const& center, T radius)
+{
+	auto const e  = center - ray.origin;
+	T const    tc = dot(e, ray.direction);
+	T const    d  = norm(e - ray.direction * tc);
+	// Past this the ray is further from the sphere than any point on it is from the
+	// geometry
+	T const length = std::max(T(0), tc) + d + T(2) * radius;
+	return LineSegment<3, T>(ray.origin, ray.origin + ray.direction * length);
+}
+}  // namespace detail
+
 /**************************************************************************************
 |                                                                                     |
 |                                        AABB                                         |
@@ -192,6 +234,114 @@ template <std::size_t Dim, class T>
 	return std::sqrt(distanceSquared(a, b));
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distanceSquared(AABB<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	return distanceSquared(b, a);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distance(AABB<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	return distance(b, a);
+}
+
+template <class T>
+[[nodiscard]] constexpr T distanceSquared(AABB<3, T> const& a, Cylinder<3, T> const& b)
+{
+	return distanceSquared(b, a);
+}
+
+template <class T>
+[[nodiscard]] constexpr T distance(AABB<3, T> const& a, Cylinder<3, T> const& b)
+{
+	return distance(b, a);
+}
+
+template <class T>
+[[nodiscard]] constexpr T distanceSquared(AABB<3, T> const& a, Cone<3, T> const& b)
+{
+	return distanceSquared(b, a);
+}
+
+template <class T>
+[[nodiscard]] constexpr T distance(AABB<3, T> const& a, Cone<3, T> const& b)
+{
+	return distance(b, a);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        AABC                                         |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distanceSquared(AABC<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	T const hl = a.half_length + b.half_length;
+	T       result{};
+	for (std::size_t i{}; Dim > i; ++i) {
+		T delta = std::fdim(std::abs(a.center[i] - b.center[i]), hl);
+		result += delta * delta;
+	}
+	return result;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distance(AABC<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	return std::sqrt(distanceSquared(a, b));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distanceSquared(AABC<Dim, T> const& a, AABB<Dim, T> const& b)
+{
+	T result{};
+	for (std::size_t i{}; Dim > i; ++i) {
+		T delta = std::fdim(a.center[i] - a.half_length, b.max[i]) +
+		          std::fdim(b.min[i], a.center[i] + a.half_length);
+		result += delta * delta;
+	}
+	return result;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distance(AABC<Dim, T> const& a, AABB<Dim, T> const& b)
+{
+	return std::sqrt(distanceSquared(a, b));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distanceSquared(AABC<Dim, T> const& a, Sphere<Dim, T> const& b)
+{
+	auto dist = distance(a, b);
+	return dist * dist;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distance(AABC<Dim, T> const& a, Sphere<Dim, T> const& b)
+{
+	return std::fdim(distance(a, b.center), b.radius);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distanceSquared(AABC<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	T result{};
+	for (std::size_t i{}; Dim > i; ++i) {
+		T delta = std::fdim(std::abs(b[i] - a.center[i]), a.half_length);
+		result += delta * delta;
+	}
+	return result;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distance(AABC<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	return std::sqrt(distanceSquared(a, b));
+}
+
 /**************************************************************************************
 |                                                                                     |
 |                                       Sphere                                        |
@@ -210,6 +360,18 @@ template <std::size_t Dim, class T>
 	return distance(b, a);
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distanceSquared(Sphere<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	return distanceSquared(b, a);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distance(Sphere<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	return distance(b, a);
+}
+
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr T distanceSquared(Sphere<Dim, T> const& a,
                                           Sphere<Dim, T> const& b)
@@ -315,6 +477,31 @@ template <std::size_t Dim, class T>
 	return std::fdim(distance(a.center, b), a.radius);
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distanceSquared(Sphere<Dim, T> const& a,
+                                          Cylinder<Dim, T> const& b)
+{
+	return distanceSquared(b, a);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distance(Sphere<Dim, T> const& a, Cylinder<Dim, T> const& b)
+{
+	return distance(b, a);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distanceSquared(Sphere<Dim, T> const& a, Cone<Dim, T> const& b)
+{
+	return distanceSquared(b, a);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distance(Sphere<Dim, T> const& a, Cone<Dim, T> const& b)
+{
+	return distance(b, a);
+}
+
 /**************************************************************************************
 |                                                                                     |
 |                                       Frustum                                       |
@@ -935,6 +1122,30 @@ template <class T>
 // 	// TODO: Implement
 // }
 
+template <class T>
+[[nodiscard]] constexpr T distanceSquared(Ray<3, T> const& a, Cylinder<3, T> const& b)
+{
+	return distanceSquared(b, a);
+}
+
+template <class T>
+[[nodiscard]] constexpr T distance(Ray<3, T> const& a, Cylinder<3, T> const& b)
+{
+	return distance(b, a);
+}
+
+template <class T>
+[[nodiscard]] constexpr T distanceSquared(Ray<3, T> const& a, Cone<3, T> const& b)
+{
+	return distanceSquared(b, a);
+}
+
+template <class T>
+[[nodiscard]] constexpr T distance(Ray<3, T> const& a, Cone<3, T> const& b)
+{
+	return distance(b, a);
+}
+
 /**************************************************************************************
 |                                                                                     |
 |                                      Triangle                                       |
@@ -1057,6 +1268,157 @@ template <std::size_t Dim, class T>
 // 	// TODO: Implement
 // }
 
+/**************************************************************************************
+|                                                                                     |
+|                                      Cylinder                                       |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distanceSquared(Cylinder<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	auto const axis   = a.end - a.start;
+	T const    length = norm(axis);
+	auto const p      = b - a.start;
+
+	// Distance to the rectangle [0, length] x [0, radius] in the plane through the axis
+	T const s   = T(0) < length ? dot(p, axis) / length : T(0);
+	T const rho = std::sqrt(std::max(T(0), dot(p, p) - s * s));
+	T const ao  = T(0) > s ? -s : std::fdim(s, length);
+	T const ro  = std::fdim(rho, a.radius);
+	return ao * ao + ro * ro;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distance(Cylinder<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	return std::sqrt(distanceSquared(a, b));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distanceSquared(Cylinder<Dim, T> const& a,
+                                          Sphere<Dim, T> const& b)
+{
+	auto dist = distance(a, b);
+	return dist * dist;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distance(Cylinder<Dim, T> const& a, Sphere<Dim, T> const& b)
+{
+	return std::fdim(distance(a, b.center), b.radius);
+}
+
+template <class T>
+[[nodiscard]] constexpr T distanceSquared(Cylinder<3, T> const& a, AABB<3, T> const& b)
+{
+	return detail::convexDistanceSquared(a, b, (a.start + a.end) / T(2) - b.center());
+}
+
+template <class T>
+[[nodiscard]] constexpr T distance(Cylinder<3, T> const& a, AABB<3, T> const& b)
+{
+	return std::sqrt(distanceSquared(a, b));
+}
+
+template <class T>
+[[nodiscard]] constexpr T distanceSquared(Cylinder<3, T> const& a, Ray<3, T> const& b)
+{
+	auto const center = (a.start + a.end) / T(2);
+	T const    radius =
+	    std::sqrt(distanceSquared(a.start, a.end) / T(4) + a.radius * a.radius);
+	auto const seg = detail::clipRay(b, center, radius);
+	return detail::convexDistanceSquared(a, seg, center - seg.start);
+}
+
+template <class T>
+[[nodiscard]] constexpr T distance(Cylinder<3, T> const& a, Ray<3, T> const& b)
+{
+	return std::sqrt(distanceSquared(a, b));
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        Cone                                         |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distanceSquared(Cone<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	auto const axis   = a.base_center - a.tip;
+	T const    height = norm(axis);
+	auto const p      = b - a.tip;
+
+	// Distance to the triangle (0, 0), (height, 0), (height, radius) in the plane through
+	// the axis, with the tip at the origin
+	T const s   = T(0) < height ? dot(p, axis) / height : T(0);
+	T const rho = std::sqrt(std::max(T(0), dot(p, p) - s * s));
+	if (T(0) <= s && height >= s && rho * height <= a.radius * s) {
+		return T(0);
+	}
+
+	// Slant side
+	T const l2 = height * height + a.radius * a.radius;
+	T const t =
+	    T(0) < l2 ? std::clamp((s * height + rho * a.radius) / l2, T(0), T(1)) : T(0);
+	T const sx = s - t * height;
+	T const sy = rho - t * a.radius;
+
+	// Base
+	T const bx = s - height;
+	T const by = std::fdim(rho, a.radius);
+
+	return std::min(sx * sx + sy * sy, bx * bx + by * by);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distance(Cone<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	return std::sqrt(distanceSquared(a, b));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distanceSquared(Cone<Dim, T> const& a, Sphere<Dim, T> const& b)
+{
+	auto dist = distance(a, b);
+	return dist * dist;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distance(Cone<Dim, T> const& a, Sphere<Dim, T> const& b)
+{
+	return std::fdim(distance(a, b.center), b.radius);
+}
+
+template <class T>
+[[nodiscard]] constexpr T distanceSquared(Cone<3, T> const& a, AABB<3, T> const& b)
+{
+	return detail::convexDistanceSquared(a, b, (a.base_center + a.tip) / T(2) - b.center());
+}
+
+template <class T>
+[[nodiscard]] constexpr T distance(Cone<3, T> const& a, AABB<3, T> const& b)
+{
+	return std::sqrt(distanceSquared(a, b));
+}
+
+template <class T>
+[[nodiscard]] constexpr T distanceSquared(Cone<3, T> const& a, Ray<3, T> const& b)
+{
+	auto const center = (a.base_center + a.tip) / T(2);
+	T const    radius =
+	    std::sqrt(distanceSquared(a.base_center, a.tip) / T(4) + a.radius * a.radius);
+	auto const seg = detail::clipRay(b, center, radius);
+	return detail::convexDistanceSquared(a, seg, center - seg.start);
+}
+
+template <class T>
+[[nodiscard]] constexpr T distance(Cone<3, T> const& a, Ray<3, T> const& b)
+{
+	return std::sqrt(distanceSquared(a, b));
+}
+
 /**************************************************************************************
 |                                                                                     |
 |                                         Vec                                         |
@@ -1075,6 +1437,18 @@ template <std::size_t Dim, class T>
 	return distance(b, a);
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distanceSquared(Vec<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	return distanceSquared(b, a);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distance(Vec<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	return distance(b, a);
+}
+
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr T distanceSquared(Vec<Dim, T> const& a, Sphere<Dim, T> const& b)
 {
@@ -1171,6 +1545,302 @@ template <std::size_t Dim, class T>
 {
 	return distance(b, a);
 }
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distanceSquared(Vec<Dim, T> const& a, Cylinder<Dim, T> const& b)
+{
+	return distanceSquared(b, a);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distance(Vec<Dim, T> const& a, Cylinder<Dim, T> const& b)
+{
+	return distance(b, a);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distanceSquared(Vec<Dim, T> const& a, Cone<Dim, T> const& b)
+{
+	return distanceSquared(b, a);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T distance(Vec<Dim, T> const& a, Cone<Dim, T> const& b)
+{
+	return distance(b, a);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                       Generic                                       |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Gilbert-Johnson-Keerthi distance between any two convex geometries with
+ * `support` functions, used when there is no dedicated overload.
+ */
+template <class A, class B, std::enable_if_t<is_convex_pair_v<A, B>, bool> = true>
+[[nodiscard]] constexpr auto distanceSquaredConvex(A const& a, B const& b)
+{
+	using T = typename geometry_traits<A>::value_type;
+	return detail::convexDistanceSquared(a, b, Vec<3, T>(T(1), T(0), T(0)));
+}
+
+template <class A, class B, std::enable_if_t<is_convex_pair_v<A, B>, bool> = true>
+[[nodiscard]] constexpr auto distanceConvex(A const& a, B const& b)
+{
+	return std::sqrt(distanceSquaredConvex(a, b));
+}
+
+namespace detail
+{
+/*!
+ * @brief `distance` with the kernel selected at compile time, see `distance_kernel_v`.
+ */
+template <class A, class B>
+[[nodiscard]] constexpr auto distanceKernel(A const& a, B const& b)
+{
+	constexpr QueryKernel kernel = distance_kernel_v<A, B>;
+	static_assert(QueryKernel::NONE != kernel,
+	              "There is no distance for this pair of geometries.");
+
+	if constexpr (QueryKernel::DIRECT == kernel) {
+		return distance(a, b);
+	} else if constexpr (QueryKernel::REVERSED == kernel) {
+		return distance(b, a);
+	} else {
+		return distanceConvex(a, b);
+	}
+}
+}  // namespace detail
+
+/*!
+ * @brief Computes the distance between `a` and each geometry in [first, last) and
+ * stores the results in the range beginning at `d_first`.
+ *
+ * Works for any pair with a `distance_kernel_v` other than `QueryKernel::NONE`.
+ *
+ * @return Output iterator to the element past the last result.
+ */
+template <class A, class InputIt, class OutputIt>
+OutputIt distance(A const& a, InputIt first, InputIt last, OutputIt d_first)
+{
+	return std::transform(first, last, d_first,
+	                      [&a](auto const& b) { return detail::distanceKernel(a, b); });
+}
+
+/*!
+ * @brief Same as above, but executed according to `policy`.
+ */
+template <
+    class ExecutionPolicy, class A, class ForwardIt1, class ForwardIt2,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+ForwardIt2 distance(ExecutionPolicy&& policy, A const& a, ForwardIt1 first,
+                    ForwardIt1 last, ForwardIt2 d_first)
+{
+	return std::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                      [&a](auto const& b) { return detail::distanceKernel(a, b); });
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Threshold                                      |
+|                                                                                     |
+**************************************************************************************/
+
+namespace detail
+{
+/*!
+ * @brief The core of a rounded geometry, such that the geometry is the set of points
+ * within `roundedRadius` of it.
+ */
+template <class Geometry>
+[[nodiscard]] constexpr Geometry const& roundedCore(Geometry const& a) noexcept
+{
+	return a;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> const& roundedCore(Sphere<Dim, T> const& a) noexcept
+{
+	return a.center;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr LineSegment<Dim, T> roundedCore(Capsule<Dim, T> const& a) noexcept
+{
+	return LineSegment<Dim, T>(a.start, a.end);
+}
+
+template <class Geometry>
+[[nodiscard]] constexpr auto roundedRadius(Geometry const&) noexcept
+{
+	return typename geometry_traits<Geometry>::value_type(0);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T roundedRadius(Sphere<Dim, T> const& a) noexcept
+{
+	return a.radius;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T roundedRadius(Capsule<Dim, T> const& a) noexcept
+{
+	return a.radius;
+}
+
+/*!
+ * @brief `distanceSquared(a, b) <= max` with the kernel selected at compile time, see
+ * `distance_kernel_v`.
+ *
+ * The GJK kernel stops as soon as the answer is decided, and runs on the cores of
+ * rounded geometries with the radii added to the threshold. GJK only converges
+ * asymptotically on curved geometries, but in a few iterations on the polytope cores.
+ */
+template <class A, class B, class T>
+[[nodiscard]] constexpr bool distanceSquaredWithinKernel(A const& a, B const& b, T max)
+{
+	constexpr QueryKernel kernel = distance_kernel_v<A, B>;
+	static_assert(QueryKernel::NONE != kernel,
+	              "There is no distance for this pair of geometries.");
+
+	if (T(0) > max) {
+		return false;
+	}
+
+	if constexpr (QueryKernel::DIRECT == kernel) {
+		return distanceSquared(a, b) <= max;
+	} else if constexpr (QueryKernel::REVERSED == kernel) {
+		return distanceSquared(b, a) <= max;
+	} else {
+		T const     r  = roundedRadius(a) + roundedRadius(b);
+		T const     l  = std::sqrt(max) + r;
+		T const     m  = T(0) == r ? max : l * l;
+		auto const& ca = roundedCore(a);
+		auto const& cb = roundedCore(b);
+		return gjkDistance<T>([&ca](Vec<3, T> const& d) { return support(ca, d); },
+		                      [&cb](Vec<3, T> const& d) { return support(cb, d); },
+		                      Vec<3, T>(T(1), T(0), T(0)), m)
+		           .distance_squared <= m;
+	}
+}
+}  // namespace detail
+
+/*!
+ * @brief Checks if the squared distance between `a` and `b` is at most `max`.
+ *
+ * Exits as soon as the answer is decided, which is often much earlier than computing
+ * the distance. Works for any pair with a `distance_kernel_v` other than
+ * `QueryKernel::NONE`.
+ */
+template <class A, class B>
+[[nodiscard]] constexpr bool distanceSquaredWithin(
+    A const& a, B const& b, typename geometry_traits<A>::value_type max)
+{
+	return detail::distanceSquaredWithinKernel(a, b, max);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool distanceSquaredWithin(AABB<Dim, T> const& a,
+                                                   AABB<Dim, T> const& b, T max)
+{
+	T res{};
+	for (std::size_t i{}; Dim > i; ++i) {
+		T const d = std::fdim(a.min[i], b.max[i]) + std::fdim(b.min[i], a.max[i]);
+		res += d * d;
+		if (res > max) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool distanceSquaredWithin(AABB<Dim, T> const& a,
+                                                   Vec<Dim, T> const& b, T max)
+{
+	T res{};
+	for (std::size_t i{}; Dim > i; ++i) {
+		T const d = std::fdim(a.min[i], b[i]) + std::fdim(b[i], a.max[i]);
+		res += d * d;
+		if (res > max) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool distanceSquaredWithin(Vec<Dim, T> const& a,
+                                                   AABB<Dim, T> const& b, T max)
+{
+	return distanceSquaredWithin(b, a, max);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool distanceSquaredWithin(Sphere<Dim, T> const& a,
+                                                   AABB<Dim, T> const& b, T max)
+{
+	if (T(0) > max) {
+		return false;
+	}
+	T const l = std::sqrt(max) + a.radius;
+	return distanceSquaredWithin(b, a.center, l * l);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool distanceSquaredWithin(AABB<Dim, T> const&   a,
+                                                   Sphere<Dim, T> const& b, T max)
+{
+	return distanceSquaredWithin(b, a, max);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool distanceSquaredWithin(Sphere<Dim, T> const& a,
+                                                   Sphere<Dim, T> const& b, T max)
+{
+	if (T(0) > max) {
+		return false;
+	}
+	T const l = std::sqrt(max) + a.radius + b.radius;
+	return distanceSquared(a.center, b.center) <= l * l;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool distanceSquaredWithin(Sphere<Dim, T> const& a,
+                                                   Vec<Dim, T> const& b, T max)
+{
+	if (T(0) > max) {
+		return false;
+	}
+	T const l = std::sqrt(max) + a.radius;
+	return distanceSquared(a.center, b) <= l * l;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool distanceSquaredWithin(Vec<Dim, T> const&    a,
+                                                   Sphere<Dim, T> const& b, T max)
+{
+	return distanceSquaredWithin(b, a, max);
+}
+
+/*!
+ * @brief Checks if the distance between `a` and `b` is less than `threshold`.
+ *
+ * Same as `distanceSquaredWithin`, but with a strict comparison against a distance.
+ */
+template <class A, class B>
+[[nodiscard]] constexpr bool distanceLessThan(
+    A const& a, B const& b, typename geometry_traits<A>::value_type threshold)
+{
+	using T = typename geometry_traits<A>::value_type;
+	// `x < y` is the same as `x <= z`, where `z` is the largest value below `y`
+	return T(0) < threshold &&
+	       distanceSquaredWithin(a, b, std::nextafter(threshold * threshold, T(0)));
+}
 }  // namespace ufo
 
 #endif  // UFO_GEOMETRY_DISTANCE_HPP
\ No newline at end of file
@@ -0,0 +1,541 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_DYNAMIC_AABB_TREE_HPP
+#define UFO_GEOMETRY_DYNAMIC_AABB_TREE_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/bounding_volume.hpp>
+#include <ufo/geometry/bvh.hpp>
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/intersects.hpp>
+#include <ufo/geometry/type_traits.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief A bounding volume hierarchy for geometries that are inserted, removed, and
+ * moved one at a time.
+ *
+ * Each geometry is stored in a leaf whose bounds are its bounds grown by `margin`, so
+ * small motions stay inside them and `update` does not have to touch the tree. A leaf
+ * is inserted next to the node where it increases the surface area the least, and the
+ * ancestors are rebalanced by rotations on the way back up, which keeps the height of
+ * the tree logarithmic.
+ *
+ * The nodes are kept in a pool with a free list, so there is no allocation per
+ * geometry. The id returned by `insert` stays valid until the geometry is erased.
+ *
+ * Works for any geometry with `min` and `max` in `fun.hpp`, as well as for `Vec`.
+ * Complements `BVH`, which is faster to query but has to be refitted or rebuilt as a
+ * whole.
+ */
+template <class Geometry>
+class DynamicAABBTree
+{
+ public:
+	using geometry_type = Geometry;
+	using value_type    = typename geometry_traits<Geometry>::value_type;
+	using size_type     = std::size_t;
+
+	static constexpr std::size_t dimension = geometry_traits<Geometry>::dimension;
+
+	using bounds_type = AABB<dimension, value_type>;
+
+	/*!
+	 * @brief Id of no geometry, returned by queries that find nothing.
+	 */
+	static constexpr size_type NO_ID = std::numeric_limits<std::uint32_t>::max();
+
+	/*!
+	 * @brief The maximum height of the tree, which bounds the traversal stack. A balanced
+	 * tree over 2^32 geometries is less than 48 high.
+	 */
+	static constexpr std::size_t MAX_DEPTH = 64;
+
+	explicit DynamicAABBTree(value_type margin = value_type(0.1)) : margin_(margin) {}
+
+	[[nodiscard]] size_type size() const noexcept { return size_; }
+
+	[[nodiscard]] bool empty() const noexcept { return 0 == size_; }
+
+	[[nodiscard]] value_type margin() const noexcept { return margin_; }
+
+	/*!
+	 * @brief Number of nodes on the longest path from the root to a leaf, zero if empty.
+	 */
+	[[nodiscard]] size_type height() const noexcept
+	{
+		return NO_ID == root_ ? 0 : nodes_[root_].height + 1;
+	}
+
+	[[nodiscard]] bounds_type bounds() const
+	{
+		return NO_ID == root_ ? detail::emptyAABB<dimension, value_type>()
+		                      : nodes_[root_].bounds;
+	}
+
+	/*!
+	 * @brief The geometry with id `id`.
+	 */
+	[[nodiscard]] Geometry const& operator[](size_type id) const { return geometry_[id]; }
+
+	/*!
+	 * @brief The bounds of the leaf of `id`, the bounds of its geometry when it was last
+	 * inserted, grown by `margin`.
+	 */
+	[[nodiscard]] bounds_type const& fatBounds(size_type id) const
+	{
+		return nodes_[id].bounds;
+	}
+
+	void clear()
+	{
+		nodes_.clear();
+		geometry_.clear();
+		root_ = NO_ID;
+		free_ = NO_ID;
+		size_ = 0;
+	}
+
+	/*!
+	 * @brief Inserts `g`.
+	 *
+	 * @return The id of `g`.
+	 */
+	size_type insert(Geometry const& g)
+	{
+		std::uint32_t const leaf = allocate();
+		geometry_[leaf]          = g;
+		nodes_[leaf].bounds      = fat(g);
+		nodes_[leaf].height      = 0;
+		insertLeaf(leaf);
+		++size_;
+		return leaf;
+	}
+
+	/*!
+	 * @brief Removes the geometry with id `id`, after which `id` may be reused.
+	 */
+	void erase(size_type id)
+	{
+		auto const leaf = static_cast<std::uint32_t>(id);
+		removeLeaf(leaf);
+		release(leaf);
+		--size_;
+	}
+
+	/*!
+	 * @brief Replaces the geometry with id `id` by `g`.
+	 *
+	 * The leaf is only moved if `g` is not inside its fat bounds anymore.
+	 *
+	 * @return Whether the leaf was moved.
+	 */
+	bool update(size_type id, Geometry const& g)
+	{
+		auto const leaf = static_cast<std::uint32_t>(id);
+		geometry_[leaf] = g;
+
+		bounds_type const& b      = nodes_[leaf].bounds;
+		auto const         lo     = detail::lower(g);
+		auto const         hi     = detail::upper(g);
+		bool               inside = true;
+		for (std::size_t i{}; dimension > i; ++i) {
+			inside = inside && b.min[i] <= lo[i] && hi[i] <= b.max[i];
+		}
+		if (inside) {
+			return false;
+		}
+
+		removeLeaf(leaf);
+		nodes_[leaf].bounds = fat(g);
+		insertLeaf(leaf);
+		return true;
+	}
+
+	/*!
+	 * @brief Calls `f(geometry, id)` for every geometry in a leaf whose bounds, and the
+	 * bounds of all its ancestors, satisfy `descend`.
+	 */
+	template <class Descend, class F>
+	void traverse(Descend descend, F f) const
+	{
+		(void)traverseAny(descend, [&f](Geometry const& g, size_type id) {
+			f(g, id);
+			return false;
+		});
+	}
+
+	/*!
+	 * @brief Same as `traverse`, but stops as soon as `f(geometry, id)` returns `true`.
+	 *
+	 * @return Whether `f` returned `true` for any geometry.
+	 */
+	template <class Descend, class F>
+	[[nodiscard]] bool traverseAny(Descend descend, F f) const
+	{
+		if (NO_ID == root_) {
+			return false;
+		}
+
+		std::array<std::uint32_t, MAX_DEPTH> stack;
+		std::size_t                          top{};
+		stack[top++] = root_;
+		while (top) {
+			std::uint32_t const i    = stack[--top];
+			Node const&         node = nodes_[i];
+			if (!descend(node.bounds)) {
+				continue;
+			}
+
+			if (node.leaf()) {
+				if (f(geometry_[i], i)) {
+					return true;
+				}
+			} else {
+				stack[top++] = node.second;
+				stack[top++] = node.first;
+			}
+		}
+		return false;
+	}
+
+	/*!
+	 * @brief Writes the id of every geometry intersecting `query` to `d_first`.
+	 *
+	 * @return Output iterator to the element past the last element written.
+	 */
+	template <class Query, class OutputIt>
+	OutputIt intersects(Query const& query, OutputIt d_first) const
+	{
+		traverse(
+		    [&query](bounds_type const& b) { return detail::intersectsKernel(b, query); },
+		    [&query, &d_first](Geometry const& g, size_type id) {
+			    if (detail::intersectsKernel(g, query)) {
+				    *d_first++ = id;
+			    }
+		    });
+		return d_first;
+	}
+
+	/*!
+	 * @brief The geometry closest to `query`, considering only distances smaller than
+	 * `max`. The closer child of each node is visited first.
+	 *
+	 * @return The id of the closest geometry and the distance to it, or `NO_ID` and `max`
+	 * if no geometry is closer than `max`.
+	 */
+	template <class Query>
+	[[nodiscard]] std::pair<size_type, value_type> nearest(
+	    Query const& query,
+	    value_type   max = std::numeric_limits<value_type>::infinity()) const
+	{
+		std::pair<size_type, value_type> res(NO_ID, max);
+		if (NO_ID == root_) {
+			return res;
+		}
+
+		auto const bound = [&query](bounds_type const& b) {
+			return static_cast<value_type>(detail::distanceKernel(b, query));
+		};
+
+		std::array<std::pair<std::uint32_t, value_type>, MAX_DEPTH> stack;
+		std::size_t                                                 top{};
+		stack[top++] = {root_, bound(nodes_[root_].bounds)};
+		while (top) {
+			auto const [i, lower] = stack[--top];
+			if (!(lower < res.second)) {
+				continue;
+			}
+
+			Node const& node = nodes_[i];
+			if (node.leaf()) {
+				value_type const d =
+				    static_cast<value_type>(detail::distanceKernel(geometry_[i], query));
+				if (d < res.second) {
+					res = {i, d};
+				}
+				continue;
+			}
+
+			std::uint32_t a  = node.first;
+			std::uint32_t b  = node.second;
+			value_type    da = bound(nodes_[a].bounds);
+			value_type    db = bound(nodes_[b].bounds);
+			if (db < da) {
+				std::swap(a, b);
+				std::swap(da, db);
+			}
+			// The closer child is pushed last so it is visited first
+			if (db < res.second) {
+				stack[top++] = {b, db};
+			}
+			if (da < res.second) {
+				stack[top++] = {a, da};
+			}
+		}
+		return res;
+	}
+
+ private:
+	struct Node {
+		bounds_type bounds;
+		// Parent, or the next free node while in the free list
+		std::uint32_t parent = NO_ID;
+		// Children, `NO_ID` for leaves
+		std::uint32_t first  = NO_ID;
+		std::uint32_t second = NO_ID;
+		// Zero for leaves, -1 while in the free list
+		std::int32_t height = -1;
+
+		[[nodiscard]] constexpr bool leaf() const noexcept { return NO_ID == first; }
+	};
+
+	[[nodiscard]] bounds_type fat(Geometry const& g) const
+	{
+		return bounds_type(detail::lower(g) - margin_, detail::upper(g) + margin_);
+	}
+
+	[[nodiscard]] static bounds_type merge(bounds_type const& a, bounds_type const& b)
+	{
+		return bounds_type(min(a.min, b.min), max(a.max, b.max));
+	}
+
+	/*!
+	 * @brief Takes a node from the free list, growing the pool if it is empty.
+	 */
+	[[nodiscard]] std::uint32_t allocate()
+	{
+		if (NO_ID == free_) {
+			free_ = static_cast<std::uint32_t>(nodes_.size());
+			nodes_.emplace_back();
+			geometry_.emplace_back();
+		}
+		std::uint32_t const i = free_;
+		free_                 = nodes_[i].parent;
+		nodes_[i]             = Node{};
+		return i;
+	}
+
+	void release(std::uint32_t i)
+	{
+		nodes_[i]        = Node{};
+		nodes_[i].parent = free_;
+		free_            = i;
+	}
+
+	/*!
+	 * @brief Recomputes the height and bounds of `i` from its children.
+	 */
+	void fix(std::uint32_t i)
+	{
+		Node&       node   = nodes_[i];
+		Node const& first  = nodes_[node.first];
+		Node const& second = nodes_[node.second];
+		node.height        = 1 + std::max(first.height, second.height);
+		node.bounds        = merge(first.bounds, second.bounds);
+	}
+
+	/*!
+	 * @brief Fixes and rebalances `i` and all its ancestors.
+	 */
+	void fixUp(std::uint32_t i)
+	{
+		for (; NO_ID != i; i = nodes_[i].parent) {
+			i = balance(i);
+			fix(i);
+		}
+	}
+
+	void insertLeaf(std::uint32_t leaf)
+	{
+		if (NO_ID == root_) {
+			root_               = leaf;
+			nodes_[leaf].parent = NO_ID;
+			return;
+		}
+
+		// Descend to where the leaf adds the least surface area, counting the growth of
+		// the ancestors, which is the same whichever child it goes into
+		bounds_type const b = nodes_[leaf].bounds;
+		std::uint32_t     i = root_;
+		while (!nodes_[i].leaf()) {
+			Node const&      node     = nodes_[i];
+			value_type const area     = detail::halfArea(node.bounds);
+			value_type const combined = detail::halfArea(merge(node.bounds, b));
+
+			// Making a new parent of this node and the leaf
+			value_type const here = 2 * combined;
+			// Minimum cost of pushing the leaf further down
+			value_type const inheritance = 2 * (combined - area);
+
+			// A leaf child gets a new parent, an internal child only grows
+			auto const cost = [&](std::uint32_t c) {
+				value_type const m = detail::halfArea(merge(nodes_[c].bounds, b));
+				return inheritance +
+				       (nodes_[c].leaf() ? m : m - detail::halfArea(nodes_[c].bounds));
+			};
+			value_type const first  = cost(node.first);
+			value_type const second = cost(node.second);
+			if (here < first && here < second) {
+				break;
+			}
+			i = first < second ? node.first : node.second;
+		}
+
+		std::uint32_t const old_parent = nodes_[i].parent;
+		std::uint32_t const parent     = allocate();
+		nodes_[parent].parent          = old_parent;
+		nodes_[parent].first           = i;
+		nodes_[parent].second          = leaf;
+		nodes_[i].parent               = parent;
+		nodes_[leaf].parent            = parent;
+		if (NO_ID == old_parent) {
+			root_ = parent;
+		} else if (nodes_[old_parent].first == i) {
+			nodes_[old_parent].first = parent;
+		} else {
+			nodes_[old_parent].second = parent;
+		}
+		fixUp(parent);
+	}
+
+	void removeLeaf(std::uint32_t leaf)
+	{
+		if (root_ == leaf) {
+			root_ = NO_ID;
+			return;
+		}
+
+		// The sibling takes the place of the parent
+		std::uint32_t const parent      = nodes_[leaf].parent;
+		std::uint32_t const grandparent = nodes_[parent].parent;
+		std::uint32_t const sibling =
+		    nodes_[parent].first == leaf ? nodes_[parent].second : nodes_[parent].first;
+		nodes_[sibling].parent = grandparent;
+		if (NO_ID == grandparent) {
+			root_ = sibling;
+		} else {
+			if (nodes_[grandparent].first == parent) {
+				nodes_[grandparent].first = sibling;
+			} else {
+				nodes_[grandparent].second = sibling;
+			}
+			fixUp(grandparent);
+		}
+		release(parent);
+	}
+
+	/*!
+	 * @brief Rotates the taller child of `a` up if the heights of the children of `a`
+	 * differ by more than one.
+	 *
+	 * The child takes the place of `a`, and `a` takes the shorter child of the child. The
+	 * order of children does not matter, so this single rotation also covers the case
+	 * where an ordered tree would need two.
+	 *
+	 * @return The root of the subtree, `a` or the rotated child.
+	 */
+	[[nodiscard]] std::uint32_t balance(std::uint32_t a)
+	{
+		Node& na = nodes_[a];
+		if (na.leaf() || 2 > na.height) {
+			return a;
+		}
+
+		std::int32_t const diff = nodes_[na.second].height - nodes_[na.first].height;
+		if (-1 <= diff && 1 >= diff) {
+			return a;
+		}
+
+		std::uint32_t const b  = 0 < diff ? na.second : na.first;
+		Node&               nb = nodes_[b];
+
+		// `b` keeps its taller child and gives the shorter to `a`
+		std::uint32_t const keep =
+		    nodes_[nb.first].height < nodes_[nb.second].height ? nb.second : nb.first;
+		std::uint32_t const give = keep == nb.first ? nb.second : nb.first;
+
+		nb.parent = na.parent;
+		if (NO_ID == nb.parent) {
+			root_ = b;
+		} else if (nodes_[nb.parent].first == a) {
+			nodes_[nb.parent].first = b;
+		} else {
+			nodes_[nb.parent].second = b;
+		}
+
+		nb.first  = a;
+		nb.second = keep;
+		na.parent = b;
+		if (na.first == b) {
+			na.first = give;
+		} else {
+			na.second = give;
+		}
+		nodes_[give].parent = a;
+
+		fix(a);
+		fix(b);
+		return b;
+	}
+
+	std::vector<Node>     nodes_;
+	std::vector<Geometry> geometry_;
+	std::uint32_t         root_ = NO_ID;
+	std::uint32_t         free_ = NO_ID;
+	size_type             size_{};
+	value_type            margin_;
+};
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_DYNAMIC_AABB_TREE_HPP
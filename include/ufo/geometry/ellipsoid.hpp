@@ -0,0 +1,396 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_ELLIPSOID_HPP
+#define UFO_GEOMETRY_ELLIPSOID_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/detail/symmetric_eigen.hpp>
+#include <ufo/math/mat.hpp>
+#include <ufo/math/math.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <execution>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace ufo
+{
+/*!
+ * @brief An ellipsoid, the points `x` with `(x - center)^T A (x - center) <= 1`.
+ *
+ * `A = R diag(1 / radii^2) R^T` is the inverse shape matrix, where column `i` of the
+ * rotation `R` is the axis of `radii[i]`. It is computed once when the shape is set,
+ * so containment is a single quadratic form. The half extents of the axis aligned
+ * bounds are precomputed as well.
+ *
+ * The center can be changed freely, the shape only through the setters.
+ */
+template <std::size_t Dim = 3, class T = float>
+class Ellipsoid
+{
+	static_assert(std::is_floating_point_v<T>, "T is required to be floating point.");
+
+ public:
+	using value_type = T;
+
+	constexpr Ellipsoid() noexcept = default;
+
+	/*!
+	 * @brief Axis aligned ellipsoid.
+	 */
+	constexpr Ellipsoid(Vec<Dim, T> const& center, Vec<Dim, T> const& radii) noexcept
+	    : center_(center)
+	{
+		setShape(radii, Mat<Dim, Dim, T>());
+	}
+
+	constexpr Ellipsoid(Vec<Dim, T> const& center, Vec<Dim, T> const& radii,
+	                    Mat<Dim, Dim, T> const& rotation) noexcept
+	    : center_(center)
+	{
+		setShape(radii, rotation);
+	}
+
+	/*!
+	 * @brief The ellipsoid of all points within Mahalanobis distance `gate` of `center`
+	 * for a distribution with covariance `covariance`.
+	 *
+	 * @param covariance Symmetric positive definite covariance matrix.
+	 */
+	Ellipsoid(Vec<Dim, T> const& center, Mat<Dim, Dim, T> const& covariance, T gate)
+	    : center_(center)
+	{
+		setCovariance(covariance, gate);
+	}
+
+	template <class U>
+	constexpr explicit Ellipsoid(Ellipsoid<Dim, U> const& other) noexcept
+	    : center_(other.center())
+	{
+		setShape(Vec<Dim, T>(other.radii()), Mat<Dim, Dim, T>(other.rotation()));
+	}
+
+	[[nodiscard]] constexpr Vec<Dim, T> const& center() const noexcept { return center_; }
+
+	[[nodiscard]] constexpr Vec<Dim, T> const& radii() const noexcept { return radii_; }
+
+	[[nodiscard]] constexpr Mat<Dim, Dim, T> const& rotation() const noexcept
+	{
+		return rotation_;
+	}
+
+	/*!
+	 * @brief The inverse shape matrix `A`.
+	 */
+	[[nodiscard]] constexpr Mat<Dim, Dim, T> const& inverseShape() const noexcept
+	{
+		return inv_shape_;
+	}
+
+	/*!
+	 * @brief Half extents of the smallest AABB enclosing the ellipsoid.
+	 */
+	[[nodiscard]] constexpr Vec<Dim, T> const& halfExtent() const noexcept
+	{
+		return half_extent_;
+	}
+
+	constexpr void setCenter(Vec<Dim, T> const& center) noexcept { center_ = center; }
+
+	/*!
+	 * @param radii Strictly positive radii.
+	 * @param rotation Orthonormal matrix, column `i` is the axis of `radii[i]`.
+	 */
+	constexpr void setShape(Vec<Dim, T> const& radii,
+	                        Mat<Dim, Dim, T> const& rotation) noexcept
+	{
+		radii_    = radii;
+		rotation_ = rotation;
+
+		for (std::size_t i{}; Dim > i; ++i) {
+			T e{};
+			for (std::size_t j = i; Dim > j; ++j) {
+				T a{};
+				for (std::size_t k{}; Dim > k; ++k) {
+					a += rotation[k][i] * rotation[k][j] / (radii[k] * radii[k]);
+				}
+				inv_shape_[i][j] = inv_shape_[j][i] = a;
+			}
+			for (std::size_t k{}; Dim > k; ++k) {
+				e += rotation[k][i] * rotation[k][i] * radii[k] * radii[k];
+			}
+			half_extent_[i] = std::sqrt(e);
+		}
+	}
+
+	/*!
+	 * @brief Sets the shape to the points within Mahalanobis distance `gate` for a
+	 * distribution with covariance `covariance`.
+	 */
+	void setCovariance(Mat<Dim, Dim, T> const& covariance, T gate)
+	{
+		Vec<Dim, T>      values;
+		Mat<Dim, Dim, T> vectors;
+		detail::symmetricEigen(covariance, values, vectors);
+		for (std::size_t i{}; Dim > i; ++i) {
+			values[i] = gate * std::sqrt(values[i]);
+		}
+		setShape(values, vectors);
+	}
+
+	/*!
+	 * @brief The squared Mahalanobis distance from the center to `point` in units of the
+	 * ellipsoid, at most 1 for points inside.
+	 */
+	[[nodiscard]] constexpr T mahalanobisSquared(Vec<Dim, T> const& point) const noexcept
+	{
+		T d[Dim];
+		for (std::size_t i{}; Dim > i; ++i) {
+			d[i] = point[i] - center_[i];
+		}
+
+		T res{};
+		for (std::size_t i{}; Dim > i; ++i) {
+			T row{};
+			for (std::size_t j{}; Dim > j; ++j) {
+				row += inv_shape_[j][i] * d[j];
+			}
+			res += d[i] * row;
+		}
+		return res;
+	}
+
+	/*!
+	 * @brief The smallest squared Mahalanobis distance of any point in `box`, at most 1
+	 * if the box intersects the ellipsoid.
+	 *
+	 * This is a convex quadratic over a box, so the minimum is the unconstrained minimum
+	 * on one of the faces (of any dimension) of the box. All `3^Dim` faces are tried, on
+	 * each the free coordinates are found by solving a small linear system.
+	 */
+	[[nodiscard]] constexpr T mahalanobisSquared(AABB<Dim, T> const& box) const noexcept
+	{
+		T    lo[Dim];
+		T    hi[Dim];
+		bool inside = true;
+		for (std::size_t i{}; Dim > i; ++i) {
+			lo[i]  = box.min[i] - center_[i];
+			hi[i]  = box.max[i] - center_[i];
+			inside = inside && T(0) >= lo[i] && T(0) <= hi[i];
+		}
+		if (inside) {
+			return T(0);
+		}
+
+		T const tol  = T(64) * std::numeric_limits<T>::epsilon();
+		T       best = std::numeric_limits<T>::max();
+
+		// Coordinate i is free (0), at the lower bound (1) or at the upper bound (2)
+		constexpr auto faces = static_cast<std::size_t>(ipow(3, Dim));
+		for (std::size_t code = 1; faces > code; ++code) {
+			T           y[Dim]{};
+			std::size_t free[Dim];
+			std::size_t m{};
+			for (std::size_t i{}, c = code; Dim > i; ++i, c /= 3) {
+				switch (c % 3) {
+					case 0: free[m++] = i; break;
+					case 1: y[i] = lo[i]; break;
+					default: y[i] = hi[i]; break;
+				}
+			}
+
+			// A_UU y_U = -A_UF y_F, eliminated in place since A_UU is positive definite
+			T g[Dim][Dim + 1];
+			for (std::size_t r{}; m > r; ++r) {
+				T rhs{};
+				for (std::size_t j{}; Dim > j; ++j) {
+					rhs -= inv_shape_[j][free[r]] * y[j];
+				}
+				for (std::size_t k{}; m > k; ++k) {
+					g[r][k] = inv_shape_[free[k]][free[r]];
+				}
+				g[r][m] = rhs;
+			}
+			for (std::size_t c{}; m > c; ++c) {
+				for (std::size_t r = c + 1; m > r; ++r) {
+					T const f = g[r][c] / g[c][c];
+					for (std::size_t k = c; m >= k; ++k) {
+						g[r][k] -= f * g[c][k];
+					}
+				}
+			}
+
+			bool feasible = true;
+			for (std::size_t r = m; 0 < r--;) {
+				T v = g[r][m];
+				for (std::size_t k = r + 1; m > k; ++k) {
+					v -= g[r][k] * y[free[k]];
+				}
+				std::size_t const i = free[r];
+				y[i]                = v / g[r][r];
+				T const slack       = tol * (std::abs(lo[i]) + std::abs(hi[i]));
+				feasible = feasible && lo[i] - slack <= y[i] && y[i] <= hi[i] + slack;
+			}
+			if (!feasible) {
+				continue;
+			}
+
+			T val{};
+			for (std::size_t i{}; Dim > i; ++i) {
+				T row{};
+				for (std::size_t j{}; Dim > j; ++j) {
+					row += inv_shape_[j][i] * y[j];
+				}
+				val += y[i] * row;
+			}
+			best = val < best ? val : best;
+		}
+		return best;
+	}
+
+ private:
+	Vec<Dim, T>      center_;
+	Vec<Dim, T>      radii_;
+	Mat<Dim, Dim, T> rotation_;
+	Mat<Dim, Dim, T> inv_shape_;
+	Vec<Dim, T>      half_extent_;
+};
+
+//
+// Deduction guide
+//
+
+template <std::size_t Dim, class T>
+Ellipsoid(Vec<Dim, T>, Vec<Dim, T>) -> Ellipsoid<Dim, T>;
+
+template <std::size_t Dim, class T>
+Ellipsoid(Vec<Dim, T>, Vec<Dim, T>, Mat<Dim, Dim, T>) -> Ellipsoid<Dim, T>;
+
+template <std::size_t Dim, class T>
+Ellipsoid(Vec<Dim, T>, Mat<Dim, Dim, T>, T) -> Ellipsoid<Dim, T>;
+
+/*!
+ * @brief Compare two Ellipsoids.
+ *
+ * @param lhs,rhs The Ellipsoids to compare
+ * @return `true` if they compare equal, `false` otherwise.
+ */
+template <std::size_t Dim, class T>
+bool operator==(Ellipsoid<Dim, T> const& lhs, Ellipsoid<Dim, T> const& rhs)
+{
+	return lhs.center() == rhs.center() && lhs.radii() == rhs.radii() &&
+	       lhs.rotation() == rhs.rotation();
+}
+
+/*!
+ * @brief Compare two Ellipsoids.
+ *
+ * @param lhs,rhs The Ellipsoids to compare
+ * @return `true` if they do not compare equal, `false` otherwise.
+ */
+template <std::size_t Dim, class T>
+bool operator!=(Ellipsoid<Dim, T> const& lhs, Ellipsoid<Dim, T> const& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <std::size_t Dim, class T>
+std::ostream& operator<<(std::ostream& out, Ellipsoid<Dim, T> const& ellipsoid)
+{
+	return out << "Center: " << ellipsoid.center() << ", Radii: " << ellipsoid.radii()
+	           << ", Rotation: " << ellipsoid.rotation();
+}
+
+/*!
+ * @brief Computes the squared Mahalanobis distance from the center of `a` to all points
+ * in [first, last) and stores the results in the range beginning at `d_first`.
+ *
+ * @return Output iterator to the element past the last result.
+ */
+template <std::size_t Dim, class T, class InputIt, class OutputIt>
+OutputIt mahalanobisSquared(Ellipsoid<Dim, T> const& a, InputIt first, InputIt last,
+                            OutputIt d_first)
+{
+	return std::transform(first, last, d_first, [&a](Vec<Dim, T> const& p) {
+		return a.mahalanobisSquared(p);
+	});
+}
+
+/*!
+ * @brief Same as above, but executed according to `policy`.
+ */
+template <
+    class ExecutionPolicy, std::size_t Dim, class T, class ForwardIt1, class ForwardIt2,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+ForwardIt2 mahalanobisSquared(ExecutionPolicy&& policy, Ellipsoid<Dim, T> const& a,
+                              ForwardIt1 first, ForwardIt1 last, ForwardIt2 d_first)
+{
+	return std::transform(
+	    std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	    [&a](Vec<Dim, T> const& p) { return a.mahalanobisSquared(p); });
+}
+
+template <class T>
+using Ellipsoid2 = Ellipsoid<2, T>;
+template <class T>
+using Ellipsoid3 = Ellipsoid<3, T>;
+template <class T>
+using Ellipsoid4 = Ellipsoid<4, T>;
+
+using Ellipsoid2f = Ellipsoid<2, float>;
+using Ellipsoid3f = Ellipsoid<3, float>;
+using Ellipsoid4f = Ellipsoid<4, float>;
+
+using Ellipsoid2d = Ellipsoid<2, double>;
+using Ellipsoid3d = Ellipsoid<3, double>;
+using Ellipsoid4d = Ellipsoid<4, double>;
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_ELLIPSOID_HPP
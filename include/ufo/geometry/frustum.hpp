@@ -45,9 +45,11 @@
 // UFO
 #include <ufo/geometry/line.hpp>
 #include <ufo/geometry/plane.hpp>
+#include <ufo/math/mat.hpp>
 #include <ufo/math/vec.hpp>
 
 // STL
+#include <array>
 #include <cmath>
 #include <cstddef>
 #include <ostream>
@@ -192,6 +194,68 @@ struct Frustum<3, T> {
 		far    = Plane(far_top_right, far_top_left, far_bottom_left);
 	}
 
+	/*!
+	 * @brief Extracts the planes from a projection or view-projection matrix (G. Gribb and
+	 * K. Hartmann, "Fast Extraction of Viewing Frustum Planes from the
+	 * World-View-Projection Matrix", 2001).
+	 *
+	 * Each plane is a sum or difference of two rows of the matrix, so no trigonometry or
+	 * corners are needed. With a projection matrix the frustum is in the view frame, with
+	 * a view-projection matrix it is in the world frame.
+	 *
+	 * @param m The matrix, mapping column vectors to clip space.
+	 * @param zero_to_one Whether the clip space depth is [0, 1] (Direct3D, Vulkan) rather
+	 * than [-1, 1] (OpenGL).
+	 */
+	constexpr explicit Frustum(Mat<4, 4, T> const& m, bool zero_to_one = false)
+	{
+		auto row = [&m](std::size_t i) {
+			return std::array<T, 4>{m[0][i], m[1][i], m[2][i], m[3][i]};
+		};
+		auto plane = [](std::array<T, 4> const& a, std::array<T, 4> const& b, T s) {
+			Vec<3, T> n(a[0] + s * b[0], a[1] + s * b[1], a[2] + s * b[2]);
+			T const   l = norm(n);
+			return Plane<T>(n / l, (a[3] + s * b[3]) / l);
+		};
+
+		auto const r0 = row(0);
+		auto const r1 = row(1);
+		auto const r2 = row(2);
+		auto const r3 = row(3);
+
+		left   = plane(r3, r0, T(1));
+		right  = plane(r3, r0, T(-1));
+		bottom = plane(r3, r1, T(1));
+		top    = plane(r3, r1, T(-1));
+		near   = zero_to_one ? plane(r2, r2, T(0)) : plane(r3, r2, T(1));
+		far    = plane(r3, r2, T(-1));
+	}
+
+	/*!
+	 * @brief Frustum of a pinhole camera from its intrinsics, in the camera frame with x
+	 * to the right, y down and z forward.
+	 *
+	 * The side planes pass through the camera center and the edges of the image
+	 * [0, width] x [0, height], no trigonometry is needed. Use `transform` to place the
+	 * frustum at the pose of the camera.
+	 *
+	 * @param fx,fy The focal lengths in pixels.
+	 * @param cx,cy The principal point in pixels.
+	 * @param width,height The size of the image in pixels.
+	 */
+	constexpr Frustum(T fx, T fy, T cx, T cy, T width, T height, T near_distance,
+	                  T far_distance)
+	{
+		auto side = [](Vec<3, T> const& n) { return Plane<T>(normalize(n), T(0)); };
+
+		left   = side(Vec<3, T>(T(1), T(0), cx / fx));
+		right  = side(Vec<3, T>(T(-1), T(0), (width - cx) / fx));
+		top    = side(Vec<3, T>(T(0), T(1), cy / fy));
+		bottom = side(Vec<3, T>(T(0), T(-1), (height - cy) / fy));
+		near   = Plane<T>(Vec<3, T>(T(0), T(0), T(1)), -near_distance);
+		far    = Plane<T>(Vec<3, T>(T(0), T(0), T(-1)), far_distance);
+	}
+
 	constexpr Frustum(Frustum const&) noexcept = default;
 
 	template <class U>
@@ -44,18 +44,26 @@
 
 // UFO
 #include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/aabc.hpp>
 #include <ufo/geometry/capsule.hpp>
+#include <ufo/geometry/cone.hpp>
+#include <ufo/geometry/convex_polyhedron.hpp>
+#include <ufo/geometry/cylinder.hpp>
+#include <ufo/geometry/ellipsoid.hpp>
 #include <ufo/geometry/frustum.hpp>
 #include <ufo/geometry/line_segment.hpp>
 #include <ufo/geometry/obb.hpp>
 #include <ufo/geometry/plane.hpp>
+#include <ufo/geometry/polygon.hpp>
 #include <ufo/geometry/ray.hpp>
 #include <ufo/geometry/sphere.hpp>
+#include <ufo/geometry/spherical_sector.hpp>
 #include <ufo/geometry/triangle.hpp>
 #include <ufo/math/math.hpp>
 #include <ufo/math/vec.hpp>
 
 // STL
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
@@ -63,6 +71,46 @@
 
 namespace ufo
 {
+namespace detail
+{
+/*!
+ * @brief Half length of the smallest AABB enclosing `a`.
+ *
+ * @note `a.rotation` maps from the OBB frame to the world frame, so world axis `i` of
+ * the half length is the sum of `|a.rotation[j][i]| * a.half_length[j]` over `j`.
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> halfLengthAABB(OBB<Dim, T> const& a)
+{
+	Vec<Dim, T> res;
+	for (std::size_t i{}; Dim > i; ++i) {
+		res[i] = std::abs(a.rotation[0][i]) * a.half_length[0];
+		for (std::size_t j = 1; Dim > j; ++j) {
+			res[i] += std::abs(a.rotation[j][i]) * a.half_length[j];
+		}
+	}
+	return res;
+}
+
+/*!
+ * @brief Half length of the smallest AABB enclosing a disk with `radius` and normal
+ * `axis`, which does not have to be normalized.
+ *
+ * @note A zero `axis` gives the half length of the enclosing ball.
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> halfLengthDisk(Vec<Dim, T> const& axis, T radius)
+{
+	T const     l2 = dot(axis, axis);
+	Vec<Dim, T> res;
+	for (std::size_t i{}; Dim > i; ++i) {
+		T const u2 = T(0) < l2 ? axis[i] * axis[i] / l2 : T(0);
+		res[i]     = radius * std::sqrt(std::max(T(0), T(1) - u2));
+	}
+	return res;
+}
+}  // namespace detail
+
 /**************************************************************************************
 |                                                                                     |
 |                                         Min                                         |
@@ -75,6 +123,12 @@ template <std::size_t Dim, class T>
 	return a.min;
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> min(AABC<Dim, T> const& a)
+{
+	return a.center - a.half_length;
+}
+
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr Vec<Dim, T> min(Sphere<Dim, T> const& a)
 {
@@ -109,8 +163,7 @@ template <std::size_t Dim, class T>
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr Vec<Dim, T> min(OBB<Dim, T> const& a)
 {
-	// TODO: Implement correct
-	return a.center - abs(a.rotatedHalfLength());
+	return a.center - detail::halfLengthAABB(a);
 }
 
 template <class T>
@@ -139,6 +192,47 @@ template <std::size_t Dim, class T>
 	return min(a[0], min(a[1], a[2]));
 }
 
+template <class T>
+[[nodiscard]] Vec<3, T> min(ConvexPolyhedron<T> const& a)
+{
+	Vec<3, T> res(std::numeric_limits<T>::max());
+	for (auto const& v : a.vertices) {
+		res = min(res, v);
+	}
+	return res;
+}
+
+template <class T>
+[[nodiscard]] Vec<2, T> min(Polygon<T> const& a)
+{
+	return a.bounds().min;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> min(Ellipsoid<Dim, T> const& a)
+{
+	return a.center() - a.halfExtent();
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> min(Cylinder<Dim, T> const& a)
+{
+	return min(a.start, a.end) - detail::halfLengthDisk(a.end - a.start, a.radius);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> min(Cone<Dim, T> const& a)
+{
+	return min(a.tip,
+	           a.base_center - detail::halfLengthDisk(a.base_center - a.tip, a.radius));
+}
+
+template <class T>
+[[nodiscard]] Vec<3, T> min(SphericalSector<T> const& a)
+{
+	return a.bounds().min;
+}
+
 /**************************************************************************************
 |                                                                                     |
 |                                         Max                                         |
@@ -151,6 +245,12 @@ template <std::size_t Dim, class T>
 	return a.max;
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> max(AABC<Dim, T> const& a)
+{
+	return a.center + a.half_length;
+}
+
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr Vec<Dim, T> max(Sphere<Dim, T> const& a)
 {
@@ -185,8 +285,7 @@ template <std::size_t Dim, class T>
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr Vec<Dim, T> max(OBB<Dim, T> const& a)
 {
-	// TODO: Implement correct
-	return a.center + abs(a.rotatedHalfLength());
+	return a.center + detail::halfLengthAABB(a);
 }
 
 template <class T>
@@ -215,6 +314,47 @@ template <std::size_t Dim, class T>
 	return max(a[0], max(a[1], a[2]));
 }
 
+template <class T>
+[[nodiscard]] Vec<3, T> max(ConvexPolyhedron<T> const& a)
+{
+	Vec<3, T> res(std::numeric_limits<T>::lowest());
+	for (auto const& v : a.vertices) {
+		res = max(res, v);
+	}
+	return res;
+}
+
+template <class T>
+[[nodiscard]] Vec<2, T> max(Polygon<T> const& a)
+{
+	return a.bounds().max;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> max(Ellipsoid<Dim, T> const& a)
+{
+	return a.center() + a.halfExtent();
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> max(Cylinder<Dim, T> const& a)
+{
+	return max(a.start, a.end) + detail::halfLengthDisk(a.end - a.start, a.radius);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> max(Cone<Dim, T> const& a)
+{
+	return max(a.tip,
+	           a.base_center + detail::halfLengthDisk(a.base_center - a.tip, a.radius));
+}
+
+template <class T>
+[[nodiscard]] Vec<3, T> max(SphericalSector<T> const& a)
+{
+	return a.bounds().max;
+}
+
 /**************************************************************************************
 |                                                                                     |
 |                                       Corners                                       |
@@ -271,6 +411,13 @@ template <std::size_t Dim, class T>
 	}
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr std::array<Vec<Dim, T>, ipow(2, Dim)> corners(
+    AABC<Dim, T> const& a)
+{
+	return corners(AABB<Dim, T>(a));
+}
+
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr std::array<Vec<Dim, T>, ipow(2, Dim)> corners(
     Frustum<Dim, T> const& a)
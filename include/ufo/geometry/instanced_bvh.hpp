@@ -0,0 +1,348 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_INSTANCED_BVH_HPP
+#define UFO_GEOMETRY_INSTANCED_BVH_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/bvh.hpp>
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/intersects.hpp>
+#include <ufo/geometry/obb.hpp>
+#include <ufo/geometry/transform.hpp>
+#include <ufo/math/mat.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <cstddef>
+#include <execution>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief A two-level bounding volume hierarchy, where each instance places a shared
+ * bottom-level `BVH` in the world with a rigid transform.
+ *
+ * Scenes with many copies of the same object, such as shelves or pallets, only store
+ * and build the geometry of the object once. The top level is a `BVH` over the world
+ * bounds of the instances. Queries are transformed into the frame of each instance they
+ * reach and then answered by its bottom-level tree, so the geometry is never
+ * transformed.
+ *
+ * Queries work for any geometry with a rigid `transform`. An AABB query is turned into
+ * an OBB first, since it is no longer axis aligned in the frame of a rotated instance.
+ *
+ * Instances of an empty shape have no world bounds and are left out of the top level.
+ */
+template <class Geometry>
+class InstancedBVH
+{
+ public:
+	using geometry_type = Geometry;
+	using shape_type    = BVH<Geometry>;
+	using value_type    = typename shape_type::value_type;
+	using size_type     = std::size_t;
+
+	static constexpr std::size_t dimension = shape_type::dimension;
+
+	static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+	using bounds_type   = AABB<dimension, value_type>;
+	using rotation_type = Mat<dimension, dimension, value_type>;
+	using vector_type   = Vec<dimension, value_type>;
+
+	struct Instance {
+		std::shared_ptr<shape_type const> shape;
+		// From the frame of the instance to the world, `x' = rotation * x + translation`
+		rotation_type rotation;
+		vector_type   translation;
+	};
+
+	struct Nearest {
+		// Position of the instance in the input, `size()` if nothing was found
+		size_type instance;
+		// Input position of the geometry in the shape of the instance, `npos` if nothing
+		// was found
+		size_type  index;
+		value_type distance;
+	};
+
+	InstancedBVH() = default;
+
+	template <class InputIt>
+	InstancedBVH(InputIt first, InputIt last, BVHBuild method = BVHBuild::SAH)
+	    : instances_(first, last)
+	{
+		build(std::execution::seq, method);
+	}
+
+	/*!
+	 * @brief Builds the top level over the instances in [first, last) according to
+	 * `policy`. The shapes are shared and not rebuilt.
+	 */
+	template <
+	    class ExecutionPolicy, class RandomIt,
+	    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+	        true>
+	InstancedBVH(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+	             BVHBuild method = BVHBuild::SAH)
+	    : instances_(first, last)
+	{
+		build(std::forward<ExecutionPolicy>(policy), method);
+	}
+
+	InstancedBVH(std::initializer_list<Instance> init, BVHBuild method = BVHBuild::SAH)
+	    : instances_(init)
+	{
+		build(std::execution::seq, method);
+	}
+
+	[[nodiscard]] size_type size() const noexcept { return instances_.size(); }
+
+	[[nodiscard]] bool empty() const noexcept { return instances_.empty(); }
+
+	[[nodiscard]] bounds_type bounds() const { return top_.bounds(); }
+
+	[[nodiscard]] std::vector<Instance> const& instances() const noexcept
+	{
+		return instances_;
+	}
+
+	/*!
+	 * @brief The top level, a tree over the world bounds of the non-empty instances.
+	 */
+	[[nodiscard]] BVH<bounds_type> const& top() const noexcept { return top_; }
+
+	/*!
+	 * @brief The instance of each input position of the top level, in increasing order.
+	 */
+	[[nodiscard]] std::vector<size_type> const& topInstances() const noexcept
+	{
+		return top_instances_;
+	}
+
+	/*!
+	 * @brief Moves instance `i`.
+	 *
+	 * As for `BVH::update`, the top level is not changed until `refit` or `restructure`
+	 * is called.
+	 */
+	void setTransform(size_type i, rotation_type const& rotation,
+	                  vector_type const& translation)
+	{
+		instances_[i].rotation    = rotation;
+		instances_[i].translation = translation;
+		to_local_[i]              = toLocal(instances_[i]);
+		if (!instances_[i].shape->empty()) {
+			auto const k = std::lower_bound(top_instances_.begin(), top_instances_.end(), i);
+			top_.update(static_cast<size_type>(k - top_instances_.begin()),
+			            worldBounds(instances_[i]));
+		}
+	}
+
+	/*!
+	 * @brief Corrects the top level after `setTransform`, see `BVH::refit`.
+	 */
+	void refit() { top_.refit(); }
+
+	/*!
+	 * @brief Same as above, but executed according to `policy`.
+	 */
+	template <
+	    class ExecutionPolicy,
+	    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+	        true>
+	void refit(ExecutionPolicy&& policy)
+	{
+		top_.refit(std::forward<ExecutionPolicy>(policy));
+	}
+
+	/*!
+	 * @brief Corrects the top level after `setTransform` and rebuilds the parts of it that
+	 * have degraded, see `BVH::restructure`.
+	 */
+	size_type restructure(value_type threshold = 2, BVHBuild method = BVHBuild::SAH)
+	{
+		return top_.restructure(threshold, method);
+	}
+
+	/*!
+	 * @brief Same as above, but executed according to `policy`.
+	 */
+	template <
+	    class ExecutionPolicy,
+	    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+	        true>
+	size_type restructure(ExecutionPolicy&& policy, value_type threshold = 2,
+	                      BVHBuild method = BVHBuild::SAH)
+	{
+		return top_.restructure(std::forward<ExecutionPolicy>(policy), threshold, method);
+	}
+
+	/*!
+	 * @brief Writes the instance and the input position within its shape of every
+	 * geometry intersecting `query`, as `std::pair<size_type, size_type>`, to `d_first`.
+	 *
+	 * @return Output iterator to the element past the last element written.
+	 */
+	template <class Query, class OutputIt>
+	OutputIt intersects(Query const& query, OutputIt d_first) const
+	{
+		top_.traverse(
+		    [&query](bounds_type const& b) { return detail::intersectsKernel(b, query); },
+		    [this, &query, &d_first](bounds_type const&, size_type k) {
+			    auto const i     = top_instances_[k];
+			    auto const local = transformQuery(query, to_local_[i]);
+			    instances_[i].shape->traverse(
+			        [&local](bounds_type const& b) {
+				        return detail::intersectsKernel(b, local);
+			        },
+			        [&local, &d_first, i](Geometry const& g, size_type j) {
+				        if (detail::intersectsKernel(g, local)) {
+					        *d_first++ = std::pair<size_type, size_type>(i, j);
+				        }
+			        });
+		    });
+		return d_first;
+	}
+
+	/*!
+	 * @brief The geometry closest to `query` over all instances, considering only
+	 * distances smaller than `max`.
+	 *
+	 * Rigid transforms preserve distances, so the distance in the frame of an instance is
+	 * the distance in the world. The instances are visited closest first and each is
+	 * searched only for geometries closer than the best found so far.
+	 */
+	template <class Query>
+	[[nodiscard]] Nearest nearest(
+	    Query const& query,
+	    value_type   max = std::numeric_limits<value_type>::infinity()) const
+	{
+		Nearest res{size(), npos, max};
+		(void)top_.traverseNearest(
+		    [&query](bounds_type const& b) {
+			    return static_cast<value_type>(detail::distanceKernel(b, query));
+		    },
+		    [this, &query, &res](bounds_type const&, size_type k) {
+			    auto const i      = top_instances_[k];
+			    auto const local  = transformQuery(query, to_local_[i]);
+			    auto const [j, d] = instances_[i].shape->traverseNearest(
+			        [&local](bounds_type const& b) {
+				        return static_cast<value_type>(detail::distanceKernel(b, local));
+			        },
+			        [&local](Geometry const& g, size_type) {
+				        return static_cast<value_type>(detail::distanceKernel(g, local));
+			        },
+			        res.distance);
+			    if (d < res.distance) {
+				    res = {i, j, d};
+			    }
+			    return d;
+		    },
+		    max);
+		return res;
+	}
+
+ private:
+	template <class ExecutionPolicy>
+	void build(ExecutionPolicy&& policy, BVHBuild method)
+	{
+		top_instances_.clear();
+		for (size_type i{}; instances_.size() > i; ++i) {
+			if (!instances_[i].shape->empty()) {
+				top_instances_.push_back(i);
+			}
+		}
+		std::vector<bounds_type> bounds(top_instances_.size());
+		std::transform(policy, top_instances_.begin(), top_instances_.end(), bounds.begin(),
+		               [this](size_type i) { return worldBounds(instances_[i]); });
+		to_local_.assign(instances_.size(), detail::Rigid<dimension, value_type>(
+		                                        rotation_type(), vector_type()));
+		std::transform(policy, instances_.begin(), instances_.end(), to_local_.begin(),
+		               [](Instance const& a) { return toLocal(a); });
+		top_ = BVH<bounds_type>(policy, bounds.begin(), bounds.end(), method);
+	}
+
+	[[nodiscard]] static bounds_type worldBounds(Instance const& a)
+	{
+		return aabb(a.rotation, a.translation, a.shape->bounds());
+	}
+
+	/*!
+	 * @brief The inverse of the transform of `a`, from the world to the frame of `a`.
+	 */
+	[[nodiscard]] static detail::Rigid<dimension, value_type> toLocal(Instance const& a)
+	{
+		detail::Rigid<dimension, value_type> res(transpose(a.rotation), vector_type());
+		res.t = -res.rotate(a.translation);
+		return res;
+	}
+
+	template <class Query>
+	[[nodiscard]] static auto transformQuery(
+	    Query const& query, detail::Rigid<dimension, value_type> const& tf)
+	{
+		if constexpr (std::is_same_v<bounds_type, Query>) {
+			return detail::transform(
+			    OBB<dimension, value_type>(query.center(), query.halfLength()), tf);
+		} else {
+			return detail::transform(query, tf);
+		}
+	}
+
+	std::vector<Instance>                             instances_;
+	std::vector<detail::Rigid<dimension, value_type>> to_local_;
+	std::vector<size_type>                            top_instances_;
+	BVH<bounds_type>                                  top_;
+};
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_INSTANCED_BVH_HPP
@@ -44,21 +44,40 @@
 
 // UFO
 #include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/aabc.hpp>
 #include <ufo/geometry/capsule.hpp>
 #include <ufo/geometry/closest_point.hpp>
+#include <ufo/geometry/cone.hpp>
+#include <ufo/geometry/convex_polyhedron.hpp>
+#include <ufo/geometry/cylinder.hpp>
+#include <ufo/geometry/detail/gjk.hpp>
 #include <ufo/geometry/detail/helper.hpp>
+#include <ufo/geometry/detail/spherical_sector.hpp>
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/ellipsoid.hpp>
 #include <ufo/geometry/frustum.hpp>
+#include <ufo/geometry/fun.hpp>
 #include <ufo/geometry/line.hpp>
 #include <ufo/geometry/line_segment.hpp>
 #include <ufo/geometry/obb.hpp>
 #include <ufo/geometry/plane.hpp>
+#include <ufo/geometry/polygon.hpp>
 #include <ufo/geometry/ray.hpp>
+#include <ufo/geometry/raycast.hpp>
 #include <ufo/geometry/sphere.hpp>
+#include <ufo/geometry/spherical_sector.hpp>
+#include <ufo/geometry/support.hpp>
 #include <ufo/geometry/triangle.hpp>
+#include <ufo/geometry/type_traits.hpp>
 #include <ufo/math/vec.hpp>
 
 // STL
+#include <algorithm>
 #include <cmath>
+#include <execution>
+#include <limits>
+#include <type_traits>
+#include <utility>
 
 namespace ufo
 {
@@ -100,15 +119,42 @@ template <std::size_t Dim, class T>
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr bool intersects(AABB<Dim, T> const& a, Frustum<Dim, T> const& b)
 {
+	static_assert(2 == Dim || 3 == Dim, "Only 2D and 3D frustums are supported.");
+
 	if constexpr (2 == Dim) {
-		// TODO: Implement
-		return false;
-	} else if constexpr (3 == Dim) {
+		// Separating axis test against the quadrilateral, along the axes of the box and the
+		// normals of the sides
+		auto const c = corners(b);
+		AABB<2, T> box(c[0], c[0]);
+		for (auto const& p : c) {
+			box.min = min(box.min, p);
+			box.max = max(box.max, p);
+		}
+		if (!intersects(a, box)) {
+			return false;
+		}
+
+		auto const center = a.center();
+		auto const hl     = a.halfLength();
+		for (auto const& n : {b.left.normal, b.right.normal, b.far.normal, b.near.normal}) {
+			T const m  = dot(n, center);
+			T const r  = std::abs(n.x) * hl.x + std::abs(n.y) * hl.y;
+			T       lo = dot(n, c[0]);
+			T       hi = lo;
+			for (std::size_t i = 1; c.size() > i; ++i) {
+				T const d = dot(n, c[i]);
+				lo        = std::min(lo, d);
+				hi        = std::max(hi, d);
+			}
+			if (m + r < lo || m - r > hi) {
+				return false;
+			}
+		}
+		return true;
+	} else {
 		return 0 <= detail::classify(a, b.bottom) && 0 <= detail::classify(a, b.far) &&
 		       0 <= detail::classify(a, b.left) && 0 <= detail::classify(a, b.near) &&
 		       0 <= detail::classify(a, b.right) && 0 <= detail::classify(a, b.top);
-	} else {
-		// TODO: Implement
 	}
 }
 
@@ -216,41 +262,71 @@ bool overlapOnAxis(AABB<Dim, T> const& a, OBB<Dim, T> const& b, Vec<Dim, T> cons
 	return ((bb.min <= aa.max) && (aa.min <= bb.max));
 }
 
+/*!
+ * @brief Separating axis test, with the face axes of both boxes and in 3D also their
+ * edge cross products (C. Ericson, "Real-Time Collision Detection", 2005, 4.4.1).
+ */
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr bool intersects(AABB<Dim, T> const& a, OBB<Dim, T> const& b)
 {
-	using Point = Vec<Dim, T>;
+	static_assert(2 == Dim || 3 == Dim, "Only 2D and 3D are supported.");
 
-	if constexpr (2 == Dim) {
-		// TODO: Implement
+	// Keeps nearly parallel edges, whose cross product is close to zero, from separating
+	constexpr T eps = T(1e-6);
 
-		std::array<Point, 4> test = {Point(1, 0),  // AABB axis 1
-		                             Point(0, 1),  // AABB axis 2
-		                             normalize(Point(b.half_length.x, 0)) * b.rotation,
-		                             normalize(Point(0, b.half_length.y)) * b.rotation};
+	auto const ea = a.halfLength();
+	auto const eb = b.half_length;
+	auto const t  = b.center - a.center();
 
-		return std::all_of(test.begin(), test.end(),
-		                   [&a, &b](auto const& t) { return overlapOnAxis(a, b, t); });
-	} else if constexpr (3 == Dim) {
-		std::array<float, 9> obb_rot_matrix = b.rotation.rotMatrix();
-
-		std::array<Point, 15> test = {
-		    Point(1, 0, 0),  // AABB axis 1
-		    Point(0, 1, 0),  // AABB axis 2
-		    Point(0, 0, 1),  // AABB axis 3
-		    Point(obb_rot_matrix[0], obb_rot_matrix[1], obb_rot_matrix[2]),
-		    Point(obb_rot_matrix[3], obb_rot_matrix[4], obb_rot_matrix[5]),
-		    Point(obb_rot_matrix[6], obb_rot_matrix[7], obb_rot_matrix[8])};
-
-		for (std::size_t i{}; 3 > i; ++i) {  // Fill out rest of axis
-			test[6 + i * 3 + 0] = Point::cross(test[i], test[3]);
-			test[6 + i * 3 + 1] = Point::cross(test[i], test[4]);
-			test[6 + i * 3 + 2] = Point::cross(test[i], test[5]);
+	// The axes of `b` in the frame of `a`
+	T r[Dim][Dim];
+	T ar[Dim][Dim];
+	for (std::size_t i{}; Dim > i; ++i) {
+		for (std::size_t j{}; Dim > j; ++j) {
+			r[i][j]  = b.rotation[j][i];
+			ar[i][j] = std::abs(r[i][j]) + eps;
 		}
+	}
 
-		return std::all_of(std::cbegin(test), std::cend(test),
-		                   [&a, &b](auto const& t) { return overlapOnAxis(a, b, t); });
+	for (std::size_t i{}; Dim > i; ++i) {
+		T rb{};
+		for (std::size_t j{}; Dim > j; ++j) {
+			rb += eb[j] * ar[i][j];
+		}
+		if (std::abs(t[i]) > ea[i] + rb) {
+			return false;
+		}
 	}
+
+	for (std::size_t j{}; Dim > j; ++j) {
+		T ra{};
+		T d{};
+		for (std::size_t i{}; Dim > i; ++i) {
+			ra += ea[i] * ar[i][j];
+			d += t[i] * r[i][j];
+		}
+		if (std::abs(d) > ra + eb[j]) {
+			return false;
+		}
+	}
+
+	if constexpr (3 == Dim) {
+		for (std::size_t i{}; 3 > i; ++i) {
+			std::size_t const i1 = (i + 1) % 3;
+			std::size_t const i2 = (i + 2) % 3;
+			for (std::size_t j{}; 3 > j; ++j) {
+				std::size_t const j1 = (j + 1) % 3;
+				std::size_t const j2 = (j + 2) % 3;
+				T const           ra = ea[i1] * ar[i2][j] + ea[i2] * ar[i1][j];
+				T const           rb = eb[j1] * ar[i][j2] + eb[j2] * ar[i][j1];
+				if (std::abs(t[i2] * r[i1][j] - t[i1] * r[i2][j]) > ra + rb) {
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
 }
 
 template <class T>
@@ -330,6 +406,137 @@ template <std::size_t Dim, class T>
 	return all(lessThanEqual(min(a), b)) && all(lessThanEqual(b, max(a)));
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(AABB<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	return intersects(b, a);
+}
+
+template <class T>
+[[nodiscard]] bool intersects(AABB<3, T> const& a, ConvexPolyhedron<T> const& b)
+{
+	return intersects(b, a);
+}
+
+template <class T>
+[[nodiscard]] bool intersects(AABB<2, T> const& a, Polygon<T> const& b)
+{
+	return intersects(b, a);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(AABB<Dim, T> const&      a,
+                                        Ellipsoid<Dim, T> const& b)
+{
+	return intersects(b, a);
+}
+
+template <class T>
+[[nodiscard]] bool intersects(AABB<3, T> const& a, SphericalSector<T> const& b)
+{
+	return intersects(b, a);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        AABC                                         |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(AABC<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	T const hl = a.half_length + b.half_length;
+	for (std::size_t i{}; Dim > i; ++i) {
+		if (hl < std::abs(a.center[i] - b.center[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(AABC<Dim, T> const& a, AABB<Dim, T> const& b)
+{
+	for (std::size_t i{}; Dim > i; ++i) {
+		T const hl = a.half_length;
+		if (a.center[i] - hl > b.max[i] || a.center[i] + hl < b.min[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(AABC<Dim, T> const& a, Capsule<Dim, T> const& b)
+{
+	return intersects(AABB<Dim, T>(a), b);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(AABC<Dim, T> const& a, Frustum<Dim, T> const& b)
+{
+	if constexpr (3 == Dim) {
+		return 0 <= detail::classify(a, b.bottom) && 0 <= detail::classify(a, b.far) &&
+		       0 <= detail::classify(a, b.left) && 0 <= detail::classify(a, b.near) &&
+		       0 <= detail::classify(a, b.right) && 0 <= detail::classify(a, b.top);
+	} else {
+		return intersects(AABB<Dim, T>(a), b);
+	}
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(AABC<Dim, T> const&        a,
+                                        LineSegment<Dim, T> const& b)
+{
+	Ray<Dim, T> ray;
+	ray.origin    = b.start;
+	ray.direction = b.end - b.start;
+	T length      = norm(ray.direction);
+	ray.direction /= length;
+	return detail::intersectsLine(a, ray, T(0), length);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(AABC<Dim, T> const& a, Sphere<Dim, T> const& b)
+{
+	T distance_squared{};
+	for (std::size_t i{}; Dim > i; ++i) {
+		T d = std::max(std::abs(b.center[i] - a.center[i]) - a.half_length, T(0));
+		distance_squared += d * d;
+	}
+	return distance_squared <= b.radius * b.radius;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(AABC<Dim, T> const& a, OBB<Dim, T> const& b)
+{
+	return intersects(AABB<Dim, T>(a), b);
+}
+
+template <class T>
+[[nodiscard]] constexpr bool intersects(AABC<3, T> const& a, Plane<T> const& b)
+{
+	return T(0) == detail::classify(a, b);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(AABC<Dim, T> const& a, Ray<Dim, T> const& b)
+{
+	return detail::intersectsLine(a, b, T(0), std::numeric_limits<T>::max());
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(AABC<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	for (std::size_t i{}; Dim > i; ++i) {
+		if (a.half_length < std::abs(b[i] - a.center[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
 /**************************************************************************************
 |                                                                                     |
 |                                       Sphere                                        |
@@ -342,6 +549,12 @@ template <std::size_t Dim, class T>
 	return intersects(b, a);
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Sphere<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	return intersects(b, a);
+}
+
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr bool intersects(Sphere<Dim, T> const& a, Sphere<Dim, T> const& b)
 {
@@ -380,8 +593,14 @@ template <std::size_t Dim, class T>
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr bool intersects(Sphere<Dim, T> const& a, OBB<Dim, T> const& b)
 {
-	auto closest_point    = closestPoint(b, a.center);
-	auto distance_squared = distanceSquared(closest_point, a.center);
+	// Distance from the center to the box, in the frame of the box
+	auto const d = a.center - b.center;
+	T          distance_squared{};
+	for (std::size_t i{}; Dim > i; ++i) {
+		T const l = dot(d, b.rotation[i]);
+		T const e = std::abs(l) - b.half_length[i];
+		distance_squared += T(0) < e ? e * e : T(0);
+	}
 	return distance_squared <= (a.radius * a.radius);
 }
 
@@ -416,6 +635,25 @@ template <std::size_t Dim, class T>
 	return normSquared(b - a.center) <= (a.radius * a.radius);
 }
 
+template <class T>
+[[nodiscard]] bool intersects(Sphere<3, T> const& a, ConvexPolyhedron<T> const& b)
+{
+	return intersects(b, a);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Sphere<Dim, T> const& a,
+                                        Cylinder<Dim, T> const& b)
+{
+	return intersects(b, a);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Sphere<Dim, T> const& a, Cone<Dim, T> const& b)
+{
+	return intersects(b, a);
+}
+
 /**************************************************************************************
 |                                                                                     |
 |                                       Capsule                                       |
@@ -428,6 +666,12 @@ template <std::size_t Dim, class T>
 	return intersects(b, a);
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Capsule<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	return intersects(b, a);
+}
+
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr bool intersects(Capsule<Dim, T> const& a, Sphere<Dim, T> const& b)
 {
@@ -497,6 +741,12 @@ template <std::size_t Dim, class T>
 	return intersects(b, a);
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Frustum<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	return intersects(b, a);
+}
+
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr bool intersects(Frustum<Dim, T> const& a, Sphere<Dim, T> const& b)
 {
@@ -577,6 +827,13 @@ template <std::size_t Dim, class T>
 	return intersects(b, a);
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(LineSegment<Dim, T> const& a,
+                                        AABC<Dim, T> const&        b)
+{
+	return intersects(b, a);
+}
+
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr bool intersects(LineSegment<Dim, T> const& a,
                                         Sphere<Dim, T> const&      b)
@@ -754,6 +1011,12 @@ template <std::size_t Dim, class T>
 	return intersects(b, a);
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(OBB<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	return intersects(b, a);
+}
+
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr bool intersects(OBB<Dim, T> const& a, Sphere<Dim, T> const& b)
 {
@@ -917,6 +1180,12 @@ template <class T>
 	return intersects(b, a);
 }
 
+template <class T>
+[[nodiscard]] constexpr bool intersects(Plane<T> const& a, AABC<3, T> const& b)
+{
+	return intersects(b, a);
+}
+
 template <class T>
 [[nodiscard]] constexpr bool intersects(Plane<T> const& a, Sphere<3, T> const& b)
 {
@@ -993,6 +1262,12 @@ template <std::size_t Dim, class T>
 	return intersects(b, a);
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Ray<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	return intersects(b, a);
+}
+
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr bool intersects(Ray<Dim, T> const& a, Sphere<Dim, T> const& b)
 {
@@ -1053,6 +1328,18 @@ template <std::size_t Dim, class T>
 	return T(1) == dot(direction, a.direction);
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Ray<Dim, T> const& a, Cylinder<Dim, T> const& b)
+{
+	return intersects(b, a);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Ray<Dim, T> const& a, Cone<Dim, T> const& b)
+{
+	return intersects(b, a);
+}
+
 /**************************************************************************************
 |                                                                                     |
 |                                      Triangle                                       |
@@ -1125,6 +1412,234 @@ template <std::size_t Dim, class T>
 // 	// TODO: Implement
 // }
 
+/**************************************************************************************
+|                                                                                     |
+|                                  Convex polyhedron                                  |
+|                                                                                     |
+**************************************************************************************/
+
+template <class T>
+[[nodiscard]] bool intersects(ConvexPolyhedron<T> const& a, AABB<3, T> const& b)
+{
+	if (a.empty()) {
+		return false;
+	}
+
+	// Planes of the polyhedron, the box is outside if it is fully in front of any
+	auto const c   = b.center();
+	auto const h   = b.halfLength();
+	T          sep = std::numeric_limits<T>::lowest();
+	for (auto const& p : a.planes) {
+		T r = std::abs(h.x * p.normal.x) + std::abs(h.y * p.normal.y) +
+		      std::abs(h.z * p.normal.z);
+		T d = p.normal.x * c.x + p.normal.y * c.y + p.normal.z * c.z + p.distance - r;
+		sep = sep < d ? d : sep;
+	}
+	if (T(0) < sep) {
+		return false;
+	}
+
+	// Faces of the box
+	if (!intersects(AABB<3, T>(min(a), max(a)), b)) {
+		return false;
+	}
+
+	// The remaining separating axes are edge-edge, resolved exactly by GJK
+	return detail::gjk<T>([&a](Vec<3, T> const& d) { return a.support(d); },
+	                      [&b](Vec<3, T> const& d) {
+		                      return Vec<3, T>(T(0) > d.x ? b.min.x : b.max.x,
+		                                       T(0) > d.y ? b.min.y : b.max.y,
+		                                       T(0) > d.z ? b.min.z : b.max.z);
+	                      },
+	                      a.vertices.front() - c);
+}
+
+template <class T>
+[[nodiscard]] bool intersects(ConvexPolyhedron<T> const& a, Sphere<3, T> const& b)
+{
+	if (a.empty()) {
+		return false;
+	}
+
+	T const sep = a.signedDistance(b.center);
+	if (b.radius < sep) {
+		return false;
+	} else if (T(0) >= sep) {
+		return true;
+	}
+
+	return detail::gjk<T>([&a](Vec<3, T> const& d) { return a.support(d); },
+	                      [&b](Vec<3, T> const& d) { return support(b, d); },
+	                      a.vertices.front() - b.center);
+}
+
+template <class T>
+[[nodiscard]] bool intersects(ConvexPolyhedron<T> const& a, ConvexPolyhedron<T> const& b)
+{
+	if (a.empty() || b.empty() ||
+	    !intersects(AABB<3, T>(min(a), max(a)), AABB<3, T>(min(b), max(b)))) {
+		return false;
+	}
+
+	return detail::gjk<T>([&a](Vec<3, T> const& d) { return a.support(d); },
+	                      [&b](Vec<3, T> const& d) { return b.support(d); },
+	                      a.vertices.front() - b.vertices.front());
+}
+
+template <class T>
+[[nodiscard]] bool intersects(ConvexPolyhedron<T> const& a, Vec<3, T> const& b)
+{
+	return !a.empty() && T(0) >= a.signedDistance(b);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                       Polygon                                       |
+|                                                                                     |
+**************************************************************************************/
+
+template <class T>
+[[nodiscard]] bool intersects(Polygon<T> const& a, AABB<2, T> const& b)
+{
+	// If no edge touches the box, either the box is inside or they are disjoint
+	return !a.empty() && intersects(a.bounds(), b) &&
+	       (a.intersectsBoundary(b) || a.contains(b.center()));
+}
+
+template <class T>
+[[nodiscard]] bool intersects(Polygon<T> const& a, Vec<2, T> const& b)
+{
+	return a.contains(b);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Ellipsoid                                      |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Ellipsoid<Dim, T> const& a,
+                                        AABB<Dim, T> const&      b)
+{
+	return intersects(AABB<Dim, T>(min(a), max(a)), b) &&
+	       T(1) >= a.mahalanobisSquared(b);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Ellipsoid<Dim, T> const& a,
+                                        Vec<Dim, T> const&       b)
+{
+	return T(1) >= a.mahalanobisSquared(b);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Cylinder                                       |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Cylinder<Dim, T> const& a,
+                                        Sphere<Dim, T> const&   b)
+{
+	return b.radius * b.radius >= distanceSquared(a, b.center);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Cylinder<Dim, T> const& a, Ray<Dim, T> const& b)
+{
+	return std::numeric_limits<T>::infinity() != raycast(a, b);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Cylinder<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	return T(0) == distanceSquared(a, b);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        Cone                                         |
+|                                                                                     |
+**************************************************************************************/
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Cone<Dim, T> const& a, Sphere<Dim, T> const& b)
+{
+	return b.radius * b.radius >= distanceSquared(a, b.center);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Cone<Dim, T> const& a, Ray<Dim, T> const& b)
+{
+	return std::numeric_limits<T>::infinity() != raycast(a, b);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Cone<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	return T(0) == distanceSquared(a, b);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                  Spherical sector                                   |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Checks if `a` and `b` may intersect, for culling octree nodes against the field
+ * of view of a sensor.
+ *
+ * A box that intersects `a` is always reported. The range, elevation, and azimuth
+ * intervals are tested one at a time, so a box just outside a corner of `a` may be
+ * reported as well.
+ */
+template <class T>
+[[nodiscard]] bool intersects(SphericalSector<T> const& a, AABB<3, T> const& b)
+{
+	return detail::SphericalSectorTest<T>(a).intersects(b);
+}
+
+template <class T>
+[[nodiscard]] bool intersects(SphericalSector<T> const& a, Vec<3, T> const& b)
+{
+	return detail::SphericalSectorTest<T>(a).intersects(b);
+}
+
+/*!
+ * @brief Checks if `a` intersects each point or AABB in [first, last) and stores the
+ * results in the range beginning at `d_first`.
+ *
+ * The angles of `a` are only converted once, for all elements.
+ *
+ * @return Output iterator to the element past the last result.
+ */
+template <class T, class InputIt, class OutputIt>
+OutputIt intersects(SphericalSector<T> const& a, InputIt first, InputIt last,
+                    OutputIt d_first)
+{
+	detail::SphericalSectorTest<T> const test(a);
+	return std::transform(first, last, d_first,
+	                      [&test](auto const& b) { return test.intersects(b); });
+}
+
+/*!
+ * @brief Same as above, but executed according to `policy`.
+ */
+template <
+    class ExecutionPolicy, class T, class ForwardIt1, class ForwardIt2,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+ForwardIt2 intersects(ExecutionPolicy&& policy, SphericalSector<T> const& a,
+                      ForwardIt1 first, ForwardIt1 last, ForwardIt2 d_first)
+{
+	detail::SphericalSectorTest<T> const test(a);
+	return std::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                      [&test](auto const& b) { return test.intersects(b); });
+}
+
 /**************************************************************************************
 |                                                                                     |
 |                                         Vec                                         |
@@ -1137,6 +1652,12 @@ template <std::size_t Dim, class T>
 	return intersects(b, a);
 }
 
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Vec<Dim, T> const& a, AABC<Dim, T> const& b)
+{
+	return intersects(b, a);
+}
+
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr bool intersects(Vec<Dim, T> const& a, Sphere<Dim, T> const& b)
 {
@@ -1186,11 +1707,119 @@ template <std::size_t Dim, class T>
 	return intersects(b, a);
 }
 
+template <class T>
+[[nodiscard]] bool intersects(Vec<3, T> const& a, ConvexPolyhedron<T> const& b)
+{
+	return intersects(b, a);
+}
+
+template <class T>
+[[nodiscard]] bool intersects(Vec<2, T> const& a, Polygon<T> const& b)
+{
+	return intersects(b, a);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Vec<Dim, T> const&       a,
+                                        Ellipsoid<Dim, T> const& b)
+{
+	return intersects(b, a);
+}
+
 template <std::size_t Dim, class T>
 [[nodiscard]] constexpr bool intersects(Vec<Dim, T> const& a, Vec<Dim, T> const& b)
 {
 	return all(a == b);
 }
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Vec<Dim, T> const& a, Cylinder<Dim, T> const& b)
+{
+	return intersects(b, a);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr bool intersects(Vec<Dim, T> const& a, Cone<Dim, T> const& b)
+{
+	return intersects(b, a);
+}
+
+template <class T>
+[[nodiscard]] bool intersects(Vec<3, T> const& a, SphericalSector<T> const& b)
+{
+	return intersects(b, a);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                       Generic                                       |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Gilbert-Johnson-Keerthi intersection test for any two convex geometries with
+ * `support` functions, used when there is no dedicated overload.
+ */
+template <class A, class B, std::enable_if_t<is_convex_pair_v<A, B>, bool> = true>
+[[nodiscard]] constexpr bool intersectsConvex(A const& a, B const& b)
+{
+	using T = typename geometry_traits<A>::value_type;
+	return detail::gjk<T>([&a](Vec<3, T> const& d) { return support(a, d); },
+	                      [&b](Vec<3, T> const& d) { return support(b, d); },
+	                      Vec<3, T>(T(1), T(0), T(0)));
+}
+
+namespace detail
+{
+/*!
+ * @brief `intersects` with the kernel selected at compile time, see
+ * `intersects_kernel_v`.
+ */
+template <class A, class B>
+[[nodiscard]] constexpr bool intersectsKernel(A const& a, B const& b)
+{
+	constexpr QueryKernel kernel = intersects_kernel_v<A, B>;
+	static_assert(QueryKernel::NONE != kernel,
+	              "There is no intersects for this pair of geometries.");
+
+	if constexpr (QueryKernel::DIRECT == kernel) {
+		return intersects(a, b);
+	} else if constexpr (QueryKernel::REVERSED == kernel) {
+		return intersects(b, a);
+	} else {
+		return intersectsConvex(a, b);
+	}
+}
+}  // namespace detail
+
+/*!
+ * @brief Checks if `a` intersects each geometry in [first, last) and stores the results
+ * in the range beginning at `d_first`.
+ *
+ * Works for any pair with an `intersects_kernel_v` other than `QueryKernel::NONE`.
+ *
+ * @return Output iterator to the element past the last result.
+ */
+template <class A, class InputIt, class OutputIt>
+OutputIt intersects(A const& a, InputIt first, InputIt last, OutputIt d_first)
+{
+	return std::transform(first, last, d_first,
+	                      [&a](auto const& b) { return detail::intersectsKernel(a, b); });
+}
+
+/*!
+ * @brief Same as above, but executed according to `policy`.
+ */
+template <
+    class ExecutionPolicy, class A, class ForwardIt1, class ForwardIt2,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+ForwardIt2 intersects(ExecutionPolicy&& policy, A const& a, ForwardIt1 first,
+                      ForwardIt1 last, ForwardIt2 d_first)
+{
+	return std::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                      [&a](auto const& b) { return detail::intersectsKernel(a, b); });
+}
 }  // namespace ufo
 
 #endif  // UFO_GEOMETRY_INTERSECTS_HPP
\ No newline at end of file
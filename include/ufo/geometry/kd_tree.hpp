@@ -0,0 +1,482 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_KD_TREE_HPP
+#define UFO_GEOMETRY_KD_TREE_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/bounding_volume.hpp>
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/intersects.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief An implicit KD-tree over points.
+ *
+ * The points are reordered so that the tree needs no nodes: the range [first, last) is
+ * split at the median at `first + (last - first) / 2`, along the axis where the range
+ * spreads the most, and the two halves are the children. Ranges of at most `leaf_size`
+ * points are leaves and are scanned linearly. The only extra storage is the split axis
+ * of each median and the original index of each point.
+ *
+ * The medians are found with `std::nth_element`. In parallel builds the top of the tree
+ * is split with each selection running according to the policy, until there are enough
+ * ranges to build their subtrees in parallel.
+ *
+ * Queries report points by their index in the range the tree was built from.
+ */
+template <std::size_t Dim, class T = float>
+class KDTree
+{
+ public:
+	using value_type  = T;
+	using size_type   = std::size_t;
+	using point_type  = Vec<Dim, T>;
+	using bounds_type = AABB<Dim, T>;
+
+	static constexpr std::size_t dimension = Dim;
+
+	struct Neighbor {
+		size_type  index;
+		value_type distance_squared;
+
+		friend constexpr bool operator==(Neighbor const& lhs, Neighbor const& rhs) noexcept
+		{
+			return lhs.index == rhs.index && lhs.distance_squared == rhs.distance_squared;
+		}
+	};
+
+	/*!
+	 * @brief Index of no point, returned by queries that find nothing.
+	 */
+	static constexpr size_type NO_INDEX = std::numeric_limits<size_type>::max();
+
+	/*!
+	 * @brief The maximum depth of the tree, which bounds the traversal stack. The tree is
+	 * balanced, so it is never reached.
+	 */
+	static constexpr std::size_t MAX_DEPTH = 64;
+
+	KDTree() = default;
+
+	template <class InputIt>
+	KDTree(InputIt first, InputIt last, size_type leaf_size = 8)
+	    : points_(first, last), leaf_size_(std::max<size_type>(1, leaf_size))
+	{
+		build(std::execution::seq);
+	}
+
+	/*!
+	 * @brief Builds the tree over [first, last) according to `policy`.
+	 */
+	template <
+	    class ExecutionPolicy, class RandomIt,
+	    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+	        true>
+	KDTree(ExecutionPolicy&& policy, RandomIt first, RandomIt last, size_type leaf_size = 8)
+	    : points_(first, last), leaf_size_(std::max<size_type>(1, leaf_size))
+	{
+		build(std::forward<ExecutionPolicy>(policy));
+	}
+
+	KDTree(std::initializer_list<point_type> init, size_type leaf_size = 8)
+	    : KDTree(init.begin(), init.end(), leaf_size)
+	{
+	}
+
+	[[nodiscard]] size_type size() const noexcept { return points_.size(); }
+
+	[[nodiscard]] bool empty() const noexcept { return points_.empty(); }
+
+	[[nodiscard]] size_type leafSize() const noexcept { return leaf_size_; }
+
+	[[nodiscard]] bounds_type const& bounds() const noexcept { return bounds_; }
+
+	/*!
+	 * @brief Calls `f(point, index)` for every point in a cell whose bounds, and the
+	 * bounds of all cells containing it, satisfy `descend`.
+	 */
+	template <class Descend, class F>
+	void traverse(Descend descend, F f) const
+	{
+		(void)traverseAny(descend, [&f](point_type const& p, size_type index) {
+			f(p, index);
+			return false;
+		});
+	}
+
+	/*!
+	 * @brief Same as `traverse`, but stops as soon as `f(point, index)` returns `true`.
+	 *
+	 * @return Whether `f` returned `true` for any point.
+	 */
+	template <class Descend, class F>
+	[[nodiscard]] bool traverseAny(Descend descend, F f) const
+	{
+		if (empty()) {
+			return false;
+		}
+
+		struct Cell {
+			size_type   first;
+			size_type   last;
+			bounds_type bounds;
+		};
+
+		std::array<Cell, MAX_DEPTH> stack;
+		std::size_t                 top{};
+		stack[top++] = {0, size(), bounds_};
+		while (top) {
+			Cell const cell = stack[--top];
+			if (!descend(cell.bounds)) {
+				continue;
+			}
+
+			if (leaf_size_ >= cell.last - cell.first) {
+				for (size_type i = cell.first; cell.last > i; ++i) {
+					if (f(points_[i], index_[i])) {
+						return true;
+					}
+				}
+				continue;
+			}
+
+			size_type const   mid  = cell.first + (cell.last - cell.first) / 2;
+			std::size_t const axis = axis_[mid];
+			if (f(points_[mid], index_[mid])) {
+				return true;
+			}
+
+			Cell right{mid + 1, cell.last, cell.bounds};
+			Cell left{cell.first, mid, cell.bounds};
+			right.bounds.min[axis] = points_[mid][axis];
+			left.bounds.max[axis]  = points_[mid][axis];
+			stack[top++]           = right;
+			stack[top++]           = left;
+		}
+		return false;
+	}
+
+	/*!
+	 * @brief Writes the index of every point intersecting `query` (e.g., inside a
+	 * `Sphere` or an `AABB`) to `d_first`.
+	 *
+	 * @return Output iterator to the element past the last element written.
+	 */
+	template <class Query, class OutputIt>
+	OutputIt intersects(Query const& query, OutputIt d_first) const
+	{
+		traverse(
+		    [&query](bounds_type const& b) { return detail::intersectsKernel(b, query); },
+		    [&query, &d_first](point_type const& p, size_type index) {
+			    if (detail::intersectsKernel(p, query)) {
+				    *d_first++ = index;
+			    }
+		    });
+		return d_first;
+	}
+
+	/*!
+	 * @brief Writes a `Neighbor` for every point at most `radius` from `center` to
+	 * `d_first`, in no particular order.
+	 *
+	 * @return Output iterator to the element past the last element written.
+	 */
+	template <class OutputIt>
+	OutputIt radius(point_type const& center, value_type radius, OutputIt d_first) const
+	{
+		value_type const r2 = radius * radius;
+		traverse(
+		    [&center, r2](bounds_type const& b) {
+			    return distanceSquared(b, center) <= r2;
+		    },
+		    [&center, r2, &d_first](point_type const& p, size_type index) {
+			    value_type const d = distanceSquared(p, center);
+			    if (d <= r2) {
+				    *d_first++ = Neighbor{index, d};
+			    }
+		    });
+		return d_first;
+	}
+
+	/*!
+	 * @brief Finds the `k` points closest to `query`, considering only distances smaller
+	 * than `max`.
+	 *
+	 * The neighbors are written to the buffer [d_first, d_first + k), which is used as the
+	 * heap of the search so nothing is allocated. The nearer side of each split is visited
+	 * first.
+	 *
+	 * @return The number of neighbors found, at most `k`. They are sorted by increasing
+	 * distance.
+	 */
+	template <class RandomIt>
+	size_type nearest(point_type const& query, size_type k, RandomIt d_first,
+	                  value_type max = std::numeric_limits<value_type>::infinity()) const
+	{
+		if (0 == k || empty()) {
+			return 0;
+		}
+
+		auto const farther = [](Neighbor const& a, Neighbor const& b) {
+			return a.distance_squared < b.distance_squared;
+		};
+
+		size_type  count{};
+		value_type worst = max * max;
+		auto const add   = [&](size_type i) {
+			value_type const d = distanceSquared(points_[i], query);
+			if (!(d < worst)) {
+				return;
+			}
+			if (k > count) {
+				d_first[count++] = Neighbor{index_[i], d};
+				std::push_heap(d_first, d_first + count, farther);
+				if (k > count) {
+					return;
+				}
+			} else {
+				std::pop_heap(d_first, d_first + count, farther);
+				d_first[count - 1] = Neighbor{index_[i], d};
+				std::push_heap(d_first, d_first + count, farther);
+			}
+			// The heap is full, only points closer than its farthest can enter
+			worst = d_first[0].distance_squared;
+		};
+
+		struct Range {
+			size_type  first;
+			size_type  last;
+			value_type lower;
+		};
+
+		std::array<Range, MAX_DEPTH> stack;
+		std::size_t                  top{};
+		stack[top++] = {0, size(), value_type(0)};
+		while (top) {
+			Range const range = stack[--top];
+			if (!(range.lower < worst)) {
+				continue;
+			}
+
+			if (leaf_size_ >= range.last - range.first) {
+				for (size_type i = range.first; range.last > i; ++i) {
+					add(i);
+				}
+				continue;
+			}
+
+			size_type const  mid  = range.first + (range.last - range.first) / 2;
+			value_type const diff = query[axis_[mid]] - points_[mid][axis_[mid]];
+			add(mid);
+
+			Range near{range.first, mid, range.lower};
+			Range far{mid + 1, range.last, std::max(range.lower, diff * diff)};
+			if (value_type(0) <= diff) {
+				std::swap(near.first, far.first);
+				std::swap(near.last, far.last);
+			}
+			// The near side is pushed last so it is visited first
+			if (far.lower < worst) {
+				stack[top++] = far;
+			}
+			stack[top++] = near;
+		}
+
+		std::sort_heap(d_first, d_first + count, farther);
+		return count;
+	}
+
+	/*!
+	 * @brief The point closest to `query`, considering only distances smaller than `max`.
+	 *
+	 * @return The index of the closest point and the distance to it, or `NO_INDEX` and
+	 * `max` if no point is closer than `max`.
+	 */
+	[[nodiscard]] std::pair<size_type, value_type> nearest(
+	    point_type const& query,
+	    value_type        max = std::numeric_limits<value_type>::infinity()) const
+	{
+		Neighbor n;
+		if (0 == nearest(query, 1, &n, max)) {
+			return {NO_INDEX, max};
+		}
+		return {n.index, std::sqrt(n.distance_squared)};
+	}
+
+ private:
+	template <class ExecutionPolicy>
+	void build(ExecutionPolicy&& policy)
+	{
+		auto const n = size();
+		index_.resize(n);
+		std::iota(index_.begin(), index_.end(), size_type(0));
+		axis_.assign(n, 0);
+		bounds_ = n ? boundingAABB(policy, points_.begin(), points_.end())
+		            : detail::emptyAABB<Dim, T>();
+
+		// Ranges larger than `grain` are split here, with each selection running according
+		// to `policy`, until there are enough ranges to build their subtrees in parallel
+		size_type grain = n;
+		if constexpr (!std::is_same_v<std::execution::sequenced_policy,
+		                              std::decay_t<ExecutionPolicy>>) {
+			constexpr size_type min_grain = 4096;
+			size_type const threads = std::max(1u, std::thread::hardware_concurrency());
+			grain                   = std::max(min_grain, n / (8 * threads));
+		}
+
+		std::vector<std::pair<size_type, size_type>> ranges{{0, n}};
+		std::vector<std::pair<size_type, size_type>> roots;
+		for (std::size_t i{}; ranges.size() > i; ++i) {
+			auto const [first, last] = ranges[i];
+			if (grain >= last - first || leaf_size_ >= last - first) {
+				roots.push_back(ranges[i]);
+				continue;
+			}
+			size_type const mid = split(policy, first, last);
+			ranges.emplace_back(first, mid);
+			ranges.emplace_back(mid + 1, last);
+		}
+
+		std::for_each(policy, roots.begin(), roots.end(), [this](auto const& r) {
+			buildSubtree(r.first, r.second);
+		});
+
+		std::vector<point_type> points(n);
+		std::transform(policy, index_.begin(), index_.end(), points.begin(),
+		               [this](size_type i) { return points_[i]; });
+		points_.swap(points);
+	}
+
+	/*!
+	 * @brief Builds the subtree over the points at positions [first, last) of `index_`
+	 * serially.
+	 */
+	void buildSubtree(size_type first, size_type last)
+	{
+		std::array<std::pair<size_type, size_type>, MAX_DEPTH> stack;
+		std::size_t                                            top{};
+		stack[top++] = {first, last};
+		while (top) {
+			auto const [f, l] = stack[--top];
+			if (leaf_size_ >= l - f) {
+				continue;
+			}
+			size_type const mid = split(std::execution::seq, f, l);
+			stack[top++]        = {mid + 1, l};
+			stack[top++]        = {f, mid};
+		}
+	}
+
+	/*!
+	 * @brief Moves the median along the axis where the points at positions [first, last)
+	 * of `index_` spread the most to the middle of the range, with the smaller points
+	 * before it and the larger after it.
+	 *
+	 * @return The position of the median.
+	 */
+	template <class ExecutionPolicy>
+	size_type split(ExecutionPolicy&& policy, size_type first, size_type last)
+	{
+		auto const b = detail::chunkedReduce(
+		    policy, index_.begin() + first, index_.begin() + last,
+		    detail::emptyAABB<Dim, T>(),
+		    [](bounds_type const& a, bounds_type const& b) {
+			    return bounds_type(min(a.min, b.min), max(a.max, b.max));
+		    },
+		    [this](auto f, auto l) {
+			    auto res = detail::emptyAABB<Dim, T>();
+			    for (; f != l; ++f) {
+				    res.min = min(res.min, points_[*f]);
+				    res.max = max(res.max, points_[*f]);
+			    }
+			    return res;
+		    });
+
+		std::size_t axis{};
+		for (std::size_t i = 1; Dim > i; ++i) {
+			if (b.max[i] - b.min[i] > b.max[axis] - b.min[axis]) {
+				axis = i;
+			}
+		}
+
+		size_type const mid = first + (last - first) / 2;
+		std::nth_element(policy, index_.begin() + first, index_.begin() + mid,
+		                 index_.begin() + last, [this, axis](size_type a, size_type b) {
+			                 return points_[a][axis] < points_[b][axis];
+		                 });
+		axis_[mid] = static_cast<std::uint8_t>(axis);
+		return mid;
+	}
+
+ private:
+	// In tree order once built
+	std::vector<point_type> points_;
+	// Index in the input of each point
+	std::vector<size_type> index_;
+	// Split axis of each median, unused for points in leaves
+	std::vector<std::uint8_t> axis_;
+
+	size_type   leaf_size_ = 8;
+	bounds_type bounds_    = detail::emptyAABB<Dim, T>();
+};
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_KD_TREE_HPP
@@ -0,0 +1,694 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_MAPPED_HPP
+#define UFO_GEOMETRY_MAPPED_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/aabc.hpp>
+#include <ufo/geometry/capsule.hpp>
+#include <ufo/geometry/cone.hpp>
+#include <ufo/geometry/cylinder.hpp>
+#include <ufo/geometry/ellipsoid.hpp>
+#include <ufo/geometry/frustum.hpp>
+#include <ufo/geometry/line.hpp>
+#include <ufo/geometry/line_segment.hpp>
+#include <ufo/geometry/obb.hpp>
+#include <ufo/geometry/plane.hpp>
+#include <ufo/geometry/ray.hpp>
+#include <ufo/geometry/sphere.hpp>
+#include <ufo/geometry/spherical_sector.hpp>
+#include <ufo/geometry/triangle.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// POSIX
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define UFO_GEOMETRY_HAS_MMAP 1
+#else
+#define UFO_GEOMETRY_HAS_MMAP 0
+#endif
+
+namespace ufo
+{
+/*!
+ * @brief Identifies the geometry stored in a section of a mapped geometry file.
+ *
+ * Values are part of the on-disk format and must never be reordered. Custom data (e.g.,
+ * the nodes of a spatial index) should specialize `mapped_type` with values starting at
+ * `USER`. Types left at `NONE` cannot be written or read, since the layout alone does
+ * not tell two geometries apart.
+ */
+enum class MappedType : std::uint16_t {
+	NONE             = 0,
+	AABB             = 1,
+	CAPSULE          = 2,
+	FRUSTUM          = 3,
+	LINE             = 4,
+	LINE_SEGMENT     = 5,
+	OBB              = 6,
+	PLANE            = 7,
+	RAY              = 8,
+	SPHERE           = 9,
+	TRIANGLE         = 10,
+	VEC              = 11,
+	AABC             = 12,
+	CYLINDER         = 13,
+	CONE             = 14,
+	ELLIPSOID        = 15,
+	SPHERICAL_SECTOR = 16,
+	USER             = 0x8000
+};
+
+template <class T>
+struct mapped_type : std::integral_constant<MappedType, MappedType::NONE> {
+};
+
+// clang-format off
+template <std::size_t Dim, class T>
+struct mapped_type<AABB<Dim, T>> : std::integral_constant<MappedType, MappedType::AABB> {};
+template <std::size_t Dim, class T>
+struct mapped_type<AABC<Dim, T>> : std::integral_constant<MappedType, MappedType::AABC> {};
+template <std::size_t Dim, class T>
+struct mapped_type<Capsule<Dim, T>> : std::integral_constant<MappedType, MappedType::CAPSULE> {};
+template <std::size_t Dim, class T>
+struct mapped_type<Cone<Dim, T>> : std::integral_constant<MappedType, MappedType::CONE> {};
+template <std::size_t Dim, class T>
+struct mapped_type<Cylinder<Dim, T>> : std::integral_constant<MappedType, MappedType::CYLINDER> {};
+template <std::size_t Dim, class T>
+struct mapped_type<Ellipsoid<Dim, T>> : std::integral_constant<MappedType, MappedType::ELLIPSOID> {};
+template <std::size_t Dim, class T>
+struct mapped_type<Frustum<Dim, T>> : std::integral_constant<MappedType, MappedType::FRUSTUM> {};
+template <std::size_t Dim, class T>
+struct mapped_type<Line<Dim, T>> : std::integral_constant<MappedType, MappedType::LINE> {};
+template <std::size_t Dim, class T>
+struct mapped_type<LineSegment<Dim, T>> : std::integral_constant<MappedType, MappedType::LINE_SEGMENT> {};
+template <std::size_t Dim, class T>
+struct mapped_type<OBB<Dim, T>> : std::integral_constant<MappedType, MappedType::OBB> {};
+template <class T>
+struct mapped_type<Plane<T>> : std::integral_constant<MappedType, MappedType::PLANE> {};
+template <std::size_t Dim, class T>
+struct mapped_type<Ray<Dim, T>> : std::integral_constant<MappedType, MappedType::RAY> {};
+template <std::size_t Dim, class T>
+struct mapped_type<Sphere<Dim, T>> : std::integral_constant<MappedType, MappedType::SPHERE> {};
+template <class T>
+struct mapped_type<SphericalSector<T>> : std::integral_constant<MappedType, MappedType::SPHERICAL_SECTOR> {};
+template <std::size_t Dim, class T>
+struct mapped_type<Triangle<Dim, T>> : std::integral_constant<MappedType, MappedType::TRIANGLE> {};
+template <std::size_t Dim, class T>
+struct mapped_type<Vec<Dim, T>> : std::integral_constant<MappedType, MappedType::VEC> {};
+// clang-format on
+
+template <class T>
+inline constexpr MappedType mapped_type_v = mapped_type<T>::value;
+
+/*!
+ * @brief Dimension and scalar type of a geometry, used to validate mapped sections.
+ */
+template <class T>
+struct mapped_dim : std::integral_constant<std::uint8_t, 0> {
+};
+
+template <template <std::size_t, class> class G, std::size_t Dim, class T>
+struct mapped_dim<G<Dim, T>> : std::integral_constant<std::uint8_t, Dim> {
+};
+
+template <class T>
+struct mapped_dim<Plane<T>> : std::integral_constant<std::uint8_t, 3> {
+};
+
+template <class T>
+struct mapped_dim<SphericalSector<T>> : std::integral_constant<std::uint8_t, 3> {
+};
+
+template <class T>
+inline constexpr std::uint8_t mapped_dim_v = mapped_dim<T>::value;
+
+template <class T>
+struct mapped_scalar {
+	using type = void;
+};
+
+template <template <std::size_t, class> class G, std::size_t Dim, class T>
+struct mapped_scalar<G<Dim, T>> {
+	using type = T;
+};
+
+template <class T>
+struct mapped_scalar<Plane<T>> {
+	using type = T;
+};
+
+template <class T>
+struct mapped_scalar<SphericalSector<T>> {
+	using type = T;
+};
+
+template <class T>
+using mapped_scalar_t = typename mapped_scalar<T>::type;
+
+namespace detail
+{
+inline constexpr char          MAPPED_MAGIC[8]  = "UFOGEOM";
+inline constexpr std::uint32_t MAPPED_VERSION   = 1;
+inline constexpr std::uint32_t MAPPED_ENDIAN    = 0x01020304;
+inline constexpr std::uint64_t MAPPED_ALIGNMENT = 64;
+inline constexpr std::size_t   MAPPED_MAX_ALIGN = 4096;
+
+/*!
+ * @brief The header found at the start of every mapped geometry file.
+ *
+ * The file is written in the byte order of the machine that wrote it. `endian` is
+ * written as `MAPPED_ENDIAN` so that a reader with a different byte order can reject it
+ * (data is used in place, so it cannot be swapped on load).
+ */
+struct MappedHeader {
+	char          magic[8];
+	std::uint32_t endian;
+	std::uint32_t version;
+	std::uint64_t file_size;
+	std::uint64_t section_offset;
+	std::uint32_t num_sections;
+	std::uint32_t reserved[7];
+};
+
+static_assert(64 == sizeof(MappedHeader));
+
+/*!
+ * @brief Describes one contiguous, aligned array in a mapped geometry file.
+ */
+struct MappedSection {
+	std::uint16_t type;
+	std::uint8_t  dim;
+	std::uint8_t  scalar_size;
+	std::uint32_t tag;
+	std::uint32_t element_size;
+	std::uint32_t element_align;
+	std::uint64_t offset;
+	std::uint64_t count;
+};
+
+static_assert(32 == sizeof(MappedSection));
+
+[[nodiscard]] constexpr std::uint64_t alignUp(std::uint64_t value,
+                                              std::uint64_t alignment) noexcept
+{
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+template <class T>
+[[nodiscard]] constexpr std::uint8_t mappedScalarSize() noexcept
+{
+	if constexpr (std::is_void_v<mapped_scalar_t<T>>) {
+		return 0;
+	} else {
+		return sizeof(mapped_scalar_t<T>);
+	}
+}
+
+template <class T>
+[[nodiscard]] MappedSection mappedSection(std::uint32_t tag, std::uint64_t count)
+{
+	MappedSection s{};
+	s.type          = static_cast<std::uint16_t>(mapped_type_v<T>);
+	s.dim           = mapped_dim_v<T>;
+	s.scalar_size   = mappedScalarSize<T>();
+	s.tag           = tag;
+	s.element_size  = sizeof(T);
+	s.element_align = alignof(T);
+	s.count         = count;
+	return s;
+}
+}  // namespace detail
+
+/*!
+ * @brief A read-only view of a contiguous array inside a mapped geometry file.
+ *
+ * The elements live in the mapping, no copy is made. The view is only valid as long as
+ * the `MappedGeometry` it was retrieved from is alive.
+ */
+template <class T>
+class MappedSpan
+{
+ public:
+	using value_type      = T;
+	using size_type       = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using const_reference = T const&;
+	using const_pointer   = T const*;
+	using const_iterator  = T const*;
+
+	constexpr MappedSpan() noexcept = default;
+
+	constexpr MappedSpan(T const* data, std::size_t size) noexcept
+	    : data_(data), size_(size)
+	{
+	}
+
+	[[nodiscard]] constexpr const_iterator begin() const noexcept { return data_; }
+
+	[[nodiscard]] constexpr const_iterator end() const noexcept { return data_ + size_; }
+
+	[[nodiscard]] constexpr const_reference operator[](size_type pos) const noexcept
+	{
+		return data_[pos];
+	}
+
+	[[nodiscard]] constexpr const_pointer data() const noexcept { return data_; }
+
+	[[nodiscard]] constexpr size_type size() const noexcept { return size_; }
+
+	[[nodiscard]] constexpr bool empty() const noexcept { return 0 == size_; }
+
+ private:
+	T const*    data_{};
+	std::size_t size_{};
+};
+
+/*!
+ * @brief Builds a mapped geometry file out of one or more arrays of geometries.
+ *
+ * Each call to `add` creates a new section. Elements are stored verbatim, aligned to
+ * `detail::MAPPED_ALIGNMENT` bytes, so that they can be used in place once mapped. The
+ * optional `tag` can be used to tell several sections of the same type apart.
+ */
+class MappedWriter
+{
+ public:
+	template <class InputIt>
+	std::size_t add(InputIt first, InputIt last, std::uint32_t tag = 0)
+	{
+		using T = typename std::iterator_traits<InputIt>::value_type;
+		static_assert(std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T>,
+		              "Only trivially copyable, standard layout types can be mapped.");
+		static_assert(MappedType::NONE != mapped_type_v<T>,
+		              "The type needs a mapped_type specialization to be mapped.");
+		static_assert(detail::MAPPED_MAX_ALIGN >= alignof(T));
+
+		std::vector<unsigned char> bytes;
+		using category = typename std::iterator_traits<InputIt>::iterator_category;
+		if constexpr (std::is_base_of_v<std::random_access_iterator_tag, category>) {
+			bytes.reserve(sizeof(T) * static_cast<std::size_t>(std::distance(first, last)));
+		}
+		std::uint64_t count{};
+		for (; first != last; ++first, ++count) {
+			T const v = *first;
+			auto    p = reinterpret_cast<unsigned char const*>(&v);
+			bytes.insert(bytes.end(), p, p + sizeof(T));
+		}
+
+		sections_.push_back(detail::mappedSection<T>(tag, count));
+		data_.push_back(std::move(bytes));
+		return sections_.size() - 1;
+	}
+
+	template <class Range>
+	std::size_t add(Range const& range, std::uint32_t tag = 0)
+	{
+		using std::begin;
+		using std::end;
+		return add(begin(range), end(range), tag);
+	}
+
+	[[nodiscard]] std::size_t numSections() const noexcept { return sections_.size(); }
+
+	void write(std::ostream& out) const
+	{
+		detail::MappedHeader header{};
+		std::copy(std::begin(detail::MAPPED_MAGIC), std::end(detail::MAPPED_MAGIC),
+		          header.magic);
+		header.endian         = detail::MAPPED_ENDIAN;
+		header.version        = detail::MAPPED_VERSION;
+		header.num_sections   = static_cast<std::uint32_t>(sections_.size());
+		header.section_offset = sizeof(detail::MappedHeader);
+
+		auto sections = sections_;
+
+		std::uint64_t offset =
+		    header.section_offset + sections.size() * sizeof(detail::MappedSection);
+		for (std::size_t i{}; sections.size() > i; ++i) {
+			auto alignment = std::max<std::uint64_t>(detail::MAPPED_ALIGNMENT,
+			                                         sections[i].element_align);
+			offset             = detail::alignUp(offset, alignment);
+			sections[i].offset = offset;
+			offset += data_[i].size();
+		}
+		header.file_size = offset;
+
+		write(out, &header, sizeof(header));
+		std::uint64_t pos = sizeof(header);
+		write(out, sections.data(), sections.size() * sizeof(detail::MappedSection));
+		pos += sections.size() * sizeof(detail::MappedSection);
+		for (std::size_t i{}; sections.size() > i; ++i) {
+			pos = pad(out, pos, sections[i].offset);
+			write(out, data_[i].data(), data_[i].size());
+			pos += data_[i].size();
+		}
+
+		if (!out) {
+			throw std::runtime_error("Failed to write mapped geometry");
+		}
+	}
+
+	void write(std::filesystem::path const& file) const
+	{
+		std::ofstream out(file, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!out) {
+			throw std::runtime_error("Failed to open '" + file.string() + "' for writing");
+		}
+		write(out);
+	}
+
+ private:
+	static void write(std::ostream& out, void const* data, std::size_t size)
+	{
+		out.write(static_cast<char const*>(data), static_cast<std::streamsize>(size));
+	}
+
+	static std::uint64_t pad(std::ostream& out, std::uint64_t pos, std::uint64_t to)
+	{
+		for (; to > pos; ++pos) {
+			out.put('\0');
+		}
+		return pos;
+	}
+
+ private:
+	std::vector<detail::MappedSection>       sections_;
+	std::vector<std::vector<unsigned char>> data_;
+};
+
+/*!
+ * @brief A mapped geometry file.
+ *
+ * On POSIX systems the file is `mmap`ed read-only and shared, so several processes
+ * mapping the same file share the same physical pages and opening is independent of the
+ * file size. Elsewhere the file is read into a single aligned buffer.
+ *
+ * The content can also come from a buffer already in memory (e.g., shared memory), in
+ * which case the caller keeps ownership of the buffer.
+ */
+class MappedGeometry
+{
+ public:
+	MappedGeometry() = default;
+
+	explicit MappedGeometry(std::filesystem::path const& file) { open(file); }
+
+	MappedGeometry(void const* data, std::size_t size) { attach(data, size); }
+
+	MappedGeometry(MappedGeometry const&) = delete;
+
+	MappedGeometry(MappedGeometry&& other) noexcept { swap(other); }
+
+	~MappedGeometry() { close(); }
+
+	MappedGeometry& operator=(MappedGeometry const&) = delete;
+
+	MappedGeometry& operator=(MappedGeometry&& rhs) noexcept
+	{
+		close();
+		swap(rhs);
+		return *this;
+	}
+
+	void open(std::filesystem::path const& file)
+	{
+		close();
+
+#if UFO_GEOMETRY_HAS_MMAP
+		int fd = ::open(file.c_str(), O_RDONLY);
+		if (0 > fd) {
+			throw std::runtime_error("Failed to open '" + file.string() + "'");
+		}
+		struct stat st;
+		if (0 != ::fstat(fd, &st) || 0 >= st.st_size) {
+			::close(fd);
+			throw std::runtime_error("Failed to stat '" + file.string() + "'");
+		}
+		auto size = static_cast<std::size_t>(st.st_size);
+		void* ptr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (MAP_FAILED == ptr) {
+			throw std::runtime_error("Failed to map '" + file.string() + "'");
+		}
+		mapped_      = ptr;
+		mapped_size_ = size;
+#else
+		std::ifstream in(file, std::ios::in | std::ios::binary | std::ios::ate);
+		if (!in) {
+			throw std::runtime_error("Failed to open '" + file.string() + "'");
+		}
+		auto size = static_cast<std::size_t>(in.tellg());
+		buffer_.reset(static_cast<unsigned char*>(::operator new(
+		    size, std::align_val_t(detail::MAPPED_MAX_ALIGN))));
+		in.seekg(0);
+		in.read(reinterpret_cast<char*>(buffer_.get()), static_cast<std::streamsize>(size));
+		if (!in) {
+			throw std::runtime_error("Failed to read '" + file.string() + "'");
+		}
+		mapped_      = buffer_.get();
+		mapped_size_ = size;
+#endif
+
+		try {
+			attach(mapped_, mapped_size_);
+		} catch (...) {
+			close();
+			throw;
+		}
+	}
+
+	void close() noexcept
+	{
+#if UFO_GEOMETRY_HAS_MMAP
+		if (nullptr != mapped_) {
+			::munmap(mapped_, mapped_size_);
+		}
+#else
+		buffer_.reset();
+#endif
+		mapped_      = nullptr;
+		mapped_size_ = 0;
+		data_        = nullptr;
+		size_        = 0;
+	}
+
+	[[nodiscard]] bool isOpen() const noexcept { return nullptr != data_; }
+
+	[[nodiscard]] std::size_t numSections() const noexcept
+	{
+		return isOpen() ? header().num_sections : 0;
+	}
+
+	[[nodiscard]] MappedType type(std::size_t section) const
+	{
+		return static_cast<MappedType>(sectionInfo(section).type);
+	}
+
+	[[nodiscard]] std::uint32_t tag(std::size_t section) const
+	{
+		return sectionInfo(section).tag;
+	}
+
+	[[nodiscard]] std::size_t size(std::size_t section) const
+	{
+		return static_cast<std::size_t>(sectionInfo(section).count);
+	}
+
+	/*!
+	 * @brief Checks whether `section` can be viewed as an array of `T`.
+	 *
+	 * Always `false` for types without a `mapped_type`, whose layout could be mistaken
+	 * for another geometry.
+	 */
+	template <class T>
+	[[nodiscard]] bool holds(std::size_t section) const
+	{
+		auto const& s = sectionInfo(section);
+		return MappedType::NONE != mapped_type_v<T> &&
+		       static_cast<std::uint16_t>(mapped_type_v<T>) == s.type &&
+		       mapped_dim_v<T> == s.dim &&
+		       detail::mappedScalarSize<T>() == s.scalar_size &&
+		       sizeof(T) == s.element_size && alignof(T) == s.element_align;
+	}
+
+	/*!
+	 * @brief Returns the elements of `section`, in place.
+	 *
+	 * @throw std::invalid_argument If the section does not hold elements of type `T`.
+	 */
+	template <class T>
+	[[nodiscard]] MappedSpan<T> get(std::size_t section) const
+	{
+		if (!holds<T>(section)) {
+			throw std::invalid_argument("Section " + std::to_string(section) +
+			                            " does not hold the requested type");
+		}
+		auto const& s = sectionInfo(section);
+		return MappedSpan<T>(reinterpret_cast<T const*>(data_ + s.offset),
+		                     static_cast<std::size_t>(s.count));
+	}
+
+	/*!
+	 * @brief Returns the elements of the first section of type `T` with tag `tag`, or an
+	 * empty span if there is no such section.
+	 */
+	template <class T>
+	[[nodiscard]] MappedSpan<T> find(std::uint32_t tag = 0) const
+	{
+		for (std::size_t i{}; numSections() > i; ++i) {
+			if (holds<T>(i) && tag == sectionInfo(i).tag) {
+				return get<T>(i);
+			}
+		}
+		return {};
+	}
+
+	void swap(MappedGeometry& other) noexcept
+	{
+		std::swap(mapped_, other.mapped_);
+		std::swap(mapped_size_, other.mapped_size_);
+		std::swap(data_, other.data_);
+		std::swap(size_, other.size_);
+#if !UFO_GEOMETRY_HAS_MMAP
+		std::swap(buffer_, other.buffer_);
+#endif
+	}
+
+ private:
+	void attach(void const* data, std::size_t size)
+	{
+		auto bytes = static_cast<unsigned char const*>(data);
+
+		if (sizeof(detail::MappedHeader) > size) {
+			throw std::runtime_error("Mapped geometry is truncated");
+		}
+
+		auto const& h = *reinterpret_cast<detail::MappedHeader const*>(bytes);
+		if (!std::equal(std::begin(detail::MAPPED_MAGIC), std::end(detail::MAPPED_MAGIC),
+		                h.magic)) {
+			throw std::runtime_error("Not a mapped geometry file");
+		}
+		if (detail::MAPPED_ENDIAN != h.endian) {
+			throw std::runtime_error("Mapped geometry has a different byte order");
+		}
+		if (detail::MAPPED_VERSION != h.version) {
+			throw std::runtime_error("Unsupported mapped geometry version " +
+			                         std::to_string(h.version));
+		}
+		// Written as divisions so that corrupt sizes cannot wrap around
+		if (h.file_size > size || h.section_offset > h.file_size ||
+		    h.num_sections >
+		        (h.file_size - h.section_offset) / sizeof(detail::MappedSection)) {
+			throw std::runtime_error("Mapped geometry is truncated");
+		}
+
+		auto sections =
+		    reinterpret_cast<detail::MappedSection const*>(bytes + h.section_offset);
+		for (std::size_t i{}; h.num_sections > i; ++i) {
+			auto const& s = sections[i];
+			if (s.offset > h.file_size || 0 == s.element_size ||
+			    s.count > (h.file_size - s.offset) / s.element_size ||
+			    0 != reinterpret_cast<std::uintptr_t>(bytes + s.offset) %
+			             std::max<std::uint32_t>(1, s.element_align)) {
+				throw std::runtime_error("Mapped geometry section " + std::to_string(i) +
+				                         " is corrupt or misaligned");
+			}
+		}
+
+		data_ = bytes;
+		size_ = size;
+	}
+
+	[[nodiscard]] detail::MappedHeader const& header() const noexcept
+	{
+		return *reinterpret_cast<detail::MappedHeader const*>(data_);
+	}
+
+	[[nodiscard]] detail::MappedSection const& sectionInfo(std::size_t section) const
+	{
+		if (numSections() <= section) {
+			throw std::out_of_range("Section " + std::to_string(section) +
+			                        " is out of range");
+		}
+		return reinterpret_cast<detail::MappedSection const*>(
+		    data_ + header().section_offset)[section];
+	}
+
+ private:
+	void*                mapped_{};
+	std::size_t          mapped_size_{};
+	unsigned char const* data_{};
+	std::size_t          size_{};
+#if !UFO_GEOMETRY_HAS_MMAP
+	struct AlignedDelete {
+		void operator()(unsigned char* p) const noexcept
+		{
+			::operator delete(p, std::align_val_t(detail::MAPPED_MAX_ALIGN));
+		}
+	};
+	std::unique_ptr<unsigned char[], AlignedDelete> buffer_;
+#endif
+};
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_MAPPED_HPP
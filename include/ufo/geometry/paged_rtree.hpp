@@ -0,0 +1,885 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_PAGED_RTREE_HPP
+#define UFO_GEOMETRY_PAGED_RTREE_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/bounding_volume.hpp>
+#include <ufo/geometry/contains.hpp>
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/intersects.hpp>
+#include <ufo/geometry/mapped.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <execution>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+namespace detail
+{
+inline constexpr char          RTREE_MAGIC[8] = {'U', 'F', 'O', 'R', 'T', 'R', 'E', 'E'};
+inline constexpr std::uint32_t RTREE_VERSION  = 1;
+
+/*!
+ * @brief The header found at the start of the first page of a paged R-tree file.
+ *
+ * As for mapped geometry files, the byte order is the one of the machine that wrote the
+ * file and `endian` is written as `MAPPED_ENDIAN`.
+ */
+struct RTreeHeader {
+	char          magic[8];
+	std::uint32_t endian;
+	std::uint32_t version;
+	std::uint32_t page_size;
+	std::uint8_t  dim;
+	std::uint8_t  scalar_size;
+	std::uint16_t reserved0;
+	std::uint64_t num_pages;
+	std::uint64_t num_records;
+	std::uint64_t root;
+	std::uint32_t height;
+	std::uint32_t reserved[3];
+};
+
+static_assert(64 == sizeof(RTreeHeader));
+
+/*!
+ * @brief The header at the start of every node page, followed by `count` entries.
+ *
+ * `level` is zero for leaves, whose entries are records, and one more than the level of
+ * the children otherwise.
+ */
+struct RTreePageHeader {
+	std::uint32_t count;
+	std::uint32_t level;
+};
+
+/*!
+ * @brief Fixed-size pages of a file, of which at most `capacity` are kept in memory.
+ * When full, the least recently used page is dropped first.
+ *
+ * On POSIX systems the file is `mmap`ed and dropped pages are released with `madvise`,
+ * so the memory used stays bounded however much of the file is visited. Elsewhere the
+ * pages are read into buffers owned by the cache.
+ *
+ * A pointer returned by `page` is valid until the next call to `page`.
+ */
+class PageCache
+{
+ public:
+	PageCache() = default;
+
+	PageCache(std::filesystem::path const& file, std::size_t page_size,
+	          std::size_t capacity)
+	{
+		open(file, page_size, capacity);
+	}
+
+	PageCache(PageCache const&) = delete;
+
+	PageCache(PageCache&& other) noexcept { swap(other); }
+
+	~PageCache() { close(); }
+
+	PageCache& operator=(PageCache const&) = delete;
+
+	PageCache& operator=(PageCache&& rhs) noexcept
+	{
+		close();
+		swap(rhs);
+		return *this;
+	}
+
+	void open(std::filesystem::path const& file, std::size_t page_size,
+	          std::size_t capacity)
+	{
+		close();
+
+		page_size_ = page_size;
+		capacity_  = std::max<std::size_t>(1, capacity);
+
+#if UFO_GEOMETRY_HAS_MMAP
+		int fd = ::open(file.c_str(), O_RDONLY);
+		if (0 > fd) {
+			throw std::runtime_error("Failed to open '" + file.string() + "'");
+		}
+		struct stat st;
+		if (0 != ::fstat(fd, &st) || 0 >= st.st_size) {
+			::close(fd);
+			throw std::runtime_error("Failed to stat '" + file.string() + "'");
+		}
+		auto size = static_cast<std::size_t>(st.st_size);
+		void* ptr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (MAP_FAILED == ptr) {
+			throw std::runtime_error("Failed to map '" + file.string() + "'");
+		}
+		// Queries jump around the file, read ahead would only pull in unneeded pages
+		::madvise(ptr, size, MADV_RANDOM);
+		long const page = ::sysconf(_SC_PAGESIZE);
+		mapped_         = ptr;
+		mapped_size_    = size;
+		release_        = 0 < page && 0 == page_size % static_cast<std::size_t>(page);
+#else
+		in_.open(file, std::ios::in | std::ios::binary | std::ios::ate);
+		if (!in_) {
+			throw std::runtime_error("Failed to open '" + file.string() + "'");
+		}
+		mapped_size_ = static_cast<std::size_t>(in_.tellg());
+#endif
+		num_pages_ = mapped_size_ / page_size_;
+	}
+
+	void close() noexcept
+	{
+#if UFO_GEOMETRY_HAS_MMAP
+		if (nullptr != mapped_) {
+			::munmap(mapped_, mapped_size_);
+		}
+		mapped_ = nullptr;
+#else
+		in_.close();
+#endif
+		mapped_size_ = 0;
+		num_pages_   = 0;
+		lru_.clear();
+		index_.clear();
+	}
+
+	[[nodiscard]] std::size_t pageSize() const noexcept { return page_size_; }
+
+	[[nodiscard]] std::size_t numPages() const noexcept { return num_pages_; }
+
+	[[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+	/*!
+	 * @brief Number of pages currently in the cache.
+	 */
+	[[nodiscard]] std::size_t resident() const noexcept { return lru_.size(); }
+
+	/*!
+	 * @brief Number of times a page was brought into the cache since it was opened or
+	 * `resetLoads` was called.
+	 */
+	[[nodiscard]] std::size_t loads() const noexcept { return loads_; }
+
+	void resetLoads() noexcept { loads_ = 0; }
+
+	[[nodiscard]] unsigned char const* page(std::uint64_t i)
+	{
+		if (auto it = index_.find(i); index_.end() != it) {
+			lru_.splice(lru_.begin(), lru_, it->second);
+			return it->second->data;
+		}
+
+		if (num_pages_ <= i) {
+			throw std::out_of_range("Page " + std::to_string(i) + " is out of range");
+		}
+
+		if (capacity_ <= lru_.size()) {
+			// Reuse the least recently used slot
+			lru_.splice(lru_.begin(), lru_, std::prev(lru_.end()));
+			index_.erase(lru_.front().page);
+			release(lru_.front());
+		} else {
+			lru_.emplace_front();
+		}
+
+		Slot& slot = lru_.front();
+		slot.page  = i;
+		try {
+			load(slot);
+		} catch (...) {
+			lru_.pop_front();
+			throw;
+		}
+		index_[i] = lru_.begin();
+		++loads_;
+		return slot.data;
+	}
+
+	void swap(PageCache& other) noexcept
+	{
+		std::swap(page_size_, other.page_size_);
+		std::swap(num_pages_, other.num_pages_);
+		std::swap(capacity_, other.capacity_);
+		std::swap(loads_, other.loads_);
+		std::swap(mapped_size_, other.mapped_size_);
+		std::swap(lru_, other.lru_);
+		std::swap(index_, other.index_);
+#if UFO_GEOMETRY_HAS_MMAP
+		std::swap(mapped_, other.mapped_);
+		std::swap(release_, other.release_);
+#else
+		std::swap(in_, other.in_);
+#endif
+	}
+
+ private:
+	struct Slot {
+		std::uint64_t        page{};
+		unsigned char const* data{};
+#if !UFO_GEOMETRY_HAS_MMAP
+		std::vector<unsigned char> buffer;
+#endif
+	};
+
+	void load(Slot& slot)
+	{
+#if UFO_GEOMETRY_HAS_MMAP
+		slot.data = static_cast<unsigned char const*>(mapped_) + slot.page * page_size_;
+#else
+		slot.buffer.resize(page_size_);
+		in_.seekg(static_cast<std::streamoff>(slot.page * page_size_));
+		in_.read(reinterpret_cast<char*>(slot.buffer.data()),
+		         static_cast<std::streamsize>(page_size_));
+		if (!in_) {
+			throw std::runtime_error("Failed to read page " + std::to_string(slot.page));
+		}
+		slot.data = slot.buffer.data();
+#endif
+	}
+
+	void release([[maybe_unused]] Slot const& slot) noexcept
+	{
+#if UFO_GEOMETRY_HAS_MMAP
+		if (release_) {
+			::madvise(const_cast<unsigned char*>(slot.data), page_size_, MADV_DONTNEED);
+		}
+#endif
+	}
+
+ private:
+	std::size_t page_size_{};
+	std::size_t num_pages_{};
+	std::size_t capacity_{};
+	std::size_t loads_{};
+	std::size_t mapped_size_{};
+
+	// Most recently used first
+	std::list<Slot>                                             lru_;
+	std::unordered_map<std::uint64_t, std::list<Slot>::iterator> index_;
+
+#if UFO_GEOMETRY_HAS_MMAP
+	void* mapped_{};
+	// Whether pages line up with the pages of the system, so they can be released
+	bool release_{};
+#else
+	std::ifstream in_;
+#endif
+};
+
+/*!
+ * @brief Smallest `s` such that `s^r >= n`.
+ */
+[[nodiscard]] inline std::size_t strSlices(std::size_t n, std::size_t r)
+{
+	auto const pow = [r](std::size_t s) {
+		std::size_t res = 1;
+		for (std::size_t i{}; r > i; ++i) {
+			res *= s;
+		}
+		return res;
+	};
+
+	auto s = static_cast<std::size_t>(std::pow(double(n), 1.0 / double(r)));
+	s      = std::max<std::size_t>(1, s);
+	while (pow(s) < n) {
+		++s;
+	}
+	while (1 < s && pow(s - 1) >= n) {
+		--s;
+	}
+	return s;
+}
+}  // namespace detail
+
+/*!
+ * @brief A static R-tree over boxes that lives in a file and is only brought into
+ * memory a page at a time, for data sets larger than memory.
+ *
+ * `write` bulk loads the tree with Sort-Tile-Recursive (Leutenegger et al.): the boxes
+ * are sorted into slabs along each axis in turn, so each page of `pageCapacity()`
+ * entries covers a compact tile, and the same is done level by level for the bounds of
+ * the pages. Every node is one page of the file.
+ *
+ * Opening the tree only reads the header. Queries fetch the pages of the nodes they
+ * visit through a cache of at most `cache_pages` pages which drops the least recently
+ * used first, see `detail::PageCache`.
+ *
+ * Each record is a box and an id chosen by the caller, e.g., the index of the object in
+ * a `MappedGeometry` section or in a database.
+ *
+ * Queries update the page cache, so one tree must not be queried from several threads
+ * at once. Open the file once per thread instead, the mappings share the pages of the
+ * operating system.
+ */
+template <std::size_t Dim, class T = float>
+class PagedRTree
+{
+ public:
+	using value_type  = T;
+	using size_type   = std::size_t;
+	using id_type     = std::uint64_t;
+	using bounds_type = AABB<Dim, T>;
+
+	static constexpr std::size_t dimension = Dim;
+
+	struct Record {
+		bounds_type bounds;
+		id_type     id;
+	};
+
+	static_assert(std::is_trivially_copyable_v<Record>);
+
+	/*!
+	 * @brief Id of no record, returned by queries that find nothing.
+	 */
+	static constexpr id_type NO_ID = std::numeric_limits<id_type>::max();
+
+	static constexpr std::size_t DEFAULT_PAGE_SIZE   = 4096;
+	static constexpr std::size_t DEFAULT_CACHE_PAGES = 1024;
+
+	/*!
+	 * @brief Number of entries that fit in a page of `page_size` bytes.
+	 */
+	[[nodiscard]] static constexpr std::size_t pageCapacity(
+	    std::size_t page_size = DEFAULT_PAGE_SIZE) noexcept
+	{
+		return ENTRY_OFFSET > page_size ? 0 : (page_size - ENTRY_OFFSET) / sizeof(Record);
+	}
+
+	/*!
+	 * @brief Bulk loads the records [first, last) into a paged R-tree in `file`. The
+	 * sorts run according to `policy`.
+	 *
+	 * @throw std::invalid_argument If fewer than two records fit in a page.
+	 * @throw std::runtime_error If `file` could not be written.
+	 */
+	template <
+	    class ExecutionPolicy, class RandomIt,
+	    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+	        true>
+	static void write(ExecutionPolicy&& policy, std::filesystem::path const& file,
+	                  RandomIt first, RandomIt last,
+	                  std::size_t page_size = DEFAULT_PAGE_SIZE)
+	{
+		std::size_t const capacity = pageCapacity(page_size);
+		if (2 > capacity || sizeof(detail::RTreeHeader) > page_size) {
+			throw std::invalid_argument("Page size " + std::to_string(page_size) +
+			                            " is too small");
+		}
+
+		std::ofstream out(file, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!out) {
+			throw std::runtime_error("Failed to open '" + file.string() + "' for writing");
+		}
+
+		std::vector<Record> level(first, last);
+
+		detail::RTreeHeader header{};
+		std::copy(std::begin(detail::RTREE_MAGIC), std::end(detail::RTREE_MAGIC),
+		          header.magic);
+		header.endian      = detail::MAPPED_ENDIAN;
+		header.version     = detail::RTREE_VERSION;
+		header.page_size   = static_cast<std::uint32_t>(page_size);
+		header.dim         = static_cast<std::uint8_t>(Dim);
+		header.scalar_size = static_cast<std::uint8_t>(sizeof(T));
+		header.num_records = level.size();
+
+		// The header page is written last, once the root is known
+		std::vector<unsigned char> page(page_size);
+		out.write(reinterpret_cast<char const*>(page.data()),
+		          static_cast<std::streamsize>(page_size));
+
+		std::uint64_t next = 1;
+		while (!level.empty()) {
+			tile(policy, level.begin(), level.end(), 0, capacity);
+
+			std::vector<Record> parents;
+			parents.reserve((level.size() + capacity - 1) / capacity);
+			for (std::size_t i{}; level.size() > i; i += capacity) {
+				std::size_t const count = std::min(capacity, level.size() - i);
+
+				detail::RTreePageHeader const h{static_cast<std::uint32_t>(count),
+				                                header.height};
+				std::fill(page.begin(), page.end(), 0);
+				std::memcpy(page.data(), &h, sizeof(h));
+				std::memcpy(page.data() + ENTRY_OFFSET, level.data() + i,
+				            count * sizeof(Record));
+				out.write(reinterpret_cast<char const*>(page.data()),
+				          static_cast<std::streamsize>(page_size));
+
+				Record parent{level[i].bounds, next++};
+				for (std::size_t j = i + 1; i + count > j; ++j) {
+					parent.bounds = merge(parent.bounds, level[j].bounds);
+				}
+				parents.push_back(parent);
+			}
+
+			++header.height;
+			if (1 == parents.size()) {
+				header.root = next - 1;
+				break;
+			}
+			level.swap(parents);
+		}
+		header.num_pages = next;
+
+		std::fill(page.begin(), page.end(), 0);
+		std::memcpy(page.data(), &header, sizeof(header));
+		out.seekp(0);
+		out.write(reinterpret_cast<char const*>(page.data()),
+		          static_cast<std::streamsize>(page_size));
+
+		if (!out) {
+			throw std::runtime_error("Failed to write '" + file.string() + "'");
+		}
+	}
+
+	template <class InputIt>
+	static void write(std::filesystem::path const& file, InputIt first, InputIt last,
+	                  std::size_t page_size = DEFAULT_PAGE_SIZE)
+	{
+		std::vector<Record> records(first, last);
+		write(std::execution::seq, file, records.begin(), records.end(), page_size);
+	}
+
+	PagedRTree() = default;
+
+	explicit PagedRTree(std::filesystem::path const& file,
+	                    std::size_t                  cache_pages = DEFAULT_CACHE_PAGES)
+	{
+		open(file, cache_pages);
+	}
+
+	PagedRTree(PagedRTree const&) = delete;
+
+	PagedRTree(PagedRTree&& other) noexcept { swap(other); }
+
+	PagedRTree& operator=(PagedRTree const&) = delete;
+
+	PagedRTree& operator=(PagedRTree&& rhs) noexcept
+	{
+		close();
+		swap(rhs);
+		return *this;
+	}
+
+	/*!
+	 * @brief Opens the tree in `file`, keeping at most `cache_pages` pages in memory.
+	 *
+	 * @throw std::runtime_error If `file` is not a paged R-tree with this dimension and
+	 * scalar type. Queries throw it as well when they reach a corrupt page.
+	 */
+	void open(std::filesystem::path const& file,
+	          std::size_t                  cache_pages = DEFAULT_CACHE_PAGES)
+	{
+		close();
+
+		detail::RTreeHeader h{};
+		{
+			std::ifstream in(file, std::ios::in | std::ios::binary);
+			if (!in) {
+				throw std::runtime_error("Failed to open '" + file.string() + "'");
+			}
+			in.read(reinterpret_cast<char*>(&h), sizeof(h));
+			if (!in) {
+				throw std::runtime_error("Paged R-tree '" + file.string() + "' is truncated");
+			}
+		}
+
+		if (!std::equal(std::begin(detail::RTREE_MAGIC), std::end(detail::RTREE_MAGIC),
+		                h.magic)) {
+			throw std::runtime_error("'" + file.string() + "' is not a paged R-tree");
+		}
+		if (detail::MAPPED_ENDIAN != h.endian) {
+			throw std::runtime_error("Paged R-tree has a different byte order");
+		}
+		if (detail::RTREE_VERSION != h.version) {
+			throw std::runtime_error("Unsupported paged R-tree version " +
+			                         std::to_string(h.version));
+		}
+		if (sizeof(detail::RTreeHeader) > h.page_size) {
+			throw std::runtime_error("Paged R-tree has invalid page size " +
+			                         std::to_string(h.page_size));
+		}
+		if (Dim != h.dim || sizeof(T) != h.scalar_size) {
+			throw std::runtime_error("Paged R-tree has dimension " + std::to_string(h.dim) +
+			                         " and scalar size " + std::to_string(h.scalar_size));
+		}
+
+		cache_.open(file, h.page_size, cache_pages);
+		if (h.num_pages > cache_.numPages() || h.root >= h.num_pages) {
+			cache_.close();
+			throw std::runtime_error("Paged R-tree '" + file.string() + "' is truncated");
+		}
+
+		size_      = h.num_records;
+		height_    = h.height;
+		root_      = h.root;
+		num_pages_ = h.num_pages;
+
+		bounds_ = detail::emptyAABB<Dim, T>();
+		if (!empty()) {
+			try {
+				auto const [page, ph] = node(root_, rootLevel());
+				for (std::size_t i{}; ph.count > i; ++i) {
+					bounds_ = merge(bounds_, entry(page, i).bounds);
+				}
+			} catch (...) {
+				close();
+				throw;
+			}
+		}
+	}
+
+	void close() noexcept
+	{
+		cache_.close();
+		size_      = 0;
+		height_    = 0;
+		root_      = 0;
+		num_pages_ = 0;
+		bounds_    = detail::emptyAABB<Dim, T>();
+	}
+
+	[[nodiscard]] bool isOpen() const noexcept { return 0 != cache_.numPages(); }
+
+	[[nodiscard]] size_type size() const noexcept { return size_; }
+
+	[[nodiscard]] bool empty() const noexcept { return 0 == size_; }
+
+	/*!
+	 * @brief Number of levels of nodes, zero if empty.
+	 */
+	[[nodiscard]] size_type height() const noexcept { return height_; }
+
+	[[nodiscard]] bounds_type bounds() const noexcept { return bounds_; }
+
+	[[nodiscard]] size_type pageSize() const noexcept { return cache_.pageSize(); }
+
+	/*!
+	 * @brief Number of pages in the file, including the header page.
+	 */
+	[[nodiscard]] size_type numPages() const noexcept { return cache_.numPages(); }
+
+	[[nodiscard]] size_type cachePages() const noexcept { return cache_.capacity(); }
+
+	/*!
+	 * @brief Number of pages read into the cache since the tree was opened or
+	 * `resetLoads` was called.
+	 */
+	[[nodiscard]] size_type loads() const noexcept { return cache_.loads(); }
+
+	void resetLoads() noexcept { cache_.resetLoads(); }
+
+	/*!
+	 * @brief Calls `f(bounds, id)` for every record whose bounds, and the bounds of all
+	 * the nodes above it, satisfy `descend`. Only the pages of the nodes whose bounds
+	 * satisfy `descend` are read.
+	 */
+	template <class Descend, class F>
+	void traverse(Descend descend, F f) const
+	{
+		(void)traverseAny(descend, [&f](bounds_type const& b, id_type id) {
+			f(b, id);
+			return false;
+		});
+	}
+
+	/*!
+	 * @brief Same as `traverse`, but stops as soon as `f(bounds, id)` returns `true`.
+	 *
+	 * @return Whether `f` returned `true` for any record.
+	 */
+	template <class Descend, class F>
+	[[nodiscard]] bool traverseAny(Descend descend, F f) const
+	{
+		if (empty()) {
+			return false;
+		}
+
+		// Pages to visit and the level they must have
+		std::vector<std::pair<std::uint64_t, std::uint32_t>> stack{{root_, rootLevel()}};
+		while (!stack.empty()) {
+			auto const [id, level] = stack.back();
+			stack.pop_back();
+
+			auto const [page, h] = node(id, level);
+			for (std::size_t i{}; h.count > i; ++i) {
+				Record const e = entry(page, i);
+				if (!descend(e.bounds)) {
+					continue;
+				}
+				if (0 != h.level) {
+					stack.emplace_back(e.id, h.level - 1);
+				} else if (f(e.bounds, e.id)) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	/*!
+	 * @brief Writes the id of every record whose bounds intersect `query` to `d_first`.
+	 *
+	 * @return Output iterator to the element past the last element written.
+	 */
+	template <class Query, class OutputIt>
+	OutputIt intersects(Query const& query, OutputIt d_first) const
+	{
+		traverse(
+		    [&query](bounds_type const& b) { return detail::intersectsKernel(b, query); },
+		    [&d_first](bounds_type const&, id_type id) { *d_first++ = id; });
+		return d_first;
+	}
+
+	/*!
+	 * @brief Writes the id of every record whose bounds are inside `query` to `d_first`.
+	 *
+	 * @return Output iterator to the element past the last element written.
+	 */
+	template <class Query, class OutputIt>
+	OutputIt contains(Query const& query, OutputIt d_first) const
+	{
+		traverse(
+		    [&query](bounds_type const& b) { return detail::intersectsKernel(b, query); },
+		    [&query, &d_first](bounds_type const& b, id_type id) {
+			    if (ufo::contains(query, b)) {
+				    *d_first++ = id;
+			    }
+		    });
+		return d_first;
+	}
+
+	/*!
+	 * @brief Writes the id of every record whose bounds are at most `max` from `query` to
+	 * `d_first`.
+	 *
+	 * @return Output iterator to the element past the last element written.
+	 */
+	template <class Query, class OutputIt>
+	OutputIt distanceWithin(Query const& query, value_type max, OutputIt d_first) const
+	{
+		value_type const max_sq = max * max;
+		traverse(
+		    [&query, max_sq](bounds_type const& b) {
+			    return detail::distanceSquaredWithinKernel(b, query, max_sq);
+		    },
+		    [&d_first](bounds_type const&, id_type id) { *d_first++ = id; });
+		return d_first;
+	}
+
+	/*!
+	 * @brief The record whose bounds are closest to `query`, considering only distances
+	 * smaller than `max`. Pages are read in order of increasing distance, so no page
+	 * farther away than the result is read.
+	 *
+	 * @return The id of the closest record and the distance to it, or `NO_ID` and `max`
+	 * if no record is closer than `max`.
+	 */
+	template <class Query>
+	[[nodiscard]] std::pair<id_type, value_type> nearest(
+	    Query const& query,
+	    value_type   max = std::numeric_limits<value_type>::infinity()) const
+	{
+		std::pair<id_type, value_type> res(NO_ID, max);
+		if (empty()) {
+			return res;
+		}
+
+		// Distance, page and the level it must have
+		using Candidate = std::tuple<value_type, std::uint64_t, std::uint32_t>;
+		std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>>
+		    queue;
+		queue.emplace(value_type(0), root_, rootLevel());
+		while (!queue.empty() && std::get<0>(queue.top()) < res.second) {
+			auto const [page, h] = node(std::get<1>(queue.top()), std::get<2>(queue.top()));
+			queue.pop();
+
+			for (std::size_t i{}; h.count > i; ++i) {
+				Record const     e = entry(page, i);
+				value_type const d =
+				    static_cast<value_type>(detail::distanceKernel(e.bounds, query));
+				if (!(d < res.second)) {
+					continue;
+				}
+				if (0 != h.level) {
+					queue.emplace(d, e.id, h.level - 1);
+				} else {
+					res = {e.id, d};
+				}
+			}
+		}
+		return res;
+	}
+
+	void swap(PagedRTree& other) noexcept
+	{
+		cache_.swap(other.cache_);
+		std::swap(size_, other.size_);
+		std::swap(height_, other.height_);
+		std::swap(root_, other.root_);
+		std::swap(num_pages_, other.num_pages_);
+		std::swap(bounds_, other.bounds_);
+	}
+
+ private:
+	static constexpr std::size_t ENTRY_OFFSET =
+	    detail::alignUp(sizeof(detail::RTreePageHeader), alignof(Record));
+
+	[[nodiscard]] static bounds_type merge(bounds_type const& a, bounds_type const& b)
+	{
+		return bounds_type(min(a.min, b.min), max(a.max, b.max));
+	}
+
+	[[nodiscard]] static detail::RTreePageHeader pageHeader(
+	    unsigned char const* page) noexcept
+	{
+		detail::RTreePageHeader h;
+		std::memcpy(&h, page, sizeof(h));
+		return h;
+	}
+
+	[[nodiscard]] std::uint32_t rootLevel() const noexcept
+	{
+		return 0 == height_ ? 0 : static_cast<std::uint32_t>(height_ - 1);
+	}
+
+	/*!
+	 * @brief Reads page `id`, which must be a node at `level`.
+	 *
+	 * The file is only trusted as far as the header is checked on open. A page whose
+	 * count does not fit in it, or that is not at the level its parent expects, would be
+	 * read past its end, so it is reported instead. Requiring the level to go down by one
+	 * per step also rules out cycles.
+	 *
+	 * @throw std::runtime_error If `id` is not a page of the tree or the page is corrupt.
+	 */
+	[[nodiscard]] std::pair<unsigned char const*, detail::RTreePageHeader> node(
+	    std::uint64_t id, std::uint32_t level) const
+	{
+		if (0 == id || num_pages_ <= id) {
+			throw std::runtime_error("Paged R-tree refers to page " + std::to_string(id) +
+			                         " of " + std::to_string(num_pages_));
+		}
+		unsigned char const* page = cache_.page(id);
+		auto const           h    = pageHeader(page);
+		if (level != h.level || pageCapacity(cache_.pageSize()) < h.count) {
+			throw std::runtime_error("Paged R-tree page " + std::to_string(id) +
+			                         " is corrupt");
+		}
+		return {page, h};
+	}
+
+	[[nodiscard]] static Record entry(unsigned char const* page, std::size_t i) noexcept
+	{
+		Record e;
+		std::memcpy(&e, page + ENTRY_OFFSET + i * sizeof(Record), sizeof(Record));
+		return e;
+	}
+
+	/*!
+	 * @brief Sort-Tile-Recursive: orders [first, last) so that each run of `capacity`
+	 * entries is a tile. The entries are sorted by the center along `axis` and cut into
+	 * slabs, which are tiled along the next axis.
+	 */
+	template <class ExecutionPolicy, class RandomIt>
+	static void tile(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+	                 std::size_t axis, std::size_t capacity)
+	{
+		auto const n = static_cast<std::size_t>(std::distance(first, last));
+		if (capacity >= n) {
+			return;
+		}
+
+		// Comparing the sums orders by the centers without dividing
+		std::sort(policy, first, last, [axis](Record const& a, Record const& b) {
+			return a.bounds.min[axis] + a.bounds.max[axis] <
+			       b.bounds.min[axis] + b.bounds.max[axis];
+		});
+		if (Dim - 1 == axis) {
+			return;
+		}
+
+		std::size_t const pages  = (n + capacity - 1) / capacity;
+		std::size_t const slices = detail::strSlices(pages, Dim - axis);
+		std::size_t const slab   = capacity * ((pages + slices - 1) / slices);
+		for (std::size_t i{}; n > i; i += slab) {
+			tile(policy, first + i, first + std::min(n, i + slab), axis + 1, capacity);
+		}
+	}
+
+ private:
+	mutable detail::PageCache cache_;
+
+	size_type     size_{};
+	size_type     height_{};
+	std::uint64_t root_{};
+	std::uint64_t num_pages_{};
+	bounds_type   bounds_ = detail::emptyAABB<Dim, T>();
+};
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_PAGED_RTREE_HPP
@@ -0,0 +1,315 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_POLYGON_HPP
+#define UFO_GEOMETRY_POLYGON_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief A simple (non self-intersecting) polygon in 2D, with either winding order.
+ *
+ * The edges are bucketed into horizontal slabs when the polygon is constructed. Each
+ * slab stores its edges as separate arrays of coordinates, so a point-in-polygon test
+ * only looks at the few edges in the slab of the point and counts crossings without
+ * branches. Whether the polygon is convex is also determined on construction, and used
+ * for faster tests.
+ *
+ * The vertices cannot be modified after construction, since that would invalidate the
+ * slabs.
+ */
+template <class T = float>
+class Polygon
+{
+	static_assert(std::is_floating_point_v<T>, "T is required to be floating point.");
+
+ public:
+	using value_type = T;
+
+	Polygon() = default;
+
+	Polygon(std::vector<Vec<2, T>> vertices) : vertices_(std::move(vertices)) { init(); }
+
+	Polygon(std::initializer_list<Vec<2, T>> vertices) : vertices_(vertices) { init(); }
+
+	template <class InputIt>
+	Polygon(InputIt first, InputIt last) : vertices_(first, last)
+	{
+		init();
+	}
+
+	[[nodiscard]] std::vector<Vec<2, T>> const& vertices() const noexcept
+	{
+		return vertices_;
+	}
+
+	[[nodiscard]] Vec<2, T> const& operator[](std::size_t pos) const noexcept
+	{
+		return vertices_[pos];
+	}
+
+	[[nodiscard]] std::size_t size() const noexcept { return vertices_.size(); }
+
+	[[nodiscard]] bool empty() const noexcept { return 3 > vertices_.size(); }
+
+	[[nodiscard]] bool convex() const noexcept { return convex_; }
+
+	[[nodiscard]] AABB<2, T> const& bounds() const noexcept { return bounds_; }
+
+	/*!
+	 * @brief Point-in-polygon test by crossing parity, only using the edges in the slab
+	 * of `point`.
+	 */
+	[[nodiscard]] bool contains(Vec<2, T> const& point) const noexcept
+	{
+		if (empty() || point.y < bounds_.min.y || point.y > bounds_.max.y ||
+		    point.x < bounds_.min.x || point.x > bounds_.max.x) {
+			return false;
+		}
+
+		std::size_t const s     = slab(point.y);
+		std::size_t const first = offset_[s];
+		std::size_t const last  = offset_[s + 1];
+
+		T const* x0    = x0_.data();
+		T const* y0    = y0_.data();
+		T const* y1    = y1_.data();
+		T const* slope = slope_.data();
+
+		unsigned crossings{};
+		for (std::size_t i = first; last > i; ++i) {
+			T const x = x0[i] + (point.y - y0[i]) * slope[i];
+			crossings += static_cast<unsigned>((y0[i] <= point.y) & (point.y < y1[i]) &
+			                                   (point.x < x));
+		}
+		return 1u & crossings;
+	}
+
+	/*!
+	 * @brief Checks if any edge of the polygon touches `box`, only using the edges in the
+	 * slabs overlapping `box`.
+	 */
+	[[nodiscard]] bool intersectsBoundary(AABB<2, T> const& box) const noexcept
+	{
+		if (empty() || box.max.y < bounds_.min.y || box.min.y > bounds_.max.y ||
+		    box.max.x < bounds_.min.x || box.min.x > bounds_.max.x) {
+			return false;
+		}
+
+		auto const c = box.center();
+		auto const h = box.halfLength();
+
+		std::size_t const first = offset_[slab(box.min.y)];
+		std::size_t const last  = offset_[slab(box.max.y) + 1];
+		for (std::size_t i = first; last > i; ++i) {
+			if (x0_[i] < box.min.x && x1_[i] < box.min.x) {
+				continue;
+			}
+			if (x0_[i] > box.max.x && x1_[i] > box.max.x) {
+				continue;
+			}
+			if (y1_[i] < box.min.y || y0_[i] > box.max.y) {
+				continue;
+			}
+
+			// Separating axis along the normal of the edge
+			T const nx = y1_[i] - y0_[i];
+			T const ny = x0_[i] - x1_[i];
+			T const r  = std::abs(nx) * h.x + std::abs(ny) * h.y;
+			T const d  = nx * (c.x - x0_[i]) + ny * (c.y - y0_[i]);
+			if (std::abs(d) <= r) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+ private:
+	void init()
+	{
+		std::size_t const n = vertices_.size();
+		if (3 > n) {
+			return;
+		}
+
+		bounds_ = AABB<2, T>(vertices_[0], vertices_[0]);
+		for (auto const& v : vertices_) {
+			bounds_.min = min(bounds_.min, v);
+			bounds_.max = max(bounds_.max, v);
+		}
+
+		// Convex if all turns have the same direction
+		int sign{};
+		convex_ = true;
+		for (std::size_t i{}; n > i && convex_; ++i) {
+			auto const& a = vertices_[i];
+			auto const& b = vertices_[(i + 1) % n];
+			auto const& c = vertices_[(i + 2) % n];
+			T const     z = (b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x);
+			int const   s = (T(0) < z) - (T(0) > z);
+			if (0 != s) {
+				convex_ = 0 == sign || s == sign;
+				sign    = s;
+			}
+		}
+
+		// One slab per edge gives a few edges per slab for typical polygons
+		num_slabs_  = n;
+		T height    = bounds_.max.y - bounds_.min.y;
+		inv_height_ = T(0) < height ? static_cast<T>(num_slabs_) / height : T(0);
+
+		std::vector<std::size_t> count(num_slabs_ + 1, 0);
+		auto for_each_slab = [this, n](auto f) {
+			for (std::size_t i{}; n > i; ++i) {
+				auto a = vertices_[i];
+				auto b = vertices_[(i + 1) % n];
+				if (a.y > b.y) {
+					std::swap(a, b);
+				}
+				for (std::size_t s = slab(a.y), e = slab(b.y); e >= s; ++s) {
+					f(s, a, b);
+				}
+			}
+		};
+
+		for_each_slab([&count](std::size_t s, auto const&, auto const&) { ++count[s + 1]; });
+
+		offset_.resize(num_slabs_ + 1);
+		offset_[0] = 0;
+		for (std::size_t s{}; num_slabs_ > s; ++s) {
+			offset_[s + 1] = offset_[s] + count[s + 1];
+		}
+
+		std::size_t const total = offset_[num_slabs_];
+		x0_.resize(total);
+		y0_.resize(total);
+		x1_.resize(total);
+		y1_.resize(total);
+		slope_.resize(total);
+
+		std::vector<std::size_t> pos(offset_.begin(), offset_.end() - 1);
+		for_each_slab([this, &pos](std::size_t s, auto const& a, auto const& b) {
+			std::size_t const i = pos[s]++;
+			x0_[i]              = a.x;
+			y0_[i]              = a.y;
+			x1_[i]              = b.x;
+			y1_[i]              = b.y;
+			slope_[i]           = a.y < b.y ? (b.x - a.x) / (b.y - a.y) : T(0);
+		});
+	}
+
+	[[nodiscard]] std::size_t slab(T y) const noexcept
+	{
+		T const s = (y - bounds_.min.y) * inv_height_;
+		return T(0) >= s ? 0
+		                 : std::min(num_slabs_ - 1, static_cast<std::size_t>(s));
+	}
+
+ private:
+	std::vector<Vec<2, T>> vertices_;
+	AABB<2, T>             bounds_;
+	bool                   convex_{};
+
+	std::size_t              num_slabs_{};
+	T                        inv_height_{};
+	std::vector<std::size_t> offset_;
+	std::vector<T>           x0_;
+	std::vector<T>           y0_;
+	std::vector<T>           x1_;
+	std::vector<T>           y1_;
+	std::vector<T>           slope_;
+};
+
+/*!
+ * @brief Compare two Polygons.
+ *
+ * @param lhs,rhs The Polygons to compare
+ * @return `true` if they compare equal, `false` otherwise.
+ */
+template <class T>
+bool operator==(Polygon<T> const& lhs, Polygon<T> const& rhs)
+{
+	return lhs.vertices() == rhs.vertices();
+}
+
+/*!
+ * @brief Compare two Polygons.
+ *
+ * @param lhs,rhs The Polygons to compare
+ * @return `true` if they do not compare equal, `false` otherwise.
+ */
+template <class T>
+bool operator!=(Polygon<T> const& lhs, Polygon<T> const& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& out, Polygon<T> const& polygon)
+{
+	out << "Vertices: [";
+	for (std::size_t i{}; polygon.size() > i; ++i) {
+		out << (0 == i ? "" : ", ") << polygon[i];
+	}
+	return out << "]";
+}
+
+using Polygonf = Polygon<float>;
+using Polygond = Polygon<double>;
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_POLYGON_HPP
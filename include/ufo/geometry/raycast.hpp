@@ -0,0 +1,223 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_RAYCAST_HPP
+#define UFO_GEOMETRY_RAYCAST_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/cone.hpp>
+#include <ufo/geometry/cylinder.hpp>
+#include <ufo/geometry/ray.hpp>
+#include <ufo/geometry/sphere.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+namespace ufo
+{
+namespace detail
+{
+/*!
+ * @brief Parameter interval `[lo, hi]` where the axial coordinate `od + t * dd` is in
+ * `[0, length]`.
+ *
+ * @return `false` if the interval is empty.
+ */
+template <class T>
+[[nodiscard]] constexpr bool raycastSlab(T od, T dd, T length, T& lo, T& hi)
+{
+	if (T(0) == dd) {
+		lo = -std::numeric_limits<T>::infinity();
+		hi = std::numeric_limits<T>::infinity();
+		return T(0) <= od && length >= od;
+	}
+
+	T const inv = T(1) / dd;
+	T       t0  = -od * inv;
+	T       t1  = (length - od) * inv;
+	if (t0 > t1) {
+		std::swap(t0, t1);
+	}
+	lo = t0;
+	hi = t1;
+	return true;
+}
+
+/*!
+ * @brief Smallest `t` in `[lo, hi]` where `a * t^2 + 2 * b * t + c <= 0`, infinity if
+ * there is none.
+ */
+template <class T>
+[[nodiscard]] constexpr T raycastQuadratic(T a, T b, T c, T lo, T hi)
+{
+	constexpr T inf = std::numeric_limits<T>::infinity();
+
+	if (lo > hi) {
+		return inf;
+	}
+
+	auto first = [lo, hi](T l, T h) {
+		return std::max(l, lo) <= std::min(h, hi) ? std::max(l, lo) : inf;
+	};
+
+	if (T(0) == a) {
+		if (T(0) == b) {
+			return T(0) >= c ? lo : inf;
+		}
+		T const t = -c / (T(2) * b);
+		return T(0) < b ? first(-inf, t) : first(t, inf);
+	}
+
+	T const disc = b * b - a * c;
+	if (T(0) > disc) {
+		// Never or always non-positive
+		return T(0) < a ? inf : lo;
+	}
+
+	T const sq = std::sqrt(disc);
+	T const t0 = (-b - sq) / a;
+	T const t1 = (-b + sq) / a;
+	if (T(0) < a) {
+		return first(t0, t1);
+	}
+	// Opens downward, non-positive outside of the roots
+	return std::min(first(-inf, t1), first(t0, inf));
+}
+}  // namespace detail
+
+/*!
+ * @brief Distance along `b` to the first point of `a`.
+ *
+ * The ray direction is assumed to be normalized, which `Ray` ensures on construction.
+ *
+ * @return The distance to the first hit, `0` if the origin of `b` is inside `a`, and
+ * infinity if `b` misses `a`.
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T raycast(AABB<Dim, T> const& a, Ray<Dim, T> const& b)
+{
+	T lo = T(0);
+	T hi = std::numeric_limits<T>::infinity();
+	for (std::size_t i{}; Dim > i; ++i) {
+		T l;
+		T h;
+		if (!detail::raycastSlab(b.origin[i] - a.min[i], b.direction[i],
+		                         a.max[i] - a.min[i], l, h)) {
+			return std::numeric_limits<T>::infinity();
+		}
+		lo = std::max(lo, l);
+		hi = std::min(hi, h);
+	}
+	return lo <= hi ? lo : std::numeric_limits<T>::infinity();
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T raycast(Sphere<Dim, T> const& a, Ray<Dim, T> const& b)
+{
+	auto const o = b.origin - a.center;
+	return detail::raycastQuadratic(dot(b.direction, b.direction), dot(o, b.direction),
+	                                dot(o, o) - a.radius * a.radius, T(0),
+	                                std::numeric_limits<T>::infinity());
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T raycast(Cylinder<Dim, T> const& a, Ray<Dim, T> const& b)
+{
+	auto const axis   = a.end - a.start;
+	T const    length = norm(axis);
+	if (T(0) == length) {
+		return std::numeric_limits<T>::infinity();
+	}
+	auto const u = axis / length;
+
+	// Axial and radial parts of the ray relative to the start cap
+	auto const o  = b.origin - a.start;
+	T const    od = dot(o, u);
+	T const    dd = dot(b.direction, u);
+	auto const op = o - u * od;
+	auto const dp = b.direction - u * dd;
+
+	T lo;
+	T hi;
+	if (!detail::raycastSlab(od, dd, length, lo, hi)) {
+		return std::numeric_limits<T>::infinity();
+	}
+	return detail::raycastQuadratic(dot(dp, dp), dot(op, dp),
+	                                dot(op, op) - a.radius * a.radius, std::max(T(0), lo),
+	                                hi);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T raycast(Cone<Dim, T> const& a, Ray<Dim, T> const& b)
+{
+	auto const axis   = a.base_center - a.tip;
+	T const    height = norm(axis);
+	if (T(0) == height) {
+		return std::numeric_limits<T>::infinity();
+	}
+	auto const u  = axis / height;
+	T const    k  = a.radius / height;
+	T const    k2 = k * k;
+
+	// Double cone |op + t dp|^2 <= k^2 (od + t dd)^2, the slab keeps the right nappe
+	auto const o  = b.origin - a.tip;
+	T const    od = dot(o, u);
+	T const    dd = dot(b.direction, u);
+	auto const op = o - u * od;
+	auto const dp = b.direction - u * dd;
+
+	T lo;
+	T hi;
+	if (!detail::raycastSlab(od, dd, height, lo, hi)) {
+		return std::numeric_limits<T>::infinity();
+	}
+	return detail::raycastQuadratic(dot(dp, dp) - k2 * dd * dd, dot(op, dp) - k2 * od * dd,
+	                                dot(op, op) - k2 * od * od, std::max(T(0), lo), hi);
+}
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_RAYCAST_HPP
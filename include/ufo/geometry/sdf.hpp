@@ -0,0 +1,587 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_SDF_HPP
+#define UFO_GEOMETRY_SDF_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/bounding_volume.hpp>
+#include <ufo/geometry/bvh.hpp>
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/signed_distance.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+enum class SDFStorage {
+	// Every block is stored
+	DENSE,
+	// Blocks where all values are outside the band are replaced by a constant
+	SPARSE
+};
+
+/*!
+ * @brief A signed distance field sampled on a regular grid, baked from a set of
+ * geometries.
+ *
+ * The values are the smallest signed distance to any of the geometries, stored at the
+ * grid nodes `bounds.min + resolution * (x, y, z)`, and clamped to [-band, band]. The
+ * nodes are grouped in blocks of `BLOCK_SIZE^3` that are stored contiguously. With
+ * `SDFStorage::SPARSE`, blocks where every value is clamped are not stored at all.
+ *
+ * Sampling between the nodes is trilinear, and constant time regardless of the storage.
+ * Points outside the grid are clamped to it.
+ */
+template <class T = float>
+class SDF
+{
+	static_assert(std::is_floating_point_v<T>, "T is required to be floating point.");
+
+ public:
+	using value_type = T;
+	using size_type  = std::size_t;
+
+	static constexpr size_type BLOCK_SIZE = 8;
+
+	SDF() = default;
+
+	/*!
+	 * @brief Bakes the signed distance field of the geometries in `shapes` inside
+	 * `bounds`.
+	 *
+	 * The blocks are baked independently. The distance at the center of a block bounds
+	 * the distance at all its nodes, so blocks that are entirely clamped are filled
+	 * without evaluating any node. Otherwise the geometries that can be the closest to
+	 * any node in the block are collected from `shapes`, and each node only considers
+	 * those whose bounds are closer than the best distance so far.
+	 *
+	 * @param shapes The geometries, `signedDistance(geometry, Vec<3, T>)` has to exist
+	 * @param bounds The region to bake
+	 * @param resolution The distance between two grid nodes
+	 * @param storage Whether blocks outside the band are stored
+	 * @param band Values are clamped to [-band, band]
+	 * @param gradients Whether to also store the gradient at each node
+	 *
+	 * @throw std::invalid_argument If `resolution` is not positive.
+	 */
+	template <class Geometry>
+	SDF(BVH<Geometry> const& shapes, AABB<3, T> const& bounds, T resolution,
+	    SDFStorage storage = SDFStorage::DENSE, T band = std::numeric_limits<T>::infinity(),
+	    bool gradients = false)
+	    : SDF(std::execution::seq, shapes, bounds, resolution, storage, band, gradients)
+	{
+	}
+
+	/*!
+	 * @brief Same as above, but the blocks are baked according to `policy`.
+	 */
+	template <
+	    class ExecutionPolicy, class Geometry,
+	    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+	        true>
+	SDF(ExecutionPolicy&& policy, BVH<Geometry> const& shapes, AABB<3, T> const& bounds,
+	    T resolution, SDFStorage storage = SDFStorage::DENSE,
+	    T band = std::numeric_limits<T>::infinity(), bool gradients = false)
+	    : bounds_(bounds), resolution_(resolution), band_(band)
+	{
+		init();
+		bake(std::forward<ExecutionPolicy>(policy), shapes, storage, gradients);
+	}
+
+	[[nodiscard]] AABB<3, T> const& bounds() const noexcept { return bounds_; }
+
+	[[nodiscard]] T resolution() const noexcept { return resolution_; }
+
+	[[nodiscard]] T band() const noexcept { return band_; }
+
+	/*!
+	 * @brief Number of grid nodes along each axis.
+	 */
+	[[nodiscard]] std::array<size_type, 3> const& size() const noexcept { return size_; }
+
+	[[nodiscard]] bool empty() const noexcept { return block_.empty(); }
+
+	[[nodiscard]] bool hasGradients() const noexcept { return !gradient_.empty(); }
+
+	/*!
+	 * @brief Number of blocks and number of blocks that are stored.
+	 */
+	[[nodiscard]] std::pair<size_type, size_type> blocks() const noexcept
+	{
+		return {block_.size(), value_.size() / BLOCK_VOLUME};
+	}
+
+	[[nodiscard]] Vec<3, T> position(size_type x, size_type y, size_type z) const
+	{
+		return bounds_.min + Vec<3, T>(T(x), T(y), T(z)) * resolution_;
+	}
+
+	/*!
+	 * @brief The value at grid node (`x`, `y`, `z`).
+	 */
+	[[nodiscard]] T value(size_type x, size_type y, size_type z) const
+	{
+		auto const [b, i] = locate(x, y, z);
+		std::uint32_t const block = block_[b];
+		switch (block) {
+			case OUTSIDE: return band_;
+			case INSIDE: return -band_;
+			default: return value_[block * BLOCK_VOLUME + i];
+		}
+	}
+
+	/*!
+	 * @brief The stored gradient at grid node (`x`, `y`, `z`), zero in blocks that are
+	 * not stored.
+	 *
+	 * @note Requires that the field was baked with gradients.
+	 */
+	[[nodiscard]] Vec<3, T> gradient(size_type x, size_type y, size_type z) const
+	{
+		auto const [b, i] = locate(x, y, z);
+		std::uint32_t const block = block_[b];
+		return OUTSIDE == block || INSIDE == block ? Vec<3, T>()
+		                                           : gradient_[block * BLOCK_VOLUME + i];
+	}
+
+	/*!
+	 * @brief Trilinearly interpolated signed distance at `p`.
+	 */
+	[[nodiscard]] T distance(Vec<3, T> const& p) const
+	{
+		auto const [base, t] = cell(p);
+		auto const v         = corners(base);
+
+		T const x00 = v[0] + (v[1] - v[0]) * t.x;
+		T const x10 = v[2] + (v[3] - v[2]) * t.x;
+		T const x01 = v[4] + (v[5] - v[4]) * t.x;
+		T const x11 = v[6] + (v[7] - v[6]) * t.x;
+		T const y0  = x00 + (x10 - x00) * t.y;
+		T const y1  = x01 + (x11 - x01) * t.y;
+		return y0 + (y1 - y0) * t.z;
+	}
+
+	/*!
+	 * @brief Gradient at `p`.
+	 *
+	 * If the field was baked with gradients they are trilinearly interpolated, otherwise
+	 * the gradient of the trilinear interpolation of the distance is used. Neither is
+	 * normalized.
+	 */
+	[[nodiscard]] Vec<3, T> gradient(Vec<3, T> const& p) const
+	{
+		return distanceAndGradient(p).gradient;
+	}
+
+	/*!
+	 * @brief Same as `distance(p)` and `gradient(p)`, but sharing the lookups.
+	 */
+	[[nodiscard]] SignedDistance<3, T> distanceAndGradient(Vec<3, T> const& p) const
+	{
+		auto const [base, t] = cell(p);
+		auto const v         = corners(base);
+
+		T const x00 = v[0] + (v[1] - v[0]) * t.x;
+		T const x10 = v[2] + (v[3] - v[2]) * t.x;
+		T const x01 = v[4] + (v[5] - v[4]) * t.x;
+		T const x11 = v[6] + (v[7] - v[6]) * t.x;
+		T const y0  = x00 + (x10 - x00) * t.y;
+		T const y1  = x01 + (x11 - x01) * t.y;
+
+		SignedDistance<3, T> res;
+		res.distance = y0 + (y1 - y0) * t.z;
+
+		if (hasGradients()) {
+			std::array<Vec<3, T>, 8> g;
+			for (std::size_t i{}; 8 > i; ++i) {
+				g[i] = gradient(base[0] + (i & 1u), base[1] + ((i >> 1) & 1u),
+				                base[2] + ((i >> 2) & 1u));
+			}
+			Vec<3, T> const gx00 = g[0] + (g[1] - g[0]) * t.x;
+			Vec<3, T> const gx10 = g[2] + (g[3] - g[2]) * t.x;
+			Vec<3, T> const gx01 = g[4] + (g[5] - g[4]) * t.x;
+			Vec<3, T> const gx11 = g[6] + (g[7] - g[6]) * t.x;
+			Vec<3, T> const gy0  = gx00 + (gx10 - gx00) * t.y;
+			Vec<3, T> const gy1  = gx01 + (gx11 - gx01) * t.y;
+			res.gradient         = gy0 + (gy1 - gy0) * t.z;
+		} else {
+			T const inv = T(1) / resolution_;
+			T const dx0 = (v[1] - v[0]) + ((v[3] - v[2]) - (v[1] - v[0])) * t.y;
+			T const dx1 = (v[5] - v[4]) + ((v[7] - v[6]) - (v[5] - v[4])) * t.y;
+			T const dy0 = (x10 - x00);
+			T const dy1 = (x11 - x01);
+			res.gradient.x = (dx0 + (dx1 - dx0) * t.z) * inv;
+			res.gradient.y = (dy0 + (dy1 - dy0) * t.z) * inv;
+			res.gradient.z = (y1 - y0) * inv;
+		}
+		return res;
+	}
+
+ private:
+	static constexpr size_type     BLOCK_VOLUME = BLOCK_SIZE * BLOCK_SIZE * BLOCK_SIZE;
+	static constexpr std::uint32_t OUTSIDE      = std::numeric_limits<std::uint32_t>::max();
+	static constexpr std::uint32_t INSIDE       = OUTSIDE - 1;
+
+	void init()
+	{
+		if (!(T(0) < resolution_)) {
+			throw std::invalid_argument("SDF resolution has to be positive");
+		}
+
+		for (std::size_t i{}; 3 > i; ++i) {
+			T const cells = std::ceil((bounds_.max[i] - bounds_.min[i]) / resolution_);
+			size_[i]       = std::max(size_type(1), static_cast<size_type>(cells)) + 1;
+			num_blocks_[i] = (size_[i] + BLOCK_SIZE - 1) / BLOCK_SIZE;
+		}
+		block_.assign(num_blocks_[0] * num_blocks_[1] * num_blocks_[2], OUTSIDE);
+	}
+
+	[[nodiscard]] std::pair<size_type, size_type> locate(size_type x, size_type y,
+	                                                     size_type z) const noexcept
+	{
+		size_type const b =
+		    (z / BLOCK_SIZE * num_blocks_[1] + y / BLOCK_SIZE) * num_blocks_[0] +
+		    x / BLOCK_SIZE;
+		size_type const i = ((z % BLOCK_SIZE) * BLOCK_SIZE + y % BLOCK_SIZE) * BLOCK_SIZE +
+		                    x % BLOCK_SIZE;
+		return {b, i};
+	}
+
+	/*!
+	 * @brief The grid cell containing `p`, as the index of its lowest node and the
+	 * position of `p` inside it in [0, 1].
+	 */
+	[[nodiscard]] std::pair<std::array<size_type, 3>, Vec<3, T>> cell(
+	    Vec<3, T> const& p) const
+	{
+		std::array<size_type, 3> base;
+		Vec<3, T>                t;
+		for (std::size_t i{}; 3 > i; ++i) {
+			T const g = std::clamp((p[i] - bounds_.min[i]) / resolution_, T(0),
+			                       T(size_[i] - 1));
+			base[i]   = std::min(static_cast<size_type>(g), size_[i] - 2);
+			t[i]      = g - T(base[i]);
+		}
+		return {base, t};
+	}
+
+	[[nodiscard]] std::array<T, 8> corners(std::array<size_type, 3> const& base) const
+	{
+		std::array<T, 8> v;
+		for (std::size_t i{}; 8 > i; ++i) {
+			v[i] = value(base[0] + (i & 1u), base[1] + ((i >> 1) & 1u),
+			             base[2] + ((i >> 2) & 1u));
+		}
+		return v;
+	}
+
+	template <class ExecutionPolicy, class Geometry>
+	void bake(ExecutionPolicy&& policy, BVH<Geometry> const& shapes, SDFStorage storage,
+	          bool gradients)
+	{
+		struct Block {
+			std::vector<T>         value;
+			std::vector<Vec<3, T>> gradient;
+			std::uint32_t          uniform = OUTSIDE;
+		};
+
+		std::vector<Block> blocks(block_.size());
+
+		std::vector<size_type> idx(block_.size());
+		std::iota(idx.begin(), idx.end(), size_type(0));
+
+		std::for_each(std::forward<ExecutionPolicy>(policy), idx.begin(), idx.end(),
+		              [&](size_type b) {
+			              bakeBlock(shapes, b, storage, gradients, blocks[b].value,
+			                        blocks[b].gradient, blocks[b].uniform);
+		              });
+
+		size_type stored{};
+		for (size_type b{}; blocks.size() > b; ++b) {
+			if (blocks[b].value.empty()) {
+				block_[b] = blocks[b].uniform;
+			} else {
+				block_[b] = static_cast<std::uint32_t>(stored++);
+			}
+		}
+
+		value_.resize(stored * BLOCK_VOLUME);
+		if (gradients) {
+			gradient_.resize(stored * BLOCK_VOLUME);
+		}
+		for (size_type b{}; blocks.size() > b; ++b) {
+			if (blocks[b].value.empty()) {
+				continue;
+			}
+			std::copy(blocks[b].value.begin(), blocks[b].value.end(),
+			          value_.begin() + block_[b] * BLOCK_VOLUME);
+			if (gradients) {
+				std::copy(blocks[b].gradient.begin(), blocks[b].gradient.end(),
+				          gradient_.begin() + block_[b] * BLOCK_VOLUME);
+			}
+		}
+	}
+
+	/*!
+	 * @brief Evaluates the nodes of block `b`.
+	 *
+	 * `value` is left empty if the block does not have to be stored, in which case
+	 * `uniform` says whether it is inside or outside.
+	 */
+	template <class Geometry>
+	void bakeBlock(BVH<Geometry> const& shapes, size_type b, SDFStorage storage,
+	               bool gradients, std::vector<T>& value, std::vector<Vec<3, T>>& gradient,
+	               std::uint32_t& uniform) const
+	{
+		using size3 = std::array<size_type, 3>;
+
+		size3 const block{b % num_blocks_[0], b / num_blocks_[0] % num_blocks_[1],
+		                  b / num_blocks_[0] / num_blocks_[1]};
+		size3       first;
+		size3       last;
+		for (std::size_t i{}; 3 > i; ++i) {
+			first[i] = block[i] * BLOCK_SIZE;
+			last[i]  = std::min(size_[i], first[i] + BLOCK_SIZE);
+		}
+
+		AABB<3, T> const region(position(first[0], first[1], first[2]),
+		                        position(last[0] - 1, last[1] - 1, last[2] - 1));
+		Vec<3, T> const  center = region.center();
+
+		// The distance field is 1-Lipschitz, so every node in the block is within `reach`
+		// of the distance at the center
+		T const    reach = norm(region.halfLength());
+		auto const near  = shapes.traverseNearest(
+		    [&center](AABB<3, T> const& a) { return signedDistance(a, center); },
+		    [&center](Geometry const& g, size_type) { return signedDistance(g, center); },
+		    band_ + reach);
+		T const lower = near.second - reach;
+		T const upper = near.second + reach;
+
+		// All nodes are clamped
+		if (band_ <= lower || -band_ >= upper) {
+			T const v = band_ <= lower ? band_ : -band_;
+			if (SDFStorage::SPARSE == storage) {
+				uniform = band_ <= lower ? OUTSIDE : INSIDE;
+			} else {
+				value.assign(BLOCK_VOLUME, v);
+				gradient.assign(gradients ? BLOCK_VOLUME : 0, Vec<3, T>());
+			}
+			return;
+		}
+
+		// Only geometries within `upper` of the block can be the closest to a node, or the
+		// ones containing it if `upper` is negative
+		T const limit = std::max(T(0), std::min(band_, upper));
+
+		std::vector<std::pair<T, Geometry const*>> candidates;
+		std::vector<AABB<3, T>>                    candidate_bounds;
+		shapes.traverse(
+		    [&](AABB<3, T> const& a) { return ufo::distance(a, region) <= limit; },
+		    [&](Geometry const& g, size_type) {
+			    AABB<3, T> const a(detail::lower(g), detail::upper(g));
+			    if (ufo::distance(a, region) <= limit) {
+				    candidates.emplace_back(signedDistance(a, center), &g);
+			    }
+		    });
+
+		value.assign(BLOCK_VOLUME, band_);
+		if (gradients) {
+			gradient.assign(BLOCK_VOLUME, Vec<3, T>());
+		}
+
+		// Closest first, so the best distance shrinks quickly
+		std::sort(candidates.begin(), candidates.end(),
+		          [](auto const& a, auto const& b) { return a.first < b.first; });
+		for (auto const& [_, g] : candidates) {
+			candidate_bounds.emplace_back(detail::lower(*g), detail::upper(*g));
+		}
+
+		bool inside_band{};
+		bool inside{};
+		bool outside{};
+		for (size_type z = first[2]; last[2] > z; ++z) {
+			for (size_type y = first[1]; last[1] > y; ++y) {
+				for (size_type x = first[0]; last[0] > x; ++x) {
+					Vec<3, T> const p = position(x, y, z);
+					Vec<3, T>       g;
+					T               best = band_;
+
+					for (std::size_t c{}; candidates.size() > c; ++c) {
+						if (!(signedDistance(candidate_bounds[c], p) < best)) {
+							continue;
+						}
+						if (gradients) {
+							auto const sd = signedDistanceAndGradient(*candidates[c].second, p);
+							if (sd.distance < best) {
+								best = sd.distance;
+								g    = sd.gradient;
+							}
+						} else {
+							best = std::min(best, signedDistance(*candidates[c].second, p));
+						}
+					}
+
+					T const           d = std::max(-band_, best);
+					std::size_t const i = locate(x, y, z).second;
+					value[i]            = d;
+					if (gradients) {
+						gradient[i] = g;
+					}
+
+					inside_band = inside_band || (-band_ < d && d < band_);
+					inside      = inside || T(0) > d;
+					outside     = outside || T(0) <= d;
+				}
+			}
+		}
+
+		if (SDFStorage::SPARSE == storage && !inside_band && inside != outside) {
+			uniform = inside ? INSIDE : OUTSIDE;
+			value.clear();
+			gradient.clear();
+		}
+	}
+
+ private:
+	AABB<3, T> bounds_;
+	T          resolution_{};
+	T          band_{};
+
+	std::array<size_type, 3> size_{};
+	std::array<size_type, 3> num_blocks_{};
+
+	// Position of each block in `value_`, or `OUTSIDE`/`INSIDE` if it is not stored
+	std::vector<std::uint32_t> block_;
+	std::vector<T>             value_;
+	std::vector<Vec<3, T>>     gradient_;
+};
+
+/**************************************************************************************
+|                                                                                     |
+|                                        Bake                                         |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Bakes the signed distance field of the geometries in `shapes`.
+ *
+ * See `SDF` for a description of the arguments.
+ */
+template <class Geometry, class T>
+[[nodiscard]] SDF<T> bakeSDF(BVH<Geometry> const& shapes, AABB<3, T> const& bounds,
+                             T resolution, SDFStorage storage = SDFStorage::DENSE,
+                             T    band      = std::numeric_limits<T>::infinity(),
+                             bool gradients = false)
+{
+	return SDF<T>(shapes, bounds, resolution, storage, band, gradients);
+}
+
+/*!
+ * @brief Same as above, but the blocks are baked according to `policy`.
+ */
+template <
+    class ExecutionPolicy, class Geometry, class T,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+[[nodiscard]] SDF<T> bakeSDF(ExecutionPolicy&& policy, BVH<Geometry> const& shapes,
+                             AABB<3, T> const& bounds, T resolution,
+                             SDFStorage storage   = SDFStorage::DENSE,
+                             T          band      = std::numeric_limits<T>::infinity(),
+                             bool       gradients = false)
+{
+	return SDF<T>(std::forward<ExecutionPolicy>(policy), shapes, bounds, resolution,
+	              storage, band, gradients);
+}
+
+/*!
+ * @brief Bakes the signed distance field of the geometries in [first, last), which are
+ * first put in a `BVH`.
+ */
+template <class InputIt, class T>
+[[nodiscard]] SDF<T> bakeSDF(InputIt first, InputIt last, AABB<3, T> const& bounds,
+                             T resolution, SDFStorage storage = SDFStorage::DENSE,
+                             T    band      = std::numeric_limits<T>::infinity(),
+                             bool gradients = false)
+{
+	using Geometry = typename std::iterator_traits<InputIt>::value_type;
+	return SDF<T>(BVH<Geometry>(first, last), bounds, resolution, storage, band,
+	              gradients);
+}
+
+/*!
+ * @brief Same as above, but the `BVH` is built and the blocks are baked according to
+ * `policy`.
+ */
+template <
+    class ExecutionPolicy, class RandomIt, class T,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+[[nodiscard]] SDF<T> bakeSDF(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+                             AABB<3, T> const& bounds, T resolution,
+                             SDFStorage storage   = SDFStorage::DENSE,
+                             T          band      = std::numeric_limits<T>::infinity(),
+                             bool       gradients = false)
+{
+	using Geometry = typename std::iterator_traits<RandomIt>::value_type;
+	BVH<Geometry> shapes(policy, first, last);
+	return SDF<T>(std::forward<ExecutionPolicy>(policy), shapes, bounds, resolution,
+	              storage, band, gradients);
+}
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_SDF_HPP
@@ -0,0 +1,571 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_SIGNED_DISTANCE_HPP
+#define UFO_GEOMETRY_SIGNED_DISTANCE_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/capsule.hpp>
+#include <ufo/geometry/cylinder.hpp>
+#include <ufo/geometry/obb.hpp>
+#include <ufo/geometry/plane.hpp>
+#include <ufo/geometry/sphere.hpp>
+#include <ufo/geometry/triangle.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <execution>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+namespace ufo
+{
+/*!
+ * @brief Signed distance from a geometry to a point together with its gradient.
+ *
+ * The distance is negative inside the geometry. The gradient is the unit direction in
+ * which the distance grows the fastest, i.e., the outward normal of the closest surface
+ * point.
+ */
+template <std::size_t Dim = 3, class T = float>
+struct SignedDistance {
+	static_assert(std::is_floating_point_v<T>, "T is required to be floating point.");
+
+	using value_type = T;
+
+	T           distance{};
+	Vec<Dim, T> gradient;
+};
+
+/*!
+ * @brief Compare two SignedDistances.
+ *
+ * @param lhs,rhs The SignedDistances to compare
+ * @return `true` if they compare equal, `false` otherwise.
+ */
+template <std::size_t Dim, class T>
+bool operator==(SignedDistance<Dim, T> const& lhs, SignedDistance<Dim, T> const& rhs)
+{
+	return lhs.distance == rhs.distance && lhs.gradient == rhs.gradient;
+}
+
+/*!
+ * @brief Compare two SignedDistances.
+ *
+ * @param lhs,rhs The SignedDistances to compare
+ * @return `true` if they do not compare equal, `false` otherwise.
+ */
+template <std::size_t Dim, class T>
+bool operator!=(SignedDistance<Dim, T> const& lhs, SignedDistance<Dim, T> const& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <std::size_t Dim, class T>
+std::ostream& operator<<(std::ostream& out, SignedDistance<Dim, T> const& sd)
+{
+	return out << "Distance: " << sd.distance << ", Gradient: " << sd.gradient;
+}
+
+namespace detail
+{
+/*!
+ * @brief A unit vector orthogonal to `v`, which does not have to be normalized.
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> orthogonal(Vec<Dim, T> const& v)
+{
+	std::size_t axis{};
+	for (std::size_t i = 1; Dim > i; ++i) {
+		axis = std::abs(v[i]) < std::abs(v[axis]) ? i : axis;
+	}
+
+	Vec<Dim, T> res;
+	res[axis]  = T(1);
+	T const vv = dot(v, v);
+	if (T(0) < vv) {
+		res -= v * (v[axis] / vv);
+	}
+	return normalize(res);
+}
+
+/*!
+ * @brief Signed distance from a box centered at the origin with `half_length` to `p`.
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T boxSignedDistance(Vec<Dim, T> const& p,
+                                            Vec<Dim, T> const& half_length)
+{
+	T outside{};
+	T inside = std::numeric_limits<T>::lowest();
+	for (std::size_t i{}; Dim > i; ++i) {
+		T const q  = std::abs(p[i]) - half_length[i];
+		T const o  = std::max(q, T(0));
+		outside   += o * o;
+		inside     = std::max(inside, q);
+	}
+	return T(0) < outside ? std::sqrt(outside) : inside;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr SignedDistance<Dim, T> boxSignedDistanceAndGradient(
+    Vec<Dim, T> const& p, Vec<Dim, T> const& half_length)
+{
+	SignedDistance<Dim, T> res;
+
+	T           outside{};
+	T           inside = std::numeric_limits<T>::lowest();
+	std::size_t axis{};
+	for (std::size_t i{}; Dim > i; ++i) {
+		T const q       = std::abs(p[i]) - half_length[i];
+		T const o       = std::max(q, T(0));
+		res.gradient[i] = T(0) > p[i] ? -o : o;
+		outside        += o * o;
+		axis            = inside < q ? i : axis;
+		inside          = std::max(inside, q);
+	}
+
+	if (T(0) < outside) {
+		res.distance  = std::sqrt(outside);
+		res.gradient /= res.distance;
+	} else {
+		// Inside, the closest face is the one with the least depth
+		res.distance       = inside;
+		res.gradient       = Vec<Dim, T>();
+		res.gradient[axis] = T(0) > p[axis] ? T(-1) : T(1);
+	}
+	return res;
+}
+
+/*!
+ * @brief Signed distance from a ball at `center` with `radius` to `p`.
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr SignedDistance<Dim, T> ballSignedDistanceAndGradient(
+    Vec<Dim, T> const& center, T radius, Vec<Dim, T> const& p)
+{
+	auto const v = p - center;
+	T const    l = norm(v);
+	if (T(0) < l) {
+		return {l - radius, v / l};
+	}
+
+	Vec<Dim, T> g;
+	g[0] = T(1);
+	return {-radius, g};
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> closestPointSegment(Vec<Dim, T> const& start,
+                                                        Vec<Dim, T> const& end,
+                                                        Vec<Dim, T> const& p)
+{
+	auto const dir = end - start;
+	T const    l2  = dot(dir, dir);
+	T const    t   = T(0) < l2 ? std::clamp(dot(p - start, dir) / l2, T(0), T(1)) : T(0);
+	return start + dir * t;
+}
+
+// Ericson, Real-Time Collision Detection, 5.1.5
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> closestPointTriangle(Triangle<Dim, T> const& tri,
+                                                         Vec<Dim, T> const&      p)
+{
+	auto const a  = tri[0];
+	auto const ab = tri[1] - a;
+	auto const ac = tri[2] - a;
+	auto const ap = p - a;
+
+	T const d1 = dot(ab, ap);
+	T const d2 = dot(ac, ap);
+	if (T(0) >= d1 && T(0) >= d2) {
+		return a;
+	}
+
+	auto const bp = p - tri[1];
+	T const    d3 = dot(ab, bp);
+	T const    d4 = dot(ac, bp);
+	if (T(0) <= d3 && d4 <= d3) {
+		return tri[1];
+	}
+
+	T const vc = d1 * d4 - d3 * d2;
+	if (T(0) >= vc && T(0) <= d1 && T(0) >= d3) {
+		return a + ab * (d1 / (d1 - d3));
+	}
+
+	auto const cp = p - tri[2];
+	T const    d5 = dot(ab, cp);
+	T const    d6 = dot(ac, cp);
+	if (T(0) <= d6 && d5 <= d6) {
+		return tri[2];
+	}
+
+	T const vb = d5 * d2 - d1 * d6;
+	if (T(0) >= vb && T(0) <= d2 && T(0) >= d6) {
+		return a + ac * (d2 / (d2 - d6));
+	}
+
+	T const va = d3 * d6 - d5 * d4;
+	if (T(0) >= va && T(0) <= d4 - d3 && T(0) <= d5 - d6) {
+		return tri[1] + (tri[2] - tri[1]) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+	}
+
+	T const denom = T(1) / (va + vb + vc);
+	return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+/*!
+ * @brief Closest point to `p` on the boundary of a triangle.
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> closestPointTriangleBoundary(
+    Triangle<Dim, T> const& tri, Vec<Dim, T> const& p)
+{
+	Vec<Dim, T> res = closestPointSegment(tri[0], tri[1], p);
+	T           d   = distanceSquared(res, p);
+	for (std::size_t i = 1; 3 > i; ++i) {
+		auto const q  = closestPointSegment(tri[i], tri[(i + 1) % 3], p);
+		T const    dq = distanceSquared(q, p);
+		if (d > dq) {
+			d   = dq;
+			res = q;
+		}
+	}
+	return res;
+}
+
+template <class T>
+[[nodiscard]] constexpr bool insideTriangle(Triangle<2, T> const& tri,
+                                            Vec<2, T> const&      p)
+{
+	auto side = [](Vec<2, T> const& a, Vec<2, T> const& b, Vec<2, T> const& c) {
+		return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+	};
+	T const s0 = side(tri[0], tri[1], p);
+	T const s1 = side(tri[1], tri[2], p);
+	T const s2 = side(tri[2], tri[0], p);
+	return (T(0) <= s0 && T(0) <= s1 && T(0) <= s2) ||
+	       (T(0) >= s0 && T(0) >= s1 && T(0) >= s2);
+}
+
+/*!
+ * @brief Axial coordinate and radial part of `p` relative to the cylinder axis.
+ */
+template <std::size_t Dim, class T>
+constexpr void cylinderFrame(Cylinder<Dim, T> const& a, Vec<Dim, T> const& p,
+                             Vec<Dim, T>& axis, T& half, T& s, Vec<Dim, T>& radial)
+{
+	axis           = a.end - a.start;
+	T const length = norm(axis);
+	axis           = T(0) < length ? axis / length : Vec<Dim, T>();
+	half           = length / T(2);
+
+	auto const v = p - (a.start + a.end) / T(2);
+	s            = dot(v, axis);
+	radial       = v - axis * s;
+}
+}  // namespace detail
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Distance                                       |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Signed distance from `a` to `b`, negative if `b` is inside `a`.
+ *
+ * Triangles in more than two dimensions have no inside, so the distance to them is
+ * never negative. The normal of planes is assumed to be normalized, the distance is
+ * positive on the side the normal points to.
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T signedDistance(AABB<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	return detail::boxSignedDistance(b - (a.min + a.max) / T(2), (a.max - a.min) / T(2));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T signedDistance(OBB<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	auto const  v = b - a.center;
+	Vec<Dim, T> local;
+	for (std::size_t i{}; Dim > i; ++i) {
+		local[i] = dot(a.rotation[i], v);
+	}
+	return detail::boxSignedDistance(local, a.half_length);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T signedDistance(Sphere<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	return norm(b - a.center) - a.radius;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T signedDistance(Capsule<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	return norm(b - detail::closestPointSegment(a.start, a.end, b)) - a.radius;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T signedDistance(Cylinder<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	Vec<Dim, T> axis;
+	Vec<Dim, T> radial;
+	T           half;
+	T           s;
+	detail::cylinderFrame(a, b, axis, half, s, radial);
+	return detail::boxSignedDistance(Vec<2, T>(s, norm(radial)),
+	                                 Vec<2, T>(half, a.radius));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr T signedDistance(Triangle<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	if constexpr (2 == Dim) {
+		if (detail::insideTriangle(a, b)) {
+			return -norm(b - detail::closestPointTriangleBoundary(a, b));
+		}
+	}
+	return norm(b - detail::closestPointTriangle(a, b));
+}
+
+template <class T>
+[[nodiscard]] constexpr T signedDistance(Plane<T> const& a, Vec<3, T> const& b)
+{
+	return dot(a.normal, b) + a.distance;
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                Distance and gradient                                |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Signed distance from `a` to `b` and its gradient with respect to `b`, computed
+ * together.
+ *
+ * Where the gradient is not unique, on the medial axis, one of the candidates is
+ * returned.
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr SignedDistance<Dim, T> signedDistanceAndGradient(
+    AABB<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	return detail::boxSignedDistanceAndGradient(b - (a.min + a.max) / T(2),
+	                                            (a.max - a.min) / T(2));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr SignedDistance<Dim, T> signedDistanceAndGradient(
+    OBB<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	auto const  v = b - a.center;
+	Vec<Dim, T> local;
+	for (std::size_t i{}; Dim > i; ++i) {
+		local[i] = dot(a.rotation[i], v);
+	}
+
+	auto res     = detail::boxSignedDistanceAndGradient(local, a.half_length);
+	local        = res.gradient;
+	res.gradient = a.rotation[0] * local[0];
+	for (std::size_t i = 1; Dim > i; ++i) {
+		res.gradient += a.rotation[i] * local[i];
+	}
+	return res;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr SignedDistance<Dim, T> signedDistanceAndGradient(
+    Sphere<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	return detail::ballSignedDistanceAndGradient(a.center, a.radius, b);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr SignedDistance<Dim, T> signedDistanceAndGradient(
+    Capsule<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	return detail::ballSignedDistanceAndGradient(
+	    detail::closestPointSegment(a.start, a.end, b), a.radius, b);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr SignedDistance<Dim, T> signedDistanceAndGradient(
+    Cylinder<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	Vec<Dim, T> axis;
+	Vec<Dim, T> radial;
+	T           half;
+	T           s;
+	detail::cylinderFrame(a, b, axis, half, s, radial);
+
+	T const    rho = norm(radial);
+	auto const res = detail::boxSignedDistanceAndGradient(Vec<2, T>(s, rho),
+	                                                      Vec<2, T>(half, a.radius));
+
+	// On the axis any radial direction will do
+	radial = T(0) < rho ? radial / rho : detail::orthogonal(axis);
+	return {res.distance, axis * res.gradient[0] + radial * res.gradient[1]};
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr SignedDistance<Dim, T> signedDistanceAndGradient(
+    Triangle<Dim, T> const& a, Vec<Dim, T> const& b)
+{
+	if constexpr (2 == Dim) {
+		if (detail::insideTriangle(a, b)) {
+			// The closest point is on an edge, the gradient points towards it
+			auto const q = detail::closestPointTriangleBoundary(a, b);
+			T const    d = norm(q - b);
+			if (T(0) < d) {
+				return {-d, (q - b) / d};
+			}
+		}
+	}
+
+	auto res = detail::ballSignedDistanceAndGradient(detail::closestPointTriangle(a, b),
+	                                                 T(0), b);
+	if constexpr (3 == Dim) {
+		if (T(0) == res.distance) {
+			auto const n = cross(a[1] - a[0], a[2] - a[0]);
+			if (T(0) < dot(n, n)) {
+				res.gradient = normalize(n);
+			}
+		}
+	}
+	return res;
+}
+
+template <class T>
+[[nodiscard]] constexpr SignedDistance<3, T> signedDistanceAndGradient(
+    Plane<T> const& a, Vec<3, T> const& b)
+{
+	return {signedDistance(a, b), a.normal};
+}
+
+/*!
+ * @brief Gradient of the signed distance from `a` to `b` with respect to `b`.
+ */
+template <class Geometry, std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> signedDistanceGradient(Geometry const&    a,
+                                                           Vec<Dim, T> const& b)
+{
+	return signedDistanceAndGradient(a, b).gradient;
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        Batch                                        |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Computes the signed distance from `a` to each point in [first, last) and
+ * stores the results in the range beginning at `d_first`.
+ *
+ * The kernels are branch free or nearly so, an `unseq` or `par_unseq` policy lets them
+ * be vectorized.
+ *
+ * @return Output iterator to the element past the last result.
+ */
+template <class Geometry, class InputIt, class OutputIt>
+OutputIt signedDistance(Geometry const& a, InputIt first, InputIt last, OutputIt d_first)
+{
+	return std::transform(first, last, d_first,
+	                      [&a](auto const& p) { return signedDistance(a, p); });
+}
+
+/*!
+ * @brief Same as above, but executed according to `policy`.
+ */
+template <
+    class ExecutionPolicy, class Geometry, class ForwardIt1, class ForwardIt2,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+ForwardIt2 signedDistance(ExecutionPolicy&& policy, Geometry const& a, ForwardIt1 first,
+                          ForwardIt1 last, ForwardIt2 d_first)
+{
+	return std::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                      [&a](auto const& p) { return signedDistance(a, p); });
+}
+
+/*!
+ * @brief Computes the signed distance and gradient from `a` to each point in
+ * [first, last) in one pass and stores the results, as `SignedDistance`s, in the range
+ * beginning at `d_first`.
+ *
+ * @return Output iterator to the element past the last result.
+ */
+template <class Geometry, class InputIt, class OutputIt>
+OutputIt signedDistanceAndGradient(Geometry const& a, InputIt first, InputIt last,
+                                   OutputIt d_first)
+{
+	return std::transform(first, last, d_first,
+	                      [&a](auto const& p) { return signedDistanceAndGradient(a, p); });
+}
+
+/*!
+ * @brief Same as above, but executed according to `policy`.
+ */
+template <
+    class ExecutionPolicy, class Geometry, class ForwardIt1, class ForwardIt2,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+ForwardIt2 signedDistanceAndGradient(ExecutionPolicy&& policy, Geometry const& a,
+                                     ForwardIt1 first, ForwardIt1 last,
+                                     ForwardIt2 d_first)
+{
+	return std::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                      [&a](auto const& p) { return signedDistanceAndGradient(a, p); });
+}
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_SIGNED_DISTANCE_HPP
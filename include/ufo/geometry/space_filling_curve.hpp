@@ -0,0 +1,431 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_SPACE_FILLING_CURVE_HPP
+#define UFO_GEOMETRY_SPACE_FILLING_CURVE_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/bounding_volume.hpp>
+#include <ufo/geometry/type_traits.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+namespace detail
+{
+/*!
+ * @brief Number of bits per axis in a curve code of type `Code`, at most 32.
+ */
+template <class Code, std::size_t Dim>
+inline constexpr std::size_t curve_bits_v =
+    std::min<std::size_t>(32, std::numeric_limits<Code>::digits / Dim);
+
+/*!
+ * @brief `p` quantized to `Bits` bits per axis inside `bounds`. Points outside `bounds`
+ * are clamped to it.
+ */
+template <std::size_t Bits, std::size_t Dim, class T>
+[[nodiscard]] constexpr std::array<std::uint32_t, Dim> quantize(
+    Vec<Dim, T> const& p, AABB<Dim, T> const& bounds) noexcept
+{
+	constexpr std::uint64_t max   = (std::uint64_t(1) << Bits) - 1;
+	constexpr T             cells = T(max + 1);
+
+	std::array<std::uint32_t, Dim> q{};
+	for (std::size_t i{}; Dim > i; ++i) {
+		T const extent = bounds.max[i] - bounds.min[i];
+		T const c      = T(0) < extent ? (p[i] - bounds.min[i]) / extent * cells : T(0);
+		// Clamped as an integer, `cells - 1` may round to `cells` in `T`
+		q[i] = static_cast<std::uint32_t>(
+		    std::min(max, static_cast<std::uint64_t>(std::clamp(c, T(0), cells))));
+	}
+	return q;
+}
+
+/*!
+ * @brief Interleaves the low `Bits` bits of `q`, most significant first, with the bit
+ * of the first axis before the others at each level.
+ */
+template <class Code, std::size_t Bits, std::size_t Dim>
+[[nodiscard]] constexpr Code interleave(std::array<std::uint32_t, Dim> const& q) noexcept
+{
+	Code code{};
+	for (std::size_t b = Bits; 0 < b--;) {
+		for (std::size_t i{}; Dim > i; ++i) {
+			code = (code << 1) | ((q[i] >> b) & 1u);
+		}
+	}
+	return code;
+}
+
+/*!
+ * @brief Morton code of `p`, quantized to `curve_bits_v<Code, Dim>` bits per axis inside
+ * `bounds`.
+ */
+template <class Code = std::uint32_t, std::size_t Dim, class T>
+[[nodiscard]] constexpr Code mortonCode(Vec<Dim, T> const&  p,
+                                        AABB<Dim, T> const& bounds) noexcept
+{
+	constexpr std::size_t bits = curve_bits_v<Code, Dim>;
+	return interleave<Code, bits>(quantize<bits>(p, bounds));
+}
+
+/*!
+ * @brief Hilbert code of `p`, quantized to `curve_bits_v<Code, Dim>` bits per axis
+ * inside `bounds`.
+ *
+ * Uses the transpose form of Skilling (Programming the Hilbert curve, 2004): the
+ * coordinates are rotated and reflected in place into the bits of the index, which are
+ * then interleaved as for the Morton code. Consecutive codes are neighboring cells.
+ */
+template <class Code = std::uint32_t, std::size_t Dim, class T>
+[[nodiscard]] constexpr Code hilbertCode(Vec<Dim, T> const&  p,
+                                         AABB<Dim, T> const& bounds) noexcept
+{
+	constexpr std::size_t   bits = curve_bits_v<Code, Dim>;
+	constexpr std::uint32_t m    = std::uint32_t(1) << (bits - 1);
+
+	auto x = quantize<bits>(p, bounds);
+
+	// Inverse undo
+	for (std::uint32_t q = m; 1 < q; q >>= 1) {
+		std::uint32_t const r = q - 1;
+		for (std::size_t i{}; Dim > i; ++i) {
+			if (x[i] & q) {
+				x[0] ^= r;
+			} else {
+				std::uint32_t const t = (x[0] ^ x[i]) & r;
+				x[0] ^= t;
+				x[i] ^= t;
+			}
+		}
+	}
+
+	// Gray encode
+	for (std::size_t i = 1; Dim > i; ++i) {
+		x[i] ^= x[i - 1];
+	}
+	std::uint32_t t{};
+	for (std::uint32_t q = m; 1 < q; q >>= 1) {
+		if (x[Dim - 1] & q) {
+			t ^= q - 1;
+		}
+	}
+	for (std::size_t i{}; Dim > i; ++i) {
+		x[i] ^= t;
+	}
+
+	return interleave<Code, bits>(x);
+}
+
+/*!
+ * @brief Stable LSD radix sort of `keys` by the low `bits` bits of their first element,
+ * a byte at a time.
+ *
+ * The keys are split into contiguous chunks. For each byte the chunks are counted and
+ * scattered according to `policy`, with the offsets of each chunk following the chunks
+ * before it in each bucket, so the result does not depend on the policy. Bytes where
+ * all keys fall in the same bucket are skipped.
+ */
+template <class ExecutionPolicy, class Code, class Index>
+void radixSort(ExecutionPolicy&& policy, std::vector<std::pair<Code, Index>>& keys,
+               std::size_t bits)
+{
+	constexpr std::size_t radix     = 8;
+	constexpr std::size_t buckets   = std::size_t(1) << radix;
+	constexpr std::size_t min_chunk = 4096;
+
+	std::size_t const n      = keys.size();
+	std::size_t       chunks = 1;
+	if constexpr (!std::is_same_v<std::execution::sequenced_policy,
+	                              std::decay_t<ExecutionPolicy>>) {
+		std::size_t const threads = std::max(1u, std::thread::hardware_concurrency());
+		chunks = std::clamp<std::size_t>(n / min_chunk, 1, 4 * threads);
+	}
+	std::size_t const chunk = (n + chunks - 1) / std::max<std::size_t>(1, chunks);
+
+	std::vector<std::size_t> ids(chunks);
+	std::iota(ids.begin(), ids.end(), std::size_t(0));
+
+	std::vector<std::pair<Code, Index>>          tmp(n);
+	std::vector<std::array<std::size_t, buckets>> offset(chunks);
+	for (std::size_t shift{}; bits > shift; shift += radix) {
+		auto const digit = [shift](std::pair<Code, Index> const& k) {
+			return static_cast<std::size_t>(k.first >> shift) & (buckets - 1);
+		};
+
+		std::for_each(policy, ids.begin(), ids.end(), [&](std::size_t c) {
+			offset[c].fill(0);
+			for (std::size_t i = c * chunk, e = std::min(n, i + chunk); e > i; ++i) {
+				++offset[c][digit(keys[i])];
+			}
+		});
+
+		std::size_t total{};
+		bool        skip = false;
+		for (std::size_t b{}; buckets > b; ++b) {
+			std::size_t const begin = total;
+			for (std::size_t c{}; chunks > c; ++c) {
+				std::size_t const count = offset[c][b];
+				offset[c][b]            = total;
+				total += count;
+			}
+			skip = skip || n == total - begin;
+		}
+		if (skip) {
+			continue;
+		}
+
+		std::for_each(policy, ids.begin(), ids.end(), [&](std::size_t c) {
+			for (std::size_t i = c * chunk, e = std::min(n, i + chunk); e > i; ++i) {
+				tmp[offset[c][digit(keys[i])]++] = keys[i];
+			}
+		});
+		keys.swap(tmp);
+	}
+}
+
+/*!
+ * @brief The permutation that sorts [first, last) by `code(center, bounds)`, where
+ * `center` is the center of the bounds of an element and `bounds` the bounds of all the
+ * centers.
+ */
+template <class Code, class ExecutionPolicy, class RandomIt, class Encode>
+[[nodiscard]] std::vector<std::size_t> curveOrder(ExecutionPolicy&& policy,
+                                                  RandomIt first, RandomIt last,
+                                                  Encode code)
+{
+	using Geometry = typename std::iterator_traits<RandomIt>::value_type;
+	using T        = typename geometry_traits<Geometry>::value_type;
+
+	constexpr std::size_t Dim = geometry_traits<Geometry>::dimension;
+
+	auto const               n = static_cast<std::size_t>(std::distance(first, last));
+	std::vector<std::size_t> res(n);
+	if (0 == n) {
+		return res;
+	}
+
+	std::vector<Vec<Dim, T>> centers(n);
+	std::transform(policy, first, last, centers.begin(), [](Geometry const& g) {
+		return AABB<Dim, T>(lower(g), upper(g)).center();
+	});
+	auto const bounds = boundingAABB(policy, centers.begin(), centers.end());
+
+	std::iota(res.begin(), res.end(), std::size_t(0));
+	std::vector<std::pair<Code, std::size_t>> keys(n);
+	std::transform(policy, res.begin(), res.end(), keys.begin(),
+	               [&centers, &bounds, &code](std::size_t i) {
+		               return std::pair(code(centers[i], bounds), i);
+	               });
+
+	radixSort(policy, keys, Dim * curve_bits_v<Code, Dim>);
+
+	std::transform(policy, keys.begin(), keys.end(), res.begin(),
+	               [](auto const& k) { return k.second; });
+	return res;
+}
+
+/*!
+ * @brief Moves the elements of [first, last) so that the element at position `i` is the
+ * one that was at position `order[i]`.
+ */
+template <class ExecutionPolicy, class RandomIt>
+void permute(ExecutionPolicy&& policy, RandomIt first,
+             std::vector<std::size_t> const& order)
+{
+	using V = typename std::iterator_traits<RandomIt>::value_type;
+
+	std::vector<V> tmp(order.size());
+	std::transform(policy, order.begin(), order.end(), tmp.begin(),
+	               [first](std::size_t i) { return std::move(first[i]); });
+	std::move(policy, tmp.begin(), tmp.end(), first);
+}
+}  // namespace detail
+
+/*!
+ * @brief The order of [first, last) along a Morton (Z-order) curve through the centers
+ * of their bounds, computed according to `policy`.
+ *
+ * Elements that are close along the curve are close in space, so processing them in
+ * this order improves the locality of memory accesses and the coherence of branches.
+ * The Hilbert order is more local but slower to compute.
+ *
+ * Works for any geometry with `min` and `max` in `fun.hpp`, as well as for `Vec`. The
+ * codes have 64 bits, 21 per axis in 3D, and are sorted with a stable parallel radix
+ * sort, so elements with the same code keep their relative order.
+ *
+ * @return The permutation `order` such that `first[order[0]], first[order[1]], ...` is
+ * sorted.
+ */
+template <
+    class ExecutionPolicy, class RandomIt,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+[[nodiscard]] std::vector<std::size_t> mortonOrder(ExecutionPolicy&& policy,
+                                                   RandomIt first, RandomIt last)
+{
+	auto const code = [](auto const& p, auto const& b) {
+		return detail::mortonCode<std::uint64_t>(p, b);
+	};
+	return detail::curveOrder<std::uint64_t>(std::forward<ExecutionPolicy>(policy), first,
+	                                         last, code);
+}
+
+template <
+    class RandomIt,
+    std::enable_if_t<!std::is_execution_policy_v<std::decay_t<RandomIt>>, bool> = true>
+[[nodiscard]] std::vector<std::size_t> mortonOrder(RandomIt first, RandomIt last)
+{
+	return mortonOrder(std::execution::seq, first, last);
+}
+
+/*!
+ * @brief Same as `mortonOrder`, but along a Hilbert curve. Unlike the Morton curve, it
+ * never jumps: consecutive cells are neighbors.
+ */
+template <
+    class ExecutionPolicy, class RandomIt,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+[[nodiscard]] std::vector<std::size_t> hilbertOrder(ExecutionPolicy&& policy,
+                                                    RandomIt first, RandomIt last)
+{
+	auto const code = [](auto const& p, auto const& b) {
+		return detail::hilbertCode<std::uint64_t>(p, b);
+	};
+	return detail::curveOrder<std::uint64_t>(std::forward<ExecutionPolicy>(policy), first,
+	                                         last, code);
+}
+
+template <
+    class RandomIt,
+    std::enable_if_t<!std::is_execution_policy_v<std::decay_t<RandomIt>>, bool> = true>
+[[nodiscard]] std::vector<std::size_t> hilbertOrder(RandomIt first, RandomIt last)
+{
+	return hilbertOrder(std::execution::seq, first, last);
+}
+
+/*!
+ * @brief Reorders [first, last) along a Morton curve, see `mortonOrder`.
+ *
+ * @return The permutation that was applied, the element now at position `i` was at
+ * position `order[i]`.
+ */
+template <
+    class ExecutionPolicy, class RandomIt,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+std::vector<std::size_t> sortByMorton(ExecutionPolicy&& policy, RandomIt first,
+                                      RandomIt last)
+{
+	auto order = mortonOrder(policy, first, last);
+	detail::permute(policy, first, order);
+	return order;
+}
+
+template <
+    class RandomIt,
+    std::enable_if_t<!std::is_execution_policy_v<std::decay_t<RandomIt>>, bool> = true>
+std::vector<std::size_t> sortByMorton(RandomIt first, RandomIt last)
+{
+	return sortByMorton(std::execution::seq, first, last);
+}
+
+template <class Range>
+std::vector<std::size_t> sortByMorton(Range& range)
+{
+	using std::begin;
+	using std::end;
+	return sortByMorton(begin(range), end(range));
+}
+
+/*!
+ * @brief Reorders [first, last) along a Hilbert curve, see `hilbertOrder`.
+ *
+ * @return The permutation that was applied, the element now at position `i` was at
+ * position `order[i]`.
+ */
+template <
+    class ExecutionPolicy, class RandomIt,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+std::vector<std::size_t> sortByHilbert(ExecutionPolicy&& policy, RandomIt first,
+                                       RandomIt last)
+{
+	auto order = hilbertOrder(policy, first, last);
+	detail::permute(policy, first, order);
+	return order;
+}
+
+template <
+    class RandomIt,
+    std::enable_if_t<!std::is_execution_policy_v<std::decay_t<RandomIt>>, bool> = true>
+std::vector<std::size_t> sortByHilbert(RandomIt first, RandomIt last)
+{
+	return sortByHilbert(std::execution::seq, first, last);
+}
+
+template <class Range>
+std::vector<std::size_t> sortByHilbert(Range& range)
+{
+	using std::begin;
+	using std::end;
+	return sortByHilbert(begin(range), end(range));
+}
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_SPACE_FILLING_CURVE_HPP
@@ -0,0 +1,253 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_SPHERICAL_SECTOR_HPP
+#define UFO_GEOMETRY_SPHERICAL_SECTOR_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/math/mat.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+namespace ufo
+{
+/*!
+ * @brief The field of view of a range sensor, such as a spinning LiDAR: all points
+ * whose azimuth, elevation, and range from `origin` fall within the given intervals.
+ *
+ * Angles are in radians and measured in the sensor frame, whose axes are the columns of
+ * `rotation` (same as for `OBB`). The azimuth is the angle around the z-axis from the
+ * x-axis towards the y-axis and the elevation is the angle above the xy-plane, so the
+ * sensor looks along x. An azimuth interval spanning at least `FULL_TURN` is a full
+ * revolution, and elevations are clamped to [-pi/2, pi/2].
+ */
+template <class T = float>
+struct SphericalSector {
+	static_assert(std::is_floating_point_v<T>, "T is required to be floating point.");
+
+	using value_type = T;
+
+	static constexpr T FULL_TURN = T(6.283185307179586476925286766559005768);
+
+	Vec<3, T>    origin;
+	Mat<3, 3, T> rotation;
+	T            min_azimuth{};
+	T            max_azimuth{};
+	T            min_elevation{};
+	T            max_elevation{};
+	T            min_range{};
+	T            max_range{};
+
+	constexpr SphericalSector() noexcept = default;
+
+	constexpr SphericalSector(Vec<3, T> const& origin, T min_azimuth, T max_azimuth,
+	                          T min_elevation, T max_elevation, T min_range,
+	                          T max_range) noexcept
+	    : origin(origin)
+	    , min_azimuth(min_azimuth)
+	    , max_azimuth(max_azimuth)
+	    , min_elevation(min_elevation)
+	    , max_elevation(max_elevation)
+	    , min_range(min_range)
+	    , max_range(max_range)
+	{
+	}
+
+	constexpr SphericalSector(Vec<3, T> const& origin, Mat<3, 3, T> const& rotation,
+	                          T min_azimuth, T max_azimuth, T min_elevation,
+	                          T max_elevation, T min_range, T max_range) noexcept
+	    : origin(origin)
+	    , rotation(rotation)
+	    , min_azimuth(min_azimuth)
+	    , max_azimuth(max_azimuth)
+	    , min_elevation(min_elevation)
+	    , max_elevation(max_elevation)
+	    , min_range(min_range)
+	    , max_range(max_range)
+	{
+	}
+
+	constexpr SphericalSector(SphericalSector const&) noexcept = default;
+
+	template <class U>
+	constexpr explicit SphericalSector(SphericalSector<U> const& other) noexcept
+	    : origin(other.origin)
+	    , rotation(other.rotation)
+	    , min_azimuth(static_cast<T>(other.min_azimuth))
+	    , max_azimuth(static_cast<T>(other.max_azimuth))
+	    , min_elevation(static_cast<T>(other.min_elevation))
+	    , max_elevation(static_cast<T>(other.max_elevation))
+	    , min_range(static_cast<T>(other.min_range))
+	    , max_range(static_cast<T>(other.max_range))
+	{
+	}
+
+	/*!
+	 * @brief Whether the azimuth interval covers a full revolution.
+	 */
+	[[nodiscard]] constexpr bool fullAzimuth() const noexcept
+	{
+		return FULL_TURN <= max_azimuth - min_azimuth;
+	}
+
+	/*!
+	 * @brief The point at `azimuth`, `elevation`, and `range` in the world frame.
+	 */
+	[[nodiscard]] Vec<3, T> point(T azimuth, T elevation, T range) const
+	{
+		T const c = std::cos(elevation);
+		return origin + rotation[0] * (range * c * std::cos(azimuth)) +
+		       rotation[1] * (range * c * std::sin(azimuth)) +
+		       rotation[2] * (range * std::sin(elevation));
+	}
+
+	/*!
+	 * @brief Smallest AABB enclosing the sector.
+	 *
+	 * In the sensor frame each coordinate is the range times a function of the azimuth
+	 * times a function of the elevation, so its extremes are at the ends of the intervals
+	 * or where a factor peaks: azimuths at multiples of a quarter turn and zero elevation.
+	 * The box in the sensor frame is then rotated into the world frame like an OBB, which
+	 * is exact when the sensor axes are aligned with the world axes.
+	 */
+	[[nodiscard]] AABB<3, T> bounds() const
+	{
+		T const quarter = FULL_TURN / 4;
+		T const e0      = std::clamp(min_elevation, -quarter, quarter);
+		T const e1      = std::clamp(max_elevation, e0, quarter);
+
+		T           azimuths[6]{min_azimuth, max_azimuth};
+		std::size_t num_azimuths = 2;
+		for (int k{}; 4 > k; ++k) {
+			// The first turn of `k` quarters at or after the start of the interval
+			T const c = k * quarter;
+			T const t = c + FULL_TURN * std::ceil((min_azimuth - c) / FULL_TURN);
+			if (max_azimuth >= t) {
+				azimuths[num_azimuths++] = t;
+			}
+		}
+
+		Vec<3, T> lo(std::numeric_limits<T>::max());
+		Vec<3, T> hi(std::numeric_limits<T>::lowest());
+		for (std::size_t i{}; num_azimuths > i; ++i) {
+			for (T e : {e0, e1, std::clamp(T(0), e0, e1)}) {
+				for (T r : {min_range, max_range}) {
+					Vec<3, T> const p(r * std::cos(e) * std::cos(azimuths[i]),
+					                  r * std::cos(e) * std::sin(azimuths[i]), r * std::sin(e));
+					lo = min(lo, p);
+					hi = max(hi, p);
+				}
+			}
+		}
+
+		auto const c      = (lo + hi) / T(2);
+		auto const hl     = (hi - lo) / T(2);
+		auto const center =
+		    origin + rotation[0] * c.x + rotation[1] * c.y + rotation[2] * c.z;
+		Vec<3, T>  h;
+		for (std::size_t i{}; 3 > i; ++i) {
+			h[i] = std::abs(rotation[0][i]) * hl.x + std::abs(rotation[1][i]) * hl.y +
+			       std::abs(rotation[2][i]) * hl.z;
+		}
+		return AABB<3, T>(center - h, center + h);
+	}
+};
+
+//
+// Deduction guide
+//
+
+template <class T>
+SphericalSector(Vec<3, T>, T, T, T, T, T, T) -> SphericalSector<T>;
+
+template <class T>
+SphericalSector(Vec<3, T>, Mat<3, 3, T>, T, T, T, T, T, T) -> SphericalSector<T>;
+
+/*!
+ * @brief Compare two SphericalSectors.
+ *
+ * @param lhs,rhs The SphericalSectors to compare
+ * @return `true` if they compare equal, `false` otherwise.
+ */
+template <class T>
+bool operator==(SphericalSector<T> const& lhs, SphericalSector<T> const& rhs)
+{
+	return lhs.origin == rhs.origin && lhs.rotation == rhs.rotation &&
+	       lhs.min_azimuth == rhs.min_azimuth && lhs.max_azimuth == rhs.max_azimuth &&
+	       lhs.min_elevation == rhs.min_elevation &&
+	       lhs.max_elevation == rhs.max_elevation && lhs.min_range == rhs.min_range &&
+	       lhs.max_range == rhs.max_range;
+}
+
+/*!
+ * @brief Compare two SphericalSectors.
+ *
+ * @param lhs,rhs The SphericalSectors to compare
+ * @return `true` if they do not compare equal, `false` otherwise.
+ */
+template <class T>
+bool operator!=(SphericalSector<T> const& lhs, SphericalSector<T> const& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& out, SphericalSector<T> const& sector)
+{
+	return out << "Origin: " << sector.origin << ", Azimuth: [" << sector.min_azimuth
+	           << ", " << sector.max_azimuth << "], Elevation: [" << sector.min_elevation
+	           << ", " << sector.max_elevation << "], Range: [" << sector.min_range << ", "
+	           << sector.max_range << "]";
+}
+
+using SphericalSectorf = SphericalSector<float>;
+using SphericalSectord = SphericalSector<double>;
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_SPHERICAL_SECTOR_HPP
@@ -0,0 +1,212 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_SUPPORT_HPP
+#define UFO_GEOMETRY_SUPPORT_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/aabc.hpp>
+#include <ufo/geometry/capsule.hpp>
+#include <ufo/geometry/cone.hpp>
+#include <ufo/geometry/convex_polyhedron.hpp>
+#include <ufo/geometry/cylinder.hpp>
+#include <ufo/geometry/ellipsoid.hpp>
+#include <ufo/geometry/line_segment.hpp>
+#include <ufo/geometry/obb.hpp>
+#include <ufo/geometry/sphere.hpp>
+#include <ufo/geometry/triangle.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <cmath>
+#include <cstddef>
+
+namespace ufo
+{
+/*!
+ * @brief Support functions, the point of a convex geometry furthest in `direction`.
+ *
+ * They are what GJK based queries need from a geometry. If `direction` is zero, any
+ * point of the geometry may be returned.
+ */
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> support(Vec<Dim, T> const& a, Vec<Dim, T> const&)
+{
+	return a;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> support(AABB<Dim, T> const& a,
+                                            Vec<Dim, T> const&  direction)
+{
+	Vec<Dim, T> res;
+	for (std::size_t i{}; Dim > i; ++i) {
+		res[i] = T(0) > direction[i] ? a.min[i] : a.max[i];
+	}
+	return res;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> support(AABC<Dim, T> const& a,
+                                            Vec<Dim, T> const&  direction)
+{
+	Vec<Dim, T> res;
+	for (std::size_t i{}; Dim > i; ++i) {
+		res[i] = T(0) > direction[i] ? a.center[i] - a.half_length
+		                             : a.center[i] + a.half_length;
+	}
+	return res;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> support(Sphere<Dim, T> const& a,
+                                            Vec<Dim, T> const&    direction)
+{
+	T const n = norm(direction);
+	return T(0) < n ? a.center + direction * (a.radius / n) : a.center;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> support(LineSegment<Dim, T> const& a,
+                                            Vec<Dim, T> const&         direction)
+{
+	return dot(a.start, direction) < dot(a.end, direction) ? a.end : a.start;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> support(Capsule<Dim, T> const& a,
+                                            Vec<Dim, T> const&     direction)
+{
+	return support(Sphere<Dim, T>(support(LineSegment<Dim, T>(a.start, a.end), direction),
+	                              a.radius),
+	               direction);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> support(Triangle<Dim, T> const& a,
+                                            Vec<Dim, T> const&      direction)
+{
+	T const d0 = dot(a[0], direction);
+	T const d1 = dot(a[1], direction);
+	T const d2 = dot(a[2], direction);
+	return d0 >= d1 ? (d0 >= d2 ? a[0] : a[2]) : (d1 >= d2 ? a[1] : a[2]);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> support(OBB<Dim, T> const& a,
+                                            Vec<Dim, T> const& direction)
+{
+	Vec<Dim, T> res = a.center;
+	for (std::size_t i{}; Dim > i; ++i) {
+		T const h = a.half_length[i];
+		res += a.rotation[i] * (T(0) > dot(a.rotation[i], direction) ? -h : h);
+	}
+	return res;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> support(Cylinder<Dim, T> const& a,
+                                            Vec<Dim, T> const&      direction)
+{
+	Vec<Dim, T> const axis = a.end - a.start;
+	T const           len2 = dot(axis, axis);
+
+	Vec<Dim, T> res  = T(0) > dot(axis, direction) ? a.start : a.end;
+	Vec<Dim, T> perp = direction;
+	if (T(0) < len2) {
+		perp -= axis * (dot(direction, axis) / len2);
+	}
+	T const n = norm(perp);
+	return T(0) < n ? res + perp * (a.radius / n) : res;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> support(Cone<Dim, T> const& a,
+                                            Vec<Dim, T> const&  direction)
+{
+	Vec<Dim, T> const axis = a.base_center - a.tip;
+	T const           len2 = dot(axis, axis);
+
+	Vec<Dim, T> perp = direction;
+	if (T(0) < len2) {
+		perp -= axis * (dot(direction, axis) / len2);
+	}
+	T const     n   = norm(perp);
+	Vec<Dim, T> rim = T(0) < n ? a.base_center + perp * (a.radius / n) : a.base_center;
+	return dot(a.tip, direction) > dot(rim, direction) ? a.tip : rim;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> support(Ellipsoid<Dim, T> const& a,
+                                            Vec<Dim, T> const&       direction)
+{
+	// x = c + M d / sqrt(d^T M d), with M = R diag(radii^2) R^T
+	auto const& r = a.rotation();
+	Vec<Dim, T> z;
+	T           q{};
+	for (std::size_t i{}; Dim > i; ++i) {
+		T const y   = dot(r[i], direction);
+		T const rr  = a.radii()[i] * a.radii()[i];
+		z[i]        = rr * y;
+		q          += rr * y * y;
+	}
+	if (T(0) >= q) {
+		return a.center();
+	}
+
+	Vec<Dim, T> res = a.center();
+	T const     s   = T(1) / std::sqrt(q);
+	for (std::size_t i{}; Dim > i; ++i) {
+		res += r[i] * (z[i] * s);
+	}
+	return res;
+}
+
+template <class T>
+[[nodiscard]] Vec<3, T> support(ConvexPolyhedron<T> const& a, Vec<3, T> const& direction)
+{
+	return a.support(direction);
+}
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_SUPPORT_HPP
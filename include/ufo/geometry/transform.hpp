@@ -0,0 +1,369 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_TRANSFORM_HPP
+#define UFO_GEOMETRY_TRANSFORM_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/capsule.hpp>
+#include <ufo/geometry/frustum.hpp>
+#include <ufo/geometry/line.hpp>
+#include <ufo/geometry/line_segment.hpp>
+#include <ufo/geometry/obb.hpp>
+#include <ufo/geometry/plane.hpp>
+#include <ufo/geometry/ray.hpp>
+#include <ufo/geometry/sphere.hpp>
+#include <ufo/geometry/triangle.hpp>
+#include <ufo/math/mat.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <cstddef>
+#include <execution>
+#include <type_traits>
+
+namespace ufo
+{
+namespace detail
+{
+/*!
+ * @brief A rigid transform with the rotation stored row by row, so that applying it to
+ * a point is `Dim * Dim` multiply-adds on scalars already in registers.
+ *
+ * Built once per batch and shared by all elements of the batch.
+ */
+template <std::size_t Dim, class T>
+struct Rigid {
+	T           r[Dim][Dim];
+	Vec<Dim, T> t;
+
+	constexpr Rigid(Mat<Dim, Dim, T> const& rotation, Vec<Dim, T> const& translation)
+	    : t(translation)
+	{
+		for (std::size_t i{}; Dim > i; ++i) {
+			for (std::size_t j{}; Dim > j; ++j) {
+				r[i][j] = rotation[j][i];
+			}
+		}
+	}
+
+	[[nodiscard]] constexpr Vec<Dim, T> rotate(Vec<Dim, T> const& v) const
+	{
+		Vec<Dim, T> res;
+		for (std::size_t i{}; Dim > i; ++i) {
+			res[i] = r[i][0] * v[0];
+			for (std::size_t j = 1; Dim > j; ++j) {
+				res[i] += r[i][j] * v[j];
+			}
+		}
+		return res;
+	}
+
+	[[nodiscard]] constexpr Vec<Dim, T> operator()(Vec<Dim, T> const& v) const
+	{
+		return rotate(v) + t;
+	}
+
+	[[nodiscard]] constexpr Mat<Dim, Dim, T> rotate(Mat<Dim, Dim, T> const& m) const
+	{
+		Mat<Dim, Dim, T> res = m;
+		for (std::size_t i{}; Dim > i; ++i) {
+			res[i] = rotate(m[i]);
+		}
+		return res;
+	}
+};
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Vec<Dim, T> transform(Vec<Dim, T> const&   a,
+                                              Rigid<Dim, T> const& tf)
+{
+	return tf(a);
+}
+
+/*!
+ * @brief Transforms an AABB, the result is the smallest AABB enclosing the transformed
+ * box (J. Arvo, "Transforming Axis-Aligned Bounding Boxes", Graphics Gems, 1990).
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr AABB<Dim, T> transform(AABB<Dim, T> const& a,
+                                               Rigid<Dim, T> const&  tf)
+{
+	AABB<Dim, T> res(tf.t, tf.t);
+	for (std::size_t i{}; Dim > i; ++i) {
+		for (std::size_t j{}; Dim > j; ++j) {
+			T e = tf.r[i][j] * a.min[j];
+			T f = tf.r[i][j] * a.max[j];
+			if (e < f) {
+				res.min[i] += e;
+				res.max[i] += f;
+			} else {
+				res.min[i] += f;
+				res.max[i] += e;
+			}
+		}
+	}
+	return res;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Capsule<Dim, T> transform(Capsule<Dim, T> const& a,
+                                                  Rigid<Dim, T> const&   tf)
+{
+	return Capsule<Dim, T>(tf(a.start), tf(a.end), a.radius);
+}
+
+template <class T>
+[[nodiscard]] constexpr Line<2, T> transform(Line<2, T> const& a, Rigid<2, T> const& tf)
+{
+	// Line is `dot(normal, x) = distance`
+	auto normal = tf.rotate(a.normal);
+	return Line<2, T>(normal, a.distance + dot(normal, tf.t));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr LineSegment<Dim, T> transform(LineSegment<Dim, T> const& a,
+                                                      Rigid<Dim, T> const&       tf)
+{
+	return LineSegment<Dim, T>(tf(a.start), tf(a.end));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr OBB<Dim, T> transform(OBB<Dim, T> const&   a,
+                                              Rigid<Dim, T> const& tf)
+{
+	return OBB<Dim, T>(tf(a.center), a.half_length, tf.rotate(a.rotation));
+}
+
+template <class T>
+[[nodiscard]] constexpr Plane<T> transform(Plane<T> const& a, Rigid<3, T> const& tf)
+{
+	// Plane is `dot(normal, x) + distance = 0`
+	auto normal = tf.rotate(a.normal);
+	return Plane<T>(normal, a.distance - dot(normal, tf.t));
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Frustum<Dim, T> transform(Frustum<Dim, T> const& a,
+                                                  Rigid<Dim, T> const&   tf)
+{
+	Frustum<Dim, T> res = a;
+	if constexpr (2 == Dim) {
+		res.left  = transform(a.left, tf);
+		res.right = transform(a.right, tf);
+		res.far   = transform(a.far, tf);
+		res.near  = transform(a.near, tf);
+	} else if constexpr (3 == Dim) {
+		res.top    = transform(a.top, tf);
+		res.bottom = transform(a.bottom, tf);
+		res.left   = transform(a.left, tf);
+		res.right  = transform(a.right, tf);
+		res.far    = transform(a.far, tf);
+		res.near   = transform(a.near, tf);
+	} else {
+		static_assert(2 == Dim || 3 == Dim, "Only 2D and 3D frustums can be transformed.");
+	}
+	return res;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Ray<Dim, T> transform(Ray<Dim, T> const&   a,
+                                              Rigid<Dim, T> const& tf)
+{
+	// Set the members directly, the constructor would normalize the direction again
+	Ray<Dim, T> res;
+	res.origin    = tf(a.origin);
+	res.direction = tf.rotate(a.direction);
+	return res;
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Sphere<Dim, T> transform(Sphere<Dim, T> const& a,
+                                                 Rigid<Dim, T> const&  tf)
+{
+	return Sphere<Dim, T>(tf(a.center), a.radius);
+}
+
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr Triangle<Dim, T> transform(Triangle<Dim, T> const& a,
+                                                   Rigid<Dim, T> const&    tf)
+{
+	return Triangle<Dim, T>(tf(a[0]), tf(a[1]), tf(a[2]));
+}
+}  // namespace detail
+
+/**************************************************************************************
+|                                                                                     |
+|                                      Transform                                      |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Applies the rigid transform `x' = rotation * x + translation` to a geometry.
+ *
+ * Points, segments, capsules, spheres and triangles move their points, rays and OBBs
+ * also rotate their direction/orientation, planes and lines rotate their normal and
+ * update their distance. An AABB cannot be rotated, so the result is the smallest AABB
+ * enclosing the transformed box (see `aabb`).
+ *
+ * @param a The geometry to transform.
+ * @param rotation The rotation, a proper orthonormal matrix.
+ * @param translation The translation, applied after the rotation.
+ * @return The transformed geometry.
+ */
+template <class Geometry, std::size_t Dim, class T>
+[[nodiscard]] constexpr auto transform(Geometry const&         a,
+                                       Mat<Dim, Dim, T> const& rotation,
+                                       Vec<Dim, T> const&      translation)
+    -> decltype(detail::transform(a, std::declval<detail::Rigid<Dim, T>>()))
+{
+	return detail::transform(a, detail::Rigid<Dim, T>(rotation, translation));
+}
+
+/*!
+ * @brief Applies the rigid transform given by the homogeneous matrix `pose` to a
+ * geometry, e.g., a frustum from its camera frame to the world frame.
+ *
+ * The upper left block of `pose` is the rotation and the last column the translation.
+ * Frustums rotate their six planes, nothing is rebuilt from corners.
+ */
+template <class Geometry, class T>
+[[nodiscard]] constexpr auto transform(Geometry const& a, Mat<4, 4, T> const& pose)
+    -> decltype(detail::transform(a, std::declval<detail::Rigid<3, T>>()))
+{
+	Mat<3, 3, T> rotation;
+	for (std::size_t i{}; 3 > i; ++i) {
+		rotation[i] = Vec<3, T>(pose[i][0], pose[i][1], pose[i][2]);
+	}
+	return transform(a, rotation, Vec<3, T>(pose[3][0], pose[3][1], pose[3][2]));
+}
+
+/*!
+ * @brief Applies the rigid transform `x' = rotation * x + translation` to all geometries
+ * in [first, last) and stores the result in the range beginning at `d_first`.
+ *
+ * The rotation is unpacked once for the whole batch and the per element kernels are
+ * plain scalar multiply-adds, which the compiler vectorizes.
+ *
+ * @return Output iterator to the element past the last element transformed.
+ */
+template <
+    class InputIt, class OutputIt, std::size_t Dim, class T,
+    std::enable_if_t<!std::is_execution_policy_v<std::decay_t<InputIt>>, bool> = true>
+OutputIt transform(InputIt first, InputIt last, OutputIt d_first,
+                   Mat<Dim, Dim, T> const& rotation, Vec<Dim, T> const& translation)
+{
+	detail::Rigid<Dim, T> const tf(rotation, translation);
+	for (; first != last; ++first, ++d_first) {
+		*d_first = detail::transform(*first, tf);
+	}
+	return d_first;
+}
+
+/*!
+ * @brief Same as above, but executed according to `policy`.
+ */
+template <
+    class ExecutionPolicy, class ForwardIt1, class ForwardIt2, std::size_t Dim, class T,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+ForwardIt2 transform(ExecutionPolicy&& policy, ForwardIt1 first, ForwardIt1 last,
+                     ForwardIt2 d_first, Mat<Dim, Dim, T> const& rotation,
+                     Vec<Dim, T> const& translation)
+{
+	detail::Rigid<Dim, T> const tf(rotation, translation);
+	return std::transform(std::forward<ExecutionPolicy>(policy), first, last, d_first,
+	                      [&tf](auto const& a) { return detail::transform(a, tf); });
+}
+
+/*!
+ * @brief Applies the rigid transform `x' = rotation * x + translation` in-place to all
+ * geometries in [first, last).
+ */
+template <
+    class ForwardIt, std::size_t Dim, class T,
+    std::enable_if_t<!std::is_execution_policy_v<std::decay_t<ForwardIt>>, bool> = true>
+void transform(ForwardIt first, ForwardIt last, Mat<Dim, Dim, T> const& rotation,
+               Vec<Dim, T> const& translation)
+{
+	transform(first, last, first, rotation, translation);
+}
+
+/*!
+ * @brief Same as above, but executed according to `policy`.
+ */
+template <
+    class ExecutionPolicy, class ForwardIt, std::size_t Dim, class T,
+    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+        true>
+void transform(ExecutionPolicy&& policy, ForwardIt first, ForwardIt last,
+               Mat<Dim, Dim, T> const& rotation, Vec<Dim, T> const& translation)
+{
+	transform(std::forward<ExecutionPolicy>(policy), first, last, first, rotation,
+	          translation);
+}
+
+/**************************************************************************************
+|                                                                                     |
+|                                        AABB                                         |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Computes the smallest AABB enclosing `a` after it has been transformed by
+ * `x' = rotation * x + translation`.
+ *
+ * Uses Arvo's method: each output axis is the translation plus, for every input axis,
+ * the smaller (larger) of the rotation coefficient times the input min and max. No
+ * corners are computed.
+ */
+template <std::size_t Dim, class T>
+[[nodiscard]] constexpr AABB<Dim, T> aabb(Mat<Dim, Dim, T> const& rotation,
+                                          Vec<Dim, T> const&      translation,
+                                          AABB<Dim, T> const&     a)
+{
+	return detail::transform(a, detail::Rigid<Dim, T>(rotation, translation));
+}
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_TRANSFORM_HPP
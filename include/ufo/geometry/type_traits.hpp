@@ -0,0 +1,316 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_TYPE_TRAITS_HPP
+#define UFO_GEOMETRY_TYPE_TRAITS_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/aabc.hpp>
+#include <ufo/geometry/capsule.hpp>
+#include <ufo/geometry/cone.hpp>
+#include <ufo/geometry/convex_polyhedron.hpp>
+#include <ufo/geometry/cylinder.hpp>
+#include <ufo/geometry/ellipsoid.hpp>
+#include <ufo/geometry/frustum.hpp>
+#include <ufo/geometry/line.hpp>
+#include <ufo/geometry/line_segment.hpp>
+#include <ufo/geometry/obb.hpp>
+#include <ufo/geometry/plane.hpp>
+#include <ufo/geometry/polygon.hpp>
+#include <ufo/geometry/ray.hpp>
+#include <ufo/geometry/sphere.hpp>
+#include <ufo/geometry/spherical_sector.hpp>
+#include <ufo/geometry/support.hpp>
+#include <ufo/geometry/triangle.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace ufo
+{
+/**************************************************************************************
+|                                                                                     |
+|                                   Geometry traits                                   |
+|                                                                                     |
+**************************************************************************************/
+
+/*!
+ * @brief Dimension and scalar type of a geometry.
+ *
+ * Defined for `Vec` and every geometry of the form `Geometry<Dim, T>`, as well as for
+ * the geometries that have a fixed dimension.
+ */
+template <class Geometry>
+struct geometry_traits {
+};
+
+template <template <std::size_t, class> class Geometry, std::size_t Dim, class T>
+struct geometry_traits<Geometry<Dim, T>> {
+	static constexpr std::size_t dimension = Dim;
+	using value_type                       = T;
+};
+
+template <class T>
+struct geometry_traits<Plane<T>> {
+	static constexpr std::size_t dimension = 3;
+	using value_type                       = T;
+};
+
+template <class T>
+struct geometry_traits<ConvexPolyhedron<T>> {
+	static constexpr std::size_t dimension = 3;
+	using value_type                       = T;
+};
+
+template <class T>
+struct geometry_traits<Polygon<T>> {
+	static constexpr std::size_t dimension = 2;
+	using value_type                       = T;
+};
+
+template <class T>
+struct geometry_traits<SphericalSector<T>> {
+	static constexpr std::size_t dimension = 3;
+	using value_type                       = T;
+};
+
+/*!
+ * @brief Whether every `Geometry` is a convex set.
+ *
+ * `Polygon` is not, since it can be concave.
+ */
+template <class Geometry>
+struct is_convex : std::false_type {
+};
+
+template <std::size_t Dim, class T>
+struct is_convex<Vec<Dim, T>> : std::true_type {
+};
+
+template <std::size_t Dim, class T>
+struct is_convex<AABB<Dim, T>> : std::true_type {
+};
+
+template <std::size_t Dim, class T>
+struct is_convex<AABC<Dim, T>> : std::true_type {
+};
+
+template <std::size_t Dim, class T>
+struct is_convex<Capsule<Dim, T>> : std::true_type {
+};
+
+template <std::size_t Dim, class T>
+struct is_convex<Cone<Dim, T>> : std::true_type {
+};
+
+template <std::size_t Dim, class T>
+struct is_convex<Cylinder<Dim, T>> : std::true_type {
+};
+
+template <std::size_t Dim, class T>
+struct is_convex<Ellipsoid<Dim, T>> : std::true_type {
+};
+
+template <std::size_t Dim, class T>
+struct is_convex<Frustum<Dim, T>> : std::true_type {
+};
+
+template <std::size_t Dim, class T>
+struct is_convex<Line<Dim, T>> : std::true_type {
+};
+
+template <std::size_t Dim, class T>
+struct is_convex<LineSegment<Dim, T>> : std::true_type {
+};
+
+template <std::size_t Dim, class T>
+struct is_convex<OBB<Dim, T>> : std::true_type {
+};
+
+template <std::size_t Dim, class T>
+struct is_convex<Ray<Dim, T>> : std::true_type {
+};
+
+template <std::size_t Dim, class T>
+struct is_convex<Sphere<Dim, T>> : std::true_type {
+};
+
+template <std::size_t Dim, class T>
+struct is_convex<Triangle<Dim, T>> : std::true_type {
+};
+
+template <class T>
+struct is_convex<ConvexPolyhedron<T>> : std::true_type {
+};
+
+template <class T>
+struct is_convex<Plane<T>> : std::true_type {
+};
+
+template <class Geometry>
+inline constexpr bool is_convex_v = is_convex<Geometry>::value;
+
+/**************************************************************************************
+|                                                                                     |
+|                                   Query detection                                   |
+|                                                                                     |
+**************************************************************************************/
+
+// The queries are found by argument dependent lookup when the trait is first used, so
+// the query headers have to be included before that.
+
+/*!
+ * @brief Whether `support(a, direction)` exists for `Geometry`.
+ */
+template <class Geometry, class = void>
+struct has_support : std::false_type {
+};
+
+template <class Geometry>
+struct has_support<
+    Geometry,
+    std::void_t<decltype(support(
+        std::declval<Geometry const&>(),
+        std::declval<Vec<geometry_traits<Geometry>::dimension,
+                         typename geometry_traits<Geometry>::value_type> const&>()))>>
+    : std::true_type {
+};
+
+template <class Geometry>
+inline constexpr bool has_support_v = has_support<Geometry>::value;
+
+/*!
+ * @brief Whether `intersects(a, b)` exists for `A` and `B`, in that order.
+ */
+template <class A, class B, class = void>
+struct has_intersects : std::false_type {
+};
+
+template <class A, class B>
+struct has_intersects<A, B,
+                      std::void_t<decltype(intersects(std::declval<A const&>(),
+                                                      std::declval<B const&>()))>>
+    : std::true_type {
+};
+
+template <class A, class B>
+inline constexpr bool has_intersects_v = has_intersects<A, B>::value;
+
+/*!
+ * @brief Whether `distance(a, b)` exists for `A` and `B`, in that order.
+ */
+template <class A, class B, class = void>
+struct has_distance : std::false_type {
+};
+
+template <class A, class B>
+struct has_distance<A, B,
+                    std::void_t<decltype(distance(std::declval<A const&>(),
+                                                  std::declval<B const&>()))>>
+    : std::true_type {
+};
+
+template <class A, class B>
+inline constexpr bool has_distance_v = has_distance<A, B>::value;
+
+/**************************************************************************************
+|                                                                                     |
+|                                  Kernel selection                                   |
+|                                                                                     |
+**************************************************************************************/
+
+namespace detail
+{
+template <class A, class B>
+struct is_same_space3
+    : std::bool_constant<3 == geometry_traits<A>::dimension &&
+                         3 == geometry_traits<B>::dimension &&
+                         std::is_same_v<typename geometry_traits<A>::value_type,
+                                        typename geometry_traits<B>::value_type>> {
+};
+}  // namespace detail
+
+/*!
+ * @brief Whether `A` and `B` can be handled by the generic convex (GJK) kernels.
+ */
+template <class A, class B>
+struct is_convex_pair
+    : std::conjunction<is_convex<A>, is_convex<B>, has_support<A>, has_support<B>,
+                       detail::is_same_space3<A, B>> {
+};
+
+template <class A, class B>
+inline constexpr bool is_convex_pair_v = is_convex_pair<A, B>::value;
+
+/*!
+ * @brief How a query between two geometries is computed.
+ */
+enum class QueryKernel {
+	// No way to compute the query
+	NONE,
+	// An overload taking the arguments in the given order
+	DIRECT,
+	// An overload taking the arguments in the reversed order
+	REVERSED,
+	// The generic GJK kernel for convex geometries with support functions
+	CONVEX
+};
+
+template <class A, class B>
+inline constexpr QueryKernel intersects_kernel_v =
+    has_intersects_v<A, B>   ? QueryKernel::DIRECT
+    : has_intersects_v<B, A> ? QueryKernel::REVERSED
+    : is_convex_pair_v<A, B> ? QueryKernel::CONVEX
+                             : QueryKernel::NONE;
+
+template <class A, class B>
+inline constexpr QueryKernel distance_kernel_v =
+    has_distance_v<A, B>     ? QueryKernel::DIRECT
+    : has_distance_v<B, A>   ? QueryKernel::REVERSED
+    : is_convex_pair_v<A, B> ? QueryKernel::CONVEX
+                             : QueryKernel::NONE;
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_TYPE_TRAITS_HPP
@@ -0,0 +1,509 @@
+/*!
+ * UFOMap: An Efficient Probabilistic 3D Mapping Framework That Embraces the Unknown
+ *
+ * @author Daniel Duberg (dduberg@kth.se)
+ * @see https://github.com/UnknownFreeOccupied/ufomap
+ * @version 1.0
+ * @date 2022-05-13
+ *
+ * @copyright Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ *
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2022, Daniel Duberg, KTH Royal Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *     list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *     contributors may be used to endorse or promote products derived from
+ *     this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef UFO_GEOMETRY_WIDE_BVH_HPP
+#define UFO_GEOMETRY_WIDE_BVH_HPP
+
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/bvh.hpp>
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/intersects.hpp>
+#include <ufo/geometry/ray.hpp>
+#include <ufo/geometry/raycast.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ufo
+{
+/*!
+ * @brief A bounding volume hierarchy where each node has up to `Width` children.
+ *
+ * The bounds of the children are stored per axis, structure of arrays, so testing a
+ * query against all children of a node is one loop over contiguous values that the
+ * compiler vectorizes, e.g., eight floats per AVX register. Compared to the binary
+ * `BVH`, there are half or less as many nodes to visit and each cache line holds more
+ * useful bounds.
+ *
+ * The tree is built as a binary `BVH` and then collapsed, by repeatedly replacing the
+ * child with the largest surface area by its two children until a node is full.
+ * Children are visited closest first by `raycast` and `nearest`.
+ */
+template <class Geometry, std::size_t Width = 4>
+class WideBVH
+{
+	static_assert(2 <= Width && 32 >= Width, "Width is required to be in [2, 32].");
+
+ public:
+	using geometry_type = Geometry;
+	using value_type    = typename BVH<Geometry>::value_type;
+	using size_type     = std::size_t;
+
+	static constexpr std::size_t dimension = BVH<Geometry>::dimension;
+	static constexpr std::size_t width     = Width;
+
+	using bounds_type = AABB<dimension, value_type>;
+
+	/*!
+	 * @brief The maximum depth of the tree, which bounds the traversal stack.
+	 */
+	static constexpr std::size_t MAX_DEPTH = BVH<Geometry>::MAX_DEPTH;
+
+	struct alignas(64) Node {
+		// Bounds of the children, one array per axis
+		std::array<std::array<value_type, Width>, dimension> min;
+		std::array<std::array<value_type, Width>, dimension> max;
+		// Leaf child: first geometry. Internal child: index of the node.
+		std::array<std::uint32_t, Width> offset;
+		// Leaf child: number of geometries. Zero for internal children.
+		std::array<std::uint32_t, Width> count;
+		// Number of children, the slots after them are unused
+		std::uint32_t size;
+
+		[[nodiscard]] bounds_type bounds(std::size_t child) const
+		{
+			bounds_type res;
+			for (std::size_t i{}; dimension > i; ++i) {
+				res.min[i] = min[i][child];
+				res.max[i] = max[i][child];
+			}
+			return res;
+		}
+	};
+
+	WideBVH() = default;
+
+	/*!
+	 * @brief Collapses the binary `bvh`, keeping its geometries and their order.
+	 */
+	explicit WideBVH(BVH<Geometry> const& bvh)
+	    : geometry_(bvh.geometry()), index_(bvh.index()), bounds_(bvh.bounds())
+	{
+		collapse(bvh.nodes());
+	}
+
+	template <class InputIt>
+	WideBVH(InputIt first, InputIt last, BVHBuild method = BVHBuild::SAH,
+	        size_type leaf_size = 4)
+	    : WideBVH(BVH<Geometry>(first, last, method, leaf_size))
+	{
+	}
+
+	/*!
+	 * @brief Builds the tree over [first, last) according to `policy`, see `BVH`.
+	 */
+	template <
+	    class ExecutionPolicy, class RandomIt,
+	    std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecutionPolicy>>, bool> =
+	        true>
+	WideBVH(ExecutionPolicy&& policy, RandomIt first, RandomIt last,
+	        BVHBuild method = BVHBuild::SAH, size_type leaf_size = 4)
+	    : WideBVH(BVH<Geometry>(std::forward<ExecutionPolicy>(policy), first, last, method,
+	                            leaf_size))
+	{
+	}
+
+	[[nodiscard]] size_type size() const noexcept { return geometry_.size(); }
+
+	[[nodiscard]] bool empty() const noexcept { return geometry_.empty(); }
+
+	[[nodiscard]] bounds_type bounds() const { return bounds_; }
+
+	[[nodiscard]] std::vector<Node> const& nodes() const noexcept { return nodes_; }
+
+	/*!
+	 * @brief The geometries in tree order.
+	 */
+	[[nodiscard]] std::vector<Geometry> const& geometry() const noexcept
+	{
+		return geometry_;
+	}
+
+	/*!
+	 * @brief The input position of each geometry in tree order.
+	 */
+	[[nodiscard]] std::vector<size_type> const& index() const noexcept { return index_; }
+
+	/*!
+	 * @brief Writes the input position of every geometry intersecting `query` to
+	 * `d_first`.
+	 *
+	 * AABB queries test all children of a node at once, other queries test one child at a
+	 * time.
+	 *
+	 * @return Output iterator to the element past the last element written.
+	 */
+	template <class Query, class OutputIt>
+	OutputIt intersects(Query const& query, OutputIt d_first) const
+	{
+		if (empty()) {
+			return d_first;
+		}
+
+		std::array<std::uint32_t, (Width - 1) * MAX_DEPTH + 1> stack;
+		std::size_t                                           top{};
+		stack[top++] = 0;
+		while (top) {
+			Node const& node = nodes_[stack[--top]];
+
+			std::array<bool, Width> hit;
+			if constexpr (std::is_same_v<bounds_type, Query>) {
+				hit = overlaps(node, query);
+			} else {
+				for (std::size_t c{}; Width > c; ++c) {
+					hit[c] = node.size > c && detail::intersectsKernel(node.bounds(c), query);
+				}
+			}
+
+			for (std::size_t c{}; node.size > c; ++c) {
+				if (!hit[c]) {
+					continue;
+				}
+				if (0 == node.count[c]) {
+					stack[top++] = node.offset[c];
+					continue;
+				}
+				for (std::uint32_t j = node.offset[c]; node.offset[c] + node.count[c] > j; ++j) {
+					if (detail::intersectsKernel(geometry_[j], query)) {
+						*d_first++ = index_[j];
+					}
+				}
+			}
+		}
+		return d_first;
+	}
+
+	/*!
+	 * @brief The first geometry hit by `ray`, considering only distances smaller than
+	 * `max`.
+	 *
+	 * All children of a node are slab tested at once and the ones hit are visited in the
+	 * order the ray enters them, so most of the tree behind the first hit is skipped.
+	 *
+	 * @return The input position of the geometry and the distance along the ray to it,
+	 * or `size()` and `max` if nothing is hit before `max`.
+	 */
+	[[nodiscard]] std::pair<size_type, value_type> raycast(
+	    Ray<dimension, value_type> const& ray,
+	    value_type max = std::numeric_limits<value_type>::infinity()) const
+	{
+		Vec<dimension, value_type> inv;
+		for (std::size_t i{}; dimension > i; ++i) {
+			inv[i] = value_type(1) / ray.direction[i];
+		}
+
+		return traverseNearest(
+		    [&ray, &inv](Node const& node, std::array<value_type, Width>& t) {
+			    slabs(node, ray.origin, inv, t);
+		    },
+		    [&ray](Geometry const& g) {
+			    return static_cast<value_type>(ufo::raycast(g, ray));
+		    },
+		    max);
+	}
+
+	/*!
+	 * @brief The geometry closest to `query`, considering only distances smaller than
+	 * `max`.
+	 *
+	 * Points compute the distances to all children of a node at once, other queries one
+	 * child at a time. The children are visited closest first.
+	 *
+	 * @return The input position of the closest geometry and the distance to it, or
+	 * `size()` and `max` if no geometry is closer than `max`.
+	 */
+	template <class Query>
+	[[nodiscard]] std::pair<size_type, value_type> nearest(
+	    Query const& query,
+	    value_type   max = std::numeric_limits<value_type>::infinity()) const
+	{
+		return traverseNearest(
+		    [&query](Node const& node, std::array<value_type, Width>& d) {
+			    if constexpr (std::is_same_v<Vec<dimension, value_type>, Query>) {
+				    distances(node, query, d);
+			    } else {
+				    for (std::size_t c{}; Width > c; ++c) {
+					    d[c] = node.size > c ? static_cast<value_type>(
+					                               detail::distanceKernel(node.bounds(c), query))
+					                         : std::numeric_limits<value_type>::infinity();
+				    }
+			    }
+		    },
+		    [&query](Geometry const& g) {
+			    return static_cast<value_type>(detail::distanceKernel(g, query));
+		    },
+		    max);
+	}
+
+ private:
+	/*!
+	 * @brief Which children of `node` overlap `a`.
+	 */
+	[[nodiscard]] static std::array<bool, Width> overlaps(Node const&        node,
+	                                                      bounds_type const& a)
+	{
+		std::array<bool, Width> res;
+		for (std::size_t c{}; Width > c; ++c) {
+			res[c] = node.size > c;
+		}
+		for (std::size_t i{}; dimension > i; ++i) {
+			for (std::size_t c{}; Width > c; ++c) {
+				res[c] = res[c] & (node.min[i][c] <= a.max[i]) & (a.min[i] <= node.max[i][c]);
+			}
+		}
+		return res;
+	}
+
+	/*!
+	 * @brief Distance along the ray from `origin`, with inverse direction `inv`, to where
+	 * it enters each child of `node`, infinity if it misses.
+	 *
+	 * A zero direction gives infinite slab distances, and zero times infinity when the
+	 * origin is on the boundary of a slab. The entry and exit are picked by the sign of
+	 * `inv` and a NaN never tightens them, so a ray in the plane of a face is inside that
+	 * slab.
+	 */
+	static void slabs(Node const& node, Vec<dimension, value_type> const& origin,
+	                  Vec<dimension, value_type> const& inv,
+	                  std::array<value_type, Width>&    t)
+	{
+		constexpr value_type inf = std::numeric_limits<value_type>::infinity();
+
+		std::array<value_type, Width> lo;
+		std::array<value_type, Width> hi;
+		lo.fill(value_type(0));
+		hi.fill(inf);
+		for (std::size_t i{}; dimension > i; ++i) {
+			auto const& near = std::signbit(inv[i]) ? node.max[i] : node.min[i];
+			auto const& far  = std::signbit(inv[i]) ? node.min[i] : node.max[i];
+			for (std::size_t c{}; Width > c; ++c) {
+				value_type const l = (near[c] - origin[i]) * inv[i];
+				value_type const h = (far[c] - origin[i]) * inv[i];
+				lo[c]              = l > lo[c] ? l : lo[c];
+				hi[c]              = h < hi[c] ? h : hi[c];
+			}
+		}
+		for (std::size_t c{}; Width > c; ++c) {
+			t[c] = node.size > c && lo[c] <= hi[c] ? lo[c] : inf;
+		}
+	}
+
+	/*!
+	 * @brief Distance from `p` to each child of `node`.
+	 */
+	static void distances(Node const& node, Vec<dimension, value_type> const& p,
+	                      std::array<value_type, Width>& d)
+	{
+		d.fill(value_type(0));
+		for (std::size_t i{}; dimension > i; ++i) {
+			for (std::size_t c{}; Width > c; ++c) {
+				value_type const e = std::max({node.min[i][c] - p[i], value_type(0),
+				                               p[i] - node.max[i][c]});
+				d[c] += e * e;
+			}
+		}
+		for (std::size_t c{}; Width > c; ++c) {
+			d[c] = node.size > c ? std::sqrt(d[c])
+			                     : std::numeric_limits<value_type>::infinity();
+		}
+	}
+
+	/*!
+	 * @brief Finds the geometry minimizing `distance(geometry)`, where `bound(node, d)`
+	 * writes a lower bound of the distance for each child of `node` to `d`.
+	 *
+	 * The children are visited closest first, and the ones whose bound is not smaller
+	 * than the best distance found so far are pruned.
+	 */
+	template <class Bound, class Distance>
+	[[nodiscard]] std::pair<size_type, value_type> traverseNearest(Bound    bound,
+	                                                               Distance distance,
+	                                                               value_type max) const
+	{
+		std::pair<size_type, value_type> res(size(), max);
+		if (empty()) {
+			return res;
+		}
+
+		std::array<std::pair<std::uint32_t, value_type>, (Width - 1) * MAX_DEPTH + 1> stack;
+		std::size_t top{};
+		stack[top++] = {0, value_type(0)};
+		while (top) {
+			auto const [i, lower] = stack[--top];
+			if (!(lower < res.second)) {
+				continue;
+			}
+
+			Node const&                   node = nodes_[i];
+			std::array<value_type, Width> d;
+			bound(node, d);
+
+			// Children by decreasing bound, so the closest is pushed last and visited first
+			std::array<std::uint32_t, Width> order;
+			std::uint32_t                    n{};
+			for (std::uint32_t c{}; node.size > c; ++c) {
+				if (!(d[c] < res.second)) {
+					continue;
+				}
+				std::uint32_t j = n++;
+				for (; 0 < j && d[order[j - 1]] < d[c]; --j) {
+					order[j] = order[j - 1];
+				}
+				order[j] = c;
+			}
+
+			for (std::uint32_t k{}; n > k; ++k) {
+				std::uint32_t const c = order[k];
+				if (0 != node.count[c]) {
+					continue;
+				}
+				stack[top++] = {node.offset[c], d[c]};
+			}
+
+			// Leaves are checked right away, which tightens the bound for the rest
+			for (std::uint32_t k = n; 0 < k--;) {
+				std::uint32_t const c = order[k];
+				if (0 == node.count[c] || !(d[c] < res.second)) {
+					continue;
+				}
+				for (std::uint32_t j = node.offset[c]; node.offset[c] + node.count[c] > j; ++j) {
+					value_type const e = distance(geometry_[j]);
+					if (e < res.second) {
+						res = {index_[j], e};
+					}
+				}
+			}
+		}
+		return res;
+	}
+
+	/*!
+	 * @brief Builds the wide nodes from the nodes of a binary `BVH`, depth-first.
+	 */
+	void collapse(std::vector<typename BVH<Geometry>::Node> const& binary)
+	{
+		nodes_.clear();
+		if (binary.empty()) {
+			return;
+		}
+
+		// Pairs of a binary node and the wide node it becomes
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> todo{{0, 0}};
+		nodes_.emplace_back();
+		while (!todo.empty()) {
+			auto const [b, w] = todo.back();
+			todo.pop_back();
+
+			std::array<std::uint32_t, Width> children{b};
+			std::uint32_t                    n = 1;
+			if (!binary[b].leaf()) {
+				children = {b + 1, binary[b].offset};
+				n        = 2;
+			}
+			while (Width > n) {
+				// Open the internal child with the largest surface area
+				std::uint32_t best = n;
+				for (std::uint32_t c{}; n > c; ++c) {
+					if (!binary[children[c]].leaf() &&
+					    (n == best || detail::halfArea(binary[children[best]].bounds) <
+					                      detail::halfArea(binary[children[c]].bounds))) {
+						best = c;
+					}
+				}
+				if (n == best) {
+					break;
+				}
+				std::uint32_t const c = children[best];
+				children[best]        = c + 1;
+				children[n++]         = binary[c].offset;
+			}
+
+			Node node{};
+			node.size = n;
+			for (std::size_t i{}; dimension > i; ++i) {
+				node.min[i].fill(std::numeric_limits<value_type>::max());
+				node.max[i].fill(std::numeric_limits<value_type>::lowest());
+			}
+			for (std::uint32_t c{}; n > c; ++c) {
+				auto const& child = binary[children[c]];
+				for (std::size_t i{}; dimension > i; ++i) {
+					node.min[i][c] = child.bounds.min[i];
+					node.max[i][c] = child.bounds.max[i];
+				}
+				if (child.leaf()) {
+					node.offset[c] = child.offset;
+					node.count[c]  = child.count;
+				} else {
+					node.offset[c] = static_cast<std::uint32_t>(nodes_.size());
+					todo.emplace_back(children[c], node.offset[c]);
+					nodes_.emplace_back();
+				}
+			}
+			nodes_[w] = node;
+		}
+	}
+
+	std::vector<Node>      nodes_;
+	std::vector<Geometry>  geometry_;
+	std::vector<size_type> index_;
+	bounds_type            bounds_;
+};
+
+template <class Geometry>
+using BVH4 = WideBVH<Geometry, 4>;
+
+template <class Geometry>
+using BVH8 = WideBVH<Geometry, 8>;
+}  // namespace ufo
+
+#endif  // UFO_GEOMETRY_WIDE_BVH_HPP
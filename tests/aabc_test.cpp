@@ -0,0 +1,136 @@
+// UFO
+#include <ufo/geometry/aabc.hpp>
+#include <ufo/geometry/contains.hpp>
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/fun.hpp>
+#include <ufo/geometry/intersects.hpp>
+#include <ufo/geometry/mapped.hpp>
+#include <ufo/geometry/polygon.hpp>
+#include <ufo/geometry/support.hpp>
+#include <ufo/geometry/type_traits.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("[AABC] Shape")
+{
+	STATIC_REQUIRE(sizeof(ufo::AABC3f) < sizeof(ufo::AABB3f));
+	STATIC_REQUIRE(3 == ufo::geometry_traits<ufo::AABC3d>::dimension);
+	STATIC_REQUIRE(ufo::is_convex_v<ufo::AABC3d>);
+	STATIC_REQUIRE(ufo::has_support_v<ufo::AABC3d>);
+	STATIC_REQUIRE(ufo::has_intersects_v<ufo::AABC3d, ufo::Sphere3d>);
+	STATIC_REQUIRE(ufo::has_distance_v<ufo::Vec3d, ufo::AABC3d>);
+	STATIC_REQUIRE(ufo::MappedType::AABC == ufo::mapped_type_v<ufo::AABC2f>);
+
+	ufo::AABC c(ufo::Vec3d(1, 2, 3), 0.5);
+	REQUIRE(ufo::Vec3d(0.5, 1.5, 2.5) == ufo::min(c));
+	REQUIRE(ufo::Vec3d(1.5, 2.5, 3.5) == ufo::max(c));
+	REQUIRE(1.0 == c.length());
+
+	ufo::AABB3d b(c);
+	REQUIRE(ufo::min(c) == b.min);
+	REQUIRE(ufo::max(c) == b.max);
+	REQUIRE(ufo::corners(b) == ufo::corners(c));
+	REQUIRE(ufo::Vec3d(1.5, 1.5, 3.5) == ufo::support(c, ufo::Vec3d(1, -1, 0)));
+	REQUIRE(c == ufo::AABC3d(ufo::AABC3f(c)));
+	REQUIRE(c != ufo::AABC3d(c.center, 1.0));
+}
+
+TEST_CASE("[AABC] Against the equivalent AABB")
+{
+	std::mt19937                           gen(17);
+	std::uniform_real_distribution<double> pos(-3, 3);
+	std::uniform_real_distribution<double> size(0.05, 1.5);
+	std::normal_distribution<double>       dir;
+
+	ufo::Frustum3d frustum(ufo::Vec3d(0, 0, 0), ufo::Vec3d(1, 0.5, -1), ufo::Vec3d(0, 1, 0),
+	                       ufo::radians(60.0), ufo::radians(80.0), 0.5, 3.0);
+
+	for (int i{}; 2000 > i; ++i) {
+		ufo::AABC3d c(ufo::Vec3d(pos(gen), pos(gen), pos(gen)), size(gen));
+		ufo::AABB3d a(c);
+
+		ufo::Vec3d         p(pos(gen), pos(gen), pos(gen));
+		ufo::AABC3d        oc(ufo::Vec3d(pos(gen), pos(gen), pos(gen)), size(gen));
+		ufo::AABB3d        ob(oc);
+		ufo::Vec3d         lo(pos(gen), pos(gen), pos(gen));
+		ufo::AABB3d        box(lo, lo + ufo::Vec3d(size(gen), size(gen), size(gen)));
+		ufo::Sphere3d      sphere(p, size(gen));
+		ufo::Ray3d         ray(p, ufo::normalize(ufo::Vec3d(dir(gen), dir(gen), dir(gen))));
+		ufo::LineSegment3d segment(p, ufo::Vec3d(pos(gen), pos(gen), pos(gen)));
+
+		REQUIRE(ufo::intersects(a, p) == ufo::intersects(c, p));
+		REQUIRE(ufo::intersects(a, ob) == ufo::intersects(c, oc));
+		REQUIRE(ufo::intersects(a, box) == ufo::intersects(c, box));
+		REQUIRE(ufo::intersects(box, a) == ufo::intersects(box, c));
+		REQUIRE(ufo::intersects(a, sphere) == ufo::intersects(sphere, c));
+		REQUIRE(ufo::intersects(a, ray) == ufo::intersects(ray, c));
+		REQUIRE(ufo::intersects(a, segment) == ufo::intersects(c, segment));
+		REQUIRE(ufo::intersects(a, frustum) == ufo::intersects(frustum, c));
+
+		REQUIRE(ufo::contains(a, p) == ufo::contains(c, p));
+		REQUIRE(ufo::contains(a, ob) == ufo::contains(c, oc));
+		REQUIRE(ufo::contains(a, box) == ufo::contains(c, box));
+		REQUIRE(ufo::contains(box, a) == ufo::contains(box, c));
+		REQUIRE(ufo::contains(a, sphere) == ufo::contains(c, sphere));
+		REQUIRE(ufo::contains(sphere, a) == ufo::contains(sphere, c));
+		REQUIRE(ufo::contains(a, segment) == ufo::contains(c, segment));
+
+		REQUIRE(ufo::distance(a, p) == Catch::Approx(ufo::distance(p, c)).margin(1e-12));
+		REQUIRE(ufo::distance(a, ob) == Catch::Approx(ufo::distance(c, oc)).margin(1e-12));
+		REQUIRE(ufo::distance(a, box) == Catch::Approx(ufo::distance(box, c)).margin(1e-12));
+		REQUIRE(ufo::distance(a, sphere) ==
+		        Catch::Approx(ufo::distance(sphere, c)).margin(1e-12));
+		REQUIRE(ufo::distanceSquared(a, p) ==
+		        Catch::Approx(ufo::distanceSquared(c, p)).margin(1e-12));
+
+		// Straddles the plane exactly when the corners are on both sides
+		ufo::Vec3d const   n = ufo::normalize(ufo::Vec3d(dir(gen), dir(gen), dir(gen)));
+		ufo::Plane<double> plane(n, -ufo::dot(n, p));
+		double             lowest  = std::numeric_limits<double>::max();
+		double             highest = std::numeric_limits<double>::lowest();
+		for (auto const& corner : ufo::corners(c)) {
+			double const d = ufo::dot(plane.normal, corner) + plane.distance;
+			lowest         = std::min(lowest, d);
+			highest        = std::max(highest, d);
+		}
+		REQUIRE((0.0 >= lowest && 0.0 <= highest) == ufo::intersects(plane, c));
+	}
+}
+
+TEST_CASE("[AABC] 2D frustum")
+{
+	std::mt19937                           gen(23);
+	std::uniform_real_distribution<double> pos(-4, 4);
+	std::uniform_real_distribution<double> size(0.05, 1.5);
+
+	int hits{};
+	for (int i{}; 200 > i; ++i) {
+		ufo::Vec2d const eye(pos(gen), pos(gen));
+		ufo::Vec2d const target(pos(gen), pos(gen));
+		ufo::Frustum2d   frustum(eye, target, ufo::radians(70.0), 0.5, 3.0);
+
+		// The same quadrilateral as a polygon, for reference
+		auto const           corners = ufo::corners(frustum);
+		ufo::Polygon<double> polygon(corners.begin(), corners.end());
+
+		for (int j{}; 50 > j; ++j) {
+			ufo::AABC2d c(ufo::Vec2d(pos(gen), pos(gen)), size(gen));
+			ufo::AABB2d a(c);
+
+			bool const expected = ufo::intersects(polygon, a);
+			REQUIRE(expected == ufo::intersects(a, frustum));
+			REQUIRE(expected == ufo::intersects(frustum, c));
+			hits += expected;
+		}
+	}
+	REQUIRE(1000 < hits);
+	REQUIRE(9000 > hits);
+}
@@ -0,0 +1,96 @@
+// UFO
+#include <ufo/geometry/bounding_volume.hpp>
+#include <ufo/geometry/fun.hpp>
+
+// STL
+#include <cmath>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// Test
+#include "test_helpers.hpp"
+
+TEST_CASE("[BoundingVolume] AABB")
+{
+	auto points = ufo::test::randomPoints(100000, -5.0f, 5.0f, 42);
+	points[123]  = ufo::Vec3f(-7, 0, 0);
+	points[4567] = ufo::Vec3f(0, 8, 0);
+
+	auto a = ufo::boundingAABB(points.begin(), points.end());
+	REQUIRE(-7.0f == a.min.x);
+	REQUIRE(8.0f == a.max.y);
+
+	auto b = ufo::boundingAABB(std::execution::par, points.begin(), points.end());
+	REQUIRE(a == b);
+
+	std::vector<ufo::Sphere3f> spheres{ufo::Sphere3f(ufo::Vec3f(0, 0, 0), 1),
+	                                   ufo::Sphere3f(ufo::Vec3f(4, 0, 0), 2)};
+	auto c = ufo::boundingAABB(spheres.begin(), spheres.end());
+	REQUIRE(ufo::Vec3f(-1, -2, -2) == c.min);
+	REQUIRE(ufo::Vec3f(6, 2, 2) == c.max);
+}
+
+TEST_CASE("[BoundingVolume] Sphere")
+{
+	// Points on the unit sphere and its interior, the minimal sphere is the unit sphere
+	std::vector<ufo::Vec3f> points{
+	    ufo::Vec3f(1, 0, 0),  ufo::Vec3f(-1, 0, 0),       ufo::Vec3f(0, 1, 0),
+	    ufo::Vec3f(0, -1, 0), ufo::Vec3f(0, 0, 1),        ufo::Vec3f(0, 0, -1),
+	    ufo::Vec3f(0, 0, 0),  ufo::Vec3f(0.2f, 0.3f, 0.1f)};
+	auto s = ufo::boundingSphere(points.begin(), points.end());
+	REQUIRE(1.0f == Catch::Approx(s.radius).margin(1e-5));
+	REQUIRE(0.0f == Catch::Approx(ufo::norm(s.center)).margin(1e-5));
+
+	// Two points, the minimal sphere has them as diameter
+	std::vector<ufo::Vec2d> pair{ufo::Vec2d(0, 0), ufo::Vec2d(4, 0), ufo::Vec2d(2, 1)};
+	auto                    c = ufo::boundingSphere(pair.begin(), pair.end());
+	REQUIRE(2.0 == Catch::Approx(c.radius));
+
+	auto random = ufo::test::randomPoints(5000, -5.0f, 5.0f, 42);
+	auto r      = ufo::boundingSphere(random.begin(), random.end());
+	for (auto const& p : random) {
+		REQUIRE(ufo::distance(r.center, p) <= r.radius * 1.0001f);
+	}
+	// The minimal sphere is never larger than the one of the AABB
+	auto a = ufo::boundingAABB(random.begin(), random.end());
+	REQUIRE(r.radius <= ufo::norm(a.max - a.min) * 0.5f);
+}
+
+TEST_CASE("[BoundingVolume] OBB")
+{
+	// A thin box rotated 30 degrees around z
+	float const           angle = 0.5235988f;
+	ufo::Mat<3, 3, float> rot;
+	rot[0] = ufo::Vec3f(std::cos(angle), std::sin(angle), 0);
+	rot[1] = ufo::Vec3f(-std::sin(angle), std::cos(angle), 0);
+	rot[2] = ufo::Vec3f(0, 0, 1);
+
+	std::vector<ufo::Vec3f> points;
+	for (int x = -10; 10 >= x; ++x) {
+		for (int y = -2; 2 >= y; ++y) {
+			for (int z = -1; 1 >= z; ++z) {
+				points.push_back(rot * ufo::Vec3f(x * 0.5f, y * 0.25f, z * 0.1f) +
+				                 ufo::Vec3f(1, 2, 3));
+			}
+		}
+	}
+
+	auto o = ufo::boundingOBB(points.begin(), points.end());
+	REQUIRE(5.0f == Catch::Approx(o.half_length.x).margin(1e-4));
+	REQUIRE(0.5f == Catch::Approx(o.half_length.y).margin(1e-4));
+	REQUIRE(0.1f == Catch::Approx(o.half_length.z).margin(1e-4));
+	REQUIRE(0.0f ==
+	        Catch::Approx(ufo::distance(o.center, ufo::Vec3f(1, 2, 3))).margin(1e-4));
+
+	// All points are inside
+	auto inv = ufo::transpose(o.rotation);
+	for (auto const& p : points) {
+		auto l = inv * (p - o.center);
+		REQUIRE(std::abs(l.x) <= o.half_length.x + 1e-4f);
+		REQUIRE(std::abs(l.y) <= o.half_length.y + 1e-4f);
+		REQUIRE(std::abs(l.z) <= o.half_length.z + 1e-4f);
+	}
+}
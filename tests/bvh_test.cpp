@@ -0,0 +1,371 @@
+// UFO
+#include <ufo/geometry/bvh.hpp>
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/intersects.hpp>
+
+// STL
+#include <algorithm>
+#include <execution>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+// The tree is valid and intersection queries agree with brute force
+void checkTree(ufo::BVH<ufo::AABB3d> const& bvh, std::vector<ufo::AABB3d> const& boxes,
+               std::vector<ufo::AABB3d> const& queries, std::size_t leaf_size)
+{
+	REQUIRE(boxes.size() == bvh.size());
+
+	std::vector<char>        seen(bvh.size());
+	std::vector<std::size_t> depth(bvh.nodes().size(), 1);
+	for (std::size_t i{}; bvh.nodes().size() > i; ++i) {
+		auto const& node = bvh.nodes()[i];
+		REQUIRE(ufo::BVH<ufo::AABB3d>::MAX_DEPTH >= depth[i]);
+		ufo::AABB3d expected = bvh.geometry()[node.leaf() ? node.offset : 0];
+		if (node.leaf()) {
+			REQUIRE(leaf_size >= node.count);
+			for (std::uint32_t j = node.offset; node.offset + node.count > j; ++j) {
+				REQUIRE_FALSE(seen[j]);
+				seen[j]  = 1;
+				expected = ufo::AABB3d(ufo::min(expected.min, bvh.geometry()[j].min),
+				                       ufo::max(expected.max, bvh.geometry()[j].max));
+				REQUIRE(boxes[bvh.index()[j]] == bvh.geometry()[j]);
+			}
+		} else {
+			auto const& a = bvh.nodes()[i + 1];
+			auto const& b = bvh.nodes()[node.offset];
+			REQUIRE(i < node.offset);
+			expected = ufo::AABB3d(ufo::min(a.bounds.min, b.bounds.min),
+			                       ufo::max(a.bounds.max, b.bounds.max));
+			depth[i + 1]       = depth[i] + 1;
+			depth[node.offset] = depth[i] + 1;
+		}
+		REQUIRE(expected == node.bounds);
+	}
+	REQUIRE(std::all_of(seen.begin(), seen.end(), [](char c) { return c; }));
+
+	for (auto const& q : queries) {
+		std::vector<std::size_t> hits;
+		bvh.intersects(q, std::back_inserter(hits));
+		std::sort(hits.begin(), hits.end());
+
+		std::vector<std::size_t> expected;
+		for (std::size_t j{}; boxes.size() > j; ++j) {
+			if (ufo::intersects(boxes[j], q)) {
+				expected.push_back(j);
+			}
+		}
+		REQUIRE(expected == hits);
+	}
+}
+}  // namespace
+
+TEST_CASE("[BVH] Queries")
+{
+	std::mt19937                           gen(11);
+	std::uniform_real_distribution<double> pos(-10, 10);
+	std::uniform_real_distribution<double> size(0.05, 1.0);
+
+	std::vector<ufo::Sphere3d> spheres;
+	for (int i{}; 1000 > i; ++i) {
+		spheres.emplace_back(ufo::Vec3d(pos(gen), pos(gen), pos(gen)), size(gen));
+	}
+
+	ufo::BVH<ufo::Sphere3d> bvh(spheres.begin(), spheres.end());
+	REQUIRE(spheres.size() == bvh.size());
+	for (std::size_t i{}; bvh.size() > i; ++i) {
+		REQUIRE(spheres[bvh.index()[i]] == bvh.geometry()[i]);
+	}
+
+	for (int i{}; 100 > i; ++i) {
+		ufo::Vec3d  min(pos(gen), pos(gen), pos(gen));
+		ufo::AABB3d box(min, min + ufo::Vec3d(size(gen), size(gen), size(gen)) * 2.0);
+
+		std::vector<std::size_t> hits;
+		bvh.intersects(box, std::back_inserter(hits));
+		std::sort(hits.begin(), hits.end());
+
+		std::vector<std::size_t> expected;
+		for (std::size_t j{}; spheres.size() > j; ++j) {
+			if (ufo::intersects(spheres[j], box)) {
+				expected.push_back(j);
+			}
+		}
+		REQUIRE(expected == hits);
+
+		ufo::Vec3d  p(pos(gen), pos(gen), pos(gen));
+		auto const  nearest = bvh.nearest(p);
+		double      best    = std::numeric_limits<double>::infinity();
+		for (auto const& s : spheres) {
+			best = std::min(best, ufo::distance(s, p));
+		}
+		REQUIRE(best == nearest.second);
+		REQUIRE(best == ufo::distance(spheres[nearest.first], p));
+
+		// Nothing closer than the limit
+		auto const none = bvh.nearest(p, best);
+		REQUIRE(bvh.size() == none.first);
+		REQUIRE(best == none.second);
+	}
+}
+
+TEST_CASE("[BVH] Points")
+{
+	std::mt19937                          gen(5);
+	std::uniform_real_distribution<float> pos(-1, 1);
+
+	std::vector<ufo::Vec3f> points(5000);
+	for (auto& p : points) {
+		p = ufo::Vec3f(pos(gen), pos(gen), pos(gen));
+	}
+	// Duplicates cannot be split and end up in the same leaf
+	points.insert(points.end(), 100, ufo::Vec3f(0.5f));
+
+	ufo::BVH<ufo::Vec3f> bvh(points.begin(), points.end(), 8);
+	for (auto const& node : bvh.nodes()) {
+		if (node.leaf()) {
+			for (std::uint32_t i = node.offset; node.offset + node.count > i; ++i) {
+				REQUIRE(ufo::intersects(node.bounds, bvh.geometry()[i]));
+			}
+		}
+	}
+
+	for (int i{}; 100 > i; ++i) {
+		ufo::Vec3f q(pos(gen), pos(gen), pos(gen));
+		auto const nearest = bvh.nearest(q);
+		float      best    = std::numeric_limits<float>::infinity();
+		for (auto const& p : points) {
+			best = std::min(best, ufo::distance(p, q));
+		}
+		REQUIRE(best == nearest.second);
+	}
+
+	REQUIRE(ufo::BVH<ufo::Vec3f>().empty());
+	REQUIRE(0 == ufo::BVH<ufo::Vec3f>().nearest(ufo::Vec3f()).first);
+}
+
+TEST_CASE("[BVH] Builders")
+{
+	std::mt19937                           gen(3);
+	std::uniform_real_distribution<double> pos(-50, 50);
+	std::uniform_real_distribution<double> size(0.05, 1.0);
+	std::normal_distribution<double>       cluster(0, 0.5);
+
+	// Uniform boxes and a few dense clusters, which the median split handles poorly
+	std::vector<ufo::AABB3d> boxes;
+	for (int i{}; 20000 > i; ++i) {
+		ufo::Vec3d c(pos(gen), pos(gen), pos(gen));
+		if (0 == i % 2) {
+			c = ufo::Vec3d(10 * (i % 5), cluster(gen), cluster(gen));
+		}
+		boxes.emplace_back(c, c + ufo::Vec3d(size(gen), size(gen), size(gen)));
+	}
+
+	std::vector<ufo::AABB3d> queries;
+	for (int i{}; 50 > i; ++i) {
+		ufo::Vec3d min(pos(gen), pos(gen), pos(gen));
+		queries.emplace_back(min, min + ufo::Vec3d(size(gen), size(gen), size(gen)) * 5.0);
+	}
+
+	for (auto method : {ufo::BVHBuild::MEDIAN, ufo::BVHBuild::SAH, ufo::BVHBuild::LBVH}) {
+		ufo::BVH<ufo::AABB3d> seq(boxes.begin(), boxes.end(), method);
+		ufo::BVH<ufo::AABB3d> par(std::execution::par, boxes.begin(), boxes.end(), method, 2);
+		checkTree(seq, boxes, queries, 4);
+		checkTree(par, boxes, queries, 2);
+
+		// The same tree, the others only agree up to the order within the halves
+		if (ufo::BVHBuild::LBVH == method) {
+			ufo::BVH<ufo::AABB3d> lbvh(std::execution::par, boxes.begin(), boxes.end(), method);
+			REQUIRE(seq.index() == lbvh.index());
+			REQUIRE(seq.nodes().size() == lbvh.nodes().size());
+		}
+	}
+
+	// Identical geometries cannot be told apart by their codes and are split by count
+	std::vector<ufo::Vec3f> same(1000, ufo::Vec3f(0.5f));
+	ufo::BVH<ufo::Vec3f>    lbvh(std::execution::par, same.begin(), same.end(),
+	                             ufo::BVHBuild::LBVH);
+	REQUIRE(0.0f == lbvh.nearest(ufo::Vec3f(0.5f)).second);
+	for (auto const& node : lbvh.nodes()) {
+		REQUIRE((!node.leaf() || 4 >= node.count));
+	}
+}
+
+TEST_CASE("[BVH] Updates")
+{
+	std::mt19937                           gen(5);
+	std::uniform_real_distribution<double> pos(-50, 50);
+	std::uniform_real_distribution<double> size(0.05, 1.0);
+	std::uniform_real_distribution<double> step(-2, 2);
+
+	std::vector<ufo::AABB3d> boxes;
+	for (int i{}; 5000 > i; ++i) {
+		ufo::Vec3d c(pos(gen), pos(gen), pos(gen));
+		boxes.emplace_back(c, c + ufo::Vec3d(size(gen), size(gen), size(gen)));
+	}
+
+	std::vector<ufo::AABB3d> queries;
+	for (int i{}; 50 > i; ++i) {
+		ufo::Vec3d min(pos(gen), pos(gen), pos(gen));
+		queries.emplace_back(min, min + ufo::Vec3d(size(gen), size(gen), size(gen)) * 5.0);
+	}
+
+	ufo::BVH<ufo::AABB3d> seq(std::execution::par, boxes.begin(), boxes.end());
+	ufo::BVH<ufo::AABB3d> par = seq;
+
+	// Small steps of a tenth of the boxes keep the structure
+	for (int round{}; 3 > round; ++round) {
+		for (std::size_t i = round; boxes.size() > i; i += 10) {
+			ufo::Vec3d t(step(gen), step(gen), step(gen));
+			boxes[i] = ufo::AABB3d(boxes[i].min + t, boxes[i].max + t);
+			seq.update(i, boxes[i]);
+			par.update(i, boxes[i]);
+		}
+		seq.refit();
+		par.refit(std::execution::par);
+		checkTree(seq, boxes, queries, 4);
+		for (std::size_t i{}; seq.nodes().size() > i; ++i) {
+			REQUIRE(seq.nodes()[i].bounds == par.nodes()[i].bounds);
+		}
+	}
+
+	// Scattering every box degrades the refitted tree, which restructuring repairs
+	auto const visited = [&](ufo::BVH<ufo::AABB3d> const& bvh) {
+		std::size_t res{};
+		for (auto const& q : queries) {
+			bvh.traverse(
+			    [&](ufo::AABB3d const& b) {
+				    ++res;
+				    return ufo::intersects(b, q);
+			    },
+			    [](ufo::AABB3d const&, std::size_t) {});
+		}
+		return res;
+	};
+
+	for (std::size_t i{}; boxes.size() > i; ++i) {
+		ufo::Vec3d c(pos(gen), pos(gen), pos(gen));
+		boxes[i] = ufo::AABB3d(c, c + boxes[i].max - boxes[i].min);
+		seq.update(i, boxes[i]);
+		par.update(i, boxes[i]);
+	}
+	seq.refit();
+	checkTree(seq, boxes, queries, 4);
+	std::size_t const degraded = visited(seq);
+
+	REQUIRE(0 < seq.restructure());
+	REQUIRE(0 < par.restructure(std::execution::par, 2, ufo::BVHBuild::LBVH));
+	checkTree(seq, boxes, queries, 4);
+	checkTree(par, boxes, queries, 4);
+	REQUIRE(degraded > 2 * visited(seq));
+
+	// Updates keep working on the restructured tree
+	boxes[0] = ufo::AABB3d(ufo::Vec3d(100), ufo::Vec3d(101));
+	seq.update(0, boxes[0]);
+	seq.refit(std::execution::par);
+	checkTree(seq, boxes, queries, 4);
+	REQUIRE(0.0 == seq.nearest(ufo::Vec3d(100.5)).second);
+}
+
+TEST_CASE("[BVH] Pairs")
+{
+	std::mt19937                           gen(9);
+	std::uniform_real_distribution<double> pos(-20, 20);
+	std::uniform_real_distribution<double> size(0.1, 1.5);
+	std::normal_distribution<double>       step(0, 1);
+
+	std::vector<ufo::AABB3d> boxes;
+	for (int i{}; 3000 > i; ++i) {
+		ufo::Vec3d c(pos(gen), pos(gen), pos(gen));
+		boxes.emplace_back(c, c + ufo::Vec3d(size(gen), size(gen), size(gen)));
+	}
+
+	// A chain of links, where each link touches the next
+	auto const chain = [&](ufo::Vec3d p) {
+		std::vector<ufo::Capsule3d> res;
+		for (int i{}; 60 > i; ++i) {
+			ufo::Vec3d q = p + ufo::Vec3d(step(gen), step(gen), step(gen));
+			res.emplace_back(p, q, 0.3);
+			p = q;
+		}
+		return res;
+	};
+
+	using Pair = std::pair<std::size_t, std::size_t>;
+
+	ufo::BVH<ufo::AABB3d> env(std::execution::par, boxes.begin(), boxes.end());
+	for (ufo::Vec3d start : {ufo::Vec3d(0, 0, 0), ufo::Vec3d(0, 0, 40)}) {
+		auto const               links = chain(start);
+		ufo::BVH<ufo::Capsule3d> robot(links.begin(), links.end(), 2);
+		std::vector<Pair>        expected;
+		double                   d = std::numeric_limits<double>::infinity();
+		for (std::size_t i{}; links.size() > i; ++i) {
+			for (std::size_t j{}; boxes.size() > j; ++j) {
+				if (ufo::intersects(links[i], boxes[j])) {
+					expected.emplace_back(i, j);
+				}
+				d = std::min(d, ufo::detail::distanceKernel(links[i], boxes[j]));
+			}
+		}
+
+		std::vector<Pair> pairs;
+		ufo::intersects(robot, env, std::back_inserter(pairs));
+		std::sort(pairs.begin(), pairs.end());
+		REQUIRE(expected == pairs);
+		REQUIRE(expected.empty() == !ufo::intersects(robot, env));
+		REQUIRE(expected.empty() == !ufo::intersects(env, robot));
+
+		auto const nearest = ufo::nearest(robot, env);
+		REQUIRE(d == Catch::Approx(nearest.distance).margin(1e-6));
+		REQUIRE(nearest.distance ==
+		        Catch::Approx(ufo::detail::distanceKernel(links[nearest.first],
+		                                                  boxes[nearest.second]))
+		            .margin(1e-9));
+		REQUIRE(nearest.distance == ufo::distance(robot, env));
+
+		auto const none = ufo::nearest(robot, env, 0.5 * d);
+		REQUIRE(robot.size() == none.first);
+		REQUIRE(env.size() == none.second);
+
+		// Self-collision, skipping the links that always touch
+		std::vector<Pair> adjacent;
+		for (std::size_t i = 1; links.size() > i; ++i) {
+			adjacent.emplace_back(i, i - 1);
+		}
+		std::vector<Pair> self;
+		ufo::selfIntersects(robot, adjacent, std::back_inserter(self));
+		std::sort(self.begin(), self.end());
+		expected.clear();
+		for (std::size_t i{}; links.size() > i; ++i) {
+			for (std::size_t j = i + 2; links.size() > j; ++j) {
+				if (ufo::detail::intersectsKernel(links[i], links[j])) {
+					expected.emplace_back(i, j);
+				}
+			}
+		}
+		REQUIRE(expected == self);
+
+		self.clear();
+		ufo::selfIntersects(robot, std::back_inserter(self));
+		REQUIRE(expected.size() + adjacent.size() == self.size());
+	}
+
+	std::vector<Pair> self;
+	ufo::selfIntersects(env, std::back_inserter(self));
+	std::sort(self.begin(), self.end());
+	std::vector<Pair> expected;
+	for (std::size_t i{}; boxes.size() > i; ++i) {
+		for (std::size_t j = i + 1; boxes.size() > j; ++j) {
+			if (ufo::intersects(boxes[i], boxes[j])) {
+				expected.emplace_back(i, j);
+			}
+		}
+	}
+	REQUIRE(expected == self);
+}
@@ -0,0 +1,209 @@
+// UFO
+#include <ufo/geometry/closest_point.hpp>
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/signed_distance.hpp>
+
+// STL
+#include <cmath>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// Test
+#include "test_helpers.hpp"
+
+namespace
+{
+// Zero or negative if `p` is on or in `a`
+template <class Geometry>
+double surfaceDistance(Geometry const& a, ufo::Vec3d const& p)
+{
+	if constexpr (std::is_same_v<ufo::Vec3d, Geometry>) {
+		return ufo::distance(a, p);
+	} else if constexpr (std::is_same_v<ufo::Plane<double>, Geometry>) {
+		return std::abs(ufo::signedDistance(a, p));
+	} else {
+		return ufo::signedDistance(a, p);
+	}
+}
+
+// The points are on (or in) their geometries and `distance` apart, in both argument
+// orders. Parallel faces have many closest pairs, so the orders may pick different ones
+template <class A, class B>
+void checkPair(A const& a, B const& b, double distance, double margin = 1e-9)
+{
+	auto const cp  = ufo::closestPoints(a, b);
+	auto const rev = ufo::closestPoints(b, a);
+	for (auto const& [pa, pb, d2] : {cp, decltype(cp){rev.point_b, rev.point_a,
+	                                                  rev.distance_squared}}) {
+		REQUIRE(distance * distance == Catch::Approx(d2).margin(margin));
+		REQUIRE(d2 == Catch::Approx(ufo::distanceSquared(pa, pb)).margin(margin));
+		REQUIRE(margin >= surfaceDistance(a, pa));
+		REQUIRE(margin >= surfaceDistance(b, pb));
+	}
+}
+}  // namespace
+
+TEST_CASE("[Closest points] Point queries")
+{
+	ufo::AABB3d     aabb(ufo::Vec3d(-1, -0.5, 0), ufo::Vec3d(1.5, 1, 0.25));
+	ufo::Sphere3d   sphere(ufo::Vec3d(0.5, 0, -0.5), 1.5);
+	ufo::Capsule3d  capsule(ufo::Vec3d(-1, -1, 0), ufo::Vec3d(1, 0.5, 0.5), 0.75);
+	ufo::Cylinder3d cylinder(ufo::Vec3d(-1, 0.5, -1), ufo::Vec3d(1, -0.5, 1.5), 1.0);
+	ufo::Triangle3d tri(ufo::Vec3d(-1, -1, 0), ufo::Vec3d(2, -0.5, 0.5),
+	                    ufo::Vec3d(0, 2, -1));
+	ufo::Plane<double> plane(ufo::Vec3d(0, 0, 1), ufo::Vec3d(1, 0, 1), ufo::Vec3d(0, 1, 1));
+
+	ufo::Mat<3, 3, double> r;
+	r[0] = ufo::Vec3d(0, 1, 0);
+	r[1] = ufo::Vec3d(-1, 0, 0);
+	r[2] = ufo::Vec3d(0, 0, 1);
+	ufo::OBB3d obb(ufo::Vec3d(1, 2, 3), ufo::Vec3d(2, 1, 0.5), r);
+
+	for (auto const& p : ufo::test::randomPoints(300, -4.0, 4.0, 11)) {
+		auto const clamp = [](double d) { return std::max(d, 0.0); };
+		checkPair(aabb, p, ufo::distance(aabb, p));
+		checkPair(sphere, p, clamp(ufo::signedDistance(sphere, p)));
+		checkPair(capsule, p, clamp(ufo::signedDistance(capsule, p)));
+		checkPair(cylinder, p, clamp(ufo::signedDistance(cylinder, p)));
+		checkPair(obb, p, clamp(ufo::signedDistance(obb, p)));
+		checkPair(tri, p, std::abs(ufo::signedDistance(tri, p)));
+		checkPair(plane, p, std::abs(ufo::signedDistance(plane, p)));
+
+		ufo::LineSegment3d segment(capsule.start, capsule.end);
+		auto const         cp = ufo::closestPoints(segment, p);
+		REQUIRE(cp.distance_squared ==
+		        Catch::Approx(ufo::distanceSquared(segment, p)).margin(1e-9));
+	}
+
+	// The plane point is the projection
+	auto const cp = ufo::closestPoints(plane, ufo::Vec3d(2, -3, 5));
+	REQUIRE(ufo::Vec3d(2, -3, 1) == cp.point_a);
+	REQUIRE(16.0 == Catch::Approx(cp.distance_squared));
+}
+
+TEST_CASE("[Closest points] Closed form pairs")
+{
+	// Separated boxes meet at the facing faces, overlapping ones in the overlap
+	ufo::AABB3d a(ufo::Vec3d(0, 0, 0), ufo::Vec3d(1, 1, 1));
+	ufo::AABB3d b(ufo::Vec3d(2, 0.5, 3), ufo::Vec3d(3, 2, 4));
+	auto        cp = ufo::closestPoints(a, b);
+	REQUIRE(ufo::Vec3d(1, 0.75, 1) == cp.point_a);
+	REQUIRE(ufo::Vec3d(2, 0.75, 3) == cp.point_b);
+	REQUIRE(ufo::distanceSquared(a, b) == cp.distance_squared);
+
+	ufo::AABB3d c(ufo::Vec3d(0.5, 0.5, 0.5), ufo::Vec3d(2, 2, 2));
+	cp = ufo::closestPoints(a, c);
+	REQUIRE(0.0 == cp.distance_squared);
+	REQUIRE(cp.point_a == cp.point_b);
+	REQUIRE(0.0 == ufo::distance(a, cp.point_a));
+	REQUIRE(0.0 == ufo::distance(c, cp.point_a));
+
+	// Spheres meet on the line between the centers
+	ufo::Sphere3d s1(ufo::Vec3d(0, 0, 0), 1);
+	ufo::Sphere3d s2(ufo::Vec3d(4, 0, 0), 2);
+	checkPair(s1, s2, 1.0);
+	cp = ufo::closestPoints(s1, s2);
+	REQUIRE(ufo::Vec3d(1, 0, 0) == cp.point_a);
+	REQUIRE(ufo::Vec3d(2, 0, 0) == cp.point_b);
+	cp = ufo::closestPoints(s2, s1);
+	REQUIRE(ufo::Vec3d(2, 0, 0) == cp.point_a);
+	REQUIRE(ufo::Vec3d(1, 0, 0) == cp.point_b);
+
+	ufo::Sphere3d s3(ufo::Vec3d(2, 0, 0), 2);
+	cp = ufo::closestPoints(s1, s3);
+	REQUIRE(0.0 == cp.distance_squared);
+	REQUIRE(ufo::Vec3d(2.0 / 3, 0, 0) == cp.point_a);
+
+	checkPair(b, s2, ufo::distance(b, s2));
+
+	// Skew, parallel and touching segments
+	ufo::LineSegment3d l1(ufo::Vec3d(-1, 0, 0), ufo::Vec3d(1, 0, 0));
+	ufo::LineSegment3d l2(ufo::Vec3d(0, -1, 2), ufo::Vec3d(0, 1, 2));
+	cp = ufo::closestPoints(l1, l2);
+	REQUIRE(ufo::Vec3d(0, 0, 0) == cp.point_a);
+	REQUIRE(ufo::Vec3d(0, 0, 2) == cp.point_b);
+	REQUIRE(4.0 == cp.distance_squared);
+
+	ufo::LineSegment3d l3(ufo::Vec3d(3, 1, 0), ufo::Vec3d(5, 1, 0));
+	cp = ufo::closestPoints(l1, l3);
+	REQUIRE(ufo::Vec3d(1, 0, 0) == cp.point_a);
+	REQUIRE(ufo::Vec3d(3, 1, 0) == cp.point_b);
+
+	ufo::LineSegment3d l4(ufo::Vec3d(0, 0, 0), ufo::Vec3d(0, 0, 0));
+	REQUIRE(0.0 == ufo::closestPoints(l1, l4).distance_squared);
+
+	// Capsules against each other and against spheres
+	ufo::Capsule3d c1(l1.start, l1.end, 0.5);
+	ufo::Capsule3d c2(l2.start, l2.end, 0.25);
+	checkPair(c1, c2, 1.25);
+	checkPair(c1, s2, 0.5);
+	checkPair(c1, ufo::Capsule3d(l3.start, l3.end, 2.0), 0.0);
+}
+
+TEST_CASE("[Closest points] Generic convex pairs")
+{
+	std::mt19937                           gen(5);
+	std::uniform_real_distribution<double> pos(-3, 3);
+	std::uniform_real_distribution<double> size(0.1, 1);
+
+	ufo::Mat<3, 3, double> r;
+	r[0] = ufo::normalize(ufo::Vec3d(1, 1, 0));
+	r[1] = ufo::normalize(ufo::Vec3d(-1, 1, 0));
+	r[2] = ufo::Vec3d(0, 0, 1);
+	ufo::OBB3d     obb(ufo::Vec3d(0.5, 0, 0), ufo::Vec3d(1, 0.5, 0.75), r);
+	ufo::Capsule3d capsule(ufo::Vec3d(-1, 0, 0), ufo::Vec3d(1, 1, 0.5), 0.5);
+
+	for (int i{}; 100 > i; ++i) {
+		ufo::Vec3d center(pos(gen), pos(gen), pos(gen));
+		ufo::OBB3d other(center, ufo::Vec3d(size(gen), size(gen), size(gen)), r);
+		checkPair(obb, other, ufo::distanceConvex(obb, other), 1e-6);
+		checkPair(capsule, other, ufo::distanceConvex(capsule, other), 1e-6);
+
+		ufo::Sphere3d sphere(center, size(gen));
+		checkPair(obb, sphere, ufo::distanceConvex(obb, sphere), 1e-6);
+	}
+}
+
+TEST_CASE("[Closest points] Plane pairs")
+{
+	std::mt19937                           gen(9);
+	std::uniform_real_distribution<double> pos(-3, 3);
+	std::uniform_real_distribution<double> size(0.1, 1);
+	std::normal_distribution<double>       dir;
+
+	ufo::Mat<3, 3, double> r;
+	r[0] = ufo::normalize(ufo::Vec3d(1, 1, 0));
+	r[1] = ufo::normalize(ufo::Vec3d(-1, 1, 0));
+	r[2] = ufo::Vec3d(0, 0, 1);
+
+	for (int i{}; 200 > i; ++i) {
+		ufo::Vec3d const   n = ufo::normalize(ufo::Vec3d(dir(gen), dir(gen), dir(gen)));
+		ufo::Plane<double> plane(n, pos(gen));
+
+		ufo::Vec3d     c(pos(gen), pos(gen), pos(gen));
+		ufo::Vec3d     h(size(gen), size(gen), size(gen));
+		ufo::AABB3d    aabb(c - h, c + h);
+		ufo::OBB3d     obb(c, h, r);
+		ufo::Sphere3d  sphere(c, h.x);
+		ufo::Capsule3d capsule(c - h, c + h, h.y / 2);
+
+		// The distance is zero if the extent along the normal reaches the plane
+		double const d = std::abs(ufo::signedDistance(plane, c));
+		double       aabb_r{};
+		double       obb_r{};
+		for (std::size_t j{}; 3 > j; ++j) {
+			aabb_r += h[j] * std::abs(n[j]);
+			obb_r += h[j] * std::abs(ufo::dot(n, r[j]));
+		}
+
+		checkPair(plane, aabb, std::fdim(d, aabb_r));
+		checkPair(obb, plane, std::fdim(d, obb_r));
+		checkPair(plane, sphere, std::fdim(d, h.x));
+		checkPair(capsule, plane, std::fdim(d, std::abs(ufo::dot(n, h)) + h.y / 2));
+	}
+}
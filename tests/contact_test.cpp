@@ -0,0 +1,206 @@
+// UFO
+#include <ufo/geometry/contact.hpp>
+#include <ufo/geometry/intersects.hpp>
+#include <ufo/geometry/signed_distance.hpp>
+
+// STL
+#include <cmath>
+#include <random>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// Test
+#include "test_helpers.hpp"
+
+namespace
+{
+using ufo::test::rotation;
+
+template <class Geometry>
+Geometry translated(Geometry g, ufo::Vec3d const& t)
+{
+	if constexpr (std::is_same_v<ufo::AABB3d, Geometry>) {
+		g.min += t;
+		g.max += t;
+	} else if constexpr (std::is_same_v<ufo::Capsule3d, Geometry>) {
+		g.start += t;
+		g.end += t;
+	} else {
+		g.center += t;
+	}
+	return g;
+}
+
+// The contact agrees with the intersection test, the points are on the surface of `b`,
+// and translating `b` by the depth along the normal separates the geometries. Unless
+// `exact`, the depth may not be the least and the points may be inside `b`
+template <class A, class B>
+void checkContact(A const& a, B const& b, bool exact = true)
+{
+	auto const cm = ufo::contact(a, b);
+	REQUIRE(cm.empty() == !ufo::intersectsConvex(a, b));
+	if (cm.empty()) {
+		return;
+	}
+
+	REQUIRE(1.0 == Catch::Approx(ufo::norm(cm.normal)));
+	double depth{};
+	for (auto const& p : cm) {
+		REQUIRE(0.0 <= p.depth);
+		if (exact) {
+			REQUIRE(0.0 == Catch::Approx(ufo::signedDistance(b, p.position)).margin(1e-9));
+		} else {
+			REQUIRE(1e-9 >= ufo::signedDistance(b, p.position));
+		}
+		depth = std::max(depth, p.depth);
+	}
+	REQUIRE(depth == cm.depth);
+
+	REQUIRE_FALSE(ufo::intersectsConvex(a, translated(b, cm.normal * (cm.depth + 1e-6))));
+	if (exact) {
+		REQUIRE(ufo::intersectsConvex(a, translated(b, cm.normal * (cm.depth - 1e-3))));
+	}
+
+	// The same contact seen from the other side
+	auto const rev = ufo::contact(b, a);
+	REQUIRE(rev.size() == cm.size());
+	REQUIRE(cm.depth == Catch::Approx(rev.depth).margin(1e-9));
+	REQUIRE(0.0 == Catch::Approx(ufo::norm(cm.normal + rev.normal)).margin(1e-9));
+}
+}  // namespace
+
+TEST_CASE("[Contact] Resting boxes")
+{
+	// A box on top of another, the overlap of the faces gives four points
+	ufo::AABB3d a(ufo::Vec3d(0, 0, 0), ufo::Vec3d(1, 1, 1));
+	ufo::AABB3d b(ufo::Vec3d(0.25, 0.25, 0.9), ufo::Vec3d(1.25, 1.25, 2));
+	auto        cm = ufo::contact(a, b);
+	REQUIRE(4 == cm.size());
+	REQUIRE(ufo::Vec3d(0, 0, 1) == cm.normal);
+	REQUIRE(0.1 == Catch::Approx(cm.depth));
+	for (auto const& p : cm) {
+		REQUIRE(0.9 == Catch::Approx(p.position.z));
+		REQUIRE(0.1 == Catch::Approx(p.depth));
+		REQUIRE(0.25 <= p.position.x + 1e-12);
+		REQUIRE(1.0 >= p.position.x - 1e-12);
+	}
+	checkContact(a, b);
+
+	// Rotated 45 degrees on the face, the octagon of the overlap is reduced to four
+	ufo::Mat<3, 3, double> r;
+	r[0] = ufo::normalize(ufo::Vec3d(1, 1, 0));
+	r[1] = ufo::normalize(ufo::Vec3d(-1, 1, 0));
+	r[2] = ufo::Vec3d(0, 0, 1);
+	ufo::OBB3d obb(ufo::Vec3d(0.5, 0.5, 1.4), ufo::Vec3d(0.6, 0.6, 0.5), r);
+	cm = ufo::contact(a, obb);
+	REQUIRE(4 == cm.size());
+	REQUIRE(0.1 == Catch::Approx(cm.depth));
+	checkContact(a, obb);
+
+	// Separated
+	REQUIRE(ufo::contact(a, translated(b, ufo::Vec3d(0, 0, 0.2))).empty());
+}
+
+TEST_CASE("[Contact] Edge against edge")
+{
+	// Two boxes rotated 45 degrees around different axes, meeting at crossing edges
+	ufo::Mat<3, 3, double> ra;
+	ra[0] = ufo::Vec3d(1, 0, 0);
+	ra[1] = ufo::normalize(ufo::Vec3d(0, 1, 1));
+	ra[2] = ufo::normalize(ufo::Vec3d(0, -1, 1));
+	ufo::Mat<3, 3, double> rb;
+	rb[0] = ufo::normalize(ufo::Vec3d(1, 0, 1));
+	rb[1] = ufo::Vec3d(0, 1, 0);
+	rb[2] = ufo::normalize(ufo::Vec3d(-1, 0, 1));
+
+	double const h = std::sqrt(0.5);
+	ufo::OBB3d   a(ufo::Vec3d(0, 0, 0), ufo::Vec3d(1, 0.5, 0.5), ra);
+	ufo::OBB3d   b(ufo::Vec3d(0, 0, 2 * h - 0.05), ufo::Vec3d(0.5, 1, 0.5), rb);
+	auto const   cm = ufo::contact(a, b);
+	REQUIRE(1 == cm.size());
+	REQUIRE(0.0 == Catch::Approx(ufo::norm(cm.normal - ufo::Vec3d(0, 0, 1))).margin(1e-9));
+	REQUIRE(0.05 == Catch::Approx(cm.depth));
+	REQUIRE(0.0 == Catch::Approx(ufo::norm(cm[0].position -
+	                                       ufo::Vec3d(0, 0, h - 0.05)))
+	                   .margin(1e-9));
+	checkContact(a, b);
+}
+
+TEST_CASE("[Contact] Round shapes")
+{
+	ufo::Sphere3d s1(ufo::Vec3d(0, 0, 0), 1);
+	ufo::Sphere3d s2(ufo::Vec3d(1.5, 0, 0), 1);
+	auto          cm = ufo::contact(s1, s2);
+	REQUIRE(1 == cm.size());
+	REQUIRE(ufo::Vec3d(1, 0, 0) == cm.normal);
+	REQUIRE(0.5 == cm.depth);
+	REQUIRE(ufo::Vec3d(0.5, 0, 0) == cm[0].position);
+	checkContact(s1, s2);
+
+	// Sphere with the center inside a box leaves through the closest face
+	ufo::AABB3d box(ufo::Vec3d(-1, -1, -1), ufo::Vec3d(1, 1, 1));
+	ufo::Sphere3d inside(ufo::Vec3d(0.2, 0.7, 0), 0.5);
+	cm = ufo::contact(box, inside);
+	REQUIRE(ufo::Vec3d(0, 1, 0) == cm.normal);
+	REQUIRE(0.8 == Catch::Approx(cm.depth));
+	checkContact(box, inside);
+
+	// A capsule lying on a box and on another capsule is supported at both ends
+	ufo::Capsule3d lying(ufo::Vec3d(-0.5, 0, 1.2), ufo::Vec3d(0.5, 0, 1.2), 0.25);
+	cm = ufo::contact(box, lying);
+	REQUIRE(2 == cm.size());
+	REQUIRE(0.0 == Catch::Approx(ufo::norm(cm.normal - ufo::Vec3d(0, 0, 1))).margin(1e-9));
+	REQUIRE(0.05 == Catch::Approx(cm.depth));
+	checkContact(box, lying);
+
+	ufo::Capsule3d under(ufo::Vec3d(-2, 0, 0.8), ufo::Vec3d(0, 0, 0.8), 0.25);
+	cm = ufo::contact(under, lying);
+	REQUIRE(2 == cm.size());
+	REQUIRE(ufo::Vec3d(0, 0, 1) == cm.normal);
+	REQUIRE(0.1 == Catch::Approx(cm.depth));
+	checkContact(under, lying);
+
+	// Segment through the box
+	ufo::Capsule3d through(ufo::Vec3d(-0.5, 0.9, 0), ufo::Vec3d(0.5, 0.9, 0.2), 0.1);
+	cm = ufo::contact(box, through);
+	REQUIRE(0.0 == Catch::Approx(ufo::norm(cm.normal - ufo::Vec3d(0, 1, 0))).margin(1e-9));
+	REQUIRE(0.2 == Catch::Approx(cm.depth));
+	checkContact(box, through, false);
+
+	checkContact(s1, lying);
+	checkContact(lying, s2);
+}
+
+TEST_CASE("[Contact] Random pairs")
+{
+	std::mt19937                           gen(13);
+	std::uniform_real_distribution<double> pos(-1.5, 1.5);
+	std::uniform_real_distribution<double> size(0.1, 1);
+
+	for (int i{}; 300 > i; ++i) {
+		ufo::Vec3d c1(pos(gen), pos(gen), pos(gen));
+		ufo::Vec3d c2(pos(gen), pos(gen), pos(gen));
+		ufo::Vec3d h1(size(gen), size(gen), size(gen));
+		ufo::Vec3d h2(size(gen), size(gen), size(gen));
+
+		ufo::OBB3d     o1(c1, h1, rotation(gen));
+		ufo::OBB3d     o2(c2, h2, rotation(gen));
+		ufo::AABB3d    aabb(c2 - h2, c2 + h2);
+		ufo::Sphere3d  sphere(c2, h2.x);
+		ufo::Capsule3d capsule(c2 - h2, c2 + h2, h1.x / 2);
+		ufo::Vec3d     e1(h1.z, -h1.y, h1.x);
+		ufo::Capsule3d other(c1 - e1, c1 + e1, h2.y / 2);
+
+		checkContact(o1, o2);
+		checkContact(o1, aabb);
+		checkContact(aabb, ufo::AABB3d(c1 - h1, c1 + h1));
+		checkContact(o1, sphere);
+		checkContact(aabb, sphere);
+		checkContact(sphere, other);
+		checkContact(capsule, other);
+		// Only the separating axis candidates are tried once the segment is inside
+		checkContact(o1, capsule, false);
+	}
+}
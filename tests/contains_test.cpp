@@ -0,0 +1,41 @@
+// UFO
+#include <ufo/geometry/aabb.hpp>
+#include <ufo/geometry/contains.hpp>
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/line_segment.hpp>
+#include <ufo/geometry/sphere.hpp>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("[Contains] AABB and point")
+{
+	ufo::AABB3d a(ufo::Vec3d(-1, 0, 2), ufo::Vec3d(1, 3, 4));
+
+	REQUIRE(ufo::contains(a, ufo::Vec3d(0, 1, 3)));
+	REQUIRE(ufo::contains(a, a.min));
+	REQUIRE(ufo::contains(a, a.max));
+	REQUIRE(ufo::contains(a, ufo::Vec3d(1, 0, 4)));
+	REQUIRE_FALSE(ufo::contains(a, ufo::Vec3d(1.5, 1, 3)));
+	REQUIRE_FALSE(ufo::contains(a, ufo::Vec3d(0, -0.5, 3)));
+	REQUIRE_FALSE(ufo::contains(a, ufo::Vec3d(0, 1, 4.5)));
+
+	// Line segments are contained when both ends are
+	REQUIRE(ufo::contains(a, ufo::LineSegment3d(a.min, a.max)));
+	REQUIRE_FALSE(ufo::contains(a, ufo::LineSegment3d(a.min, ufo::Vec3d(0, 1, 5))));
+}
+
+TEST_CASE("[Contains] Sphere and point")
+{
+	ufo::Sphere3d a(ufo::Vec3d(1, 2, 3), 2);
+
+	REQUIRE(ufo::contains(a, a.center));
+	REQUIRE(ufo::contains(a, ufo::Vec3d(3, 2, 3)));
+	REQUIRE(ufo::contains(a, ufo::Vec3d(1, 0.5, 4)));
+	REQUIRE_FALSE(ufo::contains(a, ufo::Vec3d(3.5, 2, 3)));
+	REQUIRE_FALSE(ufo::contains(a, ufo::Vec3d(1, 2, 6.5)));
+
+	// A box is contained when all its corners are
+	REQUIRE(ufo::contains(a, ufo::AABB3d(ufo::Vec3d(0, 1, 2), ufo::Vec3d(2, 3, 4))));
+	REQUIRE_FALSE(ufo::contains(a, ufo::AABB3d(ufo::Vec3d(-1, 0, 1), ufo::Vec3d(3, 4, 5))));
+}
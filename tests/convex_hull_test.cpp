@@ -0,0 +1,108 @@
+// UFO
+#include <ufo/geometry/contains.hpp>
+#include <ufo/geometry/convex_hull.hpp>
+#include <ufo/geometry/intersects.hpp>
+
+// STL
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+ufo::ConvexPolyhedronf octahedron()
+{
+	std::vector<ufo::Vec3f> points{ufo::Vec3f(1, 0, 0),  ufo::Vec3f(-1, 0, 0),
+	                               ufo::Vec3f(0, 1, 0),  ufo::Vec3f(0, -1, 0),
+	                               ufo::Vec3f(0, 0, 1),  ufo::Vec3f(0, 0, -1),
+	                               ufo::Vec3f(0, 0, 0),  ufo::Vec3f(0.1f, 0.2f, 0.3f)};
+	return ufo::convexHull(points.begin(), points.end());
+}
+}  // namespace
+
+TEST_CASE("[ConvexHull] Cube")
+{
+	std::mt19937                          gen(7);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	std::vector<ufo::Vec3f> points;
+	for (int i{}; 8 > i; ++i) {
+		points.emplace_back(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f,
+		                    i & 4 ? 1.0f : -1.0f);
+	}
+	for (int i{}; 10000 > i; ++i) {
+		points.emplace_back(dist(gen), dist(gen), dist(gen));
+	}
+
+	auto hull = ufo::convexHull(points.begin(), points.end());
+	REQUIRE(6 == hull.planes.size());
+	REQUIRE(8 == hull.vertices.size());
+
+	auto par = ufo::convexHull(std::execution::par, points.begin(), points.end());
+	REQUIRE(6 == par.planes.size());
+	REQUIRE(8 == par.vertices.size());
+
+	REQUIRE(ufo::contains(hull, ufo::Vec3f(0.5f, -0.5f, 0.9f)));
+	REQUIRE_FALSE(ufo::contains(hull, ufo::Vec3f(0.5f, -0.5f, 1.1f)));
+	REQUIRE(ufo::Vec3f(-1, -1, -1) == ufo::min(hull));
+	REQUIRE(ufo::Vec3f(1, 1, 1) == ufo::max(hull));
+}
+
+TEST_CASE("[ConvexHull] Sphere points")
+{
+	std::mt19937                     gen(3);
+	std::normal_distribution<double> dist;
+
+	std::vector<ufo::Vec3d> points(2000);
+	for (auto& p : points) {
+		p = ufo::normalize(ufo::Vec3d(dist(gen), dist(gen), dist(gen))) * 2.0;
+	}
+
+	auto hull = ufo::convexHull(points.begin(), points.end());
+	REQUIRE(points.size() == hull.vertices.size());
+	for (auto const& p : points) {
+		REQUIRE(1e-9 >= hull.signedDistance(p));
+	}
+	REQUIRE(ufo::contains(hull, ufo::Vec3d(0, 0, 1.9)));
+	REQUIRE_FALSE(ufo::contains(hull, ufo::Vec3d(0, 0, 2.1)));
+}
+
+TEST_CASE("[ConvexHull] Flat")
+{
+	std::vector<ufo::Vec3f> points{ufo::Vec3f(0, 0, 0), ufo::Vec3f(1, 0, 0),
+	                               ufo::Vec3f(1, 1, 0), ufo::Vec3f(0, 1, 0),
+	                               ufo::Vec3f(0.5f, 0.5f, 0)};
+	auto                    hull = ufo::convexHull(points.begin(), points.end());
+	REQUIRE(6 == hull.planes.size());
+	REQUIRE(ufo::intersects(hull, ufo::Vec3f(0.5f, 0.25f, 0)));
+	REQUIRE_FALSE(ufo::intersects(hull, ufo::Vec3f(0.5f, 0.25f, 0.1f)));
+}
+
+TEST_CASE("[ConvexPolyhedron] Intersects/contains")
+{
+	auto o = octahedron();
+	REQUIRE(8 == o.planes.size());
+	REQUIRE(6 == o.vertices.size());
+	REQUIRE(ufo::Vec3f(0, 0, 1) == o.support(ufo::Vec3f(0.1f, 0.2f, 0.9f)));
+
+	REQUIRE(ufo::intersects(o, ufo::AABB3f(ufo::Vec3f(0.3f, 0.3f, -0.1f),
+	                                       ufo::Vec3f(1, 1, 0.1f))));
+	REQUIRE_FALSE(ufo::intersects(o, ufo::AABB3f(ufo::Vec3f(0.6f, 0.6f, -0.1f),
+	                                             ufo::Vec3f(1, 1, 0.1f))));
+	REQUIRE(ufo::intersects(ufo::AABB3f(ufo::Vec3f(-2), ufo::Vec3f(2)), o));
+
+	// The closest feature to (1, 1, 0) is the edge at distance sqrt(0.5), while the
+	// distance to the plane of the closest face is only 1 / sqrt(3)
+	REQUIRE_FALSE(ufo::intersects(o, ufo::Sphere3f(ufo::Vec3f(1, 1, 0), 0.6f)));
+	REQUIRE(ufo::intersects(o, ufo::Sphere3f(ufo::Vec3f(1, 1, 0), 0.75f)));
+
+	REQUIRE(ufo::contains(o, ufo::AABB3f(ufo::Vec3f(-0.2f), ufo::Vec3f(0.2f))));
+	REQUIRE_FALSE(ufo::contains(o, ufo::AABB3f(ufo::Vec3f(-0.4f), ufo::Vec3f(0.4f))));
+	REQUIRE(ufo::contains(o, ufo::Sphere3f(ufo::Vec3f(0), 0.5f)));
+	REQUIRE_FALSE(ufo::contains(o, ufo::Sphere3f(ufo::Vec3f(0), 0.6f)));
+	REQUIRE(ufo::contains(ufo::Sphere3f(ufo::Vec3f(0), 1.0f), o));
+	REQUIRE(ufo::contains(ufo::AABB3f(ufo::Vec3f(-1), ufo::Vec3f(1)), o));
+}
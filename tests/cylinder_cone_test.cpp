@@ -0,0 +1,199 @@
+// UFO
+#include <ufo/geometry/cone.hpp>
+#include <ufo/geometry/contains.hpp>
+#include <ufo/geometry/cylinder.hpp>
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/fun.hpp>
+#include <ufo/geometry/intersects.hpp>
+#include <ufo/geometry/raycast.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+// Points on the surface of the shape, the radius at axial fraction `s` is `radius(s)`
+template <class F>
+std::vector<ufo::Vec3d> surface(ufo::Vec3d start, ufo::Vec3d end, F radius)
+{
+	ufo::Vec3d axis = ufo::normalize(end - start);
+	ufo::Vec3d ref  = std::abs(axis.x) < 0.9 ? ufo::Vec3d(1, 0, 0) : ufo::Vec3d(0, 1, 0);
+	ufo::Vec3d u    = ufo::normalize(ufo::cross(axis, ref));
+	ufo::Vec3d v    = ufo::cross(axis, u);
+
+	std::vector<ufo::Vec3d> res;
+	int const               n = 120;
+	for (int i{}; n >= i; ++i) {
+		double     s = i / double(n);
+		ufo::Vec3d c = start + (end - start) * s;
+		for (int j{}; n > j; ++j) {
+			double a = 2 * M_PI * j / n;
+			for (double f : {1.0, 0.75, 0.5, 0.25, 0.0}) {
+				if (1.0 == f || 0 == i || n == i) {
+					res.push_back(c + (u * std::cos(a) + v * std::sin(a)) * (f * radius(s)));
+				}
+			}
+		}
+	}
+	return res;
+}
+
+template <class Shape>
+void checkShape(Shape const& shape, std::vector<ufo::Vec3d> const& samples)
+{
+	std::mt19937                           gen(7);
+	std::uniform_real_distribution<double> pos(-4, 4);
+
+	// Bounds are tight
+	ufo::Vec3d lo(std::numeric_limits<double>::max());
+	ufo::Vec3d hi(std::numeric_limits<double>::lowest());
+	for (auto const& p : samples) {
+		lo = ufo::min(lo, p);
+		hi = ufo::max(hi, p);
+	}
+	for (std::size_t i{}; 3 > i; ++i) {
+		REQUIRE(lo[i] == Catch::Approx(ufo::min(shape)[i]).margin(1e-3));
+		REQUIRE(hi[i] == Catch::Approx(ufo::max(shape)[i]).margin(1e-3));
+	}
+
+	// Point distance against the sampled surface, and containment
+	std::vector<ufo::Vec3d> points;
+	for (int i{}; 200 > i; ++i) {
+		ufo::Vec3d p(pos(gen), pos(gen), pos(gen));
+		points.push_back(p);
+
+		double d       = ufo::distance(shape, p);
+		double sampled = std::numeric_limits<double>::max();
+		for (auto const& q : samples) {
+			sampled = std::min(sampled, ufo::distance(p, q));
+		}
+
+		if (ufo::contains(shape, p)) {
+			REQUIRE(0.0 == d);
+			REQUIRE(ufo::intersects(shape, p));
+		} else {
+			REQUIRE(d <= sampled + 1e-9);
+			REQUIRE(d == Catch::Approx(sampled).margin(0.06));
+		}
+
+		ufo::Sphere3d sphere(p, 0.5);
+		REQUIRE(ufo::intersects(shape, sphere) == (0.5 >= d));
+	}
+
+	std::vector<char> seq(points.size());
+	std::vector<char> par(points.size());
+	ufo::contains(shape, points.begin(), points.end(), seq.begin());
+	ufo::contains(std::execution::par, shape, points.begin(), points.end(), par.begin());
+	for (std::size_t i{}; points.size() > i; ++i) {
+		REQUIRE(bool(seq[i]) == ufo::contains(shape, points[i]));
+		REQUIRE(seq[i] == par[i]);
+	}
+
+	// Rays against marching
+	for (int i{}; 200 > i; ++i) {
+		ufo::Vec3d origin(pos(gen), pos(gen), pos(gen));
+		ufo::Vec3d target(pos(gen) / 2, pos(gen) / 2, pos(gen) / 2);
+		ufo::Ray3d ray(origin, target - origin);
+
+		double t = ufo::raycast(shape, ray);
+		REQUIRE(ufo::intersects(shape, ray) == !std::isinf(t));
+
+		double marched = std::numeric_limits<double>::infinity();
+		for (double s{}; 16 > s; s += 0.001) {
+			if (ufo::contains(shape, origin + ray.direction * s)) {
+				marched = s;
+				break;
+			}
+		}
+		if (std::isinf(marched)) {
+			// Only grazing hits can be missed by marching
+			if (!std::isinf(t)) {
+				REQUIRE(1e-3 > ufo::distance(shape, origin + ray.direction * t));
+			}
+		} else {
+			REQUIRE(t == Catch::Approx(marched).margin(2e-3));
+		}
+
+		if (std::isinf(t)) {
+			REQUIRE(0.0 < ufo::distance(shape, ray));
+		} else {
+			REQUIRE(0.0 == Catch::Approx(ufo::distance(shape, ray)).margin(1e-6));
+		}
+	}
+
+	// Boxes against the sampled volume
+	std::uniform_real_distribution<double> size(0.05, 1.0);
+	for (int i{}; 200 > i; ++i) {
+		ufo::Vec3d  min(pos(gen), pos(gen), pos(gen));
+		ufo::AABB3d box(min, min + ufo::Vec3d(size(gen), size(gen), size(gen)));
+
+		double d       = ufo::distance(shape, box);
+		double sampled = std::numeric_limits<double>::max();
+		for (auto const& q : samples) {
+			sampled = std::min(sampled, ufo::distance(box, q));
+		}
+
+		REQUIRE(ufo::intersectsConvex(shape, box) == (0.0 == d));
+		if (0.0 < d) {
+			REQUIRE(d <= sampled + 1e-6);
+			REQUIRE(d == Catch::Approx(sampled).margin(0.06));
+		}
+		if (ufo::contains(shape, box)) {
+			REQUIRE(ufo::intersectsConvex(shape, box));
+		}
+	}
+}
+}  // namespace
+
+TEST_CASE("[Cylinder] Queries")
+{
+	ufo::Cylinder3d cylinder(ufo::Vec3d(-1, -0.5, 0.2), ufo::Vec3d(1.5, 1, -0.8), 0.75);
+	checkShape(cylinder,
+	           surface(cylinder.start, cylinder.end, [](double) { return 0.75; }));
+
+	// Axis aligned
+	ufo::Cylinder3d z(ufo::Vec3d(0, 0, 0), ufo::Vec3d(0, 0, 2), 1.0);
+	REQUIRE(ufo::contains(z, ufo::Vec3d(0.5, 0.5, 1.9)));
+	REQUIRE_FALSE(ufo::contains(z, ufo::Vec3d(0.8, 0.8, 1)));
+	REQUIRE(1.0 == Catch::Approx(ufo::distance(z, ufo::Vec3d(0, 0, 3))));
+	REQUIRE(5.0 == Catch::Approx(ufo::distance(z, ufo::Vec3d(4, 0, 6))));
+	REQUIRE(1.0 == Catch::Approx(ufo::raycast(z, ufo::Ray3d(ufo::Vec3d(-2, 0, 1),
+	                                                          ufo::Vec3d(1, 0, 0)))));
+	REQUIRE(0.0 == ufo::raycast(z, ufo::Ray3d(ufo::Vec3d(0, 0, 1), ufo::Vec3d(1, 0, 0))));
+	REQUIRE(
+	    ufo::contains(z, ufo::AABB3d(ufo::Vec3d(-0.5, -0.5, 0), ufo::Vec3d(0.5, 0.5, 2))));
+	REQUIRE_FALSE(
+	    ufo::contains(z, ufo::AABB3d(ufo::Vec3d(-0.8, -0.8, 0), ufo::Vec3d(0.8, 0.8, 2))));
+}
+
+TEST_CASE("[Cone] Queries")
+{
+	ufo::Cone3d cone(ufo::Vec3d(0.5, -1, -0.5), ufo::Vec3d(-1, 1.5, 1), 1.25);
+	checkShape(cone,
+	           surface(cone.tip, cone.base_center, [](double s) { return 1.25 * s; }));
+
+	// Axis aligned, tip at the origin
+	ufo::Cone3d z(ufo::Vec3d(0, 0, 2), ufo::Vec3d(0, 0, 0), 1.0);
+	REQUIRE(ufo::contains(z, ufo::Vec3d(0.4, 0, 1)));
+	REQUIRE_FALSE(ufo::contains(z, ufo::Vec3d(0.6, 0, 1)));
+	REQUIRE(1.0 == Catch::Approx(ufo::distance(z, ufo::Vec3d(0, 0, -1))));
+	REQUIRE(1.0 == Catch::Approx(ufo::distance(z, ufo::Vec3d(0, 0, 3))));
+	REQUIRE(std::sqrt(0.8) ==
+	        Catch::Approx(ufo::distance(z, ufo::Vec3d(1, 0, 0))));  // To the slant
+	// Straight down the axis from below hits the tip, from the side the slant
+	REQUIRE(1.0 == Catch::Approx(ufo::raycast(z, ufo::Ray3d(ufo::Vec3d(0, 0, -1),
+	                                                          ufo::Vec3d(0, 0, 1)))));
+	REQUIRE(1.5 == Catch::Approx(ufo::raycast(z, ufo::Ray3d(ufo::Vec3d(-2, 0, 1),
+	                                                          ufo::Vec3d(1, 0, 0)))));
+	REQUIRE(std::isinf(
+	    ufo::raycast(z, ufo::Ray3d(ufo::Vec3d(0, 0, -1), ufo::Vec3d(0, 0, -1)))));
+}
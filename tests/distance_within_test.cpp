@@ -0,0 +1,110 @@
+// UFO
+#include <ufo/geometry/bvh.hpp>
+#include <ufo/geometry/distance.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+// Compares against the exact distance, away from ties
+template <class A, class B>
+void checkWithin(A const& a, B const& b, double d)
+{
+	for (double t : {0.0, 0.01, 0.1, 0.5, 1.0, 2.0, 5.0}) {
+		if (1e-6 > std::abs(d - t)) {
+			continue;
+		}
+		REQUIRE((d <= t) == ufo::distanceSquaredWithin(a, b, t * t));
+		REQUIRE((d <= t) == ufo::distanceSquaredWithin(b, a, t * t));
+		REQUIRE((d < t) == ufo::distanceLessThan(a, b, t));
+	}
+	REQUIRE_FALSE(ufo::distanceSquaredWithin(a, b, -1.0));
+}
+}  // namespace
+
+TEST_CASE("[Distance within] Closed forms")
+{
+	std::mt19937                           gen(29);
+	std::uniform_real_distribution<double> pos(-3, 3);
+	std::uniform_real_distribution<double> size(0.05, 1.0);
+
+	for (int i{}; 500 > i; ++i) {
+		ufo::Vec3d  p(pos(gen), pos(gen), pos(gen));
+		ufo::Vec3d  q(pos(gen), pos(gen), pos(gen));
+		ufo::AABB3d a(p, p + ufo::Vec3d(size(gen), size(gen), size(gen)));
+		ufo::AABB3d b(q, q + ufo::Vec3d(size(gen), size(gen), size(gen)));
+		ufo::Sphere3d s(p, size(gen));
+		ufo::Sphere3d r(q, size(gen));
+
+		checkWithin(a, b, ufo::distance(a, b));
+		checkWithin(a, q, ufo::distance(a, q));
+		checkWithin(a, r, ufo::distance(a, r));
+		checkWithin(s, r, ufo::distance(s, r));
+		checkWithin(s, q, ufo::distance(s, q));
+	}
+}
+
+TEST_CASE("[Distance within] Convex")
+{
+	std::mt19937                           gen(31);
+	std::uniform_real_distribution<double> pos(-3, 3);
+	std::uniform_real_distribution<double> size(0.05, 1.0);
+
+	for (int i{}; 500 > i; ++i) {
+		ufo::Vec3d p(pos(gen), pos(gen), pos(gen));
+		ufo::Vec3d q(pos(gen), pos(gen), pos(gen));
+		ufo::OBB3d a(p, p + ufo::Vec3d(size(gen), -size(gen), size(gen)),
+		             ufo::Vec2d(size(gen), size(gen)));
+		ufo::OBB3d b(q, q + ufo::Vec3d(-size(gen), size(gen), size(gen)),
+		             ufo::Vec2d(size(gen), size(gen)));
+		ufo::Capsule3d c(p, q + ufo::Vec3d(size(gen)), size(gen));
+		ufo::Capsule3d d(q, ufo::Vec3d(pos(gen), pos(gen), pos(gen)), size(gen));
+
+		checkWithin(a, b, ufo::distanceConvex(a, b));
+		checkWithin(a, c, ufo::distanceConvex(a, c));
+		checkWithin(c, d, ufo::distanceConvex(c, d));
+		checkWithin(c, ufo::Sphere3d(q, 0.5), ufo::distanceConvex(c, ufo::Sphere3d(q, 0.5)));
+	}
+}
+
+TEST_CASE("[Distance within] BVH")
+{
+	std::mt19937                           gen(37);
+	std::uniform_real_distribution<double> pos(-10, 10);
+	std::uniform_real_distribution<double> size(0.05, 0.5);
+
+	std::vector<ufo::Capsule3d> capsules;
+	for (int i{}; 500 > i; ++i) {
+		ufo::Vec3d p(pos(gen), pos(gen), pos(gen));
+		capsules.emplace_back(p, p + ufo::Vec3d(size(gen), size(gen), -size(gen)),
+		                      size(gen));
+	}
+	ufo::BVH<ufo::Capsule3d> bvh(capsules.begin(), capsules.end());
+
+	for (int i{}; 200 > i; ++i) {
+		ufo::Vec3d p(pos(gen), pos(gen), pos(gen));
+		ufo::OBB3d box(p, ufo::Vec3d(size(gen), size(gen), size(gen)));
+		double     t = 2 * size(gen);
+
+		std::vector<std::size_t> expected;
+		for (std::size_t j{}; capsules.size() > j; ++j) {
+			if (t >= ufo::distanceConvex(capsules[j], box)) {
+				expected.push_back(j);
+			}
+		}
+
+		std::vector<std::size_t> within;
+		ufo::distanceSquaredWithin(bvh, box, t * t, std::back_inserter(within));
+		std::sort(within.begin(), within.end());
+		REQUIRE(expected == within);
+		REQUIRE(expected.empty() != ufo::distanceSquaredWithin(bvh, box, t * t));
+		REQUIRE(expected.empty() != ufo::distanceLessThan(bvh, box, t));
+	}
+}
@@ -0,0 +1,119 @@
+// UFO
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/dynamic_aabb_tree.hpp>
+#include <ufo/geometry/intersects.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("[Dynamic AABB tree] Insert, update and erase")
+{
+	std::mt19937                           gen(29);
+	std::uniform_real_distribution<double> pos(-50, 50);
+	std::uniform_real_distribution<double> radius(0.1, 1.0);
+	std::uniform_real_distribution<double> small(-0.05, 0.05);
+
+	ufo::DynamicAABBTree<ufo::Sphere3d> tree(0.2);
+	std::vector<ufo::Sphere3d>          spheres;
+	std::vector<std::size_t>            ids;
+	std::vector<char>                   alive;
+
+	auto const check = [&] {
+		std::size_t n = std::count(alive.begin(), alive.end(), char(1));
+		REQUIRE(n == tree.size());
+		// A balanced tree is at most about 1.44 log2(n) high
+		REQUIRE(tree.height() <= 1.45 * std::log2(n + 2.0) + 1);
+
+		for (int i{}; 20 > i; ++i) {
+			ufo::Vec3d  c(pos(gen), pos(gen), pos(gen));
+			ufo::AABB3d box(c - 4.0, c + 4.0);
+
+			std::vector<std::size_t> hits;
+			tree.intersects(box, std::back_inserter(hits));
+			std::sort(hits.begin(), hits.end());
+
+			std::vector<std::size_t> expected;
+			double                   closest = std::numeric_limits<double>::infinity();
+			std::size_t              id      = tree.NO_ID;
+			for (std::size_t j{}; spheres.size() > j; ++j) {
+				if (!alive[j]) {
+					continue;
+				}
+				if (ufo::intersects(spheres[j], box)) {
+					expected.push_back(ids[j]);
+				}
+				if (double d = ufo::distance(spheres[j], c); d < closest) {
+					closest = d;
+					id      = ids[j];
+				}
+			}
+			std::sort(expected.begin(), expected.end());
+			REQUIRE(expected == hits);
+
+			auto const nearest = tree.nearest(c);
+			REQUIRE(closest == nearest.second);
+			REQUIRE(id == nearest.first);
+		}
+	};
+
+	for (int i{}; 5000 > i; ++i) {
+		spheres.emplace_back(ufo::Vec3d(pos(gen), pos(gen), pos(gen)), radius(gen));
+		ids.push_back(tree.insert(spheres.back()));
+		alive.push_back(1);
+		REQUIRE(spheres.back() == tree[ids.back()]);
+	}
+	check();
+
+	// Small motions stay inside the fat bounds and do not move the leaves
+	std::size_t moved{};
+	for (std::size_t i{}; spheres.size() > i; i += 7) {
+		spheres[i].center += ufo::Vec3d(small(gen), small(gen), small(gen));
+		moved += tree.update(ids[i], spheres[i]);
+	}
+	REQUIRE(0 == moved);
+	check();
+
+	// Large ones do
+	for (std::size_t i{}; spheres.size() > i; i += 5) {
+		spheres[i].center = ufo::Vec3d(pos(gen), pos(gen), pos(gen));
+		REQUIRE(tree.update(ids[i], spheres[i]));
+		auto const& fat = tree.fatBounds(ids[i]);
+		REQUIRE(fat.min == ufo::min(spheres[i]) - 0.2);
+		REQUIRE(fat.max == ufo::max(spheres[i]) + 0.2);
+	}
+	check();
+
+	// Erased ids are reused without growing the pool
+	for (std::size_t i{}; spheres.size() > i; i += 3) {
+		tree.erase(ids[i]);
+		alive[i] = 0;
+	}
+	check();
+	for (std::size_t i{}; spheres.size() > i; i += 3) {
+		spheres[i] = ufo::Sphere3d(ufo::Vec3d(pos(gen), pos(gen), pos(gen)), radius(gen));
+		ids[i]     = tree.insert(spheres[i]);
+		alive[i]   = 1;
+		REQUIRE(2 * spheres.size() > ids[i]);
+	}
+	check();
+
+	// Inserting sorted positions is the worst case for an unbalanced tree
+	ufo::DynamicAABBTree<ufo::Vec3d> line(0);
+	for (int i{}; 4096 > i; ++i) {
+		line.insert(ufo::Vec3d(i, 0, 0));
+	}
+	REQUIRE(20 >= line.height());
+	REQUIRE(0.5 == Catch::Approx(line.nearest(ufo::Vec3d(100.5, 0.0, 0.0)).second));
+
+	line.clear();
+	REQUIRE(line.empty());
+	REQUIRE(line.NO_ID == line.nearest(ufo::Vec3d()).first);
+}
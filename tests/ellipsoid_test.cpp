@@ -0,0 +1,102 @@
+// UFO
+#include <ufo/geometry/contains.hpp>
+#include <ufo/geometry/ellipsoid.hpp>
+#include <ufo/geometry/fun.hpp>
+#include <ufo/geometry/intersects.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+ufo::Mat<3, 3, double> rotationZ(double angle)
+{
+	ufo::Mat<3, 3, double> r;
+	r[0] = ufo::Vec3d(std::cos(angle), std::sin(angle), 0);
+	r[1] = ufo::Vec3d(-std::sin(angle), std::cos(angle), 0);
+	r[2] = ufo::Vec3d(0, 0, 1);
+	return r;
+}
+}  // namespace
+
+TEST_CASE("[Ellipsoid] Shape")
+{
+	ufo::Ellipsoid3d e(ufo::Vec3d(1, 2, 3), ufo::Vec3d(2, 1, 0.5), rotationZ(M_PI / 2));
+	REQUIRE(1.0 == Catch::Approx(e.mahalanobisSquared(ufo::Vec3d(1, 4, 3))));
+	REQUIRE(1.0 == Catch::Approx(e.mahalanobisSquared(ufo::Vec3d(0, 2, 3))));
+	REQUIRE(1.0 == Catch::Approx(e.mahalanobisSquared(ufo::Vec3d(1, 2, 3.5))));
+	REQUIRE(0.0 == Catch::Approx(ufo::min(e).x));
+	REQUIRE(0.0 == Catch::Approx(ufo::min(e).y));
+	REQUIRE(2.5 == Catch::Approx(ufo::min(e).z));
+	REQUIRE(4.0 == Catch::Approx(ufo::max(e).y));
+
+	// The same ellipsoid from a covariance and a gate of 2
+	ufo::Mat<3, 3, double> cov(0.0);
+	cov[0][0] = 0.25;
+	cov[1][1] = 1.0;
+	cov[2][2] = 0.0625;
+	ufo::Ellipsoid3d g(ufo::Vec3d(1, 2, 3), cov, 2.0);
+	for (auto p : {ufo::Vec3d(1, 4, 3), ufo::Vec3d(1.5, 2.5, 3.1), ufo::Vec3d(3, 3, 3)}) {
+		REQUIRE(e.mahalanobisSquared(p) == Catch::Approx(g.mahalanobisSquared(p)));
+	}
+}
+
+TEST_CASE("[Ellipsoid] AABB")
+{
+	ufo::Ellipsoid3d e(ufo::Vec3d(0, 0, 0), ufo::Vec3d(3, 1, 0.5), rotationZ(0.6));
+
+	// The box is inside the AABB of the ellipsoid, but not inside the ellipsoid
+	ufo::AABB3d corner(ufo::Vec3d(1.5, -1.9, -0.1), ufo::Vec3d(2.0, -1.4, 0.1));
+	REQUIRE(ufo::intersects(ufo::AABB3d(ufo::min(e), ufo::max(e)), corner));
+	REQUIRE_FALSE(ufo::intersects(e, corner));
+	REQUIRE(ufo::intersects(e, ufo::AABB3d(ufo::Vec3d(2, 1, -1), ufo::Vec3d(3, 2, 1))));
+	REQUIRE(ufo::contains(e, ufo::AABB3d(ufo::Vec3d(-0.2), ufo::Vec3d(0.2))));
+	REQUIRE_FALSE(ufo::contains(e, ufo::AABB3d(ufo::Vec3d(-0.6), ufo::Vec3d(0.6))));
+
+	// Compare against a dense sampling of random boxes
+	std::mt19937                           gen(11);
+	std::uniform_real_distribution<double> pos(-3.5, 3.5);
+	std::uniform_real_distribution<double> size(0.1, 1.5);
+	for (int i{}; 50 > i; ++i) {
+		ufo::Vec3d lo(pos(gen), pos(gen), pos(gen));
+		ufo::Vec3d hi = lo + ufo::Vec3d(size(gen), size(gen), size(gen));
+
+		double    sampled = std::numeric_limits<double>::max();
+		int const n       = 40;
+		for (int x{}; n >= x; ++x) {
+			for (int y{}; n >= y; ++y) {
+				for (int z{}; n >= z; ++z) {
+					ufo::Vec3d p = lo + (hi - lo) * ufo::Vec3d(x, y, z) / double(n);
+					sampled      = std::min(sampled, e.mahalanobisSquared(p));
+				}
+			}
+		}
+
+		double exact = e.mahalanobisSquared(ufo::AABB3d(lo, hi));
+		REQUIRE(exact <= sampled + 1e-9);
+		REQUIRE(exact == Catch::Approx(sampled).epsilon(0.05).margin(0.02));
+	}
+}
+
+TEST_CASE("[Ellipsoid] Gating")
+{
+	ufo::Ellipsoid2f e(ufo::Vec2f(1, 1), ufo::Vec2f(2, 1));
+
+	std::vector<ufo::Vec2f> points{ufo::Vec2f(1, 1), ufo::Vec2f(2.9f, 1),
+	                               ufo::Vec2f(3.1f, 1), ufo::Vec2f(1, 2.1f)};
+	std::vector<char>       in(points.size());
+	ufo::contains(std::execution::par, e, points.begin(), points.end(), in.begin());
+	REQUIRE(std::vector<char>{1, 1, 0, 0} == in);
+
+	std::vector<float> d(points.size());
+	ufo::mahalanobisSquared(e, points.begin(), points.end(), d.begin());
+	REQUIRE(0.0f == d[0]);
+	REQUIRE(1.21f == Catch::Approx(d[3]));
+}
@@ -1,11 +1,14 @@
 // UFO
 #include <ufo/geometry/frustum.hpp>
 #include <ufo/geometry/fun.hpp>
+#include <ufo/geometry/transform.hpp>
 #include <ufo/math/vec.hpp>
 
 // STL
 #include <array>
+#include <cmath>
 #include <iostream>
+#include <utility>
 
 // Catch2
 #include <catch2/catch_approx.hpp>
@@ -140,4 +143,78 @@ TEST_CASE("[Frustum] Constructor")
 		REQUIRE(cs[3].x == Catch::Approx(expected[3].x));
 		REQUIRE(cs[3].y == Catch::Approx(expected[3].y));
 	}
-}
\ No newline at end of file
+}
+
+namespace
+{
+void requirePlanes(ufo::Frustum3d const& a, ufo::Frustum3d const& b)
+{
+	for (auto [p, q] : {std::pair{a.top, b.top}, std::pair{a.bottom, b.bottom},
+	                    std::pair{a.left, b.left}, std::pair{a.right, b.right},
+	                    std::pair{a.near, b.near}, std::pair{a.far, b.far}}) {
+		REQUIRE(0.0 == Catch::Approx(ufo::norm(p.normal - q.normal)).margin(1e-9));
+		REQUIRE(p.distance == Catch::Approx(q.distance).margin(1e-9));
+	}
+}
+
+// OpenGL style perspective projection with a square image, looking down -z
+ufo::Mat4x4d perspective(double fov, double near, double far, bool zero_to_one)
+{
+	double const f = 1.0 / std::tan(fov / 2);
+
+	ufo::Mat4x4d m(0.0);
+	m[0][0] = f;
+	m[1][1] = f;
+	m[2][3] = -1;
+	if (zero_to_one) {
+		m[2][2] = far / (near - far);
+		m[3][2] = near * far / (near - far);
+	} else {
+		m[2][2] = (far + near) / (near - far);
+		m[3][2] = 2 * far * near / (near - far);
+	}
+	return m;
+}
+}  // namespace
+
+TEST_CASE("[Frustum] Projection and intrinsics")
+{
+	double const   fov = ufo::radians(70.0);
+	ufo::Frustum3d expected(ufo::Vec3d(0, 0, 0), ufo::Vec3d(0, 0, -1), ufo::Vec3d(0, 1, 0),
+	                        fov, fov, 0.5, 20.0);
+
+	requirePlanes(expected, ufo::Frustum3d(perspective(fov, 0.5, 20.0, false)));
+	requirePlanes(expected, ufo::Frustum3d(perspective(fov, 0.5, 20.0, true), true));
+
+	// A 90 degree pinhole camera with y down and z forward
+	ufo::Frustum3d pinhole(50.0, 50.0, 50.0, 50.0, 100.0, 100.0, 0.5, 20.0);
+	requirePlanes(ufo::Frustum3d(ufo::Vec3d(0, 0, 0), ufo::Vec3d(0, 0, 1),
+	                             ufo::Vec3d(0, -1, 0), ufo::radians(90.0),
+	                             ufo::radians(90.0), 0.5, 20.0),
+	              pinhole);
+
+	// The camera at a pose, from the view-projection matrix and by moving the planes
+	ufo::Mat3x3d r;
+	r[0] = ufo::Vec3d(0, 1, 0);
+	r[1] = ufo::Vec3d(-1, 0, 0);
+	r[2] = ufo::Vec3d(0, 0, 1);
+	ufo::Vec3d t(1, -2, 3);
+
+	ufo::Mat4x4d pose;
+	ufo::Mat4x4d view;
+	for (std::size_t i{}; 3 > i; ++i) {
+		for (std::size_t j{}; 3 > j; ++j) {
+			pose[i][j] = r[i][j];
+			view[i][j] = r[j][i];
+		}
+		pose[3][i] = t[i];
+		view[3][i] = -ufo::dot(r[i], t);
+	}
+
+	auto const moved = ufo::transform(expected, pose);
+	requirePlanes(moved, ufo::transform(expected, r, t));
+	requirePlanes(moved, ufo::Frustum3d(perspective(fov, 0.5, 20.0, false) * view));
+	requirePlanes(ufo::Frustum3d(ufo::Vec3d(1, -2, 3), ufo::Vec3d(1, -2, 2),
+	                             ufo::Vec3d(-1, 0, 0), fov, fov, 0.5, 20.0),
+	              moved);
+}
@@ -0,0 +1,208 @@
+// UFO
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/instanced_bvh.hpp>
+#include <ufo/geometry/intersects.hpp>
+#include <ufo/geometry/transform.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <limits>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// Test
+#include "test_helpers.hpp"
+
+namespace
+{
+using ufo::test::rotation;
+
+using Instance = ufo::InstancedBVH<ufo::Sphere3d>::Instance;
+using Hit      = std::pair<std::size_t, std::size_t>;
+
+std::vector<ufo::Sphere3d> spheres(std::mt19937& gen, ufo::Vec3d extent, int n)
+{
+	std::uniform_real_distribution<double> unit(0, 1);
+	std::uniform_real_distribution<double> radius(0.02, 0.2);
+	std::vector<ufo::Sphere3d>             res;
+	for (int i{}; n > i; ++i) {
+		ufo::Vec3d c(unit(gen) * extent.x, unit(gen) * extent.y, unit(gen) * extent.z);
+		res.emplace_back(c, radius(gen));
+	}
+	return res;
+}
+
+// Every instance copied into the world, the brute force reference
+std::vector<std::pair<Hit, ufo::Sphere3d>> flatten(
+    ufo::InstancedBVH<ufo::Sphere3d> const& scene)
+{
+	std::vector<std::pair<Hit, ufo::Sphere3d>> res;
+	for (std::size_t i{}; scene.size() > i; ++i) {
+		auto const& a = scene.instances()[i];
+		for (std::size_t j{}; a.shape->size() > j; ++j) {
+			auto const& g = a.shape->geometry()[j];
+			res.emplace_back(Hit(i, a.shape->index()[j]),
+			                 ufo::transform(g, a.rotation, a.translation));
+		}
+	}
+	return res;
+}
+
+template <class Query>
+void checkQuery(ufo::InstancedBVH<ufo::Sphere3d> const&           scene,
+                std::vector<std::pair<Hit, ufo::Sphere3d>> const& world,
+                Query const&                                      query)
+{
+	std::vector<Hit> hits;
+	scene.intersects(query, std::back_inserter(hits));
+	std::sort(hits.begin(), hits.end());
+
+	std::vector<Hit> expected;
+	for (auto const& [hit, g] : world) {
+		if (ufo::intersects(g, query)) {
+			expected.push_back(hit);
+		}
+	}
+	std::sort(expected.begin(), expected.end());
+	REQUIRE(expected == hits);
+}
+}  // namespace
+
+TEST_CASE("[Instanced BVH] Queries")
+{
+	std::mt19937                           gen(17);
+	std::uniform_real_distribution<double> pos(-40, 40);
+
+	// Two shapes shared by all instances
+	auto const rack   = spheres(gen, ufo::Vec3d(4, 1, 3), 400);
+	auto const pallet = spheres(gen, ufo::Vec3d(1.2, 1, 0.2), 50);
+	std::vector<std::shared_ptr<ufo::BVH<ufo::Sphere3d> const>> shapes{
+	    std::make_shared<ufo::BVH<ufo::Sphere3d> const>(std::execution::par, rack.begin(),
+	                                                    rack.end()),
+	    std::make_shared<ufo::BVH<ufo::Sphere3d> const>(pallet.begin(), pallet.end())};
+
+	std::vector<Instance> instances;
+	for (int i{}; 300 > i; ++i) {
+		instances.push_back({shapes[i % 2], rotation(gen),
+		                     ufo::Vec3d(pos(gen), pos(gen), pos(gen) / 8)});
+	}
+
+	ufo::InstancedBVH<ufo::Sphere3d> scene(instances.begin(), instances.end());
+	ufo::InstancedBVH<ufo::Sphere3d> par(std::execution::par, instances.begin(),
+	                                     instances.end(), ufo::BVHBuild::LBVH);
+	REQUIRE(instances.size() == scene.size());
+	REQUIRE(shapes[1] == par.instances()[1].shape);
+
+	auto const check = [&](ufo::InstancedBVH<ufo::Sphere3d> const& s) {
+		auto const world = flatten(s);
+		for (auto const& [hit, g] : world) {
+			for (std::size_t i{}; 3 > i; ++i) {
+				REQUIRE(s.bounds().min[i] <= g.center[i] - g.radius + 1e-9);
+				REQUIRE(s.bounds().max[i] >= g.center[i] + g.radius - 1e-9);
+			}
+		}
+
+		for (int i{}; 30 > i; ++i) {
+			ufo::Vec3d c(pos(gen), pos(gen), pos(gen) / 8);
+			checkQuery(s, world, ufo::Sphere3d(c, 2.0));
+			checkQuery(s, world, ufo::AABB3d(c - 1.5, c + 1.5));
+
+			auto const nearest = s.nearest(c);
+			double     d       = std::numeric_limits<double>::infinity();
+			Hit        closest;
+			for (auto const& [hit, g] : world) {
+				if (double e = ufo::distance(g, c); e < d) {
+					d       = e;
+					closest = hit;
+				}
+			}
+			REQUIRE(d == Catch::Approx(nearest.distance).margin(1e-9));
+			REQUIRE(closest == Hit(nearest.instance, nearest.index));
+
+			// Nothing closer than the closest
+			auto const none = s.nearest(c, 0.999 * d);
+			REQUIRE(s.size() == none.instance);
+			REQUIRE(ufo::InstancedBVH<ufo::Sphere3d>::npos == none.index);
+			REQUIRE(0.999 * d == none.distance);
+		}
+	};
+	check(scene);
+	check(par);
+
+	// Moving instances only touches the top level
+	for (std::size_t i{}; scene.size() > i; i += 3) {
+		scene.setTransform(i, rotation(gen), ufo::Vec3d(pos(gen), pos(gen), pos(gen) / 8));
+	}
+	scene.refit(std::execution::par);
+	check(scene);
+	scene.restructure();
+	check(scene);
+
+	ufo::InstancedBVH<ufo::Sphere3d> empty;
+	REQUIRE(empty.empty());
+	REQUIRE(0 == empty.nearest(ufo::Vec3d()).instance);
+	REQUIRE(ufo::InstancedBVH<ufo::Sphere3d>::npos == empty.nearest(ufo::Vec3d()).index);
+}
+
+TEST_CASE("[Instanced BVH] Empty shapes")
+{
+	std::mt19937                           gen(29);
+	std::uniform_real_distribution<double> pos(-10, 10);
+
+	auto const crate = spheres(gen, ufo::Vec3d(1, 1, 1), 20);
+	auto const full  =
+	    std::make_shared<ufo::BVH<ufo::Sphere3d> const>(crate.begin(), crate.end());
+	auto const none  = std::make_shared<ufo::BVH<ufo::Sphere3d> const>();
+
+	std::vector<Instance> instances;
+	for (int i{}; 40 > i; ++i) {
+		ufo::Vec3d const t(pos(gen), pos(gen), pos(gen));
+		instances.push_back({0 == i % 3 ? full : none, rotation(gen), t});
+	}
+
+	ufo::InstancedBVH<ufo::Sphere3d> scene(instances.begin(), instances.end());
+	REQUIRE(14 == scene.top().size());
+	REQUIRE(3 == scene.topInstances()[1]);
+	for (std::size_t i{}; 3 > i; ++i) {
+		REQUIRE(std::isfinite(scene.bounds().min[i]));
+		REQUIRE(std::isfinite(scene.bounds().max[i]));
+	}
+
+	auto const check = [&] {
+		auto const world = flatten(scene);
+		for (int i{}; 30 > i; ++i) {
+			ufo::Vec3d c(pos(gen), pos(gen), pos(gen));
+			checkQuery(scene, world, ufo::Sphere3d(c, 3.0));
+
+			auto const nearest = scene.nearest(c);
+			double     d       = std::numeric_limits<double>::infinity();
+			for (auto const& [hit, g] : world) {
+				d = std::min(d, ufo::distance(g, c));
+			}
+			REQUIRE(0 == nearest.instance % 3);
+			REQUIRE(d == Catch::Approx(nearest.distance).margin(1e-9));
+		}
+	};
+	check();
+
+	for (std::size_t i{}; scene.size() > i; i += 2) {
+		scene.setTransform(i, rotation(gen), ufo::Vec3d(pos(gen), pos(gen), pos(gen)));
+	}
+	scene.refit();
+	check();
+
+	// Only empty instances
+	ufo::InstancedBVH<ufo::Sphere3d> hollow{{none, rotation(gen), ufo::Vec3d(1, 2, 3)}};
+	REQUIRE(1 == hollow.size());
+	REQUIRE(hollow.top().empty());
+	REQUIRE(1 == hollow.nearest(ufo::Vec3d()).instance);
+	REQUIRE(ufo::InstancedBVH<ufo::Sphere3d>::npos == hollow.nearest(ufo::Vec3d()).index);
+}
@@ -0,0 +1,147 @@
+// UFO
+#include <ufo/geometry/kd_tree.hpp>
+
+// STL
+#include <algorithm>
+#include <execution>
+#include <iterator>
+#include <random>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// Test
+#include "test_helpers.hpp"
+
+namespace
+{
+using Tree     = ufo::KDTree<3, double>;
+using Neighbor = Tree::Neighbor;
+
+std::vector<std::size_t> sorted(std::vector<std::size_t> v)
+{
+	std::sort(v.begin(), v.end());
+	return v;
+}
+
+void checkTree(Tree const& tree, std::vector<ufo::Vec3d> const& points)
+{
+	REQUIRE(points.size() == tree.size());
+
+	std::mt19937                           gen(5);
+	std::uniform_real_distribution<double> pos(-12, 12);
+	std::uniform_real_distribution<double> size(0.1, 3);
+
+	std::vector<std::size_t> res;
+	std::vector<Neighbor>    neighbors;
+	std::vector<Neighbor>    buffer(20);
+	for (int i{}; 50 > i; ++i) {
+		ufo::Vec3d    q(pos(gen), pos(gen), pos(gen));
+		ufo::Vec3d    h(size(gen), size(gen), size(gen));
+		ufo::Sphere3d sphere(q, h.x);
+		ufo::AABB3d   box(q - h, q + h);
+
+		std::vector<std::size_t> in_sphere;
+		std::vector<std::size_t> in_box;
+		std::vector<Neighbor>    all;
+		for (std::size_t j{}; points.size() > j; ++j) {
+			if (ufo::distanceSquared(points[j], q) <= h.x * h.x) {
+				in_sphere.push_back(j);
+			}
+			if (ufo::intersects(box, points[j])) {
+				in_box.push_back(j);
+			}
+			all.push_back({j, ufo::distanceSquared(points[j], q)});
+		}
+		std::sort(all.begin(), all.end(), [](Neighbor const& a, Neighbor const& b) {
+			return a.distance_squared < b.distance_squared ||
+			       (a.distance_squared == b.distance_squared && a.index < b.index);
+		});
+
+		res.clear();
+		tree.intersects(sphere, std::back_inserter(res));
+		REQUIRE(sorted(res) == in_sphere);
+
+		res.clear();
+		tree.intersects(box, std::back_inserter(res));
+		REQUIRE(sorted(res) == in_box);
+
+		neighbors.clear();
+		tree.radius(q, h.x, std::back_inserter(neighbors));
+		REQUIRE(in_sphere.size() == neighbors.size());
+		for (auto const& n : neighbors) {
+			REQUIRE(ufo::distanceSquared(points[n.index], q) == n.distance_squared);
+			REQUIRE(std::binary_search(in_sphere.begin(), in_sphere.end(), n.index));
+		}
+
+		for (std::size_t k : {1, 5, 20}) {
+			REQUIRE(std::min(k, points.size()) == tree.nearest(q, k, buffer.begin()));
+			for (std::size_t j{}; std::min(k, points.size()) > j; ++j) {
+				REQUIRE(all[j].distance_squared == buffer[j].distance_squared);
+			}
+		}
+
+		// Only the neighbors closer than `max`
+		if (5 < all.size() && all[4].distance_squared < all[5].distance_squared) {
+			double const max = (std::sqrt(all[4].distance_squared) +
+			                    std::sqrt(all[5].distance_squared)) /
+			                   2;
+			auto const   count = tree.nearest(q, 20, buffer.data(), max);
+			REQUIRE(5 == count);
+			for (std::size_t j{}; count > j; ++j) {
+				REQUIRE(all[j].distance_squared == buffer[j].distance_squared);
+			}
+		}
+
+		auto const [index, d] = tree.nearest(q);
+		REQUIRE(all[0].distance_squared == ufo::distanceSquared(points[index], q));
+		REQUIRE(std::sqrt(all[0].distance_squared) == d);
+		REQUIRE(Tree::NO_INDEX == tree.nearest(q, 0.999 * d).first);
+	}
+}
+}  // namespace
+
+TEST_CASE("[KD-tree] Queries")
+{
+	auto const points = ufo::test::randomPoints(3000, -10.0, 10.0, 1);
+	checkTree(Tree(points.begin(), points.end()), points);
+	checkTree(Tree(points.begin(), points.end(), 1), points);
+	checkTree(Tree(points.begin(), points.begin() + 3), {points[0], points[1], points[2]});
+
+	Tree par(std::execution::par, points.begin(), points.end(), 4);
+	REQUIRE(4 == par.leafSize());
+	checkTree(par, points);
+
+	auto const many = ufo::test::randomPoints(50000, -10.0, 10.0, 2);
+	checkTree(Tree(std::execution::par, many.begin(), many.end()), many);
+
+	// Duplicates and a flat cloud
+	std::vector<ufo::Vec3d> flat(points);
+	for (auto& p : flat) {
+		p.z = 0;
+		p.x = std::round(p.x);
+	}
+	checkTree(Tree(flat.begin(), flat.end(), 2), flat);
+}
+
+TEST_CASE("[KD-tree] Empty")
+{
+	Tree                  tree;
+	std::vector<Neighbor> buffer(4);
+	REQUIRE(tree.empty());
+	REQUIRE(0 == tree.nearest(ufo::Vec3d(0), 4, buffer.begin()));
+	REQUIRE(Tree::NO_INDEX == tree.nearest(ufo::Vec3d(0)).first);
+
+	std::vector<std::size_t> res;
+	tree.intersects(ufo::Sphere3d(ufo::Vec3d(0), 1), std::back_inserter(res));
+	REQUIRE(res.empty());
+
+	ufo::KDTree<2, float> small{ufo::Vec2f(0, 0), ufo::Vec2f(1, 0), ufo::Vec2f(0, 2)};
+	REQUIRE(1 == small.nearest(ufo::Vec2f(0.9f, 0.2f)).first);
+	std::vector<ufo::KDTree<2, float>::Neighbor> two(2);
+	REQUIRE(0 == small.nearest(ufo::Vec2f(0, 0), 0, two.begin()));
+	REQUIRE(2 == small.nearest(ufo::Vec2f(0, 0), 2, two.begin()));
+	REQUIRE(0 == two[0].index);
+	REQUIRE(1 == two[1].index);
+}
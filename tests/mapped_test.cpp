@@ -0,0 +1,161 @@
+// UFO
+#include <ufo/geometry/mapped.hpp>
+
+// STL
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("[Mapped] Write and map")
+{
+	std::vector<ufo::AABB3f>   aabbs;
+	std::vector<ufo::Sphere3d> spheres;
+	for (int i{}; 100 > i; ++i) {
+		aabbs.emplace_back(ufo::Vec3f(i, i, i), ufo::Vec3f(i + 1, i + 2, i + 3));
+		spheres.emplace_back(ufo::Vec3d(-i, i, 0), 0.5 * i);
+	}
+
+	auto file = std::filesystem::temp_directory_path() / "ufogeometry_mapped_test.ufog";
+
+	ufo::MappedWriter writer;
+	writer.add(aabbs);
+	writer.add(spheres.begin(), spheres.end(), 7);
+	writer.write(file);
+
+	ufo::MappedGeometry mapped(file);
+	REQUIRE(mapped.isOpen());
+	REQUIRE(2 == mapped.numSections());
+	REQUIRE(ufo::MappedType::AABB == mapped.type(0));
+	REQUIRE(ufo::MappedType::SPHERE == mapped.type(1));
+	REQUIRE(7 == mapped.tag(1));
+
+	SECTION("Types are checked")
+	{
+		REQUIRE(mapped.holds<ufo::AABB3f>(0));
+		REQUIRE_FALSE(mapped.holds<ufo::AABB3d>(0));
+		REQUIRE_FALSE(mapped.holds<ufo::AABB2f>(0));
+		REQUIRE_FALSE(mapped.holds<ufo::Sphere3f>(1));
+		REQUIRE_THROWS(mapped.get<ufo::Sphere3f>(1));
+		REQUIRE(mapped.find<ufo::Sphere3d>().empty());
+	}
+
+	SECTION("Data is used in place")
+	{
+		auto a = mapped.get<ufo::AABB3f>(0);
+		auto s = mapped.find<ufo::Sphere3d>(7);
+		REQUIRE(aabbs.size() == a.size());
+		REQUIRE(spheres.size() == s.size());
+		REQUIRE(0 == reinterpret_cast<std::uintptr_t>(a.data()) % 64);
+		for (std::size_t i{}; aabbs.size() > i; ++i) {
+			REQUIRE(aabbs[i].min == a[i].min);
+			REQUIRE(aabbs[i].max == a[i].max);
+			REQUIRE(spheres[i] == s[i]);
+		}
+	}
+
+	mapped.close();
+	std::filesystem::remove(file);
+}
+
+TEST_CASE("[Mapped] Reject invalid data")
+{
+	std::vector<unsigned char> garbage(256, 0xAB);
+	REQUIRE_THROWS(ufo::MappedGeometry(garbage.data(), garbage.size()));
+}
+
+TEST_CASE("[Mapped] Reject sizes that wrap around")
+{
+	std::vector<ufo::AABB3f> aabbs(10);
+
+	ufo::MappedWriter  writer;
+	std::ostringstream out;
+	writer.add(aabbs);
+	writer.write(out);
+	std::string const file = out.str();
+
+	// Copied into 8 byte words so the section data stays aligned
+	std::vector<std::uint64_t> words((file.size() + 7) / 8);
+	auto                       bytes = reinterpret_cast<unsigned char*>(words.data());
+	std::memcpy(bytes, file.data(), file.size());
+
+	auto& header  = *reinterpret_cast<ufo::detail::MappedHeader*>(bytes);
+	auto& section = *reinterpret_cast<ufo::detail::MappedSection*>(
+	    bytes + sizeof(ufo::detail::MappedHeader));
+
+	REQUIRE_NOTHROW(ufo::MappedGeometry(bytes, file.size()));
+
+	SECTION("Section count")
+	{
+		// 24 bytes times 2^61 elements is 0 modulo 2^64
+		REQUIRE(24 == section.element_size);
+		section.count = std::uint64_t(1) << 61;
+		REQUIRE_THROWS(ufo::MappedGeometry(bytes, file.size()));
+	}
+
+	SECTION("Section offset")
+	{
+		section.offset = std::numeric_limits<std::uint64_t>::max() - 7;
+		REQUIRE_THROWS(ufo::MappedGeometry(bytes, file.size()));
+	}
+
+	SECTION("Element size")
+	{
+		section.element_size = 0;
+		REQUIRE_THROWS(ufo::MappedGeometry(bytes, file.size()));
+	}
+
+	SECTION("Section table")
+	{
+		header.section_offset = std::numeric_limits<std::uint64_t>::max() - 31;
+		REQUIRE_THROWS(ufo::MappedGeometry(bytes, file.size()));
+	}
+}
+
+TEST_CASE("[Mapped] Shapes of the same layout are told apart")
+{
+	// Cylinder and Cone are both two points and a radius
+	STATIC_REQUIRE(sizeof(ufo::Cylinder<3, float>) == sizeof(ufo::Cone<3, float>));
+	STATIC_REQUIRE(ufo::MappedType::CYLINDER ==
+	               ufo::mapped_type_v<ufo::Cylinder<3, float>>);
+	STATIC_REQUIRE(ufo::MappedType::CONE == ufo::mapped_type_v<ufo::Cone<3, float>>);
+	STATIC_REQUIRE(ufo::MappedType::ELLIPSOID ==
+	               ufo::mapped_type_v<ufo::Ellipsoid<2, double>>);
+	STATIC_REQUIRE(ufo::MappedType::SPHERICAL_SECTOR ==
+	               ufo::mapped_type_v<ufo::SphericalSector<float>>);
+	STATIC_REQUIRE(ufo::MappedType::NONE == ufo::mapped_type_v<int>);
+
+	std::vector<ufo::Cylinder<3, float>> cylinders{
+	    {ufo::Vec3f(0, 0, 0), ufo::Vec3f(0, 0, 1), 0.5f}};
+	std::vector<ufo::Ellipsoid<3, float>> ellipsoids{
+	    {ufo::Vec3f(1, 2, 3), ufo::Vec3f(0.5f, 1, 2)}};
+	std::vector<ufo::SphericalSector<float>> sectors{
+	    {ufo::Vec3f(1, 0, 0), -1.0f, 1.0f, -0.5f, 0.5f, 0.1f, 10.0f}};
+
+	ufo::MappedWriter  writer;
+	std::ostringstream out;
+	writer.add(cylinders);
+	writer.add(ellipsoids);
+	writer.add(sectors);
+	writer.write(out);
+	std::string const file = out.str();
+
+	std::vector<std::uint64_t> words((file.size() + 7) / 8);
+	std::memcpy(words.data(), file.data(), file.size());
+	ufo::MappedGeometry mapped(words.data(), file.size());
+
+	REQUIRE(mapped.holds<ufo::Cylinder<3, float>>(0));
+	REQUIRE_FALSE(mapped.holds<ufo::Cone<3, float>>(0));
+	REQUIRE_THROWS(mapped.get<ufo::Cone<3, float>>(0));
+	REQUIRE(mapped.find<ufo::Cone<3, float>>().empty());
+	REQUIRE(cylinders[0] == mapped.get<ufo::Cylinder<3, float>>(0)[0]);
+	REQUIRE(ellipsoids[0] == mapped.get<ufo::Ellipsoid<3, float>>(1)[0]);
+	REQUIRE(sectors[0] == mapped.find<ufo::SphericalSector<float>>()[0]);
+}
@@ -0,0 +1,270 @@
+// UFO
+#include <ufo/geometry/paged_rtree.hpp>
+
+// STL
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <execution>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+using Tree   = ufo::PagedRTree<3, double>;
+using Record = Tree::Record;
+
+std::vector<Record> randomRecords(std::size_t n)
+{
+	std::mt19937                           gen(17);
+	std::uniform_real_distribution<double> pos(-100, 100);
+	std::uniform_real_distribution<double> size(0.1, 2);
+	std::vector<Record>                    res;
+	for (std::size_t i{}; n > i; ++i) {
+		ufo::Vec3d min(pos(gen), pos(gen), pos(gen));
+		res.push_back({ufo::AABB3d(min, min + ufo::Vec3d(size(gen), size(gen), size(gen))),
+		               1000 + i});
+	}
+	return res;
+}
+
+template <class F>
+std::vector<Tree::id_type> bruteForce(std::vector<Record> const& records, F f)
+{
+	std::vector<Tree::id_type> res;
+	for (auto const& r : records) {
+		if (f(r.bounds)) {
+			res.push_back(r.id);
+		}
+	}
+	return res;
+}
+
+std::vector<Tree::id_type> sorted(std::vector<Tree::id_type> v)
+{
+	std::sort(v.begin(), v.end());
+	return v;
+}
+}  // namespace
+
+TEST_CASE("[Paged R-tree] Queries")
+{
+	auto const records = randomRecords(20000);
+	auto const file =
+	    std::filesystem::temp_directory_path() / "ufogeometry_paged_rtree_test.ufor";
+
+	Tree::write(std::execution::par, file, records.begin(), records.end());
+
+	Tree tree(file, 64);
+	REQUIRE(tree.isOpen());
+	REQUIRE(records.size() == tree.size());
+	REQUIRE(Tree::DEFAULT_PAGE_SIZE == tree.pageSize());
+	REQUIRE(Tree::DEFAULT_PAGE_SIZE * tree.numPages() ==
+	        std::filesystem::file_size(file));
+	// STR fills every page but the last of each level
+	std::size_t const capacity = Tree::pageCapacity();
+	std::size_t const leaves   = (records.size() + capacity - 1) / capacity;
+	REQUIRE(3 == tree.height());
+	REQUIRE(leaves + 2 + (leaves + capacity - 1) / capacity == tree.numPages());
+	for (auto const& r : records) {
+		REQUIRE(ufo::contains(tree.bounds(), r.bounds));
+	}
+
+	std::mt19937                           gen(3);
+	std::uniform_real_distribution<double> pos(-110, 110);
+	std::uniform_real_distribution<double> size(1, 10);
+	for (int i{}; 100 > i; ++i) {
+		ufo::Vec3d    c(pos(gen), pos(gen), pos(gen));
+		ufo::Vec3d    h(size(gen), size(gen), size(gen));
+		ufo::AABB3d   box(c - h, c + h);
+		ufo::Sphere3d sphere(c, h.x);
+
+		std::vector<Tree::id_type> res;
+		tree.intersects(box, std::back_inserter(res));
+		REQUIRE(sorted(res) == bruteForce(records, [&box](ufo::AABB3d const& b) {
+			        return ufo::intersects(b, box);
+		        }));
+
+		res.clear();
+		tree.intersects(sphere, std::back_inserter(res));
+		REQUIRE(sorted(res) == bruteForce(records, [&sphere](ufo::AABB3d const& b) {
+			        return ufo::intersects(b, sphere);
+		        }));
+
+		res.clear();
+		tree.contains(box, std::back_inserter(res));
+		REQUIRE(sorted(res) == bruteForce(records, [&box](ufo::AABB3d const& b) {
+			        return ufo::contains(box, b);
+		        }));
+
+		res.clear();
+		tree.distanceWithin(c, h.y, std::back_inserter(res));
+		REQUIRE(sorted(res) == bruteForce(records, [&c, &h](ufo::AABB3d const& b) {
+			        return ufo::distance(b, c) <= h.y;
+		        }));
+
+		double best = std::numeric_limits<double>::infinity();
+		for (auto const& r : records) {
+			best = std::min(best, ufo::distance(r.bounds, c));
+		}
+		auto const [id, d] = tree.nearest(c);
+		REQUIRE(best == Catch::Approx(d));
+		REQUIRE(d == Catch::Approx(ufo::distance(records[id - 1000].bounds, c)));
+
+		auto const none = tree.nearest(c, 0.999 * best);
+		REQUIRE(Tree::NO_ID == none.first);
+	}
+
+	// A small query only reads the pages on the paths to its records
+	Tree cold(file, 16);
+	cold.resetLoads();
+	std::vector<Tree::id_type> res;
+	ufo::AABB3d                box(ufo::Vec3d(-5), ufo::Vec3d(5));
+	cold.intersects(box, std::back_inserter(res));
+	REQUIRE(!res.empty());
+	REQUIRE(cold.numPages() / 10 > cold.loads());
+	REQUIRE(16 == cold.cachePages());
+
+	// Repeating it hits the cache, unless the cache is smaller than the query
+	std::size_t const loads = cold.loads();
+	cold.intersects(box, std::back_inserter(res));
+	if (16 >= loads) {
+		REQUIRE(loads == cold.loads());
+	}
+
+	// The answers do not depend on the cache size
+	Tree tiny(file, 1);
+	for (int i{}; 20 > i; ++i) {
+		ufo::Vec3d c(pos(gen), pos(gen), pos(gen));
+		REQUIRE(tree.nearest(c) == tiny.nearest(c));
+
+		std::vector<Tree::id_type> a;
+		std::vector<Tree::id_type> b;
+		ufo::Sphere3d              sphere(c, 15);
+		tree.intersects(sphere, std::back_inserter(a));
+		tiny.intersects(sphere, std::back_inserter(b));
+		REQUIRE(sorted(a) == sorted(b));
+	}
+
+	Tree moved(std::move(tiny));
+	REQUIRE(records.size() == moved.size());
+	REQUIRE(moved.nearest(ufo::Vec3d(0)) == tree.nearest(ufo::Vec3d(0)));
+
+	tree.close();
+	cold.close();
+	moved.close();
+	std::filesystem::remove(file);
+}
+
+TEST_CASE("[Paged R-tree] Formats")
+{
+	auto const file =
+	    std::filesystem::temp_directory_path() / "ufogeometry_paged_rtree_format.ufor";
+
+	// Empty
+	std::vector<Record> none;
+	Tree::write(file, none.begin(), none.end());
+	Tree empty(file);
+	REQUIRE(empty.empty());
+	REQUIRE(0 == empty.height());
+	REQUIRE(Tree::NO_ID == empty.nearest(ufo::Vec3d(0)).first);
+	empty.close();
+
+	// Small pages give a deep tree
+	auto const records = randomRecords(500);
+	Tree::write(file, records.begin(), records.end(), 256);
+	Tree deep(file, 4);
+	REQUIRE(256 == deep.pageSize());
+	REQUIRE(3 < deep.height());
+	std::vector<Tree::id_type> res;
+	deep.intersects(deep.bounds(), std::back_inserter(res));
+	REQUIRE(records.size() == res.size());
+	deep.close();
+
+	// Wrong dimension, scalar, and file type
+	REQUIRE_THROWS(ufo::PagedRTree<2, double>(file));
+	REQUIRE_THROWS(ufo::PagedRTree<3, float>(file));
+	REQUIRE_THROWS(Tree::write(file, records.begin(), records.end(), 64));
+	{
+		std::ofstream out(file, std::ios::binary | std::ios::trunc);
+		out << "not a tree, but long enough to hold a header of sixty-four bytes.....";
+	}
+	REQUIRE_THROWS(Tree(file));
+
+	std::filesystem::remove(file);
+}
+
+TEST_CASE("[Paged R-tree] Corrupt pages")
+{
+	auto const file =
+	    std::filesystem::temp_directory_path() / "ufogeometry_paged_rtree_corrupt.ufor";
+
+	auto const records = randomRecords(500);
+	Tree::write(file, records.begin(), records.end(), 256);
+
+	std::vector<char> bytes(std::filesystem::file_size(file));
+	std::ifstream(file, std::ios::binary).read(bytes.data(), bytes.size());
+
+	ufo::detail::RTreeHeader h;
+	std::memcpy(&h, bytes.data(), sizeof(h));
+	REQUIRE(2 < h.height);
+
+	std::size_t const root     = h.root * h.page_size;
+	std::size_t const entries  = ufo::detail::alignUp(sizeof(ufo::detail::RTreePageHeader),
+	                                                  alignof(Record));
+	std::size_t const child_id = root + entries + offsetof(Record, id);
+
+	std::uint64_t child;
+	std::memcpy(&child, bytes.data() + child_id, sizeof(child));
+
+	// Writes `bytes` with `value` at `pos` and returns whether opening and querying the
+	// tree throws
+	auto const fails = [&](std::size_t pos, auto value) {
+		auto copy = bytes;
+		std::memcpy(copy.data() + pos, &value, sizeof(value));
+		std::ofstream(file, std::ios::binary | std::ios::trunc)
+		    .write(copy.data(), copy.size());
+		try {
+			Tree                       tree(file);
+			std::vector<Tree::id_type> res;
+			tree.intersects(tree.bounds(), std::back_inserter(res));
+			(void)tree.nearest(ufo::Vec3d(0));
+		} catch (std::runtime_error const&) {
+			return true;
+		}
+		return false;
+	};
+
+	REQUIRE_FALSE(fails(0, h));
+
+	SECTION("Count larger than a page")
+	{
+		auto const capacity = static_cast<std::uint32_t>(Tree::pageCapacity(256) + 1);
+		REQUIRE(fails(root, capacity));
+		REQUIRE(fails(child * h.page_size, capacity));
+	}
+
+	SECTION("Child outside the file")
+	{
+		REQUIRE(fails(child_id, h.num_pages));
+		REQUIRE(fails(child_id, std::uint64_t(0)));
+	}
+
+	SECTION("Levels that do not go down by one")
+	{
+		// The child is a copy of the root level, or points back at the root
+		REQUIRE(fails(child * h.page_size + sizeof(std::uint32_t), h.height - 1));
+		REQUIRE(fails(child_id, h.root));
+	}
+
+	std::filesystem::remove(file);
+}
@@ -0,0 +1,86 @@
+// UFO
+#include <ufo/geometry/contains.hpp>
+#include <ufo/geometry/intersects.hpp>
+#include <ufo/geometry/polygon.hpp>
+
+// STL
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+// Reference crossing test over all edges
+bool naiveContains(std::vector<ufo::Vec2f> const& v, ufo::Vec2f p)
+{
+	bool inside = false;
+	for (std::size_t i{}, j = v.size() - 1; v.size() > i; j = i++) {
+		if ((v[i].y > p.y) != (v[j].y > p.y) &&
+		    p.x < (v[j].x - v[i].x) * (p.y - v[i].y) / (v[j].y - v[i].y) + v[i].x) {
+			inside = !inside;
+		}
+	}
+	return inside;
+}
+
+// A star with `n` spikes
+std::vector<ufo::Vec2f> star(std::size_t n)
+{
+	std::vector<ufo::Vec2f> v;
+	for (std::size_t i{}; 2 * n > i; ++i) {
+		float const a = static_cast<float>(M_PI) * static_cast<float>(i) / n;
+		float const r = 0 == i % 2 ? 10.0f : 4.0f;
+		v.emplace_back(r * std::cos(a), r * std::sin(a));
+	}
+	return v;
+}
+}  // namespace
+
+TEST_CASE("[Polygon] Convex")
+{
+	ufo::Polygonf square{ufo::Vec2f(0, 0), ufo::Vec2f(4, 0), ufo::Vec2f(4, 4),
+	                     ufo::Vec2f(0, 4)};
+	REQUIRE(square.convex());
+	REQUIRE(ufo::contains(square, ufo::Vec2f(1, 1)));
+	REQUIRE_FALSE(ufo::contains(square, ufo::Vec2f(5, 1)));
+	REQUIRE(ufo::contains(square, ufo::AABB2f(ufo::Vec2f(1, 1), ufo::Vec2f(2, 3))));
+	REQUIRE_FALSE(ufo::contains(square, ufo::AABB2f(ufo::Vec2f(1, 1), ufo::Vec2f(5, 3))));
+	REQUIRE(ufo::intersects(square, ufo::AABB2f(ufo::Vec2f(3, 3), ufo::Vec2f(5, 5))));
+	REQUIRE(ufo::intersects(square, ufo::AABB2f(ufo::Vec2f(-1, -1), ufo::Vec2f(5, 5))));
+	REQUIRE_FALSE(ufo::intersects(square, ufo::AABB2f(ufo::Vec2f(5, 5), ufo::Vec2f(6, 6))));
+	REQUIRE(ufo::Vec2f(0, 0) == ufo::min(square));
+	REQUIRE(ufo::Vec2f(4, 4) == ufo::max(square));
+}
+
+TEST_CASE("[Polygon] Simple")
+{
+	auto          v = star(500);
+	ufo::Polygonf p(v.begin(), v.end());
+	REQUIRE_FALSE(p.convex());
+	REQUIRE(1000 == p.size());
+
+	std::mt19937                          gen(1);
+	std::uniform_real_distribution<float> dist(-11.0f, 11.0f);
+
+	std::vector<ufo::Vec2f> points(100000);
+	for (auto& q : points) {
+		q = ufo::Vec2f(dist(gen), dist(gen));
+	}
+
+	std::vector<char> res(points.size());
+	ufo::contains(std::execution::par, p, points.begin(), points.end(), res.begin());
+	for (std::size_t i{}; points.size() > i; ++i) {
+		REQUIRE(naiveContains(v, points[i]) == static_cast<bool>(res[i]));
+	}
+
+	// A box in the notch between two spikes touches the polygon but is not inside
+	ufo::AABB2f notch(ufo::Vec2f(8.9f, 0.03f), ufo::Vec2f(9.0f, 0.08f));
+	REQUIRE_FALSE(ufo::intersects(p, notch));
+	REQUIRE(ufo::intersects(p, ufo::AABB2f(ufo::Vec2f(3, -0.1f), ufo::Vec2f(9, 0.1f))));
+	REQUIRE(ufo::contains(p, ufo::AABB2f(ufo::Vec2f(-1, -1), ufo::Vec2f(1, 1))));
+	REQUIRE_FALSE(ufo::contains(p, ufo::AABB2f(ufo::Vec2f(-5, -5), ufo::Vec2f(5, 5))));
+	REQUIRE(ufo::contains(ufo::AABB2f(ufo::Vec2f(-10), ufo::Vec2f(10)), p));
+}
@@ -0,0 +1,133 @@
+// UFO
+#include <ufo/geometry/sdf.hpp>
+#include <ufo/geometry/signed_distance.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+template <class Geometry>
+ufo::SignedDistance<3, double> bruteForce(std::vector<Geometry> const& shapes,
+                                          ufo::Vec3d const&            p)
+{
+	ufo::SignedDistance<3, double> res{std::numeric_limits<double>::infinity(), {}};
+	for (auto const& s : shapes) {
+		auto const sd = ufo::signedDistanceAndGradient(s, p);
+		if (sd.distance < res.distance) {
+			res = sd;
+		}
+	}
+	return res;
+}
+}  // namespace
+
+TEST_CASE("[SDF] Dense")
+{
+	std::mt19937                           gen(17);
+	std::uniform_real_distribution<double> pos(-2, 2);
+	std::uniform_real_distribution<double> size(0.1, 0.6);
+
+	std::vector<ufo::Sphere3d> spheres;
+	for (int i{}; 40 > i; ++i) {
+		spheres.emplace_back(ufo::Vec3d(pos(gen), pos(gen), pos(gen)), size(gen));
+	}
+
+	ufo::AABB3d const bounds(ufo::Vec3d(-2.5), ufo::Vec3d(2.5, 2.5, 1.0));
+	auto const sdf = ufo::bakeSDF(std::execution::par, spheres.begin(), spheres.end(),
+	                              bounds, 0.125);
+	REQUIRE(41 == sdf.size()[0]);
+	REQUIRE(29 == sdf.size()[2]);
+	REQUIRE(sdf.blocks().first == sdf.blocks().second);
+	REQUIRE_FALSE(sdf.hasGradients());
+
+	for (std::size_t z{}; sdf.size()[2] > z; ++z) {
+		for (std::size_t y{}; sdf.size()[1] > y; ++y) {
+			for (std::size_t x{}; sdf.size()[0] > x; ++x) {
+				auto const p = sdf.position(x, y, z);
+				REQUIRE(bruteForce(spheres, p).distance == sdf.value(x, y, z));
+				REQUIRE(sdf.value(x, y, z) == sdf.distance(p));
+			}
+		}
+	}
+
+	// Trilinear interpolation of a 1-Lipschitz function
+	std::uniform_real_distribution<double> in(-2.5, 1.0);
+	for (int i{}; 1000 > i; ++i) {
+		ufo::Vec3d p(in(gen), in(gen), in(gen));
+		REQUIRE(std::abs(bruteForce(spheres, p).distance - sdf.distance(p)) <=
+		        0.125 * std::sqrt(3.0));
+
+		// The gradient of the interpolation
+		double const h  = 1e-6;
+		auto const   sd = sdf.distanceAndGradient(p);
+		REQUIRE(sd.distance == Catch::Approx(sdf.distance(p)));
+		for (std::size_t j{}; 3 > j; ++j) {
+			ufo::Vec3d e;
+			e[j]            = h;
+			double const fd = (sdf.distance(p + e) - sdf.distance(p - e)) / (2 * h);
+			REQUIRE(fd == Catch::Approx(sd.gradient[j]).margin(1e-5));
+		}
+	}
+
+	// Outside the grid the closest grid point is used
+	REQUIRE(sdf.distance(ufo::Vec3d(-2.5, 0, 1)) == sdf.distance(ufo::Vec3d(-9, 0, 5)));
+
+	REQUIRE_THROWS(ufo::bakeSDF(spheres.begin(), spheres.end(), bounds, 0.0));
+}
+
+TEST_CASE("[SDF] Sparse narrow band")
+{
+	std::mt19937                           gen(23);
+	std::uniform_real_distribution<double> pos(-4, 4);
+	std::uniform_real_distribution<double> size(0.1, 0.5);
+
+	std::vector<ufo::OBB3d> boxes;
+	for (int i{}; 30 > i; ++i) {
+		ufo::Vec3d start(pos(gen), pos(gen), pos(gen));
+		ufo::Vec3d end = start + ufo::Vec3d(size(gen), -size(gen), size(gen));
+		boxes.emplace_back(start, end, ufo::Vec2d(size(gen), size(gen)));
+	}
+	// A large box whose center is deeper than the band
+	boxes.emplace_back(ufo::Vec3d(0), ufo::Vec3d(2.0));
+
+	double const         band = 0.25;
+	ufo::AABB3d const    bounds(ufo::Vec3d(-5), ufo::Vec3d(5));
+	ufo::BVH<ufo::OBB3d> bvh(boxes.begin(), boxes.end());
+
+	auto const sparse = ufo::bakeSDF(std::execution::par, bvh, bounds, 0.1,
+	                                 ufo::SDFStorage::SPARSE, band, true);
+	auto const dense  = ufo::bakeSDF(bvh, bounds, 0.1, ufo::SDFStorage::DENSE, band);
+
+	REQUIRE(sparse.hasGradients());
+	REQUIRE(sparse.blocks().first == dense.blocks().second);
+	REQUIRE(sparse.blocks().second < sparse.blocks().first / 2);
+
+	for (std::size_t z{}; sparse.size()[2] > z; ++z) {
+		for (std::size_t y{}; sparse.size()[1] > y; ++y) {
+			for (std::size_t x{}; sparse.size()[0] > x; ++x) {
+				auto const p  = sparse.position(x, y, z);
+				auto const sd = bruteForce(boxes, p);
+				double     d  = std::clamp(sd.distance, -band, band);
+				REQUIRE(d == Catch::Approx(sparse.value(x, y, z)).margin(1e-12));
+				REQUIRE(dense.value(x, y, z) == sparse.value(x, y, z));
+				if (std::abs(sd.distance) < band) {
+					auto const g = sparse.gradient(x, y, z);
+					REQUIRE(0.0 == Catch::Approx(ufo::norm(sd.gradient - g)).margin(1e-12));
+				}
+			}
+		}
+	}
+
+	REQUIRE(-band == sparse.distance(ufo::Vec3d(0)));
+	REQUIRE(band == sparse.distance(ufo::Vec3d(-5)));
+}
@@ -0,0 +1,129 @@
+// UFO
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/signed_distance.hpp>
+
+// STL
+#include <cmath>
+#include <execution>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// Test
+#include "test_helpers.hpp"
+
+namespace
+{
+template <class Geometry>
+void checkGradient(Geometry const& a, std::vector<ufo::Vec3d> const& points)
+{
+	double const h = 1e-6;
+	for (auto const& p : points) {
+		auto const sd = ufo::signedDistanceAndGradient(a, p);
+		REQUIRE(sd.distance == Catch::Approx(ufo::signedDistance(a, p)).margin(1e-12));
+		REQUIRE(1.0 == Catch::Approx(ufo::norm(sd.gradient)));
+
+		// Stepping along the gradient lands on the surface
+		REQUIRE(0.0 == Catch::Approx(ufo::signedDistance(a, p - sd.gradient * sd.distance))
+		                   .margin(1e-9));
+
+		// Central differences, except on the medial axis where they are not unit length
+		ufo::Vec3d fd;
+		for (std::size_t i{}; 3 > i; ++i) {
+			ufo::Vec3d e;
+			e[i]  = h;
+			fd[i] = (ufo::signedDistance(a, p + e) - ufo::signedDistance(a, p - e)) / (2 * h);
+		}
+		if (1e-3 > std::abs(1.0 - ufo::norm(fd))) {
+			REQUIRE(0.0 == Catch::Approx(ufo::norm(fd - sd.gradient)).margin(1e-4));
+		}
+	}
+
+	std::vector<double>                         d(points.size());
+	std::vector<ufo::SignedDistance<3, double>> g(points.size());
+	ufo::signedDistance(std::execution::par_unseq, a, points.begin(), points.end(),
+	                    d.begin());
+	ufo::signedDistanceAndGradient(a, points.begin(), points.end(), g.begin());
+	for (std::size_t i{}; points.size() > i; ++i) {
+		REQUIRE(d[i] == ufo::signedDistance(a, points[i]));
+		REQUIRE(g[i] == ufo::signedDistanceAndGradient(a, points[i]));
+	}
+}
+}  // namespace
+
+TEST_CASE("[Signed distance] Boxes")
+{
+	auto const points = ufo::test::randomPoints(500, -3.0, 3.0, 3);
+
+	ufo::AABB3d aabb(ufo::Vec3d(-1, -0.5, 0), ufo::Vec3d(1.5, 1, 0.25));
+	REQUIRE(-0.125 == Catch::Approx(ufo::signedDistance(aabb, ufo::Vec3d(0, 0, 0.125))));
+	for (auto const& p : points) {
+		double d = ufo::signedDistance(aabb, p);
+		REQUIRE(std::max(d, 0.0) == Catch::Approx(ufo::distance(aabb, p)).margin(1e-12));
+	}
+	checkGradient(aabb, points);
+
+	// An OBB rotated 90 degrees around z is the same as the swapped AABB
+	ufo::Mat<3, 3, double> r;
+	r[0] = ufo::Vec3d(0, 1, 0);
+	r[1] = ufo::Vec3d(-1, 0, 0);
+	r[2] = ufo::Vec3d(0, 0, 1);
+	ufo::OBB3d  obb(ufo::Vec3d(1, 2, 3), ufo::Vec3d(2, 1, 0.5), r);
+	ufo::AABB3d swapped(ufo::Vec3d(0, 0, 2.5), ufo::Vec3d(2, 4, 3.5));
+	for (auto const& p : points) {
+		REQUIRE(ufo::signedDistance(swapped, p) ==
+		        Catch::Approx(ufo::signedDistance(obb, p)).margin(1e-12));
+	}
+	checkGradient(obb, points);
+}
+
+TEST_CASE("[Signed distance] Round shapes")
+{
+	auto const points = ufo::test::randomPoints(500, -3.0, 3.0, 3);
+
+	ufo::Sphere3d sphere(ufo::Vec3d(0.5, 0, -0.5), 1.5);
+	REQUIRE(-1.5 == ufo::signedDistance(sphere, sphere.center));
+	checkGradient(sphere, points);
+
+	ufo::Capsule3d capsule(ufo::Vec3d(-1, -1, 0), ufo::Vec3d(1, 0.5, 0.5), 0.75);
+	checkGradient(capsule, points);
+
+	ufo::Cylinder3d cylinder(ufo::Vec3d(-1, 0.5, -1), ufo::Vec3d(1, -0.5, 1.5), 1.0);
+	for (auto const& p : points) {
+		double d = ufo::signedDistance(cylinder, p);
+		REQUIRE(std::max(d, 0.0) == Catch::Approx(ufo::distance(cylinder, p)).margin(1e-9));
+	}
+	checkGradient(cylinder, points);
+
+	// The gradient on the axis is any radial direction
+	ufo::Cylinder3d z(ufo::Vec3d(0, 0, -5), ufo::Vec3d(0, 0, 5), 1.0);
+	auto const      sd = ufo::signedDistanceAndGradient(z, ufo::Vec3d(0, 0, 0));
+	REQUIRE(-1.0 == sd.distance);
+	REQUIRE(0.0 == Catch::Approx(sd.gradient.z));
+	REQUIRE(1.0 == Catch::Approx(ufo::norm(sd.gradient)));
+}
+
+TEST_CASE("[Signed distance] Triangle and plane")
+{
+	auto const points = ufo::test::randomPoints(500, -3.0, 3.0, 3);
+
+	ufo::Triangle3d tri(ufo::Vec3d(-1, -1, 0), ufo::Vec3d(2, -0.5, 0.5),
+	                    ufo::Vec3d(0, 2, -1));
+	checkGradient(tri, points);
+	REQUIRE(0.0 == ufo::signedDistance(tri, tri[0]));
+
+	ufo::Triangle2d flat(ufo::Vec2d(0, 0), ufo::Vec2d(4, 0), ufo::Vec2d(0, 4));
+	REQUIRE(-1.0 == Catch::Approx(ufo::signedDistance(flat, ufo::Vec2d(1, 1))));
+	REQUIRE(1.0 == Catch::Approx(ufo::signedDistance(flat, ufo::Vec2d(-1, 1))));
+	auto const g = ufo::signedDistanceGradient(flat, ufo::Vec2d(0.5, 2));
+	REQUIRE(-1.0 == Catch::Approx(g.x));
+	REQUIRE(0.0 == Catch::Approx(g.y).margin(1e-12));
+
+	ufo::Plane<double> plane(ufo::Vec3d(0, 0, 1), ufo::Vec3d(1, 0, 1), ufo::Vec3d(0, 1, 1));
+	double const       s = ufo::signedDistance(plane, ufo::Vec3d(0, 0, 0));
+	REQUIRE(1.0 == Catch::Approx(std::abs(s)));
+	REQUIRE(-s == Catch::Approx(ufo::signedDistance(plane, ufo::Vec3d(5, -3, 2))));
+	checkGradient(plane, points);
+}
@@ -0,0 +1,155 @@
+// UFO
+#include <ufo/geometry/space_filling_curve.hpp>
+#include <ufo/geometry/sphere.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <execution>
+#include <random>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_test_macros.hpp>
+
+// Test
+#include "test_helpers.hpp"
+
+namespace
+{
+// The cells of an aligned block are visited one after the other, each next to the last
+template <class Code, std::size_t Dim>
+void checkHilbert(std::uint32_t block)
+{
+	constexpr std::size_t  bits  = ufo::detail::curve_bits_v<Code, Dim>;
+	double const           cells = double(std::uint64_t(1) << bits);
+	ufo::AABB<Dim, double> bounds(ufo::Vec<Dim, double>(0), ufo::Vec<Dim, double>(cells));
+
+	std::vector<std::pair<Code, ufo::Vec<Dim, double>>> codes;
+	std::size_t                                         total = 1;
+	for (std::size_t i{}; Dim > i; ++i) {
+		total *= block;
+	}
+	for (std::size_t c{}; total > c; ++c) {
+		ufo::Vec<Dim, double> p;
+		for (std::size_t i{}, r = c; Dim > i; ++i, r /= block) {
+			p[i] = double(r % block) + 0.5;
+		}
+		codes.emplace_back(ufo::detail::hilbertCode<Code>(p, bounds), p);
+	}
+	std::sort(codes.begin(), codes.end(),
+	          [](auto const& a, auto const& b) { return a.first < b.first; });
+
+	REQUIRE(Code(0) == codes.front().first);
+	for (std::size_t c = 1; total > c; ++c) {
+		REQUIRE(codes[c - 1].first + 1 == codes[c].first);
+		double steps{};
+		for (std::size_t i{}; Dim > i; ++i) {
+			steps += std::abs(codes[c].second[i] - codes[c - 1].second[i]);
+		}
+		REQUIRE(1.0 == steps);
+	}
+}
+
+double pathLength(std::vector<ufo::Vec3f> const& points)
+{
+	double res{};
+	for (std::size_t i = 1; points.size() > i; ++i) {
+		res += ufo::distance(points[i - 1], points[i]);
+	}
+	return res;
+}
+}  // namespace
+
+TEST_CASE("[Space filling curve] Codes")
+{
+	checkHilbert<std::uint32_t, 2>(16);
+	checkHilbert<std::uint64_t, 2>(32);
+	checkHilbert<std::uint32_t, 3>(8);
+	checkHilbert<std::uint64_t, 3>(8);
+
+	// Morton interleaves the bits, the first axis most significant
+	ufo::AABB2d bounds(ufo::Vec2d(0), ufo::Vec2d(65536));
+	REQUIRE(0u == ufo::detail::mortonCode(ufo::Vec2d(0.5, 0.5), bounds));
+	REQUIRE(1u == ufo::detail::mortonCode(ufo::Vec2d(0.5, 1.5), bounds));
+	REQUIRE(2u == ufo::detail::mortonCode(ufo::Vec2d(1.5, 0.5), bounds));
+	REQUIRE(0b1110u == ufo::detail::mortonCode(ufo::Vec2d(3.5, 2.5), bounds));
+
+	// Outside the bounds is clamped, also at the full 32 bits per axis
+	ufo::AABB2f unit(ufo::Vec2f(0), ufo::Vec2f(1));
+	REQUIRE(~std::uint64_t(0) ==
+	        ufo::detail::mortonCode<std::uint64_t>(ufo::Vec2f(2, 2), unit));
+	REQUIRE(0u == ufo::detail::mortonCode(ufo::Vec2f(-2, -2), unit));
+}
+
+TEST_CASE("[Space filling curve] Radix sort")
+{
+	std::mt19937                                 gen(4);
+	std::uniform_int_distribution<std::uint64_t> key(0, 1000);
+
+	std::vector<std::pair<std::uint64_t, std::size_t>> keys(50000);
+	for (std::size_t i{}; keys.size() > i; ++i) {
+		// Few distinct values in the low bits, all high bytes equal but one
+		keys[i] = {(key(gen) << 20) | (std::uint64_t(i % 3) << 56), i};
+	}
+
+	auto expected = keys;
+	std::stable_sort(expected.begin(), expected.end(),
+	                 [](auto const& a, auto const& b) { return a.first < b.first; });
+
+	auto seq = keys;
+	ufo::detail::radixSort(std::execution::seq, seq, 64);
+	REQUIRE(expected == seq);
+
+	auto par = keys;
+	ufo::detail::radixSort(std::execution::par, par, 64);
+	REQUIRE(expected == par);
+}
+
+TEST_CASE("[Space filling curve] Reordering")
+{
+	auto const points = ufo::test::randomPoints(100000, -50.0f, 50.0f, 21);
+
+	for (auto const& order : {ufo::mortonOrder(points.begin(), points.end()),
+	                          ufo::hilbertOrder(points.begin(), points.end())}) {
+		auto sorted = order;
+		std::sort(sorted.begin(), sorted.end());
+		for (std::size_t i{}; sorted.size() > i; ++i) {
+			REQUIRE(i == sorted[i]);
+		}
+	}
+
+	// The order does not depend on the policy
+	REQUIRE(ufo::mortonOrder(points.begin(), points.end()) ==
+	        ufo::mortonOrder(std::execution::par, points.begin(), points.end()));
+	REQUIRE(ufo::hilbertOrder(points.begin(), points.end()) ==
+	        ufo::hilbertOrder(std::execution::par_unseq, points.begin(), points.end()));
+
+	auto morton  = points;
+	auto hilbert = points;
+
+	auto const m = ufo::sortByMorton(std::execution::par, morton.begin(), morton.end());
+	auto const h = ufo::sortByHilbert(hilbert);
+	for (std::size_t i{}; points.size() > i; ++i) {
+		REQUIRE(points[m[i]] == morton[i]);
+		REQUIRE(points[h[i]] == hilbert[i]);
+	}
+
+	// Consecutive points are close, and the Hilbert curve never jumps
+	double const scan = pathLength(points);
+	REQUIRE(scan > 10 * pathLength(morton));
+	REQUIRE(pathLength(morton) > pathLength(hilbert));
+
+	// Shapes are ordered by the centers of their bounds
+	std::vector<ufo::Sphere3d> spheres;
+	for (int i{}; 8 > i; ++i) {
+		spheres.emplace_back(ufo::Vec3d(i / 4, (i / 2) % 2, i % 2) * 10.0, 1 + i);
+	}
+	std::reverse(spheres.begin(), spheres.end());
+	auto const order = ufo::sortByMorton(spheres);
+	for (std::size_t i{}; spheres.size() > i; ++i) {
+		REQUIRE(7 - i == order[i]);
+		REQUIRE(1.0 + i == spheres[i].radius);
+	}
+}
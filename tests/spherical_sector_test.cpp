@@ -0,0 +1,222 @@
+// UFO
+#include <ufo/geometry/contains.hpp>
+#include <ufo/geometry/fun.hpp>
+#include <ufo/geometry/intersects.hpp>
+#include <ufo/geometry/spherical_sector.hpp>
+
+// STL
+#include <cmath>
+#include <execution>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// Test
+#include "test_helpers.hpp"
+
+namespace
+{
+using ufo::test::rotation;
+
+// Containment from the angles themselves
+bool reference(ufo::SphericalSectord const& a, ufo::Vec3d const& p)
+{
+	ufo::Vec3d v = p - a.origin;
+	ufo::Vec3d l(ufo::dot(a.rotation[0], v), ufo::dot(a.rotation[1], v),
+	             ufo::dot(a.rotation[2], v));
+
+	double r = ufo::norm(l);
+	double e = std::atan2(l.z, std::sqrt(l.x * l.x + l.y * l.y));
+	double z = std::atan2(l.y, l.x);
+	z        = a.min_azimuth + std::fmod(std::fmod(z - a.min_azimuth, 2 * M_PI) + 2 * M_PI,
+	                                     2 * M_PI);
+	return a.min_range <= r && a.max_range >= r && a.min_elevation <= e &&
+	       a.max_elevation >= e && (a.fullAzimuth() || a.max_azimuth >= z);
+}
+
+// The grid of angles and ranges, with the quarter turns and the horizon where the
+// sector reaches furthest along the axes
+std::vector<ufo::Vec3d> samples(ufo::SphericalSectord const& a)
+{
+	int const           n = 60;
+	std::vector<double> azimuths;
+	std::vector<double> elevations{0.0};
+	for (int i{}; n >= i; ++i) {
+		azimuths.push_back(a.min_azimuth + (a.max_azimuth - a.min_azimuth) * i / n);
+		elevations.push_back(a.min_elevation + (a.max_elevation - a.min_elevation) * i / n);
+	}
+	for (int k = -8; 8 >= k; ++k) {
+		azimuths.push_back(k * M_PI / 2);
+	}
+
+	std::vector<ufo::Vec3d> res;
+	for (double z : azimuths) {
+		for (double e : elevations) {
+			for (int k{}; 4 >= k; ++k) {
+				auto p = a.point(z, e, a.min_range + (a.max_range - a.min_range) * k / 4);
+				if (reference(a, p)) {
+					res.push_back(p);
+				}
+			}
+		}
+	}
+	return res;
+}
+
+void checkSector(ufo::SphericalSectord const& a, bool aligned)
+{
+	std::mt19937                           gen(17);
+	std::uniform_real_distribution<double> pos(-5, 5);
+	std::uniform_real_distribution<double> size(0.05, 2);
+
+	// Points against the angles, one at a time and in batches
+	std::vector<ufo::Vec3d> points;
+	for (int i{}; 2000 > i; ++i) {
+		points.emplace_back(pos(gen), pos(gen), pos(gen));
+		REQUIRE(reference(a, points.back()) == ufo::contains(a, points.back()));
+		REQUIRE(ufo::contains(a, points.back()) == ufo::intersects(points.back(), a));
+	}
+
+	std::vector<char> seq(points.size());
+	std::vector<char> par(points.size());
+	ufo::contains(a, points.begin(), points.end(), seq.begin());
+	ufo::intersects(std::execution::par, a, points.begin(), points.end(), par.begin());
+	for (std::size_t i{}; points.size() > i; ++i) {
+		REQUIRE(bool(seq[i]) == ufo::contains(a, points[i]));
+		REQUIRE(seq[i] == par[i]);
+	}
+
+	// Boxes against points sampled in them, an intersecting box is never missed
+	std::vector<ufo::AABB3d> boxes;
+	for (int i{}; 500 > i; ++i) {
+		ufo::Vec3d min(pos(gen), pos(gen), pos(gen));
+		boxes.emplace_back(min, min + ufo::Vec3d(size(gen), size(gen), size(gen)));
+		auto const& box = boxes.back();
+
+		bool any{};
+		bool all = true;
+		for (int x{}; 6 >= x; ++x) {
+			for (int y{}; 6 >= y; ++y) {
+				for (int z{}; 6 >= z; ++z) {
+					bool in = ufo::contains(
+					    a, box.min + (box.max - box.min) * ufo::Vec3d(x, y, z) / 6.0);
+					any = any || in;
+					all = all && in;
+				}
+			}
+		}
+
+		bool const hit = ufo::intersects(a, box);
+		REQUIRE(hit == ufo::intersects(box, a));
+		if (any) {
+			REQUIRE(hit);
+		}
+		if (ufo::contains(a, box)) {
+			REQUIRE(all);
+			REQUIRE(hit);
+		}
+	}
+
+	std::vector<char> hits(boxes.size());
+	std::vector<char> inside(boxes.size());
+	ufo::intersects(a, boxes.begin(), boxes.end(), hits.begin());
+	ufo::contains(std::execution::par, a, boxes.begin(), boxes.end(), inside.begin());
+	for (std::size_t i{}; boxes.size() > i; ++i) {
+		REQUIRE(bool(hits[i]) == ufo::intersects(a, boxes[i]));
+		REQUIRE(bool(inside[i]) == ufo::contains(a, boxes[i]));
+	}
+
+	// Bounds enclose the sector, and are tight when the axes are aligned
+	ufo::Vec3d lo(std::numeric_limits<double>::max());
+	ufo::Vec3d hi(std::numeric_limits<double>::lowest());
+	for (auto const& p : samples(a)) {
+		lo = ufo::min(lo, p);
+		hi = ufo::max(hi, p);
+	}
+	REQUIRE(a.bounds().min == ufo::min(a));
+	REQUIRE(a.bounds().max == ufo::max(a));
+	for (std::size_t i{}; 3 > i; ++i) {
+		REQUIRE(ufo::min(a)[i] <= lo[i] + 1e-9);
+		REQUIRE(ufo::max(a)[i] >= hi[i] - 1e-9);
+		if (aligned) {
+			REQUIRE(lo[i] == Catch::Approx(ufo::min(a)[i]).margin(1e-9));
+			REQUIRE(hi[i] == Catch::Approx(ufo::max(a)[i]).margin(1e-9));
+		}
+	}
+}
+}  // namespace
+
+TEST_CASE("[Spherical sector] Spinning LiDAR")
+{
+	// Full revolution, 30 degrees above and below the horizon, blind within 0.5
+	ufo::SphericalSectord lidar(ufo::Vec3d(0.5, -0.25, 0), -M_PI, M_PI, -M_PI / 6,
+	                            M_PI / 6, 0.5, 4.0);
+	REQUIRE(lidar.fullAzimuth());
+	checkSector(lidar, true);
+
+	REQUIRE(ufo::contains(lidar, ufo::Vec3d(-2, -0.25, 0.5)));
+	REQUIRE_FALSE(ufo::contains(lidar, ufo::Vec3d(0.5, -0.25, 1)));
+	REQUIRE_FALSE(ufo::contains(lidar, ufo::Vec3d(0.6, -0.25, 0)));
+
+	// Octree nodes in the blind spot, straight above, and in the band
+	ufo::AABB3d blind(ufo::Vec3d(0.4, -0.35, -0.1), ufo::Vec3d(0.6, -0.15, 0.1));
+	ufo::AABB3d above(ufo::Vec3d(0, -0.75, 2), ufo::Vec3d(1, 0.25, 3));
+	ufo::AABB3d band(ufo::Vec3d(2, 0, -0.25), ufo::Vec3d(2.5, 0.5, 0.25));
+	REQUIRE_FALSE(ufo::intersects(lidar, blind));
+	REQUIRE_FALSE(ufo::intersects(lidar, above));
+	REQUIRE(ufo::intersects(lidar, band));
+	REQUIRE(ufo::contains(lidar, band));
+	REQUIRE_FALSE(ufo::contains(lidar, ufo::AABB3d(band.min, band.max + 2.0)));
+
+	// Looking straight up includes the pole
+	ufo::SphericalSectord dome(ufo::Vec3d(0, 0, 0), -M_PI, M_PI, 0, M_PI / 2, 0, 2);
+	REQUIRE(ufo::contains(dome, ufo::Vec3d(0, 0, 1)));
+	REQUIRE(ufo::contains(dome, ufo::AABB3d(ufo::Vec3d(-0.1, -0.1, 0), ufo::Vec3d(0.1))));
+	checkSector(dome, true);
+}
+
+TEST_CASE("[Spherical sector] Limited azimuth")
+{
+	// Narrow forward looking sensor
+	ufo::SphericalSectord front(ufo::Vec3d(0, 0, 0), -M_PI / 6, M_PI / 6, -M_PI / 8,
+	                            M_PI / 4, 0, 4.5);
+	checkSector(front, true);
+	REQUIRE(ufo::contains(front, ufo::Vec3d(3, 0.5, 0)));
+	REQUIRE_FALSE(ufo::contains(front, ufo::Vec3d(-3, 0.5, 0)));
+	REQUIRE_FALSE(ufo::intersects(front, ufo::AABB3d(ufo::Vec3d(-2, -1, -1),
+	                                                 ufo::Vec3d(-1, 1, 1))));
+	// Crossing both boundaries of the wedge without containing a corner
+	REQUIRE(ufo::intersects(front, ufo::AABB3d(ufo::Vec3d(2, -3, -0.1),
+	                                           ufo::Vec3d(2.2, 3, 0.1))));
+
+	// More than half a turn, wrapping past the negative x-axis
+	ufo::SphericalSectord wide(ufo::Vec3d(-0.5, 0.5, 0.25), M_PI / 4, 7 * M_PI / 4 - 0.1,
+	                           -M_PI / 3, M_PI / 5, 0.25, 4.0);
+	checkSector(wide, true);
+	REQUIRE(ufo::contains(wide, ufo::Vec3d(-2.5, 0.5, 0.25)));
+	REQUIRE_FALSE(ufo::contains(wide, ufo::Vec3d(1.5, 0.5, 0.25)));
+
+	// Turned a quarter around z, which is still aligned with the world axes
+	ufo::Mat<3, 3, double> r;
+	r[0] = ufo::Vec3d(0, 1, 0);
+	r[1] = ufo::Vec3d(-1, 0, 0);
+	r[2] = ufo::Vec3d(0, 0, 1);
+	ufo::SphericalSectord turned(ufo::Vec3d(0, 0, 0), r, -M_PI / 6, M_PI / 6, -M_PI / 8,
+	                             M_PI / 4, 0, 4.5);
+	checkSector(turned, true);
+	REQUIRE(ufo::contains(turned, ufo::Vec3d(0.5, 3, 0)));
+}
+
+TEST_CASE("[Spherical sector] Arbitrary pose")
+{
+	std::mt19937 gen(23);
+	for (int i{}; 5 > i; ++i) {
+		ufo::SphericalSectord a(ufo::Vec3d(0.5, 0, -0.5), rotation(gen), -2.0 + i, 1.0 + i,
+		                        -0.5, 0.75, 0.5 * i, 4.0);
+		checkSector(a, false);
+	}
+}
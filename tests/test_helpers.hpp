@@ -0,0 +1,44 @@
+#ifndef UFO_GEOMETRY_TEST_HELPERS_HPP
+#define UFO_GEOMETRY_TEST_HELPERS_HPP
+
+// UFO
+#include <ufo/math/mat.hpp>
+#include <ufo/math/vec.hpp>
+
+// STL
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace ufo::test
+{
+// `n` points drawn uniformly from [min, max)^3, the same for the same `seed`
+template <class T>
+[[nodiscard]] std::vector<Vec<3, T>> randomPoints(std::size_t n, T min, T max,
+                                                  unsigned seed)
+{
+	std::mt19937                      gen(seed);
+	std::uniform_real_distribution<T> pos(min, max);
+	std::vector<Vec<3, T>>            res(n);
+	for (auto& p : res) {
+		p = Vec<3, T>(pos(gen), pos(gen), pos(gen));
+	}
+	return res;
+}
+
+// A uniformly random rotation, the columns are an orthonormal right-handed basis
+[[nodiscard]] inline Mat<3, 3, double> rotation(std::mt19937& gen)
+{
+	std::normal_distribution<double> n;
+	Vec3d x = normalize(Vec3d(n(gen), n(gen), n(gen)));
+	Vec3d y = normalize(cross(x, Vec3d(n(gen), n(gen), n(gen))));
+
+	Mat<3, 3, double> r;
+	r[0] = x;
+	r[1] = y;
+	r[2] = cross(x, y);
+	return r;
+}
+}  // namespace ufo::test
+
+#endif  // UFO_GEOMETRY_TEST_HELPERS_HPP
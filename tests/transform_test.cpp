@@ -0,0 +1,86 @@
+// UFO
+#include <ufo/geometry/fun.hpp>
+#include <ufo/geometry/transform.hpp>
+
+// STL
+#include <cmath>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+ufo::Mat<3, 3, float> rotationZ(float angle)
+{
+	ufo::Mat<3, 3, float> r;
+	r[0] = ufo::Vec3f(std::cos(angle), std::sin(angle), 0);
+	r[1] = ufo::Vec3f(-std::sin(angle), std::cos(angle), 0);
+	r[2] = ufo::Vec3f(0, 0, 1);
+	return r;
+}
+
+void requireApprox(ufo::Vec3f const& a, ufo::Vec3f const& b)
+{
+	REQUIRE(a.x == Catch::Approx(b.x).margin(1e-5));
+	REQUIRE(a.y == Catch::Approx(b.y).margin(1e-5));
+	REQUIRE(a.z == Catch::Approx(b.z).margin(1e-5));
+}
+}  // namespace
+
+TEST_CASE("[Transform] OBB min/max")
+{
+	ufo::OBB3f obb(ufo::Vec3f(1, 2, 3), ufo::Vec3f(1, 1, 1), rotationZ(M_PI / 4));
+
+	float const s = std::sqrt(2.0f);
+	requireApprox(ufo::min(obb), ufo::Vec3f(1 - s, 2 - s, 2));
+	requireApprox(ufo::max(obb), ufo::Vec3f(1 + s, 2 + s, 4));
+}
+
+TEST_CASE("[Transform] Arvo AABB")
+{
+	ufo::AABB3f a(ufo::Vec3f(-1, -2, -3), ufo::Vec3f(1, 2, 3));
+	auto        r = rotationZ(M_PI / 2);
+	ufo::Vec3f  t(10, 0, 0);
+
+	auto b = ufo::aabb(r, t, a);
+	requireApprox(b.min, ufo::Vec3f(8, -1, -3));
+	requireApprox(b.max, ufo::Vec3f(12, 1, 3));
+
+	// Must enclose all transformed corners and agree with the OBB of the transform
+	ufo::OBB3f o(a.center(), a.halfLength());
+	auto       ob = ufo::transform(o, rotationZ(0.3f), t);
+	auto       ab = ufo::aabb(rotationZ(0.3f), t, a);
+	requireApprox(ufo::min(ob), ab.min);
+	requireApprox(ufo::max(ob), ab.max);
+}
+
+TEST_CASE("[Transform] Batch")
+{
+	auto       r = rotationZ(M_PI / 2);
+	ufo::Vec3f t(1, 2, 3);
+
+	std::vector<ufo::Vec3f> points{ufo::Vec3f(1, 0, 0), ufo::Vec3f(0, 1, 0)};
+	ufo::transform(points.begin(), points.end(), r, t);
+	requireApprox(points[0], ufo::Vec3f(1, 3, 3));
+	requireApprox(points[1], ufo::Vec3f(0, 2, 3));
+
+	std::vector<ufo::Capsule3f> capsules{
+	    ufo::Capsule3f(ufo::Vec3f(0, 0, 0), ufo::Vec3f(1, 0, 0), 0.5f)};
+	std::vector<ufo::Capsule3f> out(capsules.size());
+	ufo::transform(std::execution::par, capsules.begin(), capsules.end(), out.begin(), r,
+	               t);
+	requireApprox(out[0].start, t);
+	requireApprox(out[0].end, ufo::Vec3f(1, 3, 3));
+	REQUIRE(0.5f == out[0].radius);
+
+	// A plane keeps its points on it
+	ufo::Vec3f        p1(0, 0, 1), p2(1, 0, 1), p3(0, 1, 1);
+	ufo::Plane<float> plane(p1, p2, p3);
+	auto              tp = ufo::transform(plane, r, t);
+	for (auto p : {p1, p2, p3}) {
+		auto q = ufo::transform(p, r, t);
+		REQUIRE(0 == Catch::Approx(ufo::dot(tp.normal, q) + tp.distance).margin(1e-5));
+	}
+}
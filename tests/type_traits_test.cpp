@@ -0,0 +1,77 @@
+// UFO
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/intersects.hpp>
+#include <ufo/geometry/type_traits.hpp>
+
+// STL
+#include <cmath>
+#include <execution>
+#include <random>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("[Type traits] Detection")
+{
+	STATIC_REQUIRE(3 == ufo::geometry_traits<ufo::Cylinder3f>::dimension);
+	STATIC_REQUIRE(2 == ufo::geometry_traits<ufo::Polygon<double>>::dimension);
+	STATIC_REQUIRE(std::is_same_v<double, ufo::geometry_traits<ufo::Vec3d>::value_type>);
+
+	STATIC_REQUIRE(ufo::is_convex_v<ufo::OBB3f>);
+	STATIC_REQUIRE_FALSE(ufo::is_convex_v<ufo::Polygon<float>>);
+
+	STATIC_REQUIRE(ufo::has_support_v<ufo::Capsule3f>);
+	STATIC_REQUIRE(ufo::has_support_v<ufo::ConvexPolyhedron<float>>);
+	STATIC_REQUIRE_FALSE(ufo::has_support_v<ufo::Ray3>);
+
+	STATIC_REQUIRE(ufo::has_intersects_v<ufo::AABB3f, ufo::Sphere3f>);
+	STATIC_REQUIRE(ufo::has_distance_v<ufo::Cylinder3f, ufo::Vec3f>);
+	STATIC_REQUIRE_FALSE(ufo::has_intersects_v<ufo::Cylinder3f, ufo::OBB3f>);
+
+	STATIC_REQUIRE(ufo::QueryKernel::DIRECT ==
+	               ufo::intersects_kernel_v<ufo::AABB3f, ufo::Vec3f>);
+	STATIC_REQUIRE(ufo::QueryKernel::CONVEX ==
+	               ufo::intersects_kernel_v<ufo::Cylinder3f, ufo::OBB3f>);
+	STATIC_REQUIRE(ufo::QueryKernel::CONVEX ==
+	               ufo::intersects_kernel_v<ufo::AABB3d, ufo::Cone3d>);
+	STATIC_REQUIRE(ufo::QueryKernel::CONVEX ==
+	               ufo::distance_kernel_v<ufo::Capsule3d, ufo::Cone3d>);
+	STATIC_REQUIRE(ufo::QueryKernel::NONE ==
+	               ufo::intersects_kernel_v<ufo::Polygon<float>, ufo::Ray2>);
+}
+
+TEST_CASE("[Type traits] Batch kernels")
+{
+	ufo::Cylinder3d cylinder(ufo::Vec3d(0, 0, -1), ufo::Vec3d(0, 0, 1), 1.0);
+
+	std::vector<ufo::Sphere3d> spheres;
+	std::vector<ufo::OBB3d>    boxes;
+	for (int i{}; 10 > i; ++i) {
+		spheres.emplace_back(ufo::Vec3d(0.5 * i, 0, 0), 0.25);
+		boxes.emplace_back(ufo::Vec3d(0.5 * i, 0, 0), ufo::Vec3d(0.25));
+	}
+
+	// Direct closed form
+	std::vector<char>   hit(spheres.size());
+	std::vector<double> dist(spheres.size());
+	ufo::intersects(cylinder, spheres.begin(), spheres.end(), hit.begin());
+	ufo::distance(std::execution::par, cylinder, spheres.begin(), spheres.end(),
+	              dist.begin());
+	for (std::size_t i{}; spheres.size() > i; ++i) {
+		REQUIRE(bool(hit[i]) == ufo::intersects(cylinder, spheres[i]));
+		REQUIRE(dist[i] == ufo::distance(cylinder, spheres[i]));
+	}
+
+	// Generic convex fallback, the closest side of each box is 0.5 * i - 0.25 from the
+	// axis of the cylinder
+	ufo::intersects(std::execution::par, cylinder, boxes.begin(), boxes.end(),
+	                hit.begin());
+	ufo::distance(cylinder, boxes.begin(), boxes.end(), dist.begin());
+	for (std::size_t i{}; boxes.size() > i; ++i) {
+		double const gap = std::fdim(0.5 * i - 0.25, 1.0);
+		REQUIRE(bool(hit[i]) == (0.0 == gap));
+		REQUIRE(dist[i] == Catch::Approx(gap).margin(1e-6));
+	}
+}
@@ -0,0 +1,199 @@
+// UFO
+#include <ufo/geometry/distance.hpp>
+#include <ufo/geometry/intersects.hpp>
+#include <ufo/geometry/raycast.hpp>
+#include <ufo/geometry/wide_bvh.hpp>
+
+// STL
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Catch2
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+// Every geometry is in exactly one leaf and the bounds of each child are exact
+template <std::size_t Width>
+void checkStructure(ufo::WideBVH<ufo::AABB3d, Width> const& bvh,
+                    std::vector<ufo::AABB3d> const&         boxes)
+{
+	REQUIRE(boxes.size() == bvh.size());
+
+	// Every node is the child of an earlier one
+	std::vector<char> reached(bvh.nodes().size());
+	reached[0] = 1;
+	for (std::size_t i{}; bvh.nodes().size() > i; ++i) {
+		auto const& node = bvh.nodes()[i];
+		REQUIRE(reached[i]);
+		REQUIRE(0 < node.size);
+		REQUIRE(Width >= node.size);
+		for (std::size_t c{}; node.size > c; ++c) {
+			if (0 == node.count[c]) {
+				REQUIRE(i < node.offset[c]);
+				REQUIRE_FALSE(reached[node.offset[c]]);
+				reached[node.offset[c]] = 1;
+			}
+		}
+	}
+
+	// Bounds of the subtree of each node, bottom-up
+	std::vector<char>        seen(bvh.size());
+	std::vector<ufo::AABB3d> bounds(bvh.nodes().size());
+	for (std::size_t i = bvh.nodes().size(); 0 < i--;) {
+		auto const& node = bvh.nodes()[i];
+		for (std::size_t c{}; node.size > c; ++c) {
+			ufo::AABB3d expected = 0 == node.count[c] ? bounds[node.offset[c]]
+			                                          : bvh.geometry()[node.offset[c]];
+			for (auto j = node.offset[c]; node.offset[c] + node.count[c] > j; ++j) {
+				REQUIRE_FALSE(seen[j]);
+				seen[j]  = 1;
+				expected = ufo::AABB3d(ufo::min(expected.min, bvh.geometry()[j].min),
+				                       ufo::max(expected.max, bvh.geometry()[j].max));
+				REQUIRE(boxes[bvh.index()[j]] == bvh.geometry()[j]);
+			}
+			REQUIRE(expected == node.bounds(c));
+			bounds[i] = 0 == c ? expected
+			                   : ufo::AABB3d(ufo::min(bounds[i].min, expected.min),
+			                                 ufo::max(bounds[i].max, expected.max));
+		}
+	}
+	REQUIRE(std::all_of(seen.begin(), seen.end(), [](char c) { return c; }));
+	REQUIRE(bounds[0] == bvh.bounds());
+}
+
+template <std::size_t Width>
+void checkQueries(ufo::WideBVH<ufo::AABB3d, Width> const& bvh,
+                  std::vector<ufo::AABB3d> const& boxes, std::mt19937& gen)
+{
+	std::uniform_real_distribution<double> pos(-30, 30);
+	std::normal_distribution<double>       dir;
+
+	for (int i{}; 100 > i; ++i) {
+		ufo::Vec3d c(pos(gen), pos(gen), pos(gen));
+
+		// Overlap with all children at once and one child at a time
+		ufo::AABB3d   box(c - 2.0, c + 2.0);
+		ufo::Sphere3d sphere(c, 2.0);
+		for (bool aabb : {true, false}) {
+			std::vector<std::size_t> hits;
+			if (aabb) {
+				bvh.intersects(box, std::back_inserter(hits));
+			} else {
+				bvh.intersects(sphere, std::back_inserter(hits));
+			}
+			std::sort(hits.begin(), hits.end());
+
+			std::vector<std::size_t> expected;
+			for (std::size_t j{}; boxes.size() > j; ++j) {
+				if (aabb ? ufo::intersects(boxes[j], box) : ufo::intersects(boxes[j], sphere)) {
+					expected.push_back(j);
+				}
+			}
+			REQUIRE(expected == hits);
+		}
+
+		// Every other ray is axis aligned, with zero direction components
+		ufo::Vec3d d(dir(gen), dir(gen), dir(gen));
+		if (0 == i % 2) {
+			d        = ufo::Vec3d(0, 0, 0);
+			d[i % 3] = 0 == i % 4 ? 1 : -1;
+		}
+		ufo::Ray3d ray(c, d);
+		double     t = std::numeric_limits<double>::infinity();
+		for (auto const& b : boxes) {
+			t = std::min(t, ufo::raycast(b, ray));
+		}
+		auto const hit = bvh.raycast(ray);
+		REQUIRE(t == hit.second);
+		if (!std::isinf(t)) {
+			REQUIRE(t == ufo::raycast(boxes[hit.first], ray));
+		}
+		REQUIRE(bvh.size() == bvh.raycast(ray, t).first);
+
+		// Distances to all children at once and one child at a time
+		double closest = std::numeric_limits<double>::infinity();
+		double touch   = std::numeric_limits<double>::infinity();
+		for (auto const& b : boxes) {
+			closest = std::min(closest, ufo::distance(b, c));
+			touch   = std::min(touch, ufo::distance(b, sphere));
+		}
+		auto const nearest = bvh.nearest(c);
+		REQUIRE(closest == nearest.second);
+		REQUIRE(closest == ufo::distance(boxes[nearest.first], c));
+		REQUIRE(touch == bvh.nearest(sphere).second);
+	}
+}
+}  // namespace
+
+TEST_CASE("[Wide BVH] Queries")
+{
+	std::mt19937                           gen(23);
+	std::uniform_real_distribution<double> pos(-25, 25);
+	std::uniform_real_distribution<double> size(0.05, 1.0);
+
+	std::vector<ufo::AABB3d> boxes;
+	for (int i{}; 5000 > i; ++i) {
+		ufo::Vec3d c(pos(gen), pos(gen), pos(gen));
+		boxes.emplace_back(c, c + ufo::Vec3d(size(gen), size(gen), size(gen)));
+	}
+
+	ufo::BVH<ufo::AABB3d>  binary(boxes.begin(), boxes.end(), ufo::BVHBuild::SAH);
+	ufo::BVH4<ufo::AABB3d> bvh4(binary);
+	ufo::BVH8<ufo::AABB3d> bvh8(std::execution::par, boxes.begin(), boxes.end());
+	checkStructure(bvh4, boxes);
+	checkStructure(bvh8, boxes);
+	checkQueries(bvh4, boxes, gen);
+	checkQueries(bvh8, boxes, gen);
+
+	// Each wide node replaces at least `Width - 1` binary internal nodes, unless a leaf
+	// cuts it short
+	REQUIRE(binary.nodes().size() / 2 > bvh4.nodes().size());
+	REQUIRE(bvh4.nodes().size() > bvh8.nodes().size());
+
+	// A single leaf, and nothing
+	std::vector<ufo::AABB3d> few(boxes.begin(), boxes.begin() + 3);
+	ufo::BVH4<ufo::AABB3d>   small(few.begin(), few.end());
+	checkStructure(small, few);
+	REQUIRE(1 == small.nodes().size());
+	checkQueries(small, few, gen);
+
+	ufo::BVH8<ufo::AABB3d> empty;
+	REQUIRE(0 == empty.raycast(ufo::Ray3d(ufo::Vec3d(), ufo::Vec3d(1, 0, 0))).first);
+	REQUIRE(0 == empty.nearest(ufo::Vec3d()).first);
+}
+
+TEST_CASE("[Wide BVH] Rays in the plane of a face")
+{
+	// A row of unit boxes, the rays run along the shared faces and along the outer ones
+	std::vector<ufo::AABB3d> boxes;
+	for (int i{}; 64 > i; ++i) {
+		boxes.emplace_back(ufo::Vec3d(i, 0, 0), ufo::Vec3d(i + 1, 1, 1));
+	}
+	ufo::BVH4<ufo::AABB3d> bvh4(boxes.begin(), boxes.end());
+	ufo::BVH8<ufo::AABB3d> bvh8(boxes.begin(), boxes.end());
+
+	for (int i{}; 64 >= i; ++i) {
+		for (double z : {-1.0, 1.0}) {
+			for (ufo::Ray3d ray : {ufo::Ray3d(ufo::Vec3d(i, 0.5, -5 * z), ufo::Vec3d(0, 0, z)),
+			                       ufo::Ray3d(ufo::Vec3d(i, 0, -5 * z), ufo::Vec3d(0, 0, z)),
+			                       ufo::Ray3d(ufo::Vec3d(i, 1, -5 * z), ufo::Vec3d(0, 0, z)),
+			                       ufo::Ray3d(ufo::Vec3d(i + 0.5, 0, -5 * z),
+			                                  ufo::Vec3d(0, 0, z))}) {
+				double t = std::numeric_limits<double>::infinity();
+				for (auto const& b : boxes) {
+					t = std::min(t, ufo::raycast(b, ray));
+				}
+				REQUIRE((64.0 < ray.origin.x ? std::numeric_limits<double>::infinity()
+				                             : 0.0 < z ? 5.0 : 4.0) == t);
+				REQUIRE(t == bvh4.raycast(ray).second);
+				REQUIRE(t == bvh8.raycast(ray).second);
+			}
+		}
+	}
+}